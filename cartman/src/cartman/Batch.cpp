@@ -0,0 +1,446 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+/// @file cartman/Batch.cpp
+/// @brief Non-interactive batch processing of module maps.
+
+#include "cartman/Batch.hpp"
+#include "cartman/cartman_map.h"
+#include "cartman/MeshJournal.hpp"
+#include "cartman/cartman_functions.h"
+#include "egolib/Core/ParallelFor.hpp"
+#include "egolib/FileFormats/Globals.hpp"
+#include <atomic>
+
+namespace Cartman {
+
+bool Batch::isRequested(int argc, char *argv[]) {
+    return argc > 1 && std::string("--batch") == argv[1];
+}
+
+Batch::Options Batch::parse(int argc, char *argv[]) {
+    static const std::map<std::string, Operation> operations = {
+        { "validate", Operation::Validate },
+        { "fix", Operation::Fix },
+        { "weld", Operation::Weld },
+        { "twist", Operation::Twist },
+        { "three-e", Operation::ThreeE },
+    };
+    Options options{ ".", 2, false, false, false, {}, {} };
+    for (int i = 2; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--path" || argument == "--jobs" || argument == "--ops") {
+            if (i + 1 == argc) {
+                throw id::runtime_error(__FILE__, __LINE__, "missing value of option `" + argument + "`");
+            }
+            std::string value = argv[++i];
+            if (argument == "--path") {
+                options.path = value;
+            } else if (argument == "--jobs") {
+                try {
+                    options.jobs = std::stoul(value);
+                } catch (const std::exception&) {
+                    options.jobs = 0;
+                }
+                if (0 == options.jobs) {
+                    throw id::runtime_error(__FILE__, __LINE__, "invalid number of jobs `" + value + "`");
+                }
+            } else {
+                std::istringstream is(value);
+                std::string name;
+                while (std::getline(is, name, ',')) {
+                    auto it = operations.find(name);
+                    if (operations.end() == it) {
+                        throw id::runtime_error(__FILE__, __LINE__, "unknown operation `" + name + "`");
+                    }
+                    options.operations.push_back(it->second);
+                }
+            }
+        } else if (argument == "--write") {
+            options.write = true;
+        } else if (argument == "--all") {
+            options.all = true;
+        } else if (argument == "--self-test") {
+            options.selfTest = true;
+        } else if (!argument.empty() && '-' == argument[0]) {
+            throw id::runtime_error(__FILE__, __LINE__, "unknown option `" + argument + "`");
+        } else {
+            options.modules.push_back(argument);
+        }
+    }
+    if (options.operations.empty()) {
+        throw id::runtime_error(__FILE__, __LINE__, "no operations specified");
+    }
+    if (options.modules.empty() && !options.all && !options.selfTest) {
+        throw id::runtime_error(__FILE__, __LINE__, "no modules specified");
+    }
+    return options;
+}
+
+void Batch::apply(Operation operation, cartman_mpd_t& mesh, Result& result) {
+    switch (operation) {
+        case Operation::Validate: {
+            size_t undefinedTypes = 0, outsideVertices = 0, outdatedTwists = 0;
+            for (size_t itile = 0; itile < mesh.info.getTileCount(); ++itile) {
+                const cartman_mpd_tile_t& tile = mesh.fan2[itile];
+                tile_definition_t *pdef = tile_dict.get(tile.type);
+                if (!pdef || 0 == pdef->numvertices) {
+                    undefinedTypes++;
+                    continue;
+                }
+                if (tile.twist != cartman_mpd_get_fan_twist(&mesh, itile)) {
+                    outdatedTwists++;
+                }
+                int cnt;
+                uint32_t vert;
+                for (cnt = 0, vert = tile.vrtstart;
+                     cnt < pdef->numvertices && CART_VALID_VERTEX_RANGE(vert);
+                     cnt++, vert = mesh.vrt2[vert].next) {
+                    const auto& vertex = mesh.vrt2[vert];
+                    if (vertex.x < 0.0f || vertex.x > mesh.info.getEdgeX() ||
+                        vertex.y < 0.0f || vertex.y > mesh.info.getEdgeY()) {
+                        outsideVertices++;
+                    }
+                }
+            }
+            if (0 != undefinedTypes) {
+                result.problems.push_back(std::to_string(undefinedTypes) + " tiles of undefined type");
+            }
+            if (0 != outsideVertices) {
+                result.problems.push_back(std::to_string(outsideVertices) + " vertices outside of the map");
+            }
+            if (0 != outdatedTwists) {
+                result.problems.push_back(std::to_string(outdatedTwists) + " tiles with outdated twist");
+            }
+        } break;
+        case Operation::Fix:
+            fix_mesh(mesh);
+            break;
+        case Operation::Weld:
+            for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
+                weld_corner_verts(mesh, *it);
+            }
+            break;
+        case Operation::Twist:
+            cartman_mpd_make_twist(&mesh);
+            break;
+        case Operation::ThreeE:
+            MeshEditor::three_e_mesh(mesh, 0, 0);
+            break;
+    };
+}
+
+Batch::Result Batch::process(const std::string& module, const Options& options, cartman_mpd_t& mesh, std::mutex& io) {
+    Result result{ module, false, 0, 0, {} };
+    const std::string folder = (module.size() > 4 && 0 == module.compare(module.size() - 4, 4, ".mod")) ? module : module + ".mod";
+    const std::string pathname = "mp_modules/" + folder + "/gamedat/level.mpd";
+
+    // Load the raw map.
+    map_t raw;
+    {
+        std::lock_guard<std::mutex> lock(io);
+        if (!raw.load(pathname)) {
+            result.problems.push_back("unable to load `" + pathname + "`");
+            return result;
+        }
+    }
+    run(pathname, options, raw, mesh, io, result);
+    return result;
+}
+
+Batch::Result Batch::selfTest(const Options& options, cartman_mpd_t& mesh, std::mutex& io) {
+    Result result{ "self-test", false, 0, 0, {} };
+    const std::string pathname = "/debug/cartman_self_test.mpd";
+
+    checkVertexAllocator(mesh, result);
+    checkMeshJournal(mesh, result);
+
+    // Create a new flat map as the editor does for a missing map.
+    cartman_mpd_create(&mesh, 32, 32);
+    int fan = 0;
+    for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it, ++fan) {
+        if (!mesh.add_ifan(fan, (*it).x() * Info<int>::Grid::Size(), (*it).y() * Info<int>::Grid::Size())) {
+            result.problems.push_back("unable to add the vertices of tile " + std::to_string(fan));
+            return result;
+        }
+    }
+
+    // Convert the Cartman map into a raw map such that the pipeline starts from a raw map as for a module.
+    map_t raw;
+    if (!cartman_mpd_revert(&raw, &mesh)) {
+        result.problems.push_back("unable to revert `" + pathname + "`");
+        return result;
+    }
+    run(pathname, options, raw, mesh, io, result);
+    return result;
+}
+
+void Batch::checkVertexAllocator(cartman_mpd_t& mesh, Result& result) {
+    auto check = [&result](bool condition, const std::string& problem) {
+        if (!condition) {
+            result.problems.push_back("vertex allocator: " + problem);
+        }
+        return condition;
+    };
+    auto hasNoFreeRuns = [&mesh]() {
+        for (const auto& runs : mesh.vrt_free_runs) {
+            if (!runs.empty()) {
+                return false;
+            }
+        }
+        return true;
+    };
+    cartman_mpd_free_vertices(&mesh);
+
+    // Fans are allocated contiguously from the vertices which were never allocated.
+    uint32_t a[4], b[4], c[4], d[4];
+    if (!check(mesh.allocate_vertices(4, a) && mesh.allocate_vertices(4, b) &&
+               mesh.allocate_vertices(4, c) && mesh.allocate_vertices(4, d), "unable to allocate 4 fans")) {
+        return;
+    }
+    check(0 == a[0] && 3 == a[3] && 4 == b[0] && 8 == c[0] && 12 == d[0] && 16 == mesh.vrt_at,
+          "fans are not allocated contiguously");
+
+    // Adjacent free runs are merged and a longer fan is allocated from the merged run.
+    mesh.free_vertices(a, 4);
+    mesh.free_vertices(b, 4);
+    check(mesh.vrt_free_runs[4].empty() && std::vector<uint32_t>{ 0 } == mesh.vrt_free_runs[8],
+          "adjacent free runs are not merged");
+    uint32_t e[8];
+    if (!check(mesh.allocate_vertices(8, e), "unable to allocate a fan from a merged run")) {
+        return;
+    }
+    check(0 == e[0] && 7 == e[7] && 16 == mesh.vrt_at && hasNoFreeRuns(),
+          "a fan is not allocated from a merged run");
+
+    // A free run ending at the vertices which were never allocated becomes part of them,
+    // as do the free runs ending there afterwards.
+    mesh.free_vertices(e, 8);
+    mesh.free_vertices(c, 4);
+    check(std::vector<uint32_t>{ 0 } == mesh.vrt_free_runs[12], "adjacent free runs are not merged");
+    mesh.free_vertices(d, 4);
+    check(0 == mesh.vrt_at && hasNoFreeRuns() && MAP_VERTICES_MAX == mesh.vrt_free,
+          "free runs are not merged with the vertices which were never allocated");
+
+    // Free runs are not merged into runs longer than a fan.
+    uint32_t f[MAP_FAN_VERTICES_MAX], g[MAP_FAN_VERTICES_MAX], h[4];
+    if (!check(mesh.allocate_vertices(MAP_FAN_VERTICES_MAX, f) && mesh.allocate_vertices(MAP_FAN_VERTICES_MAX, g) &&
+               mesh.allocate_vertices(4, h), "unable to allocate 3 fans")) {
+        return;
+    }
+    mesh.free_vertices(f, MAP_FAN_VERTICES_MAX);
+    mesh.free_vertices(g, MAP_FAN_VERTICES_MAX);
+    check(2 == mesh.vrt_free_runs[MAP_FAN_VERTICES_MAX].size(), "free runs are merged into runs longer than a fan");
+    mesh.free_vertices(h, 4);
+    check(0 == mesh.vrt_at && hasNoFreeRuns() && MAP_VERTICES_MAX == mesh.vrt_free,
+          "free runs are not merged with the vertices which were never allocated");
+
+    cartman_mpd_free_vertices(&mesh);
+}
+
+void Batch::checkMeshJournal(cartman_mpd_t& mesh, Result& result) {
+    auto check = [&result](bool condition, const std::string& problem) {
+        if (!condition) {
+            result.problems.push_back("mesh journal: " + problem);
+        }
+        return condition;
+    };
+
+    // Changes of both edits are kept unless the element is back in its original state.
+    const VertexState s0{ CHAINEND, 0.0f, 0.0f, 0.0f, 1 }, s1{ CHAINEND, 0.0f, 0.0f, 1.0f, 1 }, s2{ CHAINEND, 0.0f, 0.0f, 2.0f, 1 };
+    Delta<VertexState> earlier, later;
+    earlier.append(1, s0, s1);
+    earlier.append(3, s0, s1);
+    later.append(1, s1, s0);
+    later.append(2, s0, s2);
+    const auto merged = Delta<VertexState>::merge(earlier, later);
+    check(1 == merged.runs.size() && 2 == merged.runs[0].first && 2 == merged.runs[0].count &&
+          std::vector<VertexState>{ s0, s0 } == merged.before && std::vector<VertexState>{ s2, s1 } == merged.after,
+          "deltas are not merged correctly");
+
+    cartman_mpd_free_vertices(&mesh);
+    MeshJournal journal;
+    journal.attach(&mesh);
+
+    // An edit which allocates vertices.
+    uint32_t list[4];
+    {
+        MeshJournal::Transaction transaction(mesh, "allocate");
+        if (!check(mesh.allocate_vertices(4, list), "unable to allocate a fan")) {
+            return;
+        }
+    }
+    // An edit which does not change anything is not stored.
+    {
+        MeshJournal::Transaction transaction(mesh, "none");
+        mesh.touch_vertex(list[0]);
+    }
+    check(1 == journal.getUndoCount(), "edits without changes are stored");
+
+    // Consecutive edits of the same name are merged.
+    const float z = mesh.vrt2[list[0]].z;
+    {
+        MeshJournal::Transaction transaction(mesh, "set z");
+        mesh.touch_vertex(list[0]);
+        mesh.vrt2[list[0]].z = z + 1.0f;
+    }
+    {
+        MeshJournal::Transaction transaction(mesh, "set z");
+        mesh.touch_vertex(list[0]);
+        mesh.vrt2[list[0]].z = z + 2.0f;
+    }
+    check(2 == journal.getUndoCount(), "consecutive edits of the same name are not merged");
+
+    // Undo and redo restore the vertices and the free vertices.
+    check(journal.undo() && z == mesh.vrt2[list[0]].z, "an edit is not undone");
+    check(journal.undo() && VERTEXUNUSED == mesh.vrt2[list[0]].a && 0 == mesh.vrt_at && MAP_VERTICES_MAX == mesh.vrt_free,
+          "an allocation is not undone");
+    check(!journal.undo() && 2 == journal.getRedoCount(), "an edit is undone twice");
+    check(journal.redo() && VERTEXUNUSED != mesh.vrt2[list[0]].a && 4 == mesh.vrt_at && MAP_VERTICES_MAX - 4 == mesh.vrt_free,
+          "an allocation is not redone");
+    check(journal.redo() && z + 2.0f == mesh.vrt2[list[0]].z, "an edit is not redone");
+    check(!journal.redo(), "an edit is redone twice");
+
+    // A new edit discards the undone edits.
+    journal.undo();
+    {
+        MeshJournal::Transaction transaction(mesh, "set a");
+        mesh.touch_vertex(list[1]);
+        mesh.vrt2[list[1]].a = 2;
+    }
+    check(0 == journal.getRedoCount() && 2 == journal.getUndoCount(), "a new edit does not discard the undone edits");
+
+    journal.attach(nullptr);
+    cartman_mpd_free_vertices(&mesh);
+}
+
+void Batch::run(const std::string& pathname, const Options& options, map_t& raw, cartman_mpd_t& mesh, std::mutex& io, Result& result) {
+    // Convert the raw map into a Cartman map.
+    if (!cartman_mpd_convert(&mesh, &raw) || !cartman_mpd_finalize(&mesh)) {
+        result.problems.push_back("unable to convert `" + pathname + "`");
+        return;
+    }
+    result.tileCount = mesh.info.getTileCount();
+    result.vertexCount = mesh.count_used_vertices();
+
+    // Run the pipeline.
+    for (auto operation : options.operations) {
+        apply(operation, mesh, result);
+    }
+
+    // Convert the Cartman map back into a raw map. This verifies the vertex chains even if the map is not written.
+    if (!cartman_mpd_revert(&raw, &mesh)) {
+        result.problems.push_back("unable to revert `" + pathname + "`");
+        return;
+    }
+    if (options.write) {
+        std::lock_guard<std::mutex> lock(io);
+        if (!raw.save(pathname)) {
+            result.problems.push_back("unable to save `" + pathname + "`");
+            return;
+        }
+    }
+    result.success = result.problems.empty();
+}
+
+int Batch::main(int argc, char *argv[]) {
+    Options options;
+    try {
+        options = parse(argc, argv);
+    } catch (const id::runtime_error& e) {
+        printf("%s\n\n", e.what());
+        printf("USAGE: CARTMAN --batch [--path PATH] [--jobs N] [--write] --ops OPERATION{,OPERATION} (MODULE{ MODULE} | --all | --self-test)\n");
+        printf("OPERATIONS: validate, fix, weld, twist, three-e\n\n");
+        return EXIT_FAILURE;
+    }
+
+    // Initialize the file system and the log. No window is opened, however, the system initializes
+    // SDL video and audio. Select the dummy drivers such that batch mode runs without a display.
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    try {
+        Ego::Core::System::initialize(std::string(argv[0]), options.path);
+    } catch (const std::exception& e) {
+        printf("unable to initialize the system: %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+    struct SystemGuard {
+        ~SystemGuard() { Ego::Core::System::uninitialize(); }
+    } systemGuard;
+
+    // Collect the modules.
+    std::vector<std::string> modules = options.modules;
+    if (options.all) {
+        SearchContext ctxt(Ego::VfsPath("mp_modules"), Ego::Extension("mod"), VFS_SEARCH_DIR | VFS_SEARCH_BARE);
+        while (ctxt.hasData()) {
+            modules.push_back(ctxt.getData().string());
+            ctxt.nextData();
+        }
+    }
+
+    // The tile dictionary is shared by all maps.
+    cartman_tile_dictionary_load_vfs();
+
+    // Process the maps. Each job uses its own (large) mesh as scratch space,
+    // hence the number of jobs and not the number of maps bounds the memory usage.
+    std::vector<Result> results(modules.size());
+    std::atomic<size_t> next(0);
+    std::mutex io;
+    const size_t jobs = std::min(options.jobs, modules.size());
+    Ego::Core::parallelFor(jobs, 1, [&](size_t begin, size_t end) {
+        for (size_t job = begin; job < end; ++job) {
+            std::unique_ptr<cartman_mpd_t> mesh = std::make_unique<cartman_mpd_t>();
+            for (size_t i = next++; i < modules.size(); i = next++) {
+                try {
+                    results[i] = process(modules[i], options, *mesh, io);
+                } catch (const std::exception& e) {
+                    results[i] = Result{ modules[i], false, 0, 0, { e.what() } };
+                }
+            }
+        }
+    });
+
+    // Run the pipeline on a new flat map.
+    if (options.selfTest) {
+        std::unique_ptr<cartman_mpd_t> mesh = std::make_unique<cartman_mpd_t>();
+        try {
+            results.push_back(selfTest(options, *mesh, io));
+        } catch (const std::exception& e) {
+            results.push_back(Result{ "self-test", false, 0, 0, { e.what() } });
+        }
+    }
+
+    // Report the results.
+    size_t failures = 0;
+    for (const auto& result : results) {
+        printf("%s %s: %zu tiles, %zu vertices\n", result.success ? "OK  " : "FAIL", result.module.c_str(),
+               result.tileCount, result.vertexCount);
+        for (const auto& problem : result.problems) {
+            printf("    %s\n", problem.c_str());
+        }
+        if (!result.success) {
+            failures++;
+        }
+    }
+    printf("%zu of %zu maps processed successfully\n", results.size() - failures, results.size());
+    return 0 == failures ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace Cartman
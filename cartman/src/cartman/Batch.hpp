@@ -0,0 +1,164 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+/// @file cartman/Batch.hpp
+/// @brief Non-interactive batch processing of module maps.
+
+#pragma once
+
+#include "cartman/cartman_typedef.h"
+#include <mutex>
+
+struct map_t;
+
+namespace Cartman {
+
+/**
+ * @brief
+ *  Non-interactive batch processing of module maps.
+ * @remark
+ *  The maps of the specified modules are loaded, a pipeline of operations is applied to each map and the
+ *  results are optionally written back. The maps are processed in parallel. No window is opened.
+ *
+ *  Usage:
+ *  @code
+ *  cartman --batch [--path PATH] [--jobs N] [--write] --ops OPERATION{,OPERATION} (MODULE{ MODULE} | --all | --self-test)
+ *  @endcode
+ *  where @a OPERATION is one of
+ *  - @a validate: report undefined tile types, vertices outside of the map and outdated tile twists
+ *  - @a fix: weld the corner and edge vertices of all tiles (same as the G key in the editor)
+ *  - @a weld: weld the corner vertices of all tiles
+ *  - @a twist: recompute the tile twists
+ *  - @a three-e: replace all 0x3F tiles by 0x3E tiles
+ *  and @a MODULE is the name of a module with or without the @a .mod extension.
+ *  @a --self-test additionally runs the pipeline on a new flat map (as created by the editor for a missing map)
+ *  such that the pipeline can be smoke-tested without module data. It is written to @a /debug/cartman_self_test.mpd
+ *  if @a --write is specified. Before, the vertex allocator and the mesh journal are checked.
+ */
+struct Batch {
+    /// @brief A map operation.
+    enum class Operation {
+        Validate,
+        Fix,
+        Weld,
+        Twist,
+        ThreeE,
+    };
+
+    /// @brief The options of a batch run.
+    struct Options {
+        /// @brief The Egoboo path, the current directory by default.
+        std::string path;
+        /// @brief The maximum number of maps processed at the same time.
+        size_t jobs;
+        /// @brief If the results are written back.
+        bool write;
+        /// @brief If all modules are processed.
+        bool all;
+        /// @brief If the pipeline is run on a new flat map.
+        bool selfTest;
+        /// @brief The pipeline.
+        std::vector<Operation> operations;
+        /// @brief The module names.
+        std::vector<std::string> modules;
+    };
+
+    /// @brief The result of processing a map.
+    struct Result {
+        /// @brief The module name.
+        std::string module;
+        /// @brief If processing succeeded and no problems were found.
+        bool success;
+        /// @brief The number of tiles and vertices of the map.
+        size_t tileCount, vertexCount;
+        /// @brief The problems found by the pipeline.
+        std::vector<std::string> problems;
+    };
+
+    /**
+     * @brief
+     *  Get if the command line requests a batch run.
+     * @return
+     *  @a true if the first argument is <tt>--batch</tt>, @a false otherwise
+     */
+    static bool isRequested(int argc, char *argv[]);
+
+    /**
+     * @brief
+     *  Run a batch.
+     * @return
+     *  @a EXIT_SUCCESS if all maps were processed successfully, @a EXIT_FAILURE otherwise
+     */
+    static int main(int argc, char *argv[]);
+
+    /**
+     * @brief
+     *  Parse the command line of a batch run.
+     * @throw id::runtime_error
+     *  if the command line is malformed
+     */
+    static Options parse(int argc, char *argv[]);
+
+    /**
+     * @brief
+     *  Process a map.
+     * @param module
+     *  the module name
+     * @param options
+     *  the options
+     * @param mesh
+     *  the mesh to use as scratch space
+     * @param io
+     *  the mutex serializing the file system accesses
+     * @return
+     *  the result
+     */
+    static Result process(const std::string& module, const Options& options, cartman_mpd_t& mesh, std::mutex& io);
+
+    /**
+     * @brief
+     *  Process a new flat map.
+     * @param options
+     *  the options
+     * @param mesh
+     *  the mesh to use as scratch space
+     * @param io
+     *  the mutex serializing the file system accesses
+     * @return
+     *  the result
+     */
+    static Result selfTest(const Options& options, cartman_mpd_t& mesh, std::mutex& io);
+
+    /// @brief Check the vertex allocator of a mesh and append found problems to a result.
+    /// @remark The vertices of the mesh are freed.
+    static void checkVertexAllocator(cartman_mpd_t& mesh, Result& result);
+
+    /// @brief Check the merging of journal deltas and the undo and redo of mesh edits and append found problems to a result.
+    /// @remark The vertices of the mesh are freed.
+    static void checkMeshJournal(cartman_mpd_t& mesh, Result& result);
+
+    /// @brief Convert a raw map into a Cartman map, run the pipeline, convert the Cartman map back and optionally write it.
+    static void run(const std::string& pathname, const Options& options, map_t& raw, cartman_mpd_t& mesh, std::mutex& io, Result& result);
+
+    /// @brief Apply an operation to a map and append found problems to a result.
+    static void apply(Operation operation, cartman_mpd_t& mesh, Result& result);
+};
+
+} // namespace Cartman
@@ -0,0 +1,248 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+/// @file cartman/MeshJournal.cpp
+/// @brief An undo/redo journal of mesh edits.
+
+#include "cartman/MeshJournal.hpp"
+#include "cartman/cartman_map.h"
+
+namespace Cartman {
+
+/// @brief Consecutive edits of the same name are merged if they are committed within this time.
+static constexpr std::chrono::milliseconds MERGE_INTERVAL(500);
+
+MeshJournal::Transaction::Transaction(cartman_mpd_t& mesh, const char *name)
+    : _journal(mesh.journal) {
+    if (_journal) {
+        _journal->begin(name);
+    }
+}
+
+MeshJournal::Transaction::~Transaction() {
+    if (_journal) {
+        _journal->commit();
+    }
+}
+
+MeshJournal::MeshJournal(size_t capacity)
+    : _mesh(nullptr), _capacity(capacity), _depth(0), _name(),
+      _recordedVertices(), _recordedTiles(), _undo(), _redo(), _memoryUsage(0) {
+}
+
+MeshJournal::~MeshJournal() {
+    attach(nullptr);
+}
+
+void MeshJournal::attach(cartman_mpd_t *mesh) {
+    if (0 != _depth) {
+        throw id::runtime_error(__FILE__, __LINE__, "unable to attach a journal during a transaction");
+    }
+    if (_mesh) {
+        _mesh->journal = nullptr;
+    }
+    clear();
+    _mesh = mesh;
+    if (_mesh) {
+        _mesh->journal = this;
+    }
+}
+
+void MeshJournal::clear() {
+    _undo.clear();
+    _redo.clear();
+    _memoryUsage = 0;
+}
+
+void MeshJournal::begin(const char *name) {
+    if (0 == _depth++) {
+        _name = name;
+        _recordedVertices.clear();
+        _recordedTiles.clear();
+    }
+}
+
+void MeshJournal::commit() {
+    if (0 == _depth) {
+        throw id::runtime_error(__FILE__, __LINE__, "no transaction to commit");
+    }
+    if (0 != --_depth) {
+        return;
+    }
+    // Keep the elements which were changed in ascending order of their indices.
+    Entry entry{_name, std::chrono::steady_clock::now(), {}, {}, false};
+    std::vector<uint32_t> indices;
+    indices.reserve(_recordedVertices.size());
+    for (const auto& vertex : _recordedVertices) {
+        indices.push_back(vertex.first);
+    }
+    std::sort(indices.begin(), indices.end());
+    for (auto ivrt : indices) {
+        const VertexState& before = _recordedVertices[ivrt];
+        VertexState after = getVertex(ivrt);
+        if (before != after) {
+            entry.vertices.append(ivrt, before, after);
+            entry.allocationChanged |= (VERTEXUNUSED == before.a) != (VERTEXUNUSED == after.a);
+        }
+    }
+    indices.clear();
+    for (const auto& tile : _recordedTiles) {
+        indices.push_back(tile.first);
+    }
+    std::sort(indices.begin(), indices.end());
+    for (auto itile : indices) {
+        const TileState& before = _recordedTiles[itile];
+        TileState after = getTile(itile);
+        if (before != after) {
+            entry.tiles.append(itile, before, after);
+        }
+    }
+    _recordedVertices.clear();
+    _recordedTiles.clear();
+    if (entry.vertices.empty() && entry.tiles.empty()) {
+        return;
+    }
+
+    // A new edit invalidates the undone edits.
+    for (const auto& undone : _redo) {
+        _memoryUsage -= undone.getMemoryUsage();
+    }
+    _redo.clear();
+
+    // Merge the entry with the latest entry if they belong to the same gesture.
+    if (!_undo.empty() && _undo.back().name == entry.name && entry.time - _undo.back().time < MERGE_INTERVAL) {
+        Entry& latest = _undo.back();
+        _memoryUsage -= latest.getMemoryUsage();
+        latest.vertices = Delta<VertexState>::merge(latest.vertices, entry.vertices);
+        latest.tiles = Delta<TileState>::merge(latest.tiles, entry.tiles);
+        latest.allocationChanged |= entry.allocationChanged;
+        latest.time = entry.time;
+        _memoryUsage += latest.getMemoryUsage();
+    } else {
+        _memoryUsage += entry.getMemoryUsage();
+        _undo.push_back(std::move(entry));
+    }
+    trim();
+}
+
+void MeshJournal::recordVertex(uint32_t ivrt) {
+    if (0 == _depth || !CART_VALID_VERTEX_RANGE(ivrt)) {
+        return;
+    }
+    if (_recordedVertices.find(ivrt) == _recordedVertices.end()) {
+        _recordedVertices.emplace(ivrt, getVertex(ivrt));
+    }
+}
+
+void MeshJournal::recordTile(uint32_t itile) {
+    if (0 == _depth || itile >= MAP_TILE_MAX) {
+        return;
+    }
+    if (_recordedTiles.find(itile) == _recordedTiles.end()) {
+        _recordedTiles.emplace(itile, getTile(itile));
+    }
+}
+
+bool MeshJournal::undo() {
+    if (!_mesh || 0 != _depth || _undo.empty()) {
+        return false;
+    }
+    Entry entry = std::move(_undo.back());
+    _undo.pop_back();
+    apply(entry, true);
+    _redo.push_back(std::move(entry));
+    return true;
+}
+
+bool MeshJournal::redo() {
+    if (!_mesh || 0 != _depth || _redo.empty()) {
+        return false;
+    }
+    Entry entry = std::move(_redo.back());
+    _redo.pop_back();
+    apply(entry, false);
+    // Do not merge a redone edit with a following edit.
+    entry.time = std::chrono::steady_clock::time_point();
+    _undo.push_back(std::move(entry));
+    return true;
+}
+
+size_t MeshJournal::getUndoCount() const {
+    return _undo.size();
+}
+
+size_t MeshJournal::getRedoCount() const {
+    return _redo.size();
+}
+
+size_t MeshJournal::getMemoryUsage() const {
+    return _memoryUsage;
+}
+
+VertexState MeshJournal::getVertex(uint32_t ivrt) const {
+    const auto& vertex = _mesh->vrt2[ivrt];
+    return VertexState{vertex.next, vertex.x, vertex.y, vertex.z, vertex.a};
+}
+
+void MeshJournal::setVertex(uint32_t ivrt, const VertexState& state) {
+    auto& vertex = _mesh->vrt2[ivrt];
+    vertex.next = state.next;
+    vertex.x = state.x;
+    vertex.y = state.y;
+    vertex.z = state.z;
+    vertex.a = state.a;
+}
+
+TileState MeshJournal::getTile(uint32_t itile) const {
+    const auto& tile = _mesh->fan2[itile];
+    return TileState{tile.type, tile.fx, tile.tx_bits, tile.twist, tile.vrtstart};
+}
+
+void MeshJournal::setTile(uint32_t itile, const TileState& state) {
+    auto& tile = _mesh->fan2[itile];
+    tile.type = state.type;
+    tile.fx = state.fx;
+    tile.tx_bits = state.tx_bits;
+    tile.twist = state.twist;
+    tile.vrtstart = state.vrtstart;
+}
+
+void MeshJournal::apply(const Entry& entry, bool undo) {
+    entry.vertices.forEach([this, undo](uint32_t ivrt, const VertexState& before, const VertexState& after) {
+        setVertex(ivrt, undo ? before : after);
+    });
+    entry.tiles.forEach([this, undo](uint32_t itile, const TileState& before, const TileState& after) {
+        setTile(itile, undo ? before : after);
+    });
+    // The free vertex runs can not be patched: Rebuild them.
+    if (entry.allocationChanged) {
+        _mesh->free_vertex_count();
+    }
+}
+
+void MeshJournal::trim() {
+    // Keep at least the latest entry. The undone entries are discarded by the next edit.
+    while (_memoryUsage > _capacity && _undo.size() > 1) {
+        _memoryUsage -= _undo.front().getMemoryUsage();
+        _undo.pop_front();
+    }
+}
+
+} // namespace Cartman
@@ -0,0 +1,330 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+/// @file cartman/MeshJournal.hpp
+/// @brief An undo/redo journal of mesh edits.
+
+#pragma once
+
+#include "cartman/cartman_typedef.h"
+#include <chrono>
+#include <deque>
+
+namespace Cartman {
+
+/**
+ * @brief
+ *  The state of a vertex as recorded by the journal.
+ */
+struct VertexState {
+    uint32_t next;
+    float x, y, z;
+    uint8_t a;
+
+    bool operator==(const VertexState& other) const {
+        return next == other.next && x == other.x && y == other.y && z == other.z && a == other.a;
+    }
+    bool operator!=(const VertexState& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief
+ *  The state of a tile as recorded by the journal.
+ */
+struct TileState {
+    uint8_t type;
+    uint8_t fx;
+    uint16_t tx_bits;
+    uint8_t twist;
+    uint32_t vrtstart;
+
+    bool operator==(const TileState& other) const {
+        return type == other.type && fx == other.fx && tx_bits == other.tx_bits &&
+               twist == other.twist && vrtstart == other.vrtstart;
+    }
+    bool operator!=(const TileState& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief
+ *  The changes of an edit to elements (vertices or tiles) of one kind.
+ * @remark
+ *  Only changed elements are stored. Their indices are stored as runs of consecutive indices,
+ *  their states before and after the edit are stored in ascending order of their indices.
+ */
+template <typename State>
+struct Delta {
+    struct Run {
+        uint32_t first;
+        uint32_t count;
+    };
+    std::vector<Run> runs;
+    std::vector<State> before;
+    std::vector<State> after;
+
+    bool empty() const {
+        return runs.empty();
+    }
+
+    /// @brief Get the number of bytes of memory used by this delta.
+    size_t getMemoryUsage() const {
+        return runs.capacity() * sizeof(Run) + (before.capacity() + after.capacity()) * sizeof(State);
+    }
+
+    /// @brief Append a change. The indices must be appended in strictly ascending order.
+    void append(uint32_t index, const State& stateBefore, const State& stateAfter) {
+        if (runs.empty() || runs.back().first + runs.back().count != index) {
+            runs.push_back(Run{index, 0});
+        }
+        runs.back().count++;
+        before.push_back(stateBefore);
+        after.push_back(stateAfter);
+    }
+
+    /// @brief Invoke <tt>function(index, before, after)</tt> for each change in ascending order of the indices.
+    template <typename Function>
+    void forEach(Function function) const {
+        size_t i = 0;
+        for (const auto& run : runs) {
+            for (uint32_t j = 0; j < run.count; ++j, ++i) {
+                function(run.first + j, before[i], after[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief
+     *  Merge the changes of an edit with the changes of a later edit.
+     * @return
+     *  the changes of both edits
+     */
+    static Delta merge(const Delta& earlier, const Delta& later) {
+        struct Change {
+            uint32_t index;
+            const State *before, *after;
+        };
+        std::vector<Change> x, y;
+        earlier.forEach([&x](uint32_t index, const State& b, const State& a) { x.push_back(Change{index, &b, &a}); });
+        later.forEach([&y](uint32_t index, const State& b, const State& a) { y.push_back(Change{index, &b, &a}); });
+        Delta result;
+        size_t i = 0, j = 0;
+        while (i < x.size() || j < y.size()) {
+            if (j == y.size() || (i < x.size() && x[i].index < y[j].index)) {
+                result.append(x[i].index, *x[i].before, *x[i].after);
+                i++;
+            } else if (i == x.size() || y[j].index < x[i].index) {
+                result.append(y[j].index, *y[j].before, *y[j].after);
+                j++;
+            } else {
+                // Changed by both edits: Keep the change only if the element differs from its original state.
+                if (*x[i].before != *y[j].after) {
+                    result.append(x[i].index, *x[i].before, *y[j].after);
+                }
+                i++;
+                j++;
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief
+ *  An undo/redo journal of mesh edits.
+ * @remark
+ *  While a journal is attached to a mesh, the mesh editing functions record the state of each vertex
+ *  and tile before they modify it for the first time in the current transaction. When the outermost
+ *  transaction is committed, the recorded elements are compared to their current state and only the
+ *  changed elements are kept as an entry of the journal. Undo and redo hence take time proportional
+ *  to the number of changed elements. If the memory used by the entries exceeds the capacity of the
+ *  journal, the oldest entries are discarded.
+ */
+class MeshJournal {
+public:
+    /// @brief The default capacity, in Bytes, of a journal.
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+    /**
+     * @brief
+     *  A transaction. An RAII wrapper for MeshJournal::begin and MeshJournal::commit.
+     * @remark
+     *  Does nothing if no journal is attached to the mesh.
+     */
+    class Transaction {
+    public:
+        /**
+         * @brief
+         *  Begin a transaction.
+         * @param mesh
+         *  the mesh
+         * @param name
+         *  the name of the edit. Consecutive edits of the same name within a short time are merged
+         *  (e.g. the edits of the frames during which a mouse button is held).
+         */
+        Transaction(cartman_mpd_t& mesh, const char *name);
+        ~Transaction();
+        Transaction(const Transaction&) = delete;
+        Transaction& operator=(const Transaction&) = delete;
+    private:
+        MeshJournal *_journal;
+    };
+
+    /**
+     * @brief
+     *  Construct this journal.
+     * @param capacity
+     *  the capacity, in Bytes, of this journal
+     */
+    explicit MeshJournal(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief
+     *  Destruct this journal. The journal is detached from its mesh.
+     */
+    ~MeshJournal();
+
+    MeshJournal(const MeshJournal&) = delete;
+    MeshJournal& operator=(const MeshJournal&) = delete;
+
+    /**
+     * @brief
+     *  Attach this journal to a mesh. All entries are discarded.
+     * @param mesh
+     *  a pointer to the mesh or a null pointer to detach this journal
+     */
+    void attach(cartman_mpd_t *mesh);
+
+    /**
+     * @brief
+     *  Discard all entries.
+     * @remark
+     *  Must be invoked whenever the mesh is modified without the journal e.g. if a mesh is loaded.
+     */
+    void clear();
+
+    /**
+     * @brief
+     *  Begin a (possibly nested) transaction.
+     * @param name
+     *  the name of the edit
+     */
+    void begin(const char *name);
+
+    /**
+     * @brief
+     *  Commit the current transaction. If it is the outermost transaction, the changes are stored as an entry.
+     */
+    void commit();
+
+    /**
+     * @brief
+     *  Record the state of a vertex before it is modified.
+     * @param ivrt
+     *  the index of the vertex
+     */
+    void recordVertex(uint32_t ivrt);
+
+    /**
+     * @brief
+     *  Record the state of a tile before it is modified.
+     * @param itile
+     *  the index of the tile
+     */
+    void recordTile(uint32_t itile);
+
+    /**
+     * @brief
+     *  Undo the latest edit.
+     * @return
+     *  @a true if an edit was undone, @a false otherwise
+     */
+    bool undo();
+
+    /**
+     * @brief
+     *  Redo the latest undone edit.
+     * @return
+     *  @a true if an edit was redone, @a false otherwise
+     */
+    bool redo();
+
+    /// @brief Get the number of edits which can be undone.
+    size_t getUndoCount() const;
+
+    /// @brief Get the number of edits which can be redone.
+    size_t getRedoCount() const;
+
+    /// @brief Get the number of bytes of memory used by the entries.
+    size_t getMemoryUsage() const;
+
+private:
+    /// @brief An entry i.e. the changes of an edit.
+    struct Entry {
+        std::string name;
+        std::chrono::steady_clock::time_point time;
+        Delta<VertexState> vertices;
+        Delta<TileState> tiles;
+        /// @brief If the edit allocated or freed vertices.
+        bool allocationChanged;
+
+        size_t getMemoryUsage() const {
+            return sizeof(Entry) + vertices.getMemoryUsage() + tiles.getMemoryUsage();
+        }
+    };
+
+    /// @brief Get the state of a vertex.
+    VertexState getVertex(uint32_t ivrt) const;
+    /// @brief Set the state of a vertex.
+    void setVertex(uint32_t ivrt, const VertexState& state);
+    /// @brief Get the state of a tile.
+    TileState getTile(uint32_t itile) const;
+    /// @brief Set the state of a tile.
+    void setTile(uint32_t itile, const TileState& state);
+
+    /// @brief Apply the state before (@a undo is @a true) or after (@a undo is @a false) of an entry.
+    void apply(const Entry& entry, bool undo);
+
+    /// @brief Discard the oldest entries until the memory used by the entries does not exceed the capacity.
+    void trim();
+
+    /// @brief The mesh or a null pointer.
+    cartman_mpd_t *_mesh;
+    /// @brief The capacity, in Bytes.
+    size_t _capacity;
+    /// @brief The nesting depth of the current transaction, @a 0 if there is no current transaction.
+    size_t _depth;
+    /// @brief The name of the current transaction.
+    std::string _name;
+    /// @brief The states of the vertices and tiles recorded in the current transaction.
+    std::unordered_map<uint32_t, VertexState> _recordedVertices;
+    std::unordered_map<uint32_t, TileState> _recordedTiles;
+    /// @brief The entries which can be undone, the latest entry last.
+    std::deque<Entry> _undo;
+    /// @brief The entries which can be redone, the latest undone entry last.
+    std::vector<Entry> _redo;
+    /// @brief The number of bytes of memory used by the entries which can be undone or redone.
+    size_t _memoryUsage;
+};
+
+} // namespace Cartman
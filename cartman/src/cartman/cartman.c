@@ -22,6 +22,8 @@
 #include "cartman/cartman.h"
 
 #include "cartman/cartman_map.h"
+#include "cartman/MeshJournal.hpp"
+#include "cartman/Batch.hpp"
 #include "cartman/cartman_functions.h"
 #include "cartman/cartman_input.h"
 #include "cartman/cartman_gui.h"
@@ -87,6 +89,9 @@ static int direct = 16;
 
 static bool _ttf_atexit_registered = false;
 
+/// The undo/redo journal of the mesh.
+static Cartman::MeshJournal journal;
+
 //--------------------------------------------------------------------------------------------
 
 // ui functions
@@ -479,6 +484,9 @@ bool load_module( const std::string& modname, cartman_mpd_t * pmesh )
         cartman_create_mesh( pmesh );
     }
 
+    // start a new edit history
+    journal.attach( pmesh );
+
     // read the wawalite file from the module directory
     pdata = wawalite_data_read("mp_data/wawalite.txt", &wawalite_data);
 
@@ -633,6 +641,7 @@ int vertex_calc_vrta( cartman_mpd_t * pmesh, uint32_t vert )
     // Bounds
     if ( newa < -ambicut ) newa = -ambicut;
     newa += ambi;
+    pmesh->touch_vertex( vert );
     pmesh->vrt2[vert].a = Ego::Math::constrain( newa, 1, 255 );
 
     // Edge fade
@@ -682,6 +691,9 @@ void mesh_calc_vrta(cartman_mpd_t *self)
 {
     if (NULL == self) self = &mesh;
 
+    // The edits of the frames during which the lighting sliders are dragged are merged.
+    Cartman::MeshJournal::Transaction transaction(*self, "relight");
+
     for (auto it = self->info.begin(); it != self->info.end(); ++it) {
             int fan = self->get_ifan(*it);
 
@@ -1293,6 +1305,21 @@ bool cartman_check_keys( const char * modname, cartman_mpd_t * pmesh )
 
     if ( NULL == pmesh ) pmesh = &mesh;
 
+    // Undo & redo
+    // (the selection is dropped as the edit might have allocated or freed selected vertices)
+    if ( CART_KEYDOWN_MOD( SDLK_z, KMOD_CTRL ) )
+    {
+        if ( journal.undo() ) mdata.win_select.clear();
+        Input::get()._keyboard.delay = KEYDELAY;
+        return true;
+    }
+    if ( CART_KEYDOWN_MOD( SDLK_y, KMOD_CTRL ) )
+    {
+        if ( journal.redo() ) mdata.win_select.clear();
+        Input::get()._keyboard.delay = KEYDELAY;
+        return true;
+    }
+
     // Hurt
     if ( CART_KEYDOWN( SDLK_h ) )
     {
@@ -1768,6 +1795,9 @@ void main_end( void )
     // Ending statistics
     show_info();
 
+    // detach the journal from the mesh
+    journal.attach( nullptr );
+
     // end the graphics system
     setup_clear_base_vfs_paths();
 }
@@ -1778,6 +1808,12 @@ int SDL_main( int argcnt, char* argtext[] )
 {
     char modulename[100];
 
+    // A batch run neither opens a window nor uses the editor state.
+    if ( Cartman::Batch::isRequested( argcnt, argtext ) )
+    {
+        return Cartman::Batch::main( argcnt, argtext );
+    }
+
     // register the function to be called to deinitialize the program
     atexit( main_end );
 
@@ -1787,7 +1823,8 @@ int SDL_main( int argcnt, char* argtext[] )
     // grab the egoboo directory and the module name from the command line
     if ( argcnt < 2 || argcnt > 3 )
     {
-        printf( "USAGE: CARTMAN [PATH] MODULE ( without .MOD )\n\n" );
+        printf( "USAGE: CARTMAN [PATH] MODULE ( without .MOD )\n" );
+        printf( "       CARTMAN --batch ... ( see cart.txt )\n\n" );
 		return EXIT_FAILURE;
     }
     else if ( argcnt < 3 )
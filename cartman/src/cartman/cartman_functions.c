@@ -21,6 +21,7 @@
 
 #include "cartman/cartman.h"
 #include "cartman/cartman_map.h"
+#include "cartman/MeshJournal.hpp"
 #include "cartman/cartman_select.h"
 #include "cartman/cartman_math.h"
 #include "cartman/View.hpp"
@@ -115,6 +116,18 @@ void fix_vertices( cartman_mpd_t& mesh, Index2D index2d )
     }
 }
 
+//--------------------------------------------------------------------------------------------
+/// Add the vertex of a tile corner to a selection list.
+/// Tiles outside of the mesh have no vertices and are skipped, hence the corners at the edges of the mesh can be welded.
+static void select_lst_add_corner(select_lst_t& lst, Index2D index2d, int corner)
+{
+    int ivrt = lst.get_mesh()->get_ivrt_xy(index2d, corner);
+    if (CART_VALID_VERTEX_RANGE(ivrt))
+    {
+        lst.add(ivrt);
+    }
+}
+
 //--------------------------------------------------------------------------------------------
 void weld_corner_verts(cartman_mpd_t& mesh, Index2D index2d)
 {
@@ -135,10 +148,10 @@ void weld_TL( cartman_mpd_t& mesh, Index2D index2d )
 	select_lst_t loc_lst;
     loc_lst.init( &mesh );
 
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x(), index2d.y()}, CORNER_TL));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x() - 1, index2d.y()}, CORNER_TR));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x() - 1, index2d.y() - 1}, CORNER_BR));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x(), index2d.y() - 1}, CORNER_BL));
+    select_lst_add_corner(loc_lst, {index2d.x(), index2d.y()}, CORNER_TL);
+    select_lst_add_corner(loc_lst, {index2d.x() - 1, index2d.y()}, CORNER_TR);
+    select_lst_add_corner(loc_lst, {index2d.x() - 1, index2d.y() - 1}, CORNER_BR);
+    select_lst_add_corner(loc_lst, {index2d.x(), index2d.y() - 1}, CORNER_BL);
 
     mesh_select_weld( loc_lst );
 }
@@ -149,10 +162,10 @@ void weld_TR( cartman_mpd_t& mesh, Index2D index2d )
 	select_lst_t loc_lst;
     loc_lst.init( &mesh );
 
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x(), index2d.y()}, CORNER_TR));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x(), index2d.y() - 1}, CORNER_BR));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x() + 1, index2d.y() - 1}, CORNER_BL));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x() + 1, index2d.y()}, CORNER_TL));
+    select_lst_add_corner(loc_lst, {index2d.x(), index2d.y()}, CORNER_TR);
+    select_lst_add_corner(loc_lst, {index2d.x(), index2d.y() - 1}, CORNER_BR);
+    select_lst_add_corner(loc_lst, {index2d.x() + 1, index2d.y() - 1}, CORNER_BL);
+    select_lst_add_corner(loc_lst, {index2d.x() + 1, index2d.y()}, CORNER_TL);
 
     mesh_select_weld( loc_lst );
 }
@@ -163,10 +176,10 @@ void weld_BR( cartman_mpd_t& mesh, Index2D index2d )
     select_lst_t loc_lst;
     loc_lst.init( &mesh );
 
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x(), index2d.y()}, CORNER_BR));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x() + 1, index2d.y()}, CORNER_BL));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x() + 1, index2d.y() + 1}, CORNER_TL));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x(), index2d.y() + 1}, CORNER_TR));
+    select_lst_add_corner(loc_lst, {index2d.x(), index2d.y()}, CORNER_BR);
+    select_lst_add_corner(loc_lst, {index2d.x() + 1, index2d.y()}, CORNER_BL);
+    select_lst_add_corner(loc_lst, {index2d.x() + 1, index2d.y() + 1}, CORNER_TL);
+    select_lst_add_corner(loc_lst, {index2d.x(), index2d.y() + 1}, CORNER_TR);
 
     mesh_select_weld( loc_lst );
 }
@@ -177,10 +190,10 @@ void weld_BL( cartman_mpd_t& mesh, Index2D index2d )
 	select_lst_t loc_lst;
     loc_lst.init( &mesh );
 
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x(), index2d.y()}, CORNER_BL));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x(), index2d.y() + 1}, CORNER_TL));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x() - 1, index2d.y() + 1}, CORNER_TR));
-    loc_lst.add(loc_lst.get_mesh()->get_ivrt_xy({index2d.x() - 1, index2d.y()}, CORNER_BR));
+    select_lst_add_corner(loc_lst, {index2d.x(), index2d.y()}, CORNER_BL);
+    select_lst_add_corner(loc_lst, {index2d.x(), index2d.y() + 1}, CORNER_TL);
+    select_lst_add_corner(loc_lst, {index2d.x() - 1, index2d.y() + 1}, CORNER_TR);
+    select_lst_add_corner(loc_lst, {index2d.x() - 1, index2d.y()}, CORNER_BR);
 
     mesh_select_weld( loc_lst );
 }
@@ -464,8 +477,11 @@ int select_lst_add_fan_vertex( select_lst_t& plst, Index2D index2d, int grid_ix,
         }
     }
 
-    // select_lst_add() only adds valid verts, so don't worry about a bad value in ivrt
-    plst.add( ivrt );
+    // select_lst_t::add() throws on invalid verts, so only add a valid ivrt
+    if ( CART_VALID_VERTEX_RANGE( ivrt ) )
+    {
+        plst.add( ivrt );
+    }
 
     return ivrt;
 }
@@ -584,9 +600,10 @@ void select_lst_add_rect( select_lst_t& plst, const Vector3f& a, const Vector3f&
     std::tie(ymin, ymax) = std::minmax(a.y(), b.y());
     std::tie(zmin, zmax) = std::minmax(a.z(), b.z());
 
+    // All vertices at or above pmesh->vrt_at are unused.
     if ( mode == WINMODE_VERTEX )
     {
-        for ( ivrt = 0; ivrt < MAP_VERTICES_MAX; ivrt++)
+        for ( ivrt = 0; ivrt < pmesh->vrt_at; ivrt++)
         {
             Cartman::mpd_vertex_t& pvrt = pmesh->vrt2[ivrt];
             if (VERTEXUNUSED == pvrt.a) continue;
@@ -602,7 +619,7 @@ void select_lst_add_rect( select_lst_t& plst, const Vector3f& a, const Vector3f&
     }
     else if ( mode == WINMODE_SIDE )
     {
-        for (ivrt = 0; ivrt < MAP_VERTICES_MAX; ivrt++)
+        for (ivrt = 0; ivrt < pmesh->vrt_at; ivrt++)
         {
             Cartman::mpd_vertex_t& pvrt = pmesh->vrt2[ivrt];
             if (VERTEXUNUSED == pvrt.a) continue;
@@ -640,7 +657,7 @@ void select_lst_remove_rect( select_lst_t& plst, const Vector3f& a, const Vector
     if ( mode == WINMODE_VERTEX )
     {
 		uint32_t ivrt;
-        for ( ivrt = 0; ivrt < MAP_VERTICES_MAX; ivrt++)
+        for ( ivrt = 0; ivrt < pmesh->vrt_at; ivrt++)
         {
             Cartman::mpd_vertex_t& pvrt = pmesh->vrt2[ivrt];
             if ( VERTEXUNUSED == pvrt.a ) continue;
@@ -656,7 +673,7 @@ void select_lst_remove_rect( select_lst_t& plst, const Vector3f& a, const Vector
     else if ( mode == WINMODE_SIDE )
     {
 		uint32_t ivrt;
-        for ( ivrt = 0; ivrt < MAP_VERTICES_MAX; ivrt++)
+        for ( ivrt = 0; ivrt < pmesh->vrt_at; ivrt++)
         {
             Cartman::mpd_vertex_t& pvrt = pmesh->vrt2[ivrt];
             if ( VERTEXUNUSED == pvrt.a ) continue;
@@ -733,6 +750,7 @@ void mesh_select_move( select_lst_t& plst, float x, float y, float z )
     if (nullptr == pmesh) {
         throw id::runtime_error(__FILE__, __LINE__, "selection list has no mesh");
     }
+    Cartman::MeshJournal::Transaction transaction(*pmesh, "move");
 
     // limit the movement by the bounds of the mesh
     for ( int cnt = 0; cnt < plst.count(); cnt++ )
@@ -763,6 +781,7 @@ void mesh_select_move( select_lst_t& plst, float x, float y, float z )
 		newy = Ego::Math::constrain(newy, 0.0f, pmesh->info.getEdgeY());
 		newz = Ego::Math::constrain(newz, 0.0f, pmesh->info.getEdgeZ());
 
+        pmesh->touch_vertex(ivrt);
         pmesh->vrt2[ivrt].x = newx;
         pmesh->vrt2[ivrt].y = newy;
         pmesh->vrt2[ivrt].z = newz;
@@ -778,11 +797,13 @@ void mesh_select_set_z_no_bound( select_lst_t& plst, float z )
         throw id::runtime_error(__FILE__, __LINE__, "selection list has no mesh");
     }
 
+    Cartman::MeshJournal::Transaction transaction(*pmesh, "set z");
     for ( int cnt = 0; cnt < plst.count(); cnt++ )
     {
         uint32_t vert = select_lst_t::at(plst, cnt);
         if ( vert > pmesh->info.getVertexCount() ) continue;
 
+        pmesh->touch_vertex(vert);
         pmesh->vrt2[vert].z = z;
     }
 }
@@ -793,6 +814,7 @@ void mesh_select_jitter(select_lst_t& plst) {
     if (nullptr == pmesh)         {
         throw id::runtime_error(__FILE__, __LINE__, "selection list has no mesh");
     }
+    Cartman::MeshJournal::Transaction transaction(*pmesh, "jitter");
 	for (int i = 0; i < plst.count(); ++i) {
 		int vertex = select_lst_t::at(plst, i);
         MeshEditor::move_vert(*pmesh,  vertex, Random::next(2) - 1, Random::next(2) - 1, 0);
@@ -821,23 +843,20 @@ void mesh_select_verts_connected(select_lst_t& plst) {
 			uint32_t vert;
 			int cnt;
             for ( cnt = 0, vert = pfan->vrtstart;
-                  cnt < pdef->numvertices;
+                  cnt < pdef->numvertices && CART_VALID_VERTEX_RANGE(vert);
                   cnt++, vert = pmesh->vrt2[vert].next)
             {
-                for ( int tnc = 0; tnc < plst.count(); tnc++ )
+                if ( -1 != plst.find( vert ) )
                 {
-                    if ( select_lst_t::at(plst,tnc) == vert )
-                    {
-                        select_vertsfan = true;
-                        break;
-                    }
+                    select_vertsfan = true;
+                    break;
                 }
             }
 
             if ( select_vertsfan )
             {
-                for ( int cnt = 0, vert = pfan->vrtstart;
-                      cnt < pdef->numvertices;
+                for ( cnt = 0, vert = pfan->vrtstart;
+                      cnt < pdef->numvertices && CART_VALID_VERTEX_RANGE(vert);
                       cnt++, vert = pmesh->vrt2[vert].next)
                 {
                     plst.add( vert );
@@ -856,6 +875,7 @@ void mesh_select_weld(select_lst_t& plst)
 
     if ( plst.count() > 1 )
     {
+        Cartman::MeshJournal::Transaction transaction(*pmesh, "weld");
 		float sum_x, sum_y, sum_z, sum_a;
         sum_x = 0.0f;
         sum_y = 0.0f;
@@ -894,6 +914,7 @@ void mesh_select_weld(select_lst_t& plst)
             int vertex = select_lst_t::at(plst, cnt);
             if (CHAINEND == vertex) break;
 
+            pmesh->touch_vertex(vertex);
             pmesh->vrt2[vertex].x = avg_x;
             pmesh->vrt2[vertex].y = avg_y;
             pmesh->vrt2[vertex].z = avg_z;
@@ -906,6 +927,7 @@ void mesh_select_weld(select_lst_t& plst)
 void MeshEditor::mesh_set_tile( cartman_mpd_t& mesh, uint16_t tiletoset, uint8_t upper, uint16_t presser, uint8_t tx )
 {
     // ZZ> This function sets one tile type to another
+    Cartman::MeshJournal::Transaction transaction(mesh, "set tile");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
             if ( NULL == pfan ) continue;
@@ -938,6 +960,7 @@ void MeshEditor::mesh_set_tile( cartman_mpd_t& mesh, uint16_t tiletoset, uint8_t
                     default:
                         tx_bits = pfan->tx_bits;
                 }
+                mesh.touch_tile(pfan);
                 pfan->tx_bits = tx_bits;
             }
     }
@@ -948,6 +971,7 @@ void MeshEditor::move_mesh_z( cartman_mpd_t& mesh, int z, uint16_t tiletype, uin
 {
     tiletype = tiletype & tileand;
 
+    Cartman::MeshJournal::Transaction transaction(mesh, "move z");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
             if ( NULL == pfan ) continue;
@@ -962,6 +986,7 @@ void MeshEditor::move_mesh_z( cartman_mpd_t& mesh, int z, uint16_t tiletype, uin
                 {
                     float newz = mesh.vrt2[vert].z + z;
 					newz = Ego::Math::constrain(newz, 0.0f, mesh.info.getEdgeZ());
+                    mesh.touch_vertex(vert);
                     mesh.vrt2[vert].z = newz;
 
                     vert = mesh.vrt2[vert].next;
@@ -981,6 +1006,7 @@ void MeshEditor::move_vert( cartman_mpd_t& mesh, int vert, float x, float y, flo
 	newy = Ego::Math::constrain(newy, 0, (int)mesh.info.getEdgeY());
 	newz = Ego::Math::constrain(newz, -(int)mesh.info.getEdgeZ(), +(int)mesh.info.getEdgeZ());
 
+    mesh.touch_vertex(vert);
     mesh.vrt2[vert].x = newx;
     mesh.vrt2[vert].y = newy;
     mesh.vrt2[vert].z = newz;
@@ -991,6 +1017,8 @@ void MeshEditor::raise_mesh( cartman_mpd_t& mesh, uint32_t point_lst[], size_t p
 {
     if ( NULL == point_lst || 0 == point_cnt ) return;
 
+    Cartman::MeshJournal::Transaction transaction(mesh, "raise");
+
     for ( size_t cnt = 0; cnt < point_cnt; cnt++ )
     {
         uint32_t vert = point_lst[cnt];
@@ -1011,6 +1039,7 @@ void MeshEditor::raise_mesh( cartman_mpd_t& mesh, uint32_t point_lst[], size_t p
 //--------------------------------------------------------------------------------------------
 void MeshEditor::level_vrtz( cartman_mpd_t& mesh )
 {
+    Cartman::MeshJournal::Transaction transaction(mesh, "level");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
             if ( NULL == pfan ) continue;
@@ -1021,6 +1050,7 @@ void MeshEditor::level_vrtz( cartman_mpd_t& mesh )
             uint32_t vert = pfan->vrtstart;
             for ( int cnt = 0; cnt < pdef->numvertices; cnt++ )
             {
+                mesh.touch_vertex(vert);
                 mesh.vrt2[vert].z = 0;
                 vert = mesh.vrt2[vert].next;
             }
@@ -1030,6 +1060,7 @@ void MeshEditor::level_vrtz( cartman_mpd_t& mesh )
 //--------------------------------------------------------------------------------------------
 void MeshEditor::jitter_mesh( cartman_mpd_t& mesh )
 {
+    Cartman::MeshJournal::Transaction transaction(mesh, "jitter mesh");
 	select_lst_t loc_lst;
 
     // initialize the local selection
@@ -1068,6 +1099,8 @@ void MeshEditor::flatten_mesh( cartman_mpd_t& mesh, int y0 )
     int height = ( 780 - ( y0 ) ) * 4;
 	height = int(Ego::Math::constrain(float(height), 0.0f, mesh.info.getEdgeZ()));
 
+    Cartman::MeshJournal::Transaction transaction(mesh, "flatten");
+
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
             if ( NULL == pfan ) continue;
@@ -1084,6 +1117,7 @@ void MeshEditor::flatten_mesh( cartman_mpd_t& mesh, int y0 )
 
 				if (std::abs(ftmp) < 50)
                 {
+                    mesh.touch_vertex(vert);
                     mesh.vrt2[vert].z = height;
                 }
 
@@ -1100,11 +1134,13 @@ void MeshEditor::clear_mesh( cartman_mpd_t& mesh, uint8_t upper, uint16_t presse
 
     if ( !TILE_IS_FANOFF( TILE_SET_BITS( upper, tx ) ) )
     {
+        Cartman::MeshJournal::Transaction transaction(mesh, "clear");
         for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it)
         {
                 cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
                 if ( NULL == pfan ) continue;
 
+                mesh.touch_fan(pfan);
                 mesh.remove_pfan(pfan);
 
                 int tx_bits = TILE_SET_UPPER_BITS( upper );
@@ -1147,12 +1183,14 @@ void MeshEditor::three_e_mesh( cartman_mpd_t& mesh, uint8_t upper, uint8_t tx )
         return;
     }
 
+    Cartman::MeshJournal::Transaction transaction(mesh, "three e");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
             if ( NULL == pfan ) continue;
 
             if ( 0x3F == pfan->tx_bits )
             {
+                mesh.touch_tile(pfan);
                 pfan->tx_bits = 0x3E;
             }
     }
@@ -1355,6 +1393,7 @@ void MeshEditor::set_barrier_height( cartman_mpd_t& mesh, const Index2D& index2d
         }
 
         // interpolate a value
+        mesh.touch_vertex(vert);
         mesh.vrt2[vert].z = ftmp + min_hgt;
     }
 }
@@ -1362,6 +1401,8 @@ void MeshEditor::set_barrier_height( cartman_mpd_t& mesh, const Index2D& index2d
 //--------------------------------------------------------------------------------------------
 void MeshEditor::fix_walls( cartman_mpd_t& mesh )
 {
+    Cartman::MeshJournal::Transaction transaction(mesh, "fix walls");
+
     // make sure the corners are correct
     fix_corners( mesh );
 
@@ -1374,11 +1415,13 @@ void MeshEditor::fix_walls( cartman_mpd_t& mesh )
 //--------------------------------------------------------------------------------------------
 void MeshEditor::impass_edges( cartman_mpd_t& mesh, int amount )
 {
+    Cartman::MeshJournal::Transaction transaction(mesh, "impass edges");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             if (dist_from_edge(mesh, *it) < amount)
             {
                 cartman_mpd_tile_t *tile = mesh.get_pfan(*it);
                 if (!tile) continue;
+                mesh.touch_tile(tile);
 				tile->setImpassable();
             }
     }
@@ -1392,12 +1435,14 @@ void MeshEditor::mesh_replace_fx( cartman_mpd_t& mesh, uint16_t fx_bits, uint16_
     // trim away any bits that can't be matched
     fx_bits &= fx_mask;
 
+    Cartman::MeshJournal::Transaction transaction(mesh, "replace fx");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
             if ( NULL == pfan ) continue;
 
             if ( fx_bits == ( pfan->tx_bits&fx_mask ) )
             {
+                mesh.touch_tile(pfan);
                 pfan->fx = fx_new;
             }
     }
@@ -1607,6 +1652,7 @@ void trim_mesh_tile( cartman_mpd_t& mesh, uint16_t fx_bits, uint16_t fx_mask )
     // ZZ> This function trims walls and floors and tops automagically
     fx_bits = fx_bits & fx_mask;
 
+    Cartman::MeshJournal::Transaction transaction(mesh, "trim");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
             if ( NULL == pfan ) continue;
@@ -1625,6 +1671,7 @@ void trim_mesh_tile( cartman_mpd_t& mesh, uint16_t fx_bits, uint16_t fx_mask )
 
                 if ( code != 255 )
                 {
+                    mesh.touch_tile(pfan);
                     pfan->tx_bits = fx_bits + code;
                 }
             }
@@ -1640,6 +1687,9 @@ void MeshEditor::mesh_replace_tile(cartman_mpd_t& mesh, int _xfan, int _yfan, in
 	cartman_mpd_tile_t *pfan = CART_MPD_FAN_PTR(&mesh, _onfan);
     if ( NULL == pfan ) return;
 
+    Cartman::MeshJournal::Transaction transaction(mesh, "replace tile");
+    mesh.touch_fan(pfan);
+
     if ( !tx_only )
     {
         if ( !at_floor_level )
@@ -1729,6 +1779,8 @@ void MeshEditor::setFX( cartman_mpd_t& mesh, int ifan, uint8_t fx )
 {
     cartman_mpd_tile_t *tile = mesh.get_pfan(ifan);
     if (!tile) return;
+    Cartman::MeshJournal::Transaction transaction(mesh, "set fx");
+    mesh.touch_tile(tile);
 	tile->setFX(fx);
 }
 
@@ -1741,6 +1793,7 @@ void MeshEditor::mesh_move( cartman_mpd_t& mesh, float dx, float dy, float dz )
     cartman_mpd_tile_t * pfan   = NULL;
     tile_definition_t  * pdef    = NULL;
 
+    Cartman::MeshJournal::Transaction transaction(mesh, "move mesh");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             int count;
 
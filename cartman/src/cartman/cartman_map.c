@@ -19,6 +19,7 @@
 
 #include "egolib/FileFormats/Globals.hpp"
 #include "cartman/cartman_map.h"
+#include "cartman/MeshJournal.hpp"
 #include "cartman/cartman.h"
 #include "cartman/cartman_math.h"
 
@@ -33,13 +34,6 @@ tile_line_data_t tile_dict_lines[MAP_FAN_TYPE_MAX];
 
 //--------------------------------------------------------------------------------------------
 
-cartman_mpd_t *cartman_mpd_finalize( cartman_mpd_t * );
-
-cartman_mpd_t *cartman_mpd_convert( cartman_mpd_t *, map_t * );
-map_t *cartman_mpd_revert( map_t *, cartman_mpd_t * );
-
-//--------------------------------------------------------------------------------------------
-
 uint8_t cartman_mpd_calc_twist( int dx, int dy )
 {
     uint8_t twist;
@@ -61,8 +55,8 @@ uint8_t cartman_mpd_calc_twist( int dx, int dy )
 //--------------------------------------------------------------------------------------------
 
 cartman_mpd_t::cartman_mpd_t() :
-    vrt2(), vrt_free(MAP_VERTICES_MAX), vrt_at(0), info(),
-    fan2(), fanstart2()
+    vrt_free(MAP_VERTICES_MAX), vrt_at(0), vrt_free_runs(), vrt2(), info(),
+    fan2(), fanstart2(), journal(nullptr)
 {
 }
 
@@ -76,8 +70,7 @@ cartman_mpd_t *cartman_mpd_t::reset()
     {
         e.reset();
     }
-    vrt_free = MAP_VERTICES_MAX;
-    vrt_at = 0;
+    reset_free_vertices();
 
     info.reset();
 
@@ -232,18 +225,246 @@ Cartman::mpd_vertex_t * cartman_mpd_t::get_pvrt_idx( cartman_mpd_t * pmesh, cart
     return pvrt;
 }
 
+void cartman_mpd_t::touch_vertex(uint32_t ivrt)
+{
+    if (journal)
+    {
+        journal->recordVertex(ivrt);
+    }
+}
+
+void cartman_mpd_t::touch_tile(const cartman_mpd_tile_t *pfan)
+{
+    if (journal && pfan)
+    {
+        journal->recordTile(pfan - fan2.data());
+    }
+}
+
+void cartman_mpd_t::touch_fan(const cartman_mpd_tile_t *pfan)
+{
+    if (!journal || !pfan)
+    {
+        return;
+    }
+    journal->recordTile(pfan - fan2.data());
+    tile_definition_t *pdef = tile_dict.get(pfan->type);
+    if (!pdef)
+    {
+        return;
+    }
+    int cnt;
+    uint32_t vert;
+    for (cnt = 0, vert = pfan->vrtstart;
+         cnt < pdef->numvertices && CART_VALID_VERTEX_RANGE(vert);
+         cnt++, vert = vrt2[vert].next)
+    {
+        journal->recordVertex(vert);
+    }
+}
+
 void cartman_mpd_t::free_vertex_count()
 {
-    int num = 0;
-    for (auto& e : vrt2)
+    reset_free_vertices();
+
+    // Find the end of the used vertices.
+    vrt_at = MAP_VERTICES_MAX;
+    while (vrt_at > 0 && VERTEXUNUSED == vrt2[vrt_at - 1].a)
+    {
+        vrt_at--;
+    }
+    vrt_free = MAP_VERTICES_MAX - vrt_at;
+
+    // Collect the free runs below the end of the used vertices.
+    for (uint32_t ivrt = 0; ivrt < vrt_at;)
+    {
+        if (VERTEXUNUSED != vrt2[ivrt].a)
+        {
+            ivrt++;
+            continue;
+        }
+        uint32_t length = 0;
+        while (ivrt + length < vrt_at && length < MAP_FAN_VERTICES_MAX && VERTEXUNUSED == vrt2[ivrt + length].a)
+        {
+            length++;
+        }
+        vrt_free_runs[length].push_back(ivrt);
+        vrt_free += length;
+        ivrt += length;
+    }
+}
+
+void cartman_mpd_t::reset_free_vertices()
+{
+    for (auto& runs : vrt_free_runs)
+    {
+        runs.clear();
+    }
+    vrt_at = 0;
+    vrt_free = MAP_VERTICES_MAX;
+}
+
+bool cartman_mpd_t::allocate_vertices(size_t count, uint32_t list[])
+{
+    if (count > MAP_FAN_VERTICES_MAX || vrt_free < count)
+    {
+        return false;
+    }
+    size_t allocated = 0;
+    auto take = [this, list, &allocated](uint32_t first, size_t length)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            list[allocated++] = first + i;
+        }
+    };
+    if (0 == count)
+    {
+        // Nothing to do.
+    }
+    // A free run of exactly the requested length.
+    else if (!vrt_free_runs[count].empty())
+    {
+        take(vrt_free_runs[count].back(), count);
+        vrt_free_runs[count].pop_back();
+    }
+    // The vertices which were never allocated.
+    else if (vrt_at + count <= MAP_VERTICES_MAX)
+    {
+        take(vrt_at, count);
+        vrt_at += count;
+    }
+    else
+    {
+        // Split a longer free run.
+        for (size_t length = count + 1; length <= MAP_FAN_VERTICES_MAX && 0 == allocated; ++length)
+        {
+            if (!vrt_free_runs[length].empty())
+            {
+                uint32_t first = vrt_free_runs[length].back();
+                vrt_free_runs[length].pop_back();
+                take(first, count);
+                vrt_free_runs[length - count].push_back(first + count);
+            }
+        }
+        // The free vertices are fragmented: Gather the vertices from shorter runs.
+        for (size_t length = 1; length < count && allocated < count; ++length)
+        {
+            while (!vrt_free_runs[length].empty() && allocated < count)
+            {
+                uint32_t first = vrt_free_runs[length].back();
+                vrt_free_runs[length].pop_back();
+                size_t used = std::min(length, count - allocated);
+                take(first, used);
+                if (used < length)
+                {
+                    vrt_free_runs[length - used].push_back(first + used);
+                }
+            }
+        }
+        if (allocated < count)
+        {
+            size_t used = std::min<size_t>(MAP_VERTICES_MAX - vrt_at, count - allocated);
+            take(vrt_at, used);
+            vrt_at += used;
+        }
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        touch_vertex(list[i]);
+        vrt2[list[i]].a = 1;
+        vrt2[list[i]].next = CHAINEND;
+    }
+    vrt_free -= count;
+    return true;
+}
+
+void cartman_mpd_t::free_vertices(const uint32_t list[], size_t count)
+{
+    for (size_t i = 0; i < count;)
+    {
+        if (!CART_VALID_VERTEX_RANGE(list[i]) || VERTEXUNUSED == vrt2[list[i]].a)
+        {
+            i++;
+            continue;
+        }
+        // Free the maximal run of contiguous vertices starting at this vertex.
+        uint32_t first = list[i], length = 0;
+        while (i < count && length < MAP_FAN_VERTICES_MAX && list[i] == first + length &&
+               CART_VALID_VERTEX_RANGE(list[i]) && VERTEXUNUSED != vrt2[list[i]].a)
+        {
+            touch_vertex(list[i]);
+            vrt2[list[i]].a = VERTEXUNUSED;
+            vrt2[list[i]].next = CHAINEND;
+            length++;
+            i++;
+        }
+        add_free_run(first, length);
+        vrt_free += length;
+    }
+}
+
+void cartman_mpd_t::add_free_run(uint32_t first, uint32_t length)
+{
+    // A run ending at the vertices which were never allocated becomes part of them,
+    // as does any free run ending there afterwards.
+    if (first + length == vrt_at)
+    {
+        vrt_at = first;
+        bool merged = true;
+        while (merged && vrt_at > 0 && VERTEXUNUSED == vrt2[vrt_at - 1].a)
+        {
+            merged = false;
+            for (uint32_t other = 1; other <= MAP_FAN_VERTICES_MAX && other <= vrt_at && !merged; ++other)
+            {
+                if (remove_free_run(vrt_at - other, other))
+                {
+                    vrt_at -= other;
+                    merged = true;
+                }
+            }
+        }
+        return;
+    }
+    // Merge with the free run ending at the first vertex and the free run starting after the last vertex
+    // unless the merged run would be longer than a fan.
+    if (first > 0 && VERTEXUNUSED == vrt2[first - 1].a)
+    {
+        for (uint32_t other = 1; other + length <= MAP_FAN_VERTICES_MAX && other <= first; ++other)
+        {
+            if (remove_free_run(first - other, other))
+            {
+                first -= other;
+                length += other;
+                break;
+            }
+        }
+    }
+    if (first + length < vrt_at && VERTEXUNUSED == vrt2[first + length].a)
     {
-        if (VERTEXUNUSED == e.a)
+        for (uint32_t other = 1; other + length <= MAP_FAN_VERTICES_MAX; ++other)
         {
-            num++;
+            if (remove_free_run(first + length, other))
+            {
+                length += other;
+                break;
+            }
         }
     }
+    vrt_free_runs[length].push_back(first);
+}
 
-    vrt_free = num;
+bool cartman_mpd_t::remove_free_run(uint32_t first, uint32_t length)
+{
+    auto& runs = vrt_free_runs[length];
+    auto it = std::find(runs.begin(), runs.end(), first);
+    if (runs.end() == it)
+    {
+        return false;
+    }
+    *it = runs.back();
+    runs.pop_back();
+    return true;
 }
 
 int cartman_mpd_t::count_used_vertices()
@@ -282,8 +503,7 @@ void cartman_mpd_free_vertices(cartman_mpd_t *self)
         self->vrt2[i].next = CHAINEND;
     }
 
-    self->vrt_at = 0;
-    self->vrt_free = MAP_VERTICES_MAX;
+    self->reset_free_vertices();
 }
 
 Cartman::mpd_vertex_t *cartman_mpd_t::get_vertex(int ivrt)
@@ -319,6 +539,8 @@ bool cartman_mpd_link_vertex(cartman_mpd_t *self, int iparent, int ichild)
         return false;
     }
 
+    self->touch_vertex(iparent);
+    self->touch_vertex(ichild);
     pparent->next = ichild;
     pchild->next  = CHAINEND;
 
@@ -327,31 +549,12 @@ bool cartman_mpd_link_vertex(cartman_mpd_t *self, int iparent, int ichild)
 
 int cartman_mpd_t::find_free_vertex()
 {
-    if (vrt_free <= 0)
+    uint32_t ivrt;
+    if (!allocate_vertices(1, &ivrt))
     {
         return -1;
     }
-
-    for (int cnt = 0;
-         cnt < MAP_VERTICES_MAX && VERTEXUNUSED != vrt2[vrt_at].a;
-         cnt++)
-    {
-        vrt_at++;
-
-        if (!CART_VALID_VERTEX_RANGE(vrt_at))
-        {
-            vrt_at = 0;
-        }
-    }
-
-    bool found = false;
-    if (VERTEXUNUSED == vrt2[vrt_at].a)
-    {
-        vrt2[vrt_at].a = 1;
-        found = true;
-    }
-
-    return found ? vrt_at : -1;
+    return ivrt;
 }
 
 uint8_t cartman_mpd_get_fan_twist( cartman_mpd_t * pmesh, uint32_t fan )
@@ -442,6 +645,8 @@ int cartman_mpd_free_vertex_list(cartman_mpd_t *self, int list[], size_t size)
     {
         return -1;
     }
+    uint32_t vertices[MAP_FAN_VERTICES_MAX];
+    size_t count = 0;
     for (size_t i = 0; i < size; ++i)
     {
         int ivrt = list[i];
@@ -449,20 +654,19 @@ int cartman_mpd_free_vertex_list(cartman_mpd_t *self, int list[], size_t size)
         {
             break;
         }
-        self->vrt2[ivrt].a = VERTEXUNUSED;
-        self->vrt2[ivrt].next = CHAINEND;
+        vertices[count++] = ivrt;
+        if (count == SDL_arraysize(vertices))
+        {
+            self->free_vertices(vertices, count);
+            count = 0;
+        }
     }
+    self->free_vertices(vertices, count);
     return size;
 }
 
 int cartman_mpd_allocate_vertex_list(cartman_mpd_t * pmesh, int list[], size_t size, size_t count)
 {
-	size_t cnt, valid_verts;
-	int allocated = 0;
-    uint32_t vrt_at_old = 0, vrt_free_old = MAP_VERTICES_MAX;
-
-    bool alloc_error = false;
-
     // the list must be valid
     if ( NULL == list || 0 == size ) return -1;
 
@@ -471,65 +675,30 @@ int cartman_mpd_allocate_vertex_list(cartman_mpd_t * pmesh, int list[], size_t s
 
     // grab the mesh
     if ( NULL == pmesh ) pmesh = &mesh;
-    vrt_at_old   = pmesh->vrt_at;
-    vrt_free_old = pmesh->vrt_free;
 
     // try to allocate the vertices
-    alloc_error = false;
-    for (cnt = 0, valid_verts = 0; cnt < count; cnt++, valid_verts++ )
-    {
-        int vert = pmesh->find_free_vertex();
-        if ( vert < 0 )
-        {
-            alloc_error = true;
-            break;
-        }
-
-        list[cnt] = vert;
-    }
-
-    // handle allocation errors
-    if ( alloc_error )
+    uint32_t vertices[MAP_FAN_VERTICES_MAX];
+    if ( !pmesh->allocate_vertices( count, vertices ) )
     {
-        // reset the pmesh memory
-        pmesh->vrt_at   = vrt_at_old;
-        pmesh->vrt_free = vrt_free_old;
-        for ( cnt = 0; cnt < valid_verts; cnt++ )
-        {
-            pmesh->vrt2[list[cnt]].reset();
-        }
-
         // tell the caller we failed
         list[0] = CHAINEND;
-        allocated = -1;
+        return -1;
     }
-    else
-    {
-        int parent, child;
-
-        // allocated all the vertices, so adjust the free count
-        pmesh->vrt_free -= valid_verts;
-
-        // finish the list
-        list[cnt] = CHAINEND;
 
-        // tell the caller we succeeded
-        allocated = valid_verts;
-
-        // set the start vertex
-        parent = list[0];
-        pmesh->vrt2[parent].a = 1;
+    // finish the list
+    for ( size_t cnt = 0; cnt < count; cnt++ )
+    {
+        list[cnt] = vertices[cnt];
+    }
+    list[count] = CHAINEND;
 
-        // link the remaining vertices
-        for ( cnt = 1; cnt < valid_verts; cnt++ )
-        {
-            parent = list[cnt-1];
-            child  = list[cnt];
-            cartman_mpd_link_vertex( pmesh, parent, child );
-        }
+    // link the vertices
+    for ( size_t cnt = 1; cnt < count; cnt++ )
+    {
+        cartman_mpd_link_vertex( pmesh, list[cnt-1], list[cnt] );
     }
 
-    return allocated;
+    return count;
 }
 
 int cartman_mpd_allocate_verts(cartman_mpd_t *self, size_t count)
@@ -591,6 +760,7 @@ int cartman_mpd_add_fan_verts(cartman_mpd_t *self, cartman_mpd_tile_t *pfan)
     cartman_mpd_allocate_vertex_list(self, vertexlist, SDL_arraysize(vertexlist), vert_count);
 
     // set the vertex posisions
+    self->touch_tile(pfan);
     pfan->vrtstart = vertexlist[0];
 
     return pfan->vrtstart;
@@ -662,16 +832,20 @@ void cartman_mpd_t::remove_pfan(cartman_mpd_tile_t *pfan)
     tile_definition_t *pdef = tile_dict.get(pfan->type);
     if (!pdef) return;
 
-    Uint32 numvert = pdef->numvertices;
+    Uint32 numvert = std::min<Uint32>(pdef->numvertices, MAP_FAN_VERTICES_MAX);
 
-    for (int cnt = 0, vert = pfan->vrtstart;
-         cnt < numvert && CHAINEND != vert;
-         cnt++, vert = this->vrt2[vert].next )
+    // collect the vertices before freeing them, freeing unlinks them
+    uint32_t vertices[MAP_FAN_VERTICES_MAX];
+    Uint32 count = 0;
+    for (uint32_t vert = pfan->vrtstart;
+         count < numvert && CART_VALID_VERTEX_RANGE(vert);
+         vert = this->vrt2[vert].next )
     {
-        this->vrt2[vert].a = VERTEXUNUSED;
-        this->vrt_free++;
+        vertices[count++] = vert;
     }
+    free_vertices(vertices, count);
 
+    touch_tile(pfan);
     pfan->type     = 0;
     pfan->fx       = MAPFX_SHA;
     pfan->vrtstart = CHAINEND;
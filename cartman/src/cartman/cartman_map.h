@@ -198,7 +198,22 @@ struct cartman_mpd_t
      *  <tt>MAP_VERTICES_MAX</tt>
      */
     uint32_t vrt_free;
-    uint32_t vrt_at;                          // Current vertex check for new
+    /**
+     * @brief
+     *  The vertices with an index greater than or equal to this index are free and were not allocated since the last reset.
+     * @default
+     *  <tt>0</tt>
+     */
+    uint32_t vrt_at;
+    /**
+     * @brief
+     *  The free vertices below @a vrt_at as runs of contiguous vertices:
+     *  <tt>vrt_free_runs[n]</tt> holds the first vertex of each free run of @a n vertices.
+     * @remark
+     *  Fans are allocated from these runs or from @a vrt_at as contiguous vertex ranges if possible
+     *  such that their vertex chains are sequential in memory.
+     */
+    std::array<std::vector<uint32_t>, MAP_FAN_VERTICES_MAX + 1> vrt_free_runs;
     std::array<Cartman::mpd_vertex_t, MAP_VERTICES_MAX> vrt2;
 
     cartman_mpd_info_t   info;
@@ -212,6 +227,40 @@ struct cartman_mpd_t
      */
     std::array<uint32_t,MAP_TILE_MAX_Y> fanstart2;
 
+    /**
+     * @brief
+     *  The journal recording the edits of this mesh or a null pointer.
+     * @default
+     *  <tt>nullptr</tt>
+     * @remark
+     *  Set by Cartman::MeshJournal::attach.
+     */
+    Cartman::MeshJournal *journal;
+
+    /**
+     * @brief
+     *  Record the state of a vertex in the journal before the vertex is modified.
+     * @param ivrt
+     *  the vertex index
+     */
+    void touch_vertex(uint32_t ivrt);
+
+    /**
+     * @brief
+     *  Record the state of a tile in the journal before the tile is modified.
+     * @param pfan
+     *  a pointer to the tile
+     */
+    void touch_tile(const cartman_mpd_tile_t *pfan);
+
+    /**
+     * @brief
+     *  Record the state of a tile and of its vertices in the journal before they are modified.
+     * @param pfan
+     *  a pointer to the tile
+     */
+    void touch_fan(const cartman_mpd_tile_t *pfan);
+
     /**
      * @brief
      *  Construct this mesh.
@@ -319,12 +368,41 @@ struct cartman_mpd_t
 
     /**
      * @brief
-     *  Get the index of a free vertex.
+     *  Allocate a free vertex.
      * @return
-     *  the index of a free vertex, @a -1 if none was found
+     *  the index of the vertex, @a -1 if no vertex is free
      */
     int find_free_vertex();
 
+    /**
+     * @brief
+     *  Allocate free vertices.
+     * @param count
+     *  the number of vertices. Must not be greater than @a MAP_FAN_VERTICES_MAX.
+     * @param list
+     *  receives the indices of the vertices
+     * @return
+     *  @a true on success, @a false if fewer than @a count vertices are free
+     * @remark
+     *  The vertices are a contiguous range unless the free vertices are too fragmented.
+     *  The vertices are marked as used, but are not linked.
+     */
+    bool allocate_vertices(size_t count, uint32_t list[]);
+
+    /**
+     * @brief
+     *  Free vertices.
+     * @param list
+     *  the indices of the vertices
+     * @param count
+     *  the number of vertices
+     * @remark
+     *  The vertices are marked as unused and unlinked. Invalid indices and unused vertices are ignored.
+     *  The freed runs are merged with adjacent free runs such that freeing and allocating fans does not
+     *  fragment the free vertices.
+     */
+    void free_vertices(const uint32_t list[], size_t count);
+
     /**
      * @brief
      *  Get the elevation at a point.
@@ -420,11 +498,40 @@ public:
     int count_used_vertices();
 
 protected:
+    friend class Cartman::MeshJournal;
+
     /**
      * @brief
-     *  Re-count unused vertices and update self->vrt_free.
+     *  Re-count unused vertices and update self->vrt_free, self->vrt_at and self->vrt_free_runs.
      */
     void free_vertex_count();
+
+    /**
+     * @brief
+     *  Mark all vertices as free.
+     */
+    void reset_free_vertices();
+
+    /**
+     * @brief
+     *  Add a run of vertices which were just freed to the free runs.
+     * @param first, length
+     *  the first vertex and the length of the run
+     * @remark
+     *  The run is merged with the vertices which were never allocated if it ends at @a vrt_at.
+     *  Otherwise it is merged with the adjacent free runs as long as the merged run is not longer than a fan.
+     */
+    void add_free_run(uint32_t first, uint32_t length);
+
+    /**
+     * @brief
+     *  Remove a free run.
+     * @param first, length
+     *  the first vertex and the length of the run
+     * @return
+     *  @a true if the run was removed, @a false if there is no such free run
+     */
+    bool remove_free_run(uint32_t first, uint32_t length);
 };
 
 
@@ -525,9 +632,35 @@ cartman_mpd_t *cartman_mpd_save_vfs(cartman_mpd_t *self);
  */
 cartman_mpd_t *cartman_mpd_create(cartman_mpd_t *self, int tiles_x, int tiles_y);
 
+/**
+ * @brief
+ *  Convert a raw map into a Cartman map.
+ * @param dst
+ *  the Cartman map to write the data to
+ * @param src
+ *  the raw map to read the data from
+ * @return
+ *  @a dst on success, a null pointer on failure
+ */
+cartman_mpd_t *cartman_mpd_convert(cartman_mpd_t *dst, map_t *src);
+/**
+ * @brief
+ *  Do the finishing calculations after a Cartman map was converted.
+ */
+cartman_mpd_t *cartman_mpd_finalize(cartman_mpd_t *self);
+/**
+ * @brief
+ *  Convert a Cartman map into a raw map.
+ * @param dst
+ *  the raw map to write the data to
+ * @param src
+ *  the Cartman map to read the data from
+ * @return
+ *  @a dst on success, a null pointer on failure
+ */
+map_t *cartman_mpd_revert(map_t *dst, cartman_mpd_t *src);
 
-
-void cartman_mpd_make_twist();
+void cartman_mpd_make_twist(cartman_mpd_t *pmesh);
 void tile_dict_lines_add( int fantype, int start, int end );
 void cartman_tile_dictionary_load_vfs();
 
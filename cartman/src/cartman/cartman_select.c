@@ -48,8 +48,8 @@ void select_lst_t::init(cartman_mpd_t *pmesh)
 
 void select_lst_t::clear()
 {
-    _count = 0;
-    _which[0] = CHAINEND;
+    _which.clear();
+    _index.clear();
 }
 
 bool select_lst_t::add(int vertex)
@@ -58,53 +58,39 @@ bool select_lst_t::add(int vertex)
 		throw id::runtime_error(__FILE__, __LINE__, "vertex index out of bounds");
 	}
 
-    // Is the vertex index in the list?
-    int index = find(vertex);
-	if (-1 != index)
+    // Is the vertex index in the list or is the list full?
+	if (_which.size() >= MAXSELECT || !_index.emplace(vertex, _which.size()).second)
 	{
-		// The vertex is already in the list. => Do nothing and return false.
+		// Do nothing and return false.
 		return false;
 	}
-	else
-	{
-		// The vertex index is not in the list. => Append it and return true.
-        _which[_count] = vertex;
-        _count++;
-
-        if (_count < MAP_VERTICES_MAX)
-        {
-			_which[_count] = CHAINEND;
-        }
-		return true;
-    }
+	// The vertex index was not in the list. => Append it and return true.
+    _which.push_back(vertex);
+	return true;
 }
 
 bool select_lst_t::remove(int vertex)
 {
-    int index = find(vertex);
-	if (-1 == index)
+	if (!CART_VALID_VERTEX_RANGE(vertex)) {
+		throw id::runtime_error(__FILE__, __LINE__, "vertex index out of bounds");
+	}
+
+	auto it = _index.find(vertex);
+	if (_index.end() == it)
 	{
 		// The vertex is not in the list. => Do nothing and return false.
 		return false;
 	}
-	else
+    // The vertex is in the list. => Move the last vertex into its place and return true.
+	uint32_t index = it->second;
+	_index.erase(it);
+	if (index + 1 < _which.size())
 	{
-        // The vertex is in the list. => Remove it and return true.
-        if (_count > 1 )
-        {
-            for (int i = index; i < _count - 1; ++i)
-            {
-				_which[i] = _which[i-1];
-            }
-        }
-
-        // blank out the last vertex
-		_which[_count] = CHAINEND;
-
-        // shorten the chain
-        _count--;
-		return true;
-    }
+		_which[index] = _which.back();
+		_index[_which[index]] = index;
+	}
+	_which.pop_back();
+	return true;
 }
 
 int select_lst_t::find(int vertex) const
@@ -113,20 +99,13 @@ int select_lst_t::find(int vertex) const
 		throw id::runtime_error(__FILE__, __LINE__, "vertex index out of bounds");
 	}
 
-    for (int i = 0; i < _count; ++i)
-    {
-        if (vertex == _which[i])
-        {
-            return i;
-        }
-    }
-
-    return -1;
+	auto it = _index.find(vertex);
+	return _index.end() == it ? -1 : it->second;
 }
 
 int select_lst_t::count() const
 {
-    return _count;
+    return _which.size();
 }
 
 void select_lst_t::synch_mesh(cartman_mpd_t *pmesh)
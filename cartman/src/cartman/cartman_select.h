@@ -31,13 +31,13 @@ struct select_lst_t
 private:
 	/// The mesh to to which the selection applies.
     cartman_mpd_t *_pmesh;
-	/// The actualnumber of points selected.
-    int _count;
-	/// An array of indices of selected points.
-    uint32_t _which[MAXSELECT];
+	/// The indices of the selected points.
+    std::vector<uint32_t> _which;
+	/// Map the index of a selected point to its index in @a _which.
+	std::unordered_map<uint32_t, uint32_t> _index;
 public:
 	select_lst_t()
-		: _pmesh(nullptr), _count(0), _which{ CHAINEND } {
+		: _pmesh(nullptr), _which(), _index() {
 	}
 	static int at(select_lst_t& self, int index) {
 		if (index < 0 || index >= self.count()) {
@@ -59,7 +59,7 @@ public:
 	 *  the index of the vertex
 	 * @return
 	 *  @a true if the vertex was not in the list,
-	 *  @a false otherwise
+	 *  @a false otherwise (including if the list is full)
 	 */
 	bool add(int vertex);
 	/**
@@ -70,6 +70,8 @@ public:
 	 * @return
 	 *  @a true if the vertex was in the list,
 	 *  @a false otherwise
+	 * @remark
+	 *  The last vertex in the list takes the place of the removed vertex.
 	 */
 	bool remove(int vertex);
 	/**
@@ -33,6 +33,7 @@ struct ogl_surface_t;
 struct s_tile_definition_t;
 
 namespace Cartman {
+class MeshJournal;
 namespace Gui {
 struct Cursor;
 struct Manager;
@@ -157,8 +157,7 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
 
             //Dont walk into pits
             //@todo: might need to check tile Z level here instead
-            const ego_tile_info_t& ptile = mesh->getTileInfo(itile);
-            if (ptile.isFanOff())
+            if (mesh->_cmem.isFanOff(itile))
             {
                 // add the invalid tile to the list as a closed tile
                 continue;
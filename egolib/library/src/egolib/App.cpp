@@ -3,10 +3,13 @@
 #include "egolib/Graphics/GraphicsSystem.hpp"
 #include "egolib/Graphics/GraphicsWindow.hpp"
 #include "egolib/Graphics/TextureManager.hpp"
+#include "egolib/Graphics/TextureCache.hpp"
 #include "egolib/Image/ImageManager.hpp"
 #include "egolib/Graphics/FontManager.hpp"
 #include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
 #include "egolib/Extensions/ogl_extensions.h"
+#include "egolib/egoboo_setup.h"
 
 namespace Ego {
 
@@ -18,6 +21,8 @@ AppImpl::AppImpl(const std::string& title, const std::string& version)
     ImageManager::initialize();
     // Initialize the renderer.
     Renderer::initialize();
+    // Initialize the texture cache.
+    TextureCache::initialize();
     // Initialize the texture manager.
     TextureManager::initialize();
     // Initialize the font manager.
@@ -50,8 +55,12 @@ AppImpl::AppImpl(const std::string& title, const std::string& version)
 
     // set up environment mapping
     /// @todo: this isn't used anywhere
-    GL_DEBUG(glTexGeni)(GL_S, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);  // Set The Texture Generation Mode For S To Sphere Mapping (NEW)
-    GL_DEBUG(glTexGeni)(GL_T, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);  // Set The Texture Generation Mode For T To Sphere Mapping (NEW)
+    if (!egoboo_config_t::get().debug_nullRenderer_enable.getValue())
+    {
+        // The null renderer has no OpenGL context.
+        GL_DEBUG(glTexGeni)(GL_S, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);  // Set The Texture Generation Mode For S To Sphere Mapping (NEW)
+        GL_DEBUG(glTexGeni)(GL_T, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);  // Set The Texture Generation Mode For T To Sphere Mapping (NEW)
+    }
 
                                                                     //Initialize the motion blur buffer
     renderer.getAccumulationBuffer().setClearValue(Colour4f(0.0f, 0.0f, 0.0f, 1.0f));
@@ -66,6 +75,21 @@ AppImpl::~AppImpl()
     FontManager::uninitialize();
     // Uninitialize the texture manager.
     TextureManager::uninitialize();
+    // Uninitialize the texture cache.
+    TextureCache::uninitialize();
+    // Write the counters of the null renderer such that they can be inspected without a GPU.
+    if (auto nullRenderer = dynamic_cast<Null::Renderer *>(&Renderer::get()))
+    {
+        static const std::string pathname = "/debug/null_renderer.txt";
+        const auto& counters = nullRenderer->getTotalCounters();
+        Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "null renderer: ", nullRenderer->getNumberOfFrames(), " frames, ",
+                                         counters.draws, " draws, ", counters.vertices, " vertices, ", counters.stateChanges, " state changes, ",
+                                         counters.binds, " binds", Log::EndOfEntry);
+        if (!nullRenderer->dump(pathname))
+        {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to write ", "`", pathname, "`", Log::EndOfEntry);
+        }
+    }
     // Uninitialize the renderer.
     Renderer::uninitialize();
     // Uninitialize the image manager.
@@ -0,0 +1,95 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file  egolib/Core/CacheFile.hpp
+/// @brief Hashing and binary (de)serialization helpers for on-disk cache files.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Ego {
+namespace CacheFile {
+
+/// @brief The offset basis of the 64 bit FNV-1a hash.
+constexpr uint64_t HASH_OFFSET_BASIS = 14695981039346656037ULL;
+
+/// @brief The 64 bit FNV-1a hash of a sequence of Bytes.
+/// @param bytes, numberOfBytes the Bytes
+/// @param value the hash to continue from
+inline uint64_t hash(const char *bytes, size_t numberOfBytes, uint64_t value = HASH_OFFSET_BASIS) {
+    for (size_t i = 0; i < numberOfBytes; ++i) {
+        value ^= static_cast<uint8_t>(bytes[i]);
+        value *= 1099511628211ULL;
+    }
+    return value;
+}
+
+/// @brief The 64 bit FNV-1a hash of a string.
+/// @param string the string
+/// @param value the hash to continue from
+inline uint64_t hash(const std::string& string, uint64_t value = HASH_OFFSET_BASIS) {
+    return hash(string.data(), string.size(), value);
+}
+
+/// @brief Append a value to a buffer.
+template <typename T>
+void write(std::vector<char>& buffer, const T& value) {
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/// @brief Append a string (prefixed by its length) to a buffer.
+inline void write(std::vector<char>& buffer, const std::string& value) {
+    write(buffer, static_cast<uint32_t>(value.size()));
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+/// @brief Reads values from a buffer, failing on short reads.
+struct Reader {
+    const char *current;
+    const char *end;
+    template <typename T>
+    bool read(T& value) {
+        if (end - current < static_cast<ptrdiff_t>(sizeof(T))) return false;
+        std::memcpy(&value, current, sizeof(T));
+        current += sizeof(T);
+        return true;
+    }
+    bool read(std::string& value) {
+        uint32_t size;
+        if (!read(size) || end - current < static_cast<ptrdiff_t>(size)) return false;
+        value.assign(current, size);
+        current += size;
+        return true;
+    }
+    bool read(std::vector<uint8_t>& value, size_t size) {
+        if (end - current < static_cast<ptrdiff_t>(size)) return false;
+        value.assign(current, current + size);
+        current += size;
+        return true;
+    }
+};
+
+} // namespace CacheFile
+} // namespace Ego
@@ -0,0 +1,176 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file  egolib/Core/LruCache.hpp
+/// @brief A hash-indexed least-recently-used cache.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace Ego {
+
+/**
+ * @brief
+ *  A hash-indexed cache of bounded capacity which evicts the least recently used entry.
+ * @remark
+ *  Lookup, insertion and eviction are O(1). The entries are kept in a list ordered by recency
+ *  (most recently used first) and indexed by a hash map from the key to the list position.
+ */
+template <typename KeyType, typename ValueType, typename HashType = std::hash<KeyType>>
+class LruCache {
+private:
+    using Entry = std::pair<KeyType, ValueType>;
+    using List = std::list<Entry>;
+
+    /// @brief The entries, most recently used first.
+    List _entries;
+
+    /// @brief Map from keys to entries.
+    std::unordered_map<KeyType, typename List::iterator, HashType> _index;
+
+    /// @brief The maximum number of entries.
+    size_t _capacity;
+
+    /// @brief The number of lookups which found an entry.
+    size_t _hits;
+
+    /// @brief The number of lookups which did not find an entry.
+    size_t _misses;
+
+public:
+    /**
+     * @brief
+     *  Construct this cache.
+     * @param capacity
+     *  the maximum number of entries. @a 0 disables caching.
+     */
+    explicit LruCache(size_t capacity) :
+        _entries(), _index(), _capacity(capacity), _hits(0), _misses(0) {
+        _index.reserve(capacity);
+    }
+
+    /**
+     * @brief
+     *  Find an entry and mark it as the most recently used one.
+     * @param key
+     *  the key
+     * @return
+     *  a pointer to the value if an entry was found, a null pointer otherwise.
+     *  The pointer is valid until the next insertion into or the next change of the capacity of this cache.
+     */
+    ValueType *find(const KeyType& key) {
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            _misses++;
+            return nullptr;
+        }
+        _hits++;
+        // Move the entry to the front without invalidating iterators.
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return &(it->second->second);
+    }
+
+    /**
+     * @brief
+     *  Insert or replace an entry and mark it as the most recently used one.
+     *  If the cache is full, the least recently used entry is evicted.
+     * @param key
+     *  the key
+     * @param value
+     *  the value
+     * @remark
+     *  If the capacity is @a 0, this function does nothing.
+     */
+    void insert(const KeyType& key, ValueType value) {
+        if (0 == _capacity) {
+            return;
+        }
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            it->second->second = std::move(value);
+            _entries.splice(_entries.begin(), _entries, it->second);
+            return;
+        }
+        if (_entries.size() >= _capacity) {
+            evict();
+        }
+        _entries.emplace_front(key, std::move(value));
+        _index.emplace(key, _entries.begin());
+    }
+
+    /**
+     * @brief
+     *  Remove all entries.
+     * @remark
+     *  The hit and miss counters are not reset.
+     */
+    void clear() {
+        _index.clear();
+        _entries.clear();
+    }
+
+    /// @brief Get the number of entries.
+    size_t getSize() const {
+        return _entries.size();
+    }
+
+    /// @brief Get the maximum number of entries.
+    size_t getCapacity() const {
+        return _capacity;
+    }
+
+    /**
+     * @brief
+     *  Set the maximum number of entries.
+     * @param capacity
+     *  the maximum number of entries. @a 0 disables caching.
+     * @remark
+     *  If the cache holds more entries than the new capacity, the least recently used entries are evicted.
+     */
+    void setCapacity(size_t capacity) {
+        _capacity = capacity;
+        while (_entries.size() > _capacity) {
+            evict();
+        }
+    }
+
+    /// @brief Get the number of lookups which found an entry.
+    size_t getHits() const {
+        return _hits;
+    }
+
+    /// @brief Get the number of lookups which did not find an entry.
+    size_t getMisses() const {
+        return _misses;
+    }
+
+private:
+    /// @brief Evict the least recently used entry.
+    void evict() {
+        _index.erase(_entries.back().first);
+        _entries.pop_back();
+    }
+};
+
+} // namespace Ego
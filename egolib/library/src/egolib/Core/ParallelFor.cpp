@@ -0,0 +1,105 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Core/ParallelFor.cpp
+/// @brief Distribute the indices of a range over the threads of a shared thread pool.
+
+#include "egolib/Core/ParallelFor.hpp"
+#include "egolib/Core/ThreadPool.hpp"
+
+namespace Ego {
+namespace Core {
+
+namespace {
+
+/// @brief Get the number of threads of the shared thread pool.
+size_t getNumberOfWorkers()
+{
+    // One hardware thread is left to the calling thread.
+    static const size_t numberOfWorkers = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+    return numberOfWorkers;
+}
+
+/// @brief Get the shared thread pool.
+/// @remark The thread pool is created on first use.
+ThreadPool& getThreadPool()
+{
+    static ThreadPool threadPool(getNumberOfWorkers());
+    return threadPool;
+}
+
+} // namespace
+
+size_t getParallelism()
+{
+    return getNumberOfWorkers() + 1;
+}
+
+void parallelFor(size_t numberOfIndices, size_t grainSize, const std::function<void(size_t, size_t)>& function)
+{
+    if (0 == grainSize)
+    {
+        throw idlib::argument_out_of_bounds_error(__FILE__, __LINE__, "grainSize");
+    }
+    const size_t numberOfTasks = std::min(getParallelism(), (numberOfIndices + grainSize - 1) / grainSize);
+    if (numberOfTasks <= 1)
+    {
+        if (0 != numberOfIndices)
+        {
+            function(0, numberOfIndices);
+        }
+        return;
+    }
+    const size_t taskSize = (numberOfIndices + numberOfTasks - 1) / numberOfTasks;
+    std::vector<std::future<void>> futures;
+    for (size_t first = taskSize; first < numberOfIndices; first += taskSize)
+    {
+        futures.push_back(getThreadPool().submit(function, first, std::min(numberOfIndices, first + taskSize)));
+    }
+    std::exception_ptr exception;
+    try
+    {
+        function(0, taskSize);
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+    for (auto& future : futures)
+    {
+        try
+        {
+            future.get();
+        }
+        catch (...)
+        {
+            if (!exception)
+            {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+} // namespace Core
+} // namespace Ego
@@ -0,0 +1,58 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Core/ParallelFor.hpp
+/// @brief Distribute the indices of a range over the threads of a shared thread pool.
+
+#pragma once
+
+#include "egolib/typedef.h"
+
+namespace Ego {
+namespace Core {
+
+/**
+ * @brief
+ *  Invoke a function for the indices 0, ..., numberOfIndices - 1, distributed over the threads of a shared thread pool.
+ * @param numberOfIndices
+ *  the number of indices
+ * @param grainSize
+ *  the minimum number of indices per task. Must be positive.
+ * @param function
+ *  the function. It is invoked with the first index and the past-the-end index of a task.
+ *  The tasks are disjoint and cover all indices.
+ * @throw idlib::argument_out_of_bounds_error
+ *  if @a grainSize is @a 0
+ * @remark
+ *  The calling thread processes one of the tasks itself and returns when all tasks are finished.
+ *  If a task raises an exception, then one of the raised exceptions is re-raised after all tasks are finished.
+ *  The function must not invoke parallelFor.
+ */
+void parallelFor(size_t numberOfIndices, size_t grainSize, const std::function<void(size_t, size_t)>& function);
+
+/**
+ * @brief
+ *  Get the maximum number of tasks parallelFor runs at the same time.
+ * @return
+ *  the number of threads of the shared thread pool plus one
+ */
+size_t getParallelism();
+
+} // namespace Core
+} // namespace Ego
@@ -0,0 +1,103 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file  egolib/Core/RadixSort.hpp
+/// @brief A stable least-significant-digit radix sort on 32 bit keys.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Ego {
+namespace Core {
+
+/**
+ * @brief
+ *  Map a float to an unsigned 32 bit key such that the order of the keys is the order of the floats.
+ * @param x
+ *  the float. Must not be NaN.
+ * @return
+ *  the key
+ * @remark
+ *  The bits of non-negative floats are ordered like the floats, hence only their sign bit is flipped.
+ *  The bits of negative floats are ordered in reverse, hence all their bits are flipped.
+ */
+inline uint32_t toRadixKey(float x) {
+    uint32_t bits;
+    static_assert(sizeof(bits) == sizeof(x), "float must be 32 bits wide");
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/**
+ * @brief
+ *  Sort elements by their keys in ascending order.
+ *  Elements with equal keys keep their relative order.
+ * @param elements
+ *  the elements
+ * @param buffer
+ *  a buffer used by the sort. Its contents are unspecified afterwards.
+ *  Reusing the buffer across sorts avoids allocations.
+ * @param key
+ *  a function mapping an element to its uint32_t key
+ * @remark
+ *  The keys are sorted by their bytes, from the least to the most significant byte.
+ *  Each byte takes a counting pass and a scatter pass. Passes over bytes equal for all
+ *  keys are skipped, hence small keys (e.g. texture indices) take fewer passes.
+ */
+template <typename ElementType, typename KeyFunction>
+void radixSort(std::vector<ElementType>& elements, std::vector<ElementType>& buffer, KeyFunction key) {
+    const size_t n = elements.size();
+    if (n < 2) {
+        return;
+    }
+    // Count the bytes of all keys in one pass.
+    std::array<std::array<size_t, 256>, 4> counts = {};
+    for (const auto& element : elements) {
+        const uint32_t k = key(element);
+        for (size_t byte = 0; byte < 4; ++byte) {
+            counts[byte][(k >> (byte * 8)) & 0xff]++;
+        }
+    }
+    buffer.resize(n);
+    for (size_t byte = 0; byte < 4; ++byte) {
+        auto& count = counts[byte];
+        // Skip the pass if all keys have the same byte.
+        if (count[(key(elements[0]) >> (byte * 8)) & 0xff] == n) {
+            continue;
+        }
+        // The offsets of the buckets.
+        size_t offset = 0;
+        for (auto& bucket : count) {
+            const size_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+        for (auto& element : elements) {
+            buffer[count[(key(element) >> (byte * 8)) & 0xff]++] = std::move(element);
+        }
+        elements.swap(buffer);
+    }
+}
+
+} // namespace Core
+} // namespace Ego
@@ -134,6 +134,7 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
     
     _terminateRequested(false),
     _objRef(objRef),
+    _slot(0),
     _profileID(proRef),
     _profile(ProfileSystem::get().getProfile(_profileID)),
     _showStatus(false),
@@ -135,6 +135,14 @@ public:
      */
     ObjectRef getObjRef() const { return _objRef; }
 
+    /**
+     * @brief Get the slot of this object.
+     * @return the slot of this object
+     * @remark Unlike object references, slots are reused by the object handler, hence they are bounded by
+     *  ObjectHandler::getSlotCount() and are suitable to index per-object arrays.
+     */
+    size_t getSlot() const { return _slot; }
+
     /**
     * @return the current team this object is on. This can change in-game (mounts or pets for example)
     **/
@@ -952,6 +960,7 @@ private:
 
     bool _terminateRequested;                        ///< True if this character no longer exists in the game and should be destructed
     ObjectRef _objRef;                               ///< The unique object reference of this object
+    size_t _slot;                                    ///< The slot of this object, assigned by the object handler
     ObjectProfileRef _profileID;                     ///< The ID of our profile
     std::shared_ptr<ObjectProfile> _profile;         ///< Our Profile
     bool _showStatus;                                ///< Display stats?
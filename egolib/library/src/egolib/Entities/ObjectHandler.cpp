@@ -41,6 +41,8 @@ ObjectHandler::ObjectHandler() :
     _semaphore(0),
     _deletedCharacters(0),
     _totalCharactersSpawned(0),
+    _freeSlots(),
+    _slotCount(0),
     _dynamicObjects(),
     _staticObjects(),
     _updateStaticTreeClock(0)
@@ -123,6 +125,14 @@ std::shared_ptr<Object> ObjectHandler::insert(ObjectProfileRef profileRef, Objec
 			return nullptr;
 		}
 
+		// Assign a slot, reusing the slot of a removed object if possible.
+		if (!_freeSlots.empty()) {
+			objPtr->_slot = _freeSlots.back();
+			_freeSlots.pop_back();
+		} else {
+			objPtr->_slot = _slotCount++;
+		}
+
 		// Allocate the new one (we can safely modify the internal map, it isn't iterable from outside).
 		_internalCharacterList[objRef] = objPtr;
 
@@ -167,9 +177,12 @@ void ObjectHandler::clear()
 {
 	_internalCharacterList.clear();
 	_iteratorList.clear();
+	_allocateList.clear();
     _dynamicObjects.clear(0, 0, 0, 0);
     _deletedCharacters = 0;
     _totalCharactersSpawned = 0;
+    _freeSlots.clear();
+    _slotCount = 0;
 }
 
 void ObjectHandler::lock()
@@ -240,6 +253,7 @@ void ObjectHandler::maybeRunDeferred()
                 {
                     //Delete this character
                     _deletedCharacters--;
+                    _freeSlots.push_back(element->getSlot());
 
                     // Make sure everyone knows it died
                     for (const std::shared_ptr<Object>& chr : _iteratorList)
@@ -293,6 +307,11 @@ ObjectHandler::ObjectIterator ObjectHandler::iterator()
     return ObjectIterator(*this);
 }
 
+size_t ObjectHandler::getSlotCount() const
+{
+    return _slotCount;
+}
+
 size_t ObjectHandler::getObjectCount() const 
 {
     return _iteratorList.size() + _allocateList.size() - _deletedCharacters;
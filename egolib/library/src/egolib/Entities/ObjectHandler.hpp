@@ -139,6 +139,14 @@ public:
 	 */
 	size_t getObjectCount() const;
 
+	/**
+	 * @brief Return the number of object slots.
+	 * @return the number of object slots
+	 * @remark The slots of all objects are less than this number. The slots of removed objects are reused,
+	 *		   hence this number is bounded by the maximum number of objects in the game at the same time.
+	 */
+	size_t getSlotCount() const;
+
 	/**
 	 * @brief Removes and de-allocates all game objects contained in this ObjectHandler.
 	 */
@@ -237,5 +245,8 @@ private:
 
 	size_t _totalCharactersSpawned;										///< Total count of characters spawned (includes removed)
 
+	std::vector<size_t> _freeSlots;										///< Slots of removed objects, reused by new objects
+	size_t _slotCount;													///< Number of slots assigned so far
+
 	friend class ObjectIterator;
 };
@@ -62,8 +62,9 @@ void prt_environment_t::reset()
 
 const std::shared_ptr<Particle> Particle::INVALID_PARTICLE = nullptr;
 
-Particle::Particle() :
+Particle::Particle(size_t slot) :
     _particleID(),
+    _slot(slot),
     _particlePhysics(*this),
     _collidedObjects(),
     _attachedTo(),
@@ -73,7 +73,13 @@ struct prt_environment_t
 class Particle : public PhysicsData, private idlib::non_copyable, public Ego::Physics::Collidable
 {
 public:
-    Particle();
+    /**
+     * @brief
+     *  Construct this particle.
+     * @param slot
+     *  the slot of this particle
+     */
+    explicit Particle(size_t slot);
 
     /**
     * @return
@@ -105,6 +111,17 @@ public:
      */
     ParticleRef getParticleID() const;
 
+    /**
+     * @brief
+     *  Get the slot of this particle.
+     * @return
+     *  the slot of this particle
+     * @remark
+     *  The particle handler reuses particles, hence unlike particle references slots are
+     *  bounded by ParticleHandler::getSlotCount() and are suitable to index per-particle arrays.
+     */
+    size_t getSlot() const { return _slot; }
+
     /**
      * @brief
      *  Get a pointer to the profile of this particle.
@@ -454,6 +471,7 @@ public:
 
 private:
     ParticleRef _particleID;                 ///< Unique identifier
+    size_t _slot;                            ///< The slot, assigned by the particle handler
 
     //Collisions
     Ego::Physics::ParticlePhysics _particlePhysics;
@@ -181,7 +181,7 @@ std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
 
     //If we have no free particles in the memory pool but we are allowed to allocate new memory
     if(_unusedPool.empty() && getCount() < _maxParticles) {
-        return std::make_shared<Ego::Particle>();
+        return std::make_shared<Ego::Particle>(_slotCount++);
     }
 
     //Get a free, unused particle from the particle pool
@@ -276,6 +276,7 @@ void ParticleHandler::clear()
     _unusedPool.clear();
     _particleMap.clear();
     _totalParticlesSpawned = 0;
+    _slotCount = 0;
 }
 
 std::shared_ptr<const Ego::Texture> ParticleHandler::getLightParticleTexture()
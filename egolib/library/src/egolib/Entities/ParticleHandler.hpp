@@ -89,6 +89,7 @@ public:
         _maxParticles(0),
         _semaphoreLock(0),
         _totalParticlesSpawned(0),
+        _slotCount(0),
         _unusedPool(),
         _activeParticles(),
         _particleMap(),
@@ -220,6 +221,13 @@ public:
     **/
     size_t getFreeCount() const { return std::min(_maxParticles, _maxParticles - getCount()); }
 
+    /**
+    * @brief
+    *   Get the number of particle slots. The slots of all particles are less than this number.
+    *   Particles are reused, hence this number is bounded by the maximum number of particles.
+    **/
+    size_t getSlotCount() const { return _slotCount; }
+
     std::shared_ptr<const Ego::Texture> getLightParticleTexture();
     std::shared_ptr<const Ego::Texture> getTransparentParticleTexture();
 
@@ -240,6 +248,7 @@ private:
     size_t _maxParticles;   ///< Maximum allowed active particles to be alive at the same time
     std::atomic<size_t> _semaphoreLock;
     std::atomic<size_t> _totalParticlesSpawned;
+    size_t _slotCount;      ///< Number of particles allocated, each particle is allocated with a new slot
 
     std::vector<std::shared_ptr<Ego::Particle>> _unusedPool;         //Particles currently unused
     std::vector<std::shared_ptr<Ego::Particle>> _activeParticles;    //List of all particles that are active ingame
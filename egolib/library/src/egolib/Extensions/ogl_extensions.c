@@ -142,26 +142,84 @@ const std::string& Utilities::toString(GLenum error)
 namespace Ego {
 namespace OpenGL {
 
-PushAttrib::PushAttrib(GLbitfield bitfield)
+PushAttrib::PushAttrib(GLbitfield bitfield) :
+    m_bitfield(bitfield), m_pushed(nullptr != SDL_GL_GetCurrentContext()), m_hasSaved(false), m_saved()
 {
+    if (!m_pushed)
+    {
+        return;
+    }
     glPushAttrib(bitfield);
+    if (auto stateCache = StateCache::getActive())
+    {
+        m_saved = *stateCache;
+        m_hasSaved = true;
+    }
 }
 
 PushAttrib::~PushAttrib()
 {
+    if (!m_pushed)
+    {
+        return;
+    }
     glPopAttrib();
-    Utilities2::isError();
+    if (auto stateCache = StateCache::getActive())
+    {
+        if (m_hasSaved)
+        {
+            stateCache->restore(m_saved, m_bitfield);
+        }
+        else
+        {
+            stateCache->invalidate(m_bitfield);
+        }
+        stateCache->checkError();
+    }
+    else
+    {
+        Utilities2::isError();
+    }
 }
 
-PushClientAttrib::PushClientAttrib(GLbitfield bitfield)
+PushClientAttrib::PushClientAttrib(GLbitfield bitfield) :
+    m_bitfield(bitfield), m_pushed(nullptr != SDL_GL_GetCurrentContext()), m_hasSaved(false), m_saved()
 {
+    if (!m_pushed)
+    {
+        return;
+    }
     glPushClientAttrib(bitfield);
+    if (auto stateCache = StateCache::getActive())
+    {
+        m_saved = *stateCache;
+        m_hasSaved = true;
+    }
 }
 
 PushClientAttrib::~PushClientAttrib()
 {
+    if (!m_pushed)
+    {
+        return;
+    }
     glPopClientAttrib();
-    Utilities2::isError();
+    if (auto stateCache = StateCache::getActive())
+    {
+        if (m_hasSaved)
+        {
+            stateCache->restoreClient(m_saved, m_bitfield);
+        }
+        else
+        {
+            stateCache->invalidateClient(m_bitfield);
+        }
+        stateCache->checkError();
+    }
+    else
+    {
+        Utilities2::isError();
+    }
 }
 
 } // namespace OpenGL
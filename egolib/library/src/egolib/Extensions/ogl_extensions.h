@@ -29,6 +29,7 @@
 #include <string>
 #define GLEW_STATIC
 #include <GL/glew.h>
+#include "egolib/Renderer/OpenGL/StateCache.hpp"
 
 //--------------------------------------------------------------------------------------------
 
@@ -50,15 +51,31 @@ public:
 
 };
 
+/// @brief Push the specified attribute groups on construction and pop them on destruction.
+/// @remark The state cache of the active OpenGL renderer (if any) is saved and restored alongside.
+/// Nothing is pushed if there is no current OpenGL context (e.g. for the null renderer).
 struct PushAttrib
 {
+private:
+    GLbitfield m_bitfield;
+    bool m_pushed;
+    bool m_hasSaved;
+    StateCache m_saved;
 public:
     PushAttrib(GLbitfield bitfield);
     ~PushAttrib();
 }; // struct PushAttrib
 
+/// @brief Push the specified client attribute groups on construction and pop them on destruction.
+/// @remark The state cache of the active OpenGL renderer (if any) is saved and restored alongside.
+/// Nothing is pushed if there is no current OpenGL context (e.g. for the null renderer).
 struct PushClientAttrib
 {
+private:
+    GLbitfield m_bitfield;
+    bool m_pushed;
+    bool m_hasSaved;
+    StateCache m_saved;
 public:
     PushClientAttrib(GLbitfield bitfield);
     ~PushClientAttrib();
@@ -33,47 +33,36 @@
 #include "egolib/Image/SDL_Image_Extensions.h"
 #include "egolib/Log/_Include.hpp"
 #include "egolib/vfs.h"
+#include "egolib/egoboo_setup.h"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 namespace Ego {
 
-struct Font::RenderedTextCache : private idlib::non_copyable {
-    std::shared_ptr<Font::LaidTextRenderer> cache;
-    uint32_t lastUseInTicks;
-    std::string text;
-    int width;
-    int height;
-    int spacing;
-
-    bool isEquivalent(const std::string &t, int w, int h, int s) {
-        return w == width && h == height && s == spacing && t == text;
-    }
-
-    static bool isLessThan(const std::shared_ptr<RenderedTextCache> &a, const std::shared_ptr<RenderedTextCache> &b) {
-        return a->lastUseInTicks < b->lastUseInTicks;
-    }
-};
-
-struct Font::SizedTextCache : private idlib::non_copyable {
-    uint32_t lastUseInTicks;
-    std::string text;
-    int width;
-    int height;
-    int spacing;
-
-    bool isEquivalent(const std::string &t, int s) {
-        return s == spacing && t == text;
-    }
+size_t Font::TextCacheKey::Hash::operator()(const TextCacheKey &key) const {
+    size_t value = std::hash<std::string>()(key.text);
+    // Combine the hashes as boost::hash_combine does.
+    auto combine = [&value](size_t x) { value ^= x + 0x9e3779b9 + (value << 6) + (value >> 2); };
+    combine(std::hash<int>()(key.width));
+    combine(std::hash<int>()(key.height));
+    combine(std::hash<int>()(key.spacing));
+    combine(key.interpretNewlines ? 1 : 0);
+    return value;
+}
 
-    static bool isLessThan(const std::shared_ptr<SizedTextCache> &a, const std::shared_ptr<SizedTextCache> &b) {
-        return a->lastUseInTicks < b->lastUseInTicks;
-    }
-};
+namespace {
+/// The minimum size of a texture atlas page. Pages are larger than the glyphs of a single
+/// text require such that the glyphs of further texts can be added to them.
+constexpr int MINIMUM_ATLAS_PAGE_SIZE = 512;
+} // namespace
 
 struct Font::FontAtlas {
     std::shared_ptr<Texture> texture;
+    std::shared_ptr<SDL_Surface> surface; ///< The source of the texture, glyphs are added to it.
     std::unordered_map<uint16_t, Rectangle2f> glyphs;
+    int x = 0; ///< The x position at which the next glyph is placed.
+    int y = 0; ///< The y position of the current row of glyphs.
+    int rowHeight = 0; ///< The height of the current row of glyphs.
 };
 
 struct Font::LaidOutText {
@@ -96,12 +85,19 @@ struct Font::LayoutOptions {
 
 Font::LaidTextRenderer::LaidTextRenderer(const std::shared_ptr<Texture> &atlas,
                                          const idlib::vertex_descriptor& vertexDescriptor,
-                                         const std::shared_ptr<idlib::vertex_buffer> &vertexBuffer) :
+                                         const std::shared_ptr<idlib::vertex_buffer> &vertexBuffer,
+                                         std::vector<TextBatch::GlyphVertex> vertices) :
     _atlas(atlas),
     _vertexDescriptor(vertexDescriptor),
-    _vertexBuffer(vertexBuffer) {}
+    _vertexBuffer(vertexBuffer),
+    _vertices(std::move(vertices)) {}
 
 void Font::LaidTextRenderer::render(int x, int y, const Colour4f &colour) {
+    if (auto textBatch = TextBatch::getActive()) {
+        textBatch->add(_atlas, _vertices.data(), _vertices.size(), static_cast<float>(x), static_cast<float>(y), colour);
+        return;
+    }
+
     struct MatrixStack {
         MatrixStack() :matrix(Renderer::get().getProjectionMatrix()) {}
         ~MatrixStack() { Renderer::get().setProjectionMatrix(matrix); }
@@ -124,8 +120,8 @@ void Font::LaidTextRenderer::render(int x, int y, const Colour4f &colour) {
 
 Font::Font(const std::string &fileName, int pointSize) :
     _ttfFont(),
-    _renderedCache(),
-    _sizedCache() {
+    _renderedCache(egoboo_config_t::get().graphic_fontCache_capacity.getValue()),
+    _sizedCache(egoboo_config_t::get().graphic_fontCache_capacity.getValue()) {
     _ttfFont = TTF_OpenFontRW(vfs_openRWopsRead(fileName), 1, pointSize);
 
     if (_ttfFont == nullptr) {
@@ -144,56 +140,15 @@ Font::~Font() {
 }
 
 void Font::getTextSize(const std::string &text, int *width, int *height) {
-    bool updateCache = true;
-    std::shared_ptr<SizedTextCache> cache = findInSizedCache(text, 0, &updateCache);
-
-    if (updateCache) {
-        int ourWidth = 0;
-        int ourHeight = 0;
-
-        LayoutOptions options;
-        options.textWidth = &ourWidth;
-        options.textHeight = &ourHeight;
-        options.interpretNewlines = false;
-
-        layout(text, options);
-
-        cache->text = text;
-        cache->width = ourWidth;
-        cache->height = ourHeight;
-        cache->spacing = 0;
-    }
-
-    if (width) *width = cache->width;
-    if (height) *height = cache->height;
-
-    cache->lastUseInTicks = Core::System::get().getSystemService().getTicks();
+    auto size = findInSizedCache(text, 0, false);
+    if (width) *width = size.width;
+    if (height) *height = size.height;
 }
 
 void Font::getTextBoxSize(const std::string &text, int spacing, int *width, int *height) {
-    bool updateCache = true;
-    auto cache = findInSizedCache(text, spacing, &updateCache);
-
-    if (updateCache) {
-        int ourWidth = 0;
-        int ourHeight = 0;
-
-        LayoutOptions options;
-        options.textWidth = &ourWidth;
-        options.textHeight = &ourHeight;
-
-        layout(text, options);
-
-        cache->text = text;
-        cache->width = ourWidth;
-        cache->height = ourHeight;
-        cache->spacing = spacing;
-    }
-
-    if (width) *width = cache->width;
-    if (height) *height = cache->height;
-
-    cache->lastUseInTicks = Core::System::get().getSystemService().getTicks();
+    auto size = findInSizedCache(text, spacing, true);
+    if (width) *width = size.width;
+    if (height) *height = size.height;
 }
 
 void Font::drawTextToTexture(Texture *tex, const std::string &text, const Colour3f &colour) {
@@ -224,40 +179,12 @@ void Font::drawTextBoxToTexture(Texture *tex, const std::string &text, int width
 
 void Font::drawText(const std::string &text, int x, int y, const Colour4f &colour) {
     if (text.empty()) return;
-
-    bool updateCache = true;
-    auto cache = findInRenderedCache(text, 0, 0, 0, &updateCache);
-
-    if (updateCache) {
-        cache->cache = layoutText(text, nullptr, nullptr);
-        cache->text = text;
-        cache->width = 0;
-        cache->height = 0;
-        cache->spacing = 0;
-    }
-
-    cache->cache->render(x, y, colour);
-
-    cache->lastUseInTicks = Core::System::get().getSystemService().getTicks();
+    findInRenderedCache(text, 0, 0, 0, false)->render(x, y, colour);
 }
 
 void Font::drawTextBox(const std::string &text, int x, int y, int width, int height, int spacing, const Colour4f &colour) {
     if (text.empty()) return;
-
-    bool updateCache = true;
-    auto cache = findInRenderedCache(text, width, height, spacing, &updateCache);
-
-    if (updateCache) {
-        cache->cache = layoutTextBox(text, width, height, spacing, nullptr, nullptr);
-        cache->text = text;
-        cache->width = width;
-        cache->height = height;
-        cache->spacing = spacing;
-    }
-
-    cache->cache->render(x, y, colour);
-
-    cache->lastUseInTicks = Core::System::get().getSystemService().getTicks();
+    findInRenderedCache(text, width, height, spacing, true)->render(x, y, colour);
 }
 
 std::shared_ptr<Font::LaidTextRenderer> Font::layoutText(const std::string &text, int *textWidth, int *textHeight) {
@@ -285,6 +212,19 @@ int Font::getLineSpacing() const {
     return TTF_FontLineSkip(_ttfFont);
 }
 
+void Font::setCacheCapacity(size_t capacity) {
+    _renderedCache.setCapacity(capacity);
+    _sizedCache.setCapacity(capacity);
+}
+
+size_t Font::getCacheHits() const {
+    return _renderedCache.getHits() + _sizedCache.getHits();
+}
+
+size_t Font::getCacheMisses() const {
+    return _renderedCache.getMisses() + _sizedCache.getMisses();
+}
+
 int Font::getFontHeight() const {
     return TTF_FontHeight(_ttfFont);
 }
@@ -389,8 +329,13 @@ Font::LaidOutText Font::layout(const std::string &text, const LayoutOptions &opt
     }
 
     if (currentAtlas == nullptr) {
-        _atlases.push_back(createFontAtlas(codepoints));
-        currentAtlas = &(_atlases.at(_atlases.size() - 1));
+        // Add the missing glyphs to the most recent page if they fit, otherwise start a new page.
+        if (!_atlases.empty() && extendFontAtlas(_atlases.back(), codepoints)) {
+            currentAtlas = &(_atlases.back());
+        } else {
+            _atlases.push_back(createFontAtlas(codepoints));
+            currentAtlas = &(_atlases.at(_atlases.size() - 1));
+        }
     }
 
     LaidOutText laidText(*currentAtlas);
@@ -443,20 +388,12 @@ Font::LaidOutText Font::layout(const std::string &text, const LayoutOptions &opt
 }
 
 std::shared_ptr<Font::LaidTextRenderer> Font::layoutToBuffer(const std::string &text, const LayoutOptions &options) {
-    struct TextVertex {
-        float x;
-        float y;
-        float z;
-        float u;
-        float v;
-    };
-
     LaidOutText laidText = layout(text, options);
 
     const auto &vertexDesc = VertexFormatFactory::get(idlib::vertex_format::P3FT2F);
     auto buffer = idlib::video_buffer_manager::get().create_vertex_buffer(4 * laidText.codepoints.size(), vertexDesc.get_size());
 
-    TextVertex *vertices = reinterpret_cast<TextVertex *>(buffer->lock());
+    std::vector<TextBatch::GlyphVertex> vertices(4 * laidText.codepoints.size());
     float texWidth = laidText.atlas.texture->getWidth();
     float texHeight = laidText.atlas.texture->getHeight();
 
@@ -499,8 +436,11 @@ std::shared_ptr<Font::LaidTextRenderer> Font::layoutToBuffer(const std::string &
         vertices[i * 4 + 3].u = uMin;
         vertices[i * 4 + 3].v = vMax;
     }
-    buffer->unlock();
-    return std::shared_ptr<LaidTextRenderer>(new LaidTextRenderer(laidText.atlas.texture, vertexDesc, buffer));
+    {
+        idlib::vertex_buffer_scoped_lock lock(*buffer);
+        std::memcpy(lock.get<TextBatch::GlyphVertex>(), vertices.data(), vertices.size() * sizeof(TextBatch::GlyphVertex));
+    }
+    return std::shared_ptr<LaidTextRenderer>(new LaidTextRenderer(laidText.atlas.texture, vertexDesc, buffer, std::move(vertices)));
 }
 
 std::shared_ptr<SDL_Surface> Font::layoutToTexture(const std::string &text, const LayoutOptions &options,
@@ -524,7 +464,7 @@ std::shared_ptr<SDL_Surface> Font::layoutToTexture(const std::string &text, cons
     idlib::fill(surf.get(), Colour4b(colorByte, 0));
     SDL::setBlendMode(surf.get(), SDL::BlendMode::NoBlending);
 
-    auto atlasSurf = laidText.atlas.texture->m_source;
+    auto atlasSurf = laidText.atlas.surface;
     auto oldMod = SDL::getColourMod(atlasSurf.get());
     SDL::setColourMod(atlasSurf.get(), colorByte);
 
@@ -553,163 +493,128 @@ Font::FontAtlas Font::createFontAtlas(const std::vector<std::string> &chars) con
 
 Font::FontAtlas Font::createFontAtlas(const std::vector<uint16_t> &codepoints) const
 {
-    static const auto WHITE = Colour4b::white();
-    std::vector<std::shared_ptr<SDL_Surface>> images;
-    std::vector<Rectangle2f> pos;
-
-    for (uint16_t cp : codepoints)
-    {
-        auto surf = SDL::render_glyph(_ttfFont, cp, WHITE);
-        images.push_back(surf);
-    }
-
-    int currentMaxSize = 128;
     int maxTextureSize = Renderer::get().getInfo()->getMaximumTextureSize();
-    std::shared_ptr<SDL_Surface> atlas = nullptr;
+    int currentMaxSize = std::min(MINIMUM_ATLAS_PAGE_SIZE, maxTextureSize);
 
     auto pfd = pixel_descriptor::get<idlib::pixel_format::R8G8B8A8>();
 
+    FontAtlas retval;
+    retval.texture = Renderer::get().createTexture();
     while (currentMaxSize <= maxTextureSize) {
-        atlas = ImageManager::get().createImage(currentMaxSize, currentMaxSize, pfd);
-        idlib::fill(atlas.get(), Colour4b(Colour3b::white(), 0));
-        SDL::setBlendMode(atlas.get(), SDL::BlendMode::NoBlending);
-
-        int x = 0, y = 0;
-        int currentHeight = 0;
-        bool fits = true;
-
-        for (const auto& surf : images) {
-            if (surf == nullptr) {
-                pos.push_back(Rectangle2f());
-                continue;
-            }
-
-            if (currentMaxSize < surf->w || currentMaxSize < surf->h)
-            {
-                fits = false;
-                break;
-            }
-
-            if (currentMaxSize - x < surf->w)
-            {
-                y += currentHeight + 1;
-                x = 0;
-                currentHeight = 0;
-            }
+        retval.surface = ImageManager::get().createImage(currentMaxSize, currentMaxSize, pfd);
+        idlib::fill(retval.surface.get(), Colour4b(Colour3b::white(), 0));
+        SDL::setBlendMode(retval.surface.get(), SDL::BlendMode::NoBlending);
 
-            if (currentHeight < surf->h)
-                currentHeight = surf->h;
-
-            if (currentMaxSize - y < currentHeight) {
-                fits = false;
-                break;
-            }
-
-            auto dst = Rectangle2f(Point2f(x, y), Point2f(x + surf->w, y + surf->h));
-            idlib::blit(surf.get(), atlas.get(), Point2f(x, y));
-            pos.push_back(dst);
-            x += surf->w + 1;
-        }
-
-        if (fits)
-            break;
+        if (extendFontAtlas(retval, codepoints))
+            return retval;
 
         Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "unable to fit atlas into a texture of size ", currentMaxSize, ", trying texture of size ", currentMaxSize * 2, " instead", Log::EndOfEntry);
         currentMaxSize <<= 1;
-        pos.clear();
-        atlas = nullptr;
     }
 
-    if (!atlas) {
-        Log::get() << Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "unable to fit a atlas into a texture of size ", maxTextureSize, Log::EndOfEntry);
-        SDL_assert(atlas);
-    }
+    auto e = Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "unable to fit a atlas into a texture of size ", maxTextureSize, Log::EndOfEntry);
+    Log::get() << e;
+    throw idlib::runtime_error(__FILE__, __LINE__, e.getText());
+}
 
-    FontAtlas retval;
-    for (int i = 0; i < images.size(); i++) {
-        if (images[i] == nullptr)
+bool Font::extendFontAtlas(FontAtlas &atlas, const std::vector<uint16_t> &codepoints) const
+{
+    static const auto WHITE = Colour4b::white();
+    std::vector<uint16_t> missing;
+    std::vector<std::shared_ptr<SDL_Surface>> images;
+
+    for (uint16_t cp : codepoints)
+    {
+        if (cp == '\n' || atlas.glyphs.find(cp) != atlas.glyphs.end() ||
+            std::find(missing.begin(), missing.end(), cp) != missing.end())
             continue;
-        retval.glyphs.insert(std::make_pair(codepoints[i], pos[i]));
+        missing.push_back(cp);
+        images.push_back(SDL::render_glyph(_ttfFont, cp, WHITE));
     }
 
-    retval.texture = Renderer::get().createTexture();
-    retval.texture->load("font atlas", atlas);
-    retval.texture->setAddressModeS(idlib::texture_address_mode::clamp);
-    retval.texture->setAddressModeT(idlib::texture_address_mode::clamp);
-    return retval;
-}
+    if (missing.empty())
+        return true;
 
-std::shared_ptr<Font::RenderedTextCache> Font::findInRenderedCache(const std::string &text, int width, int height,
-                                                                   int spacing, bool *update) {
-    if (MAX_CACHE_SIZE == 0) {
-        *update = true;
-        return std::make_shared<RenderedTextCache>();
-    }
+    // Place the glyphs row by row, continuing after the glyphs already on the page.
+    const int size = atlas.surface->w;
+    int x = atlas.x, y = atlas.y;
+    int currentHeight = atlas.rowHeight;
+    std::vector<Rectangle2f> pos;
 
-    if (MAX_CACHE_SIZE == 1) {
-        *update = true;
-        if (_renderedCache.empty())
-            _renderedCache.emplace_back(std::make_shared<RenderedTextCache>());
-        return _renderedCache[0];
-    }
+    for (const auto& surf : images) {
+        if (surf == nullptr) {
+            pos.push_back(Rectangle2f());
+            continue;
+        }
 
-    std::shared_ptr<Font::RenderedTextCache> cache;
-    bool updateCache = true;
+        if (size < surf->w || size < surf->h)
+            return false;
 
-    auto cacheIterator = std::find_if(_renderedCache.begin(), _renderedCache.end(),
-                                      [&](const std::shared_ptr<Font::RenderedTextCache> &ptr) {
-        return ptr->isEquivalent(text, width, height, spacing);
-    });
+        if (size - x < surf->w)
+        {
+            y += currentHeight + 1;
+            x = 0;
+            currentHeight = 0;
+        }
 
-    if (cacheIterator != _renderedCache.end()) {
-        cache = *cacheIterator;
-        updateCache = false;
-    } else if (_renderedCache.size() < MAX_CACHE_SIZE) {
-        cache = std::make_shared<RenderedTextCache>();
-        _renderedCache.push_back(cache);
-    } else {
-        std::sort(_renderedCache.begin(), _renderedCache.end(), RenderedTextCache::isLessThan);
-        cache = _renderedCache.at(0);
-    }
+        if (currentHeight < surf->h)
+            currentHeight = surf->h;
 
-    if (update) *update = updateCache;
-    return cache;
-}
+        if (size - y < currentHeight)
+            return false;
 
-std::shared_ptr<Font::SizedTextCache> Font::findInSizedCache(const std::string &text, int spacing, bool *update) {
-    if (MAX_CACHE_SIZE == 0) {
-        *update = true;
-        return std::make_shared<SizedTextCache>();
+        pos.push_back(Rectangle2f(Point2f(x, y), Point2f(x + surf->w, y + surf->h)));
+        x += surf->w + 1;
     }
 
-    if (MAX_CACHE_SIZE == 1) {
-        *update = true;
-        if (_sizedCache.empty())
-            _sizedCache.emplace_back(std::make_shared<SizedTextCache>());
-        return _sizedCache[0];
+    // All glyphs fit, commit them.
+    for (size_t i = 0; i < images.size(); i++) {
+        if (images[i] != nullptr)
+            idlib::blit(images[i].get(), atlas.surface.get(), pos[i].get_min());
+        atlas.glyphs.insert(std::make_pair(missing[i], pos[i]));
     }
+    atlas.x = x;
+    atlas.y = y;
+    atlas.rowHeight = currentHeight;
+
+    atlas.texture->load("font atlas", atlas.surface);
+    atlas.texture->setAddressModeS(idlib::texture_address_mode::clamp);
+    atlas.texture->setAddressModeT(idlib::texture_address_mode::clamp);
+    return true;
+}
 
-    std::shared_ptr<Font::SizedTextCache> cache;
-    bool updateCache = true;
+std::shared_ptr<Font::LaidTextRenderer> Font::findInRenderedCache(const std::string &text, int width, int height,
+                                                                  int spacing, bool interpretNewlines) {
+    TextCacheKey key{text, width, height, spacing, interpretNewlines};
+    if (auto cached = _renderedCache.find(key)) {
+        return *cached;
+    }
 
-    auto cacheIterator = std::find_if(_sizedCache.begin(), _sizedCache.end(),
-                                      [&](const std::shared_ptr<Font::SizedTextCache> &ptr) {
-        return ptr->isEquivalent(text, spacing);
-    });
+    LayoutOptions options;
+    options.maxWidth = width;
+    options.maxHeight = height;
+    options.spacing = spacing;
+    options.interpretNewlines = interpretNewlines;
+    auto laidText = layoutToBuffer(text, options);
+    _renderedCache.insert(key, laidText);
+    return laidText;
+}
 
-    if (cacheIterator != _sizedCache.end()) {
-        cache = *cacheIterator;
-        updateCache = false;
-    } else if (_sizedCache.size() < MAX_CACHE_SIZE) {
-        cache = std::make_shared<SizedTextCache>();
-        _sizedCache.push_back(cache);
-    } else {
-        std::sort(_sizedCache.begin(), _sizedCache.end(), SizedTextCache::isLessThan);
-        cache = _sizedCache.at(0);
+Font::TextSize Font::findInSizedCache(const std::string &text, int spacing, bool interpretNewlines) {
+    TextCacheKey key{text, 0, 0, spacing, interpretNewlines};
+    if (auto cached = _sizedCache.find(key)) {
+        return *cached;
     }
 
-    if (update) *update = updateCache;
-    return cache;
+    TextSize size{0, 0};
+    LayoutOptions options;
+    options.textWidth = &size.width;
+    options.textHeight = &size.height;
+    // The spacing only distinguishes cache entries, sizes are computed with the default line spacing.
+    options.interpretNewlines = interpretNewlines;
+    layout(text, options);
+    _sizedCache.insert(key, size);
+    return size;
 }
 
 uint16_t Font::convertUTF8ToCodepoint(const std::string &string, size_t *pos) {
@@ -27,6 +27,8 @@
 #include "egolib/integrations/color.hpp"
 #include "egolib/integrations/video.hpp"
 #include "egolib/Math/_Include.hpp"
+#include "egolib/Core/LruCache.hpp"
+#include "egolib/Graphics/TextBatch.hpp"
 #include <memory>
 
 namespace Ego {
@@ -56,25 +58,25 @@ public:
          *  The position on screen to render the text at
          * @param colour
          *  The colour of the rendered text; default is white
+         * @remark
+         *  If a text batch is active, the text is appended to that batch instead.
          */
         void render(int x, int y, const Colour4f &colour = Colour4f::white());
 
     protected:
         LaidTextRenderer(const std::shared_ptr<Texture> &atlas, 
                          const idlib::vertex_descriptor& vertexDescriptor,
-                         const std::shared_ptr<idlib::vertex_buffer> &vertexBuffer);
+                         const std::shared_ptr<idlib::vertex_buffer> &vertexBuffer,
+                         std::vector<TextBatch::GlyphVertex> vertices);
         friend class Font;
     private:
         std::shared_ptr<Texture> _atlas;
         idlib::vertex_descriptor _vertexDescriptor;
         std::shared_ptr<idlib::vertex_buffer> _vertexBuffer;
+        /// A copy of the vertices for appending them to a text batch.
+        std::vector<TextBatch::GlyphVertex> _vertices;
     };
 
-private:
-    /// This is the maximum size for the two caches as used by
-    /// drawText and getTextSize, set this to 0 for no caching
-    constexpr static size_t MAX_CACHE_SIZE = 20;
-
 protected:
     Font(const std::string &fileName, int pointSize);
     friend class FontManager;
@@ -224,11 +226,54 @@ public:
     **/
     int getFontHeight() const;
 
+    /**
+     * @brief
+     *  Set the maximum number of entries of the caches used by drawText, drawTextBox,
+     *  getTextSize and getTextBoxSize.
+     * @param capacity
+     *  the maximum number of entries of each cache, @a 0 disables caching
+     * @remark
+     *  The initial capacity is given by the configuration variable @a graphic.fontCache.capacity.
+     */
+    void setCacheCapacity(size_t capacity);
+
+    /**
+     * @brief
+     *  Get the number of lookups which were served from the caches of this font.
+     */
+    size_t getCacheHits() const;
+
+    /**
+     * @brief
+     *  Get the number of lookups which were not served from the caches of this font.
+     */
+    size_t getCacheMisses() const;
+
 private:
-    /// Struct for cached text that has been rendered
-    struct RenderedTextCache;
-    /// Struct for cached text that has been sized
-    struct SizedTextCache;
+    /// The key of an entry in the rendered text cache or in the sized text cache.
+    struct TextCacheKey {
+        std::string text;
+        int width;
+        int height;
+        int spacing;
+        /// @a true if newlines are interpreted, @a false otherwise.
+        bool interpretNewlines;
+
+        bool operator==(const TextCacheKey &other) const {
+            return width == other.width && height == other.height && spacing == other.spacing
+                && interpretNewlines == other.interpretNewlines && text == other.text;
+        }
+
+        struct Hash {
+            size_t operator()(const TextCacheKey &key) const;
+        };
+    };
+
+    /// The value of an entry in the sized text cache.
+    struct TextSize {
+        int width;
+        int height;
+    };
 
     struct FontAtlas;
 
@@ -239,28 +284,26 @@ private:
 
     /**
      * @brief
-     *  Find given values in the rendered text cache
-     * @param text,width,height,spacing
+     *  Find laid out text in the rendered text cache, laying it out and adding it on a miss.
+     * @param text,width,height,spacing,interpretNewlines
      *  The values to look for in the cache
-     * @param update[out]
-     *  Is set to @c true when the returned cached struct needs to be updated with the given values, @c false otherwise
      * @return
-     *  A cached struct that may need to be updated per @a update
+     *  The laid out text
      */
-    std::shared_ptr<RenderedTextCache> findInRenderedCache(const std::string &text, int width, int height,
-                                                           int spacing, bool *update);
+    std::shared_ptr<LaidTextRenderer> findInRenderedCache(const std::string &text, int width, int height,
+                                                          int spacing, bool interpretNewlines);
 
     /**
      * @brief
-     *  Find given values in the sized text cache
-     * @param text,spacing
+     *  Find the size of text in the sized text cache, computing it and adding it on a miss.
+     * @param text,spacing,interpretNewlines
      *  The values to look for in the cache
-     * @param update[out]
-     *  Is @c true when the returned cached struct needs to be updated with the given values, @c false otherwise
      * @return
-     *  A cached struct that may need to be updated per @a update
+     *  The size of the text
+     * @remark
+     *  The size is computed with the default line spacing regardless of @a spacing.
      */
-    std::shared_ptr<SizedTextCache> findInSizedCache(const std::string &text, int spacing, bool *update);
+    TextSize findInSizedCache(const std::string &text, int spacing, bool interpretNewlines);
 
     /**
      * @brief
@@ -319,14 +362,31 @@ private:
 
     /**
      * @brief
-     *  Creates a texture altas from the given codepoints.
+     *  Creates a texture altas page from the given codepoints.
      * @param chars
      *  The list of characters to add to the atlas
      * @return
      *  The created texture atlas
+     * @remark
+     *  The page leaves room such that glyphs can be added later on (see extendFontAtlas).
      */
     FontAtlas createFontAtlas(const std::vector<uint16_t> &codepoints) const;
 
+    /**
+     * @brief
+     *  Adds the glyphs of the given codepoints which are missing from a texture atlas page to that page.
+     * @param atlas
+     *  The texture atlas page
+     * @param codepoints
+     *  The list of codepoints
+     * @return
+     *  @c true if the missing glyphs were added, @c false if they do not fit. In the latter case, the page is not modified.
+     * @remark
+     *  The glyphs already on the page keep their positions and the page keeps its texture,
+     *  hence text laid out before remains valid.
+     */
+    bool extendFontAtlas(FontAtlas &atlas, const std::vector<uint16_t> &codepoints) const;
+
     /**
      * @brief
      *  Creates a texture atlas from the given UTF-8 characters.
@@ -384,8 +444,10 @@ private:
 
     TTF_Font *_ttfFont;
 
-    std::vector<std::shared_ptr<RenderedTextCache>> _renderedCache;
-    std::vector<std::shared_ptr<SizedTextCache>> _sizedCache;
+    /// Cache of laid out text as used by drawText and drawTextBox.
+    LruCache<TextCacheKey, std::shared_ptr<LaidTextRenderer>, TextCacheKey::Hash> _renderedCache;
+    /// Cache of text sizes as used by getTextSize and getTextBoxSize.
+    LruCache<TextCacheKey, TextSize, TextCacheKey::Hash> _sizedCache;
     std::vector<FontAtlas> _atlases;
 };
 
@@ -3,6 +3,8 @@
 #include "egolib/Graphics/SDL/Display.hpp"
 #include "egolib/Graphics/SDL/GraphicsWindow.hpp"
 #include "egolib/Graphics/SDL/GraphicsContext.hpp"
+#include "egolib/Renderer/Null/GraphicsContext.hpp"
+#include "egolib/egoboo_setup.h"
 
 namespace Ego {
 namespace SDL {
@@ -61,6 +63,11 @@ Ego::GraphicsContext *GraphicsSystemNew::createContext(Ego::GraphicsWindow *wind
 {
     try
     {
+        // The null renderer does not require an OpenGL context.
+        if (egoboo_config_t::get().debug_nullRenderer_enable.getValue())
+        {
+            return new Ego::Null::GraphicsContext(window);
+        }
         return new GraphicsContext(static_cast<GraphicsWindow *>(window));
     }
     catch (...)
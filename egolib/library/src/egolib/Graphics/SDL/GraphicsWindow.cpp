@@ -90,7 +90,8 @@ GraphicsWindow::GraphicsWindow()
     SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 1);
 #endif
     // (2) Upload window properties.
-    uint32_t windowFlags = SDL_WINDOW_OPENGL;
+    // The null renderer does not require an OpenGL window.
+    uint32_t windowFlags = config.debug_nullRenderer_enable.getValue() ? 0 : SDL_WINDOW_OPENGL;
     if (config.graphic_fullscreen.getValue())
     {
         windowFlags |= SDL_WINDOW_FULLSCREEN;
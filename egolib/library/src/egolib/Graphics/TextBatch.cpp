@@ -0,0 +1,121 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Graphics/TextBatch.cpp
+/// @brief Batching of laid out text into one draw per glyph atlas page.
+
+#include "egolib/Graphics/TextBatch.hpp"
+#include "egolib/Graphics/VertexFormat.hpp"
+#include "egolib/Renderer/Renderer.hpp"
+
+namespace Ego {
+
+namespace {
+/// @brief The active text batch.
+TextBatch *g_activeTextBatch = nullptr;
+} // namespace
+
+TextBatch::TextBatch() :
+    _pages(),
+    _vertexDescriptor(VertexFormatFactory::get(idlib::vertex_format::P3FC4FT2F)),
+    _vertexBuffer() {
+}
+
+TextBatch::~TextBatch() {
+    if (g_activeTextBatch == this) {
+        g_activeTextBatch = nullptr;
+    }
+}
+
+void TextBatch::add(const std::shared_ptr<Texture>& atlas, const GlyphVertex *vertices, size_t numberOfVertices,
+                    float x, float y, const Colour4f& colour) {
+    if (!atlas) {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "atlas");
+    }
+    if (0 == numberOfVertices) {
+        return;
+    }
+    auto it = std::find_if(_pages.begin(), _pages.end(), [&atlas](const Page& page) { return page.texture == atlas; });
+    if (it == _pages.end()) {
+        _pages.push_back(Page{atlas, {}});
+        it = _pages.end() - 1;
+    }
+    auto& target = it->vertices;
+    target.reserve(target.size() + numberOfVertices);
+    for (size_t i = 0; i < numberOfVertices; ++i) {
+        const auto& source = vertices[i];
+        target.push_back(Vertex{source.x + x, source.y + y, source.z,
+                                colour.get_r(), colour.get_g(), colour.get_b(), colour.get_a(),
+                                source.u, source.v});
+    }
+}
+
+void TextBatch::flush() {
+    if (_pages.empty()) {
+        return;
+    }
+    auto& renderer = Renderer::get();
+    renderer.setBlendingEnabled(true);
+    for (auto& page : _pages) {
+        if (page.vertices.empty()) {
+            continue;
+        }
+        // Grow the vertex buffer to at least twice the required size to amortize reallocations.
+        if (!_vertexBuffer || _vertexBuffer->number_of_vertices() < page.vertices.size()) {
+            _vertexBuffer = idlib::video_buffer_manager::get().create_vertex_buffer(2 * page.vertices.size(), _vertexDescriptor.get_size());
+        }
+        {
+            idlib::vertex_buffer_scoped_lock lock(*_vertexBuffer);
+            std::memcpy(lock.get<Vertex>(), page.vertices.data(), page.vertices.size() * sizeof(Vertex));
+        }
+        renderer.getTextureUnit().setActivated(page.texture.get());
+        renderer.render(*_vertexBuffer, _vertexDescriptor, idlib::primitive_type::quadriliterals, 0, page.vertices.size());
+    }
+    // Drop the pages which were not used since the last flush, keep the vertex storage of the others.
+    _pages.erase(std::remove_if(_pages.begin(), _pages.end(), [](const Page& page) { return page.vertices.empty(); }),
+                 _pages.end());
+    for (auto& page : _pages) {
+        page.vertices.clear();
+    }
+}
+
+bool TextBatch::isEmpty() const {
+    for (const auto& page : _pages) {
+        if (!page.vertices.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TextBatch *TextBatch::getActive() {
+    return g_activeTextBatch;
+}
+
+void TextBatch::setActive(TextBatch *textBatch) {
+    g_activeTextBatch = textBatch;
+}
+
+void TextBatch::flushActive() {
+    if (g_activeTextBatch) {
+        g_activeTextBatch->flush();
+    }
+}
+
+} // namespace Ego
@@ -0,0 +1,116 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Graphics/TextBatch.hpp
+/// @brief Batching of laid out text into one draw per glyph atlas page.
+
+#pragma once
+
+#include "egolib/typedef.h"
+#include "egolib/integrations/color.hpp"
+#include "egolib/integrations/video.hpp"
+
+namespace Ego {
+class Texture;
+} // namespace Ego
+
+namespace Ego {
+
+/**
+ * @brief
+ *  Collects the glyph quads of laid out text and renders them with one draw call per glyph atlas page.
+ * @remark
+ *  While a text batch is active (see Ego::TextBatch::setActive), Ego::Font::LaidTextRenderer::render
+ *  appends to the batch instead of drawing immediately. The batch must be flushed before anything
+ *  else is drawn which may overlap the text. The text is drawn with the projection matrix in effect
+ *  at the time of the flush.
+ */
+class TextBatch final : private idlib::non_copyable {
+public:
+    /// @brief A vertex of laid out text (in the format idlib::vertex_format::P3FT2F).
+    struct GlyphVertex {
+        float x, y, z;
+        float u, v;
+    };
+
+    /// @brief Construct this text batch.
+    TextBatch();
+
+    /// @brief Destruct this text batch.
+    ~TextBatch();
+
+    /**
+     * @brief
+     *  Append laid out text to this batch.
+     * @param atlas
+     *  the glyph atlas page the vertices refer to
+     * @param vertices, numberOfVertices
+     *  the vertices of the glyph quads
+     * @param x, y
+     *  the position on screen to render the text at
+     * @param colour
+     *  the colour of the text
+     */
+    void add(const std::shared_ptr<Texture>& atlas, const GlyphVertex *vertices, size_t numberOfVertices,
+             float x, float y, const Colour4f& colour);
+
+    /// @brief Render and remove all text of this batch.
+    void flush();
+
+    /// @brief Get if this batch is empty.
+    bool isEmpty() const;
+
+public:
+    /// @brief Get the active text batch.
+    /// @return a pointer to the active text batch if any, a null pointer otherwise
+    static TextBatch *getActive();
+
+    /// @brief Set the active text batch.
+    /// @param textBatch a pointer to the text batch or a null pointer
+    static void setActive(TextBatch *textBatch);
+
+    /// @brief Flush the active text batch (if any).
+    /// @remark Invoke before drawing anything which may overlap text drawn before.
+    static void flushActive();
+
+private:
+    /// @brief A vertex in the format idlib::vertex_format::P3FC4FT2F.
+    struct Vertex {
+        float x, y, z;
+        float r, g, b, a;
+        float u, v;
+    };
+
+    /// @brief The vertices of the glyphs on a single glyph atlas page.
+    struct Page {
+        std::shared_ptr<Texture> texture;
+        std::vector<Vertex> vertices;
+    };
+
+    /// @brief The pages with pending vertices.
+    std::vector<Page> _pages;
+
+    /// @brief The vertex descriptor.
+    const idlib::vertex_descriptor& _vertexDescriptor;
+
+    /// @brief The vertex buffer. Grown on demand.
+    std::shared_ptr<idlib::vertex_buffer> _vertexBuffer;
+};
+
+} // namespace Ego
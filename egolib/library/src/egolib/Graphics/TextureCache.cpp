@@ -0,0 +1,281 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Graphics/TextureCache.cpp
+/// @brief An on-disk cache of GPU-ready texture pixels.
+
+#include "egolib/Graphics/TextureCache.hpp"
+#include "egolib/Core/CacheFile.hpp"
+#include "egolib/egoboo_setup.h"
+#include "egolib/vfs.h"
+#include <algorithm>
+
+namespace Ego {
+
+namespace {
+
+/// @brief The magic number of a texture cache file ("EGTC").
+constexpr uint32_t CACHE_MAGIC = 0x43544745;
+
+/// @brief The version of the texture cache file format.
+/// Increment whenever the file format or the pixel preparation changes.
+constexpr uint32_t CACHE_VERSION = 2;
+
+/// @brief The VFS pathname of the directory of the texture cache files.
+const std::string CACHE_DIRECTORY = "/cache/textures";
+
+/// @brief A texture cache file.
+struct CacheEntry {
+    /// @brief The VFS pathname of the cache file.
+    std::string pathname;
+    /// @brief The length, in Bytes, of the cache file.
+    int64_t length;
+    /// @brief The modification time of the cache file.
+    int64_t modificationTime;
+};
+
+/// @brief Enumerate the texture cache files.
+std::vector<CacheEntry> enumerateCacheEntries() {
+    std::vector<CacheEntry> entries;
+    if (!vfs_isDirectory(CACHE_DIRECTORY)) {
+        return entries;
+    }
+    SearchContext context(Ego::VfsPath(CACHE_DIRECTORY), Ego::Extension("tex"), VFS_SEARCH_FILE | VFS_SEARCH_BARE);
+    for (; context.hasData(); context.nextData()) {
+        CacheEntry entry;
+        entry.pathname = CACHE_DIRECTORY + "/" + context.getData().string();
+        entry.length = vfs_getFileLength(entry.pathname);
+        entry.modificationTime = vfs_getLastModTime(entry.pathname);
+        if (-1 != entry.length) {
+            entries.push_back(entry);
+        }
+    }
+    return entries;
+}
+
+using CacheFile::hash;
+using CacheFile::write;
+using CacheFile::Reader;
+
+} // namespace
+
+TextureCache::TextureCache() :
+    _hits(0), _misses(0), _size(-1) {
+}
+
+TextureCache::~TextureCache() {
+}
+
+bool TextureCache::isEnabled() const {
+    return egoboo_config_t::get().graphic_textureCache_enable.getValue();
+}
+
+size_t TextureCache::getHits() const {
+    return _hits;
+}
+
+size_t TextureCache::getMisses() const {
+    return _misses;
+}
+
+bool TextureCache::getStamp(const std::string& pathname, Stamp& stamp) {
+    auto resolved = vfs_resolveReadFilename(pathname);
+    if (!resolved.first) {
+        return false;
+    }
+    stamp.resolvedPathname = resolved.second;
+    stamp.length = vfs_getFileLength(pathname);
+    stamp.modificationTime = vfs_getLastModTime(pathname);
+    return -1 != stamp.length && -1 != stamp.modificationTime;
+}
+
+bool TextureCache::getSourceHash(const std::string& pathname, uint64_t& value) {
+    char *data = nullptr;
+    size_t length = 0;
+    if (!vfs_readEntireFile(pathname, &data, &length)) {
+        return false;
+    }
+    std::unique_ptr<char, decltype(&std::free)> guard(data, &std::free);
+    value = hash(data, length);
+    return true;
+}
+
+std::string TextureCache::getCachePathname(const std::string& key) {
+    std::ostringstream os;
+    os << CACHE_DIRECTORY << "/" << std::hex << std::setw(16) << std::setfill('0') << hash(key) << ".tex";
+    return os.str();
+}
+
+std::shared_ptr<TexturePixels> TextureCache::load(const std::string& pathname, const std::string& variant) {
+    if (!isEnabled()) {
+        return nullptr;
+    }
+    Stamp stamp;
+    if (!getStamp(pathname, stamp)) {
+        return nullptr;
+    }
+    const std::string key = stamp.resolvedPathname + "#" + variant;
+    const std::string cachePathname = getCachePathname(key);
+    if (!vfs_exists(cachePathname)) {
+        _misses++;
+        return nullptr;
+    }
+    char *data = nullptr;
+    size_t length = 0;
+    if (!vfs_readEntireFile(cachePathname, &data, &length)) {
+        _misses++;
+        return nullptr;
+    }
+    std::unique_ptr<char, decltype(&std::free)> guard(data, &std::free);
+    Reader reader{data, data + length};
+
+    // Validate the header.
+    uint32_t magic, version;
+    std::string storedKey;
+    int64_t storedLength, storedModificationTime;
+    uint64_t storedSourceHash;
+    if (!reader.read(magic) || CACHE_MAGIC != magic ||
+        !reader.read(version) || CACHE_VERSION != version ||
+        !reader.read(storedKey) || key != storedKey ||
+        !reader.read(storedLength) || stamp.length != storedLength ||
+        !reader.read(storedModificationTime) ||
+        !reader.read(storedSourceHash)) {
+        _misses++;
+        return nullptr;
+    }
+    // A modified source image file (e.g. a module which was copied or re-extracted) is still
+    // valid if its contents are unchanged.
+    if (stamp.modificationTime != storedModificationTime) {
+        uint64_t sourceHash;
+        if (!getSourceHash(pathname, sourceHash) || storedSourceHash != sourceHash) {
+            _misses++;
+            return nullptr;
+        }
+    }
+
+    // Read the pixels.
+    auto pixels = std::make_shared<TexturePixels>();
+    uint8_t hasAlpha;
+    int32_t sourceWidth, sourceHeight;
+    uint32_t numberOfLevels;
+    if (!reader.read(hasAlpha) || !reader.read(sourceWidth) || !reader.read(sourceHeight) ||
+        !reader.read(numberOfLevels) || 0 == numberOfLevels) {
+        _misses++;
+        return nullptr;
+    }
+    pixels->hasAlpha = (0 != hasAlpha);
+    pixels->sourceWidth = sourceWidth;
+    pixels->sourceHeight = sourceHeight;
+    const size_t bytesPerPixel = pixels->getBytesPerPixel();
+    pixels->levels.resize(numberOfLevels);
+    for (auto& level : pixels->levels) {
+        int32_t width, height;
+        if (!reader.read(width) || !reader.read(height) || width <= 0 || height <= 0 ||
+            !reader.read(level.pixels, width * height * bytesPerPixel)) {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "corrupted texture cache file ", "`", cachePathname, "`", Log::EndOfEntry);
+            _misses++;
+            return nullptr;
+        }
+        level.width = width;
+        level.height = height;
+    }
+    _hits++;
+    return pixels;
+}
+
+void TextureCache::store(const std::string& pathname, const std::string& variant, const TexturePixels& pixels) {
+    if (!isEnabled() || pixels.levels.empty()) {
+        return;
+    }
+    Stamp stamp;
+    uint64_t sourceHash;
+    if (!getStamp(pathname, stamp) || !getSourceHash(pathname, sourceHash)) {
+        return;
+    }
+    const std::string key = stamp.resolvedPathname + "#" + variant;
+
+    size_t size = 0;
+    for (const auto& level : pixels.levels) {
+        size += level.pixels.size() + 2 * sizeof(int32_t);
+    }
+    std::vector<char> buffer;
+    buffer.reserve(size + key.size() + 64);
+
+    // Write the header.
+    write(buffer, CACHE_MAGIC);
+    write(buffer, CACHE_VERSION);
+    write(buffer, key);
+    write(buffer, stamp.length);
+    write(buffer, stamp.modificationTime);
+    write(buffer, sourceHash);
+
+    // Write the pixels.
+    write(buffer, static_cast<uint8_t>(pixels.hasAlpha ? 1 : 0));
+    write(buffer, static_cast<int32_t>(pixels.sourceWidth));
+    write(buffer, static_cast<int32_t>(pixels.sourceHeight));
+    write(buffer, static_cast<uint32_t>(pixels.levels.size()));
+    for (const auto& level : pixels.levels) {
+        write(buffer, static_cast<int32_t>(level.width));
+        write(buffer, static_cast<int32_t>(level.height));
+        buffer.insert(buffer.end(), level.pixels.begin(), level.pixels.end());
+    }
+
+    const std::string cachePathname = getCachePathname(key);
+    if (_size < 0) {
+        _size = 0;
+        for (const auto& entry : enumerateCacheEntries()) {
+            _size += entry.length;
+        }
+    }
+    // An existing cache file of this entry is overwritten.
+    const int64_t oldLength = vfs_exists(cachePathname) ? vfs_getFileLength(cachePathname) : -1;
+    if (!vfs_writeEntireFile(cachePathname, buffer.data(), buffer.size())) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to write texture cache file ", "`", cachePathname, "`", Log::EndOfEntry);
+        // Determine the size again, the old cache file might be truncated.
+        _size = -1;
+        return;
+    }
+    _size += static_cast<int64_t>(buffer.size()) - std::max(oldLength, int64_t(0));
+    evict(cachePathname);
+}
+
+void TextureCache::evict(const std::string& keep) {
+    const int64_t capacity = int64_t(egoboo_config_t::get().graphic_textureCache_capacity.getValue()) * 1024 * 1024;
+    if (_size <= capacity) {
+        return;
+    }
+    auto entries = enumerateCacheEntries();
+    std::sort(entries.begin(), entries.end(), [](const CacheEntry& x, const CacheEntry& y) {
+        return x.modificationTime < y.modificationTime;
+    });
+    _size = 0;
+    for (const auto& entry : entries) {
+        _size += entry.length;
+    }
+    for (const auto& entry : entries) {
+        if (_size <= capacity) {
+            break;
+        }
+        if (entry.pathname != keep && vfs_delete_file(entry.pathname)) {
+            _size -= entry.length;
+        }
+    }
+}
+
+} // namespace Ego
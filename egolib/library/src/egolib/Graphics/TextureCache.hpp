@@ -0,0 +1,143 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Graphics/TextureCache.hpp
+/// @brief An on-disk cache of GPU-ready texture pixels.
+
+#pragma once
+
+#include "egolib/typedef.h"
+#include "egolib/Renderer/TexturePixels.hpp"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  An on-disk cache of GPU-ready texture pixels.
+ * @remark
+ *  An entry is identified by the resolved pathname of its source image file and a variant string
+ *  (e.g. a single tile cut out of a tile set). The entry is stored under <tt>/cache/textures</tt>
+ *  of the user directory in a file named after the hash of its identity. The entry is valid as
+ *  long as the length of the source image file and either its modification time or the hash of
+ *  its contents do not change. The identity is the pathname and not the contents, hence identical
+ *  images in different files are cached twice.
+ * @remark
+ *  The total size of the cache files is bounded by <tt>graphic.textureCache.capacity</tt>.
+ *  If storing an entry exceeds that bound, the least recently written cache files are removed.
+ */
+class TextureCache : public idlib::singleton<TextureCache> {
+protected:
+    friend idlib::default_new_functor<TextureCache>;
+    friend idlib::default_delete_functor<TextureCache>;
+
+    /**
+     * @brief
+     *  Construct this texture cache.
+     * @remark
+     *  Intentionally protected.
+     */
+    TextureCache();
+
+    /**
+     * @brief
+     *  Destruct this texture cache.
+     * @remark
+     *  Intentionally protected.
+     */
+    virtual ~TextureCache();
+
+public:
+    /**
+     * @brief
+     *  Get if this texture cache is enabled.
+     * @return
+     *  @a true if this texture cache is enabled, @a false otherwise
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief
+     *  Load cached texture pixels.
+     * @param pathname
+     *  the VFS pathname of the source image file
+     * @param variant
+     *  the variant
+     * @return
+     *  the texture pixels if a valid entry exists, a null pointer otherwise
+     */
+    std::shared_ptr<TexturePixels> load(const std::string& pathname, const std::string& variant);
+
+    /**
+     * @brief
+     *  Store texture pixels in the cache.
+     * @param pathname
+     *  the VFS pathname of the source image file
+     * @param variant
+     *  the variant
+     * @param pixels
+     *  the texture pixels
+     * @remark
+     *  If the source image file does not exist, the pixels are not stored.
+     */
+    void store(const std::string& pathname, const std::string& variant, const TexturePixels& pixels);
+
+    /// @brief Get the number of lookups which were served from the cache.
+    size_t getHits() const;
+
+    /// @brief Get the number of lookups which were not served from the cache.
+    size_t getMisses() const;
+
+private:
+    /// @brief The stamp of a source image file.
+    struct Stamp {
+        /// @brief The resolved pathname of the source image file.
+        std::string resolvedPathname;
+        /// @brief The length, in Bytes, of the source image file.
+        int64_t length;
+        /// @brief The modification time of the source image file.
+        int64_t modificationTime;
+    };
+
+    /// @brief Get the stamp of a source image file.
+    /// @return @a true if the file exists, @a false otherwise
+    static bool getStamp(const std::string& pathname, Stamp& stamp);
+
+    /// @brief Get the hash of the contents of a source image file.
+    /// @return @a true on success, @a false on failure
+    static bool getSourceHash(const std::string& pathname, uint64_t& value);
+
+    /// @brief Remove the least recently written cache files until the total size of the cache files
+    /// does not exceed the capacity.
+    /// @param keep the VFS pathname of a cache file which is not removed
+    void evict(const std::string& keep);
+
+    /// @brief Get the VFS pathname of the cache file of an entry.
+    static std::string getCachePathname(const std::string& key);
+
+    /// @brief The number of hits.
+    size_t _hits;
+
+    /// @brief The number of misses.
+    size_t _misses;
+
+    /// @brief The total size, in Bytes, of the cache files or @a -1 if it was not determined yet.
+    int64_t _size;
+};
+
+} // namespace Ego
@@ -25,6 +25,7 @@
 #include "egolib/Graphics/TextureManager.hpp"
 #include "egolib/Image/ImageManager.hpp"
 #include "egolib/Image/ImageLoader.hpp"
+#include "egolib/Graphics/TextureCache.hpp"
 
 /**
  * @brief
@@ -57,6 +58,14 @@ static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const ch
             texture->release();
             // Build the full file name.
             std::string fullFilename = filename + extension;
+            // Use the cached pixels if available.
+            auto pixels = Ego::TextureCache::get().load(fullFilename, "");
+            if (pixels) {
+                retval = texture->load(fullFilename, pixels);
+                if (retval) {
+                    goto End;
+                }
+            }
             // Open the file.
             vfs_FILE *file = vfs_openRead(fullFilename);
             if (!file) {
@@ -74,9 +83,12 @@ static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const ch
             if (!surface) {
                 continue;
             }
-            // Create the texture from the surface.
-            retval = texture->load(fullFilename, surface);
+            // Convert and pad the surface and compute its mipmaps (1D textures have no mipmaps).
+            pixels = Ego::TexturePixels::create(surface, !(1 == surface->h && surface->w > 1));
+            // Create the texture from the pixels.
+            retval = texture->load(fullFilename, pixels);
             if (retval) {
+                Ego::TextureCache::get().store(fullFilename, "", *pixels);
                 goto End;
             }
         }
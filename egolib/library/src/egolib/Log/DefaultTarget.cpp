@@ -45,6 +45,7 @@ DefaultTarget::~DefaultTarget() {
 }
 
 void DefaultTarget::writev(Level level, const char *format, va_list args) {
+	std::lock_guard<std::mutex> lock(_mutex);
 	char logBuffer[MAX_LOG_MESSAGE] = EMPTY_CSTR;
 
 	// Add prefix
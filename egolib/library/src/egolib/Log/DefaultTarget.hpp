@@ -34,6 +34,11 @@ private:
 	*  The log file.
 	*/
 	vfs_FILE *_file;
+	/**
+	* @brief
+	*  Serializes the writes of entries from different threads.
+	*/
+	std::mutex _mutex;
 public:
 	DefaultTarget(const std::string& filename, Level level = Level::Warning);
 	virtual ~DefaultTarget();
@@ -19,6 +19,7 @@
 
 #define EGOLIB_PROFILES_PRIVATE 1
 #include "egolib/Profiles/EnchantProfile.hpp"
+#include "egolib/Profiles/ProfileCache.hpp"
 #include "egolib/Audio/AudioSystem.hpp"
 #include "egolib/Core/StringUtilities.hpp"
 #include "egolib/fileutil.h"
@@ -85,6 +86,17 @@ void EnchantProfile::setEnchantName(const std::string& name)
 
 std::shared_ptr<EnchantProfile> EnchantProfile::readFromFile(const std::string& pathname)
 {
+    // Load the enchant profile from the profile cache if possible.
+    {
+        auto profile = std::make_shared<EnchantProfile>();
+        if (Ego::ProfileCache::get().load(pathname, Ego::ProfileCache::Kind::Enchant,
+                                          [&profile](Ego::CacheFile::Reader& reader) { return profile->readFromCache(reader); }))
+        {
+            profile->_name = pathname;
+            return profile;
+        }
+    }
+
     std::shared_ptr<EnchantProfile> profile = std::make_shared<EnchantProfile>();
 
     std::unique_ptr<ReadContext> ctxt = nullptr;
@@ -272,5 +284,49 @@ std::shared_ptr<EnchantProfile> EnchantProfile::readFromFile(const std::string&
     // Limit the endsound_index.
     profile->endsound_index = Ego::Math::constrain<int16_t>(profile->endsound_index, INVALID_SOUND_ID, MAX_WAVE);
 
+    Ego::ProfileCache::get().store(pathname, Ego::ProfileCache::Kind::Enchant,
+                                   [&profile](std::vector<char>& buffer) { profile->writeToCache(buffer); });
+
     return profile;
 }
+
+void EnchantProfile::writeToCache(std::vector<char>& buffer) const
+{
+    using Ego::CacheFile::writeAll;
+    writeAll(buffer, _override, remove_overridden, retarget, required_damagetype, require_damagetarget_damagetype, spawn_overlay,
+             lifetime, endIfCannotPay, removedByIDSZ,
+             _owner._stay, _owner._manaDrain, _owner._lifeDrain,
+             _target._stay, _target._manaDrain, _target._lifeDrain);
+    for (const auto& modifier : _set)
+    {
+        writeAll(buffer, modifier.apply, modifier.value);
+    }
+    for (const auto& modifier : _add)
+    {
+        writeAll(buffer, modifier.apply, modifier.value);
+    }
+    writeAll(buffer, seeKurses, darkvision, contspawn,
+             endsound_index, killtargetonend, poofonend, endmessage, _enchantName);
+}
+
+bool EnchantProfile::readFromCache(Ego::CacheFile::Reader& reader)
+{
+    using Ego::CacheFile::readAll;
+    if (!readAll(reader, _override, remove_overridden, retarget, required_damagetype, require_damagetarget_damagetype, spawn_overlay,
+                 lifetime, endIfCannotPay, removedByIDSZ,
+                 _owner._stay, _owner._manaDrain, _owner._lifeDrain,
+                 _target._stay, _target._manaDrain, _target._lifeDrain))
+    {
+        return false;
+    }
+    for (auto& modifier : _set)
+    {
+        if (!readAll(reader, modifier.apply, modifier.value)) return false;
+    }
+    for (auto& modifier : _add)
+    {
+        if (!readAll(reader, modifier.apply, modifier.value)) return false;
+    }
+    return readAll(reader, seeKurses, darkvision, contspawn,
+                   endsound_index, killtargetonend, poofonend, endmessage, _enchantName);
+}
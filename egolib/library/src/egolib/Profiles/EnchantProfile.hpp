@@ -29,6 +29,8 @@
 #include "egolib/IDSZ.hpp"
 #include "egolib/Logic/MissileTreatment.hpp"
 
+namespace Ego { namespace CacheFile { struct Reader; } }
+
 /**
 * @brief
 *  An enchantment profile, or "eve"
@@ -158,6 +160,20 @@ public:
 
     static std::shared_ptr<EnchantProfile> readFromFile(const std::string& pathname);
 
+    /**
+     * @brief
+     *  Append the parsed data of this enchant profile to a profile cache payload.
+     */
+    void writeToCache(std::vector<char>& buffer) const;
+
+    /**
+     * @brief
+     *  Read the parsed data of this enchant profile from a profile cache payload.
+     * @return
+     *  @a true on success, @a false on failure
+     */
+    bool readFromCache(Ego::CacheFile::Reader& reader);
+
 public:
     // Enchant spawn description.
     bool _override;                         ///< Override other enchants?
@@ -217,6 +233,6 @@ public:
     bool poofonend;                      ///< Spawn a poof on end?
     int endmessage;                      ///< Message on end (-1 for none)
 
-private:
+protected:
     std::string _enchantName;
 };
@@ -24,6 +24,7 @@
 
 #define EGOLIB_PROFILES_PRIVATE 1
 #include "egolib/Profiles/ObjectProfile.hpp"
+#include "egolib/Profiles/ProfileCache.hpp"
 #include "egolib/game/Core/GameEngine.hpp"
 #include "egolib/Entities/_Include.hpp"
 #include "egolib/Graphics/ModelDescriptor.hpp"
@@ -432,6 +433,13 @@ ObjectProfileRef vfs_get_next_object_profile_ref(ReadContext& ctxt)
 
 bool ObjectProfile::loadDataFile(const std::string &filePath)
 {
+    // Load the data from the profile cache if possible
+    if (Ego::ProfileCache::get().load(filePath, Ego::ProfileCache::Kind::Object,
+                                      [this](Ego::CacheFile::Reader& reader) { return readDataFromCache(reader); }))
+    {
+        return true;
+    }
+
     // Open the file
     ReadContext ctxt(filePath);
 
@@ -922,9 +930,115 @@ bool ObjectProfile::loadDataFile(const std::string &filePath)
             break;
         }
     }
+
+    Ego::ProfileCache::get().store(filePath, Ego::ProfileCache::Kind::Object,
+                                   [this](std::vector<char>& buffer) { writeDataToCache(buffer); });
     return true;
 }
 
+void ObjectProfile::writeDataToCache(std::vector<char>& buffer) const
+{
+    using Ego::CacheFile::write;
+    using Ego::CacheFile::writeAll;
+
+    // naming and skins
+    write(buffer, _className);
+    write(buffer, static_cast<uint32_t>(_skinInfo.size()));
+    for (const auto& skin : _skinInfo)
+    {
+        writeAll(buffer, static_cast<uint32_t>(skin.first), skin.second.name, skin.second.cost, skin.second.maxAccel,
+                 skin.second.dressy, skin.second.defence, skin.second.damageModifier, skin.second.damageResistance);
+    }
+
+    // overrides, inventory and stats
+    writeAll(buffer, _skinOverride, _levelOverride, _stateOverride, _contentOverride, _idsz,
+             _maxAmmo, _ammo, _money, _gender, _spawnLife, _spawnMana, _baseAttribute, _attributeGain);
+
+    // physics and movement
+    writeAll(buffer, _weight, _bounciness, _bumpDampen, _size, _sizeGainPerLevel, _shadowSize,
+             _bumpSize, _bumpOverrideSize, _bumpSizeBig, _bumpOverrideSizeBig, _bumpHeight, _bumpOverrideHeight, _stoppedBy,
+             _jumpPower, _jumpNumber, _animationSpeedSneak, _animationSpeedWalk, _animationSpeedRun,
+             _flyHeight, _waterWalking, _jumpSound, _footFallSound);
+
+    // graphics
+    writeAll(buffer, _lifeColor, _manaColor, _drawIcon, _flashAND, _alpha, _light, _transferBlending, _sheen,
+             _phongMapping, _textureMovementRateX, _textureMovementRateY, _uniformLit, _hasReflection,
+             _alwaysDraw, _forceShadow, _causesRipples, _dontCullBackfaces);
+
+    // blocking, defense and experience
+    writeAll(buffer, iframefacing, iframeangle, nframefacing, nframeangle, _blockRating, _resistBumpSpawn,
+             _experienceForLevel, _startingExperience, _experienceWorth, _experienceExchange, _experienceRate,
+             _levelUpRandomSeedOverride);
+
+    // flags
+    writeAll(buffer, _isEquipment, _isItem, _isMount, _isStackable, _isInvincible, _isPlatform, _canUsePlatforms,
+             _canGrabMoney, _canOpenStuff, _canBeDazed, _canBeGrogged, _isBigItem, _isRanged, _nameIsKnown,
+             _usageIsKnown, _canCarryToNextModule, _damageTargetDamageType, _slotsValid, _riderCanAttack,
+             _kurseChance, _hideState, _isValuable, _spellEffectType);
+
+    // item usage and particle effects
+    writeAll(buffer, _needSkillIDToUse, _weaponAction, _attachAttackParticleToWeapon, _attackParticle, _attackFast,
+             _strengthBonus, _intelligenceBonus, _dexterityBonus,
+             _attachedParticleAmount, _attachedParticleReaffirmDamageType, _attachedParticle,
+             _goPoofParticleAmount, _goPoofParticleFacingAdd, _goPoofParticle, _bludValid, _bludParticle);
+
+    // skills, random stuff and perks
+    writeAll(buffer, _seeInvisibleLevel, _stickyButt, _useManaCost, _startingPerks, _perkPool);
+}
+
+bool ObjectProfile::readDataFromCache(Ego::CacheFile::Reader& reader)
+{
+    using Ego::CacheFile::readAll;
+
+    // naming and skins
+    uint32_t numberOfSkins;
+    if (!readAll(reader, _className, numberOfSkins))
+    {
+        return false;
+    }
+    _skinInfo.clear();
+    for (uint32_t i = 0; i < numberOfSkins; ++i)
+    {
+        uint32_t index;
+        SkinInfo skin;
+        if (!readAll(reader, index, skin.name, skin.cost, skin.maxAccel,
+                     skin.dressy, skin.defence, skin.damageModifier, skin.damageResistance))
+        {
+            return false;
+        }
+        _skinInfo[index] = skin;
+    }
+
+    // overrides, inventory and stats
+    return readAll(reader, _skinOverride, _levelOverride, _stateOverride, _contentOverride, _idsz,
+                   _maxAmmo, _ammo, _money, _gender, _spawnLife, _spawnMana, _baseAttribute, _attributeGain)
+    // physics and movement
+        && readAll(reader, _weight, _bounciness, _bumpDampen, _size, _sizeGainPerLevel, _shadowSize,
+                   _bumpSize, _bumpOverrideSize, _bumpSizeBig, _bumpOverrideSizeBig, _bumpHeight, _bumpOverrideHeight, _stoppedBy,
+                   _jumpPower, _jumpNumber, _animationSpeedSneak, _animationSpeedWalk, _animationSpeedRun,
+                   _flyHeight, _waterWalking, _jumpSound, _footFallSound)
+    // graphics
+        && readAll(reader, _lifeColor, _manaColor, _drawIcon, _flashAND, _alpha, _light, _transferBlending, _sheen,
+                   _phongMapping, _textureMovementRateX, _textureMovementRateY, _uniformLit, _hasReflection,
+                   _alwaysDraw, _forceShadow, _causesRipples, _dontCullBackfaces)
+    // blocking, defense and experience
+        && readAll(reader, iframefacing, iframeangle, nframefacing, nframeangle, _blockRating, _resistBumpSpawn,
+                   _experienceForLevel, _startingExperience, _experienceWorth, _experienceExchange, _experienceRate,
+                   _levelUpRandomSeedOverride)
+    // flags
+        && readAll(reader, _isEquipment, _isItem, _isMount, _isStackable, _isInvincible, _isPlatform, _canUsePlatforms,
+                   _canGrabMoney, _canOpenStuff, _canBeDazed, _canBeGrogged, _isBigItem, _isRanged, _nameIsKnown,
+                   _usageIsKnown, _canCarryToNextModule, _damageTargetDamageType, _slotsValid, _riderCanAttack,
+                   _kurseChance, _hideState, _isValuable, _spellEffectType)
+    // item usage and particle effects
+        && readAll(reader, _needSkillIDToUse, _weaponAction, _attachAttackParticleToWeapon, _attackParticle, _attackFast,
+                   _strengthBonus, _intelligenceBonus, _dexterityBonus,
+                   _attachedParticleAmount, _attachedParticleReaffirmDamageType, _attachedParticle,
+                   _goPoofParticleAmount, _goPoofParticleFacingAdd, _goPoofParticle, _bludValid, _bludParticle)
+    // skills, random stuff and perks
+        && readAll(reader, _seeInvisibleLevel, _stickyButt, _useManaCost, _startingPerks, _perkPool);
+}
+
 const SkinInfo& ObjectProfile::getSkinInfo(size_t index) const
 {
     const auto &result = _skinInfo.find(index);
@@ -990,10 +1104,14 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string& fo
     //Don't load 3d model, enchant, messages, sounds or particle effects for lightweight profiles
     if (!lightWeight)
     {
-        // Load the model for this profile
+        // Load the model for this profile, unless it was prefetched
         try
         {
-            profile->_model = std::make_shared<Ego::ModelDescriptor>(folderPath.c_str());
+            profile->_model = ProfileSystem::get().takePrefetchedModel(folderPath);
+            if (!profile->_model)
+            {
+                profile->_model = std::make_shared<Ego::ModelDescriptor>(folderPath.c_str());
+            }
         }
         catch (const std::runtime_error &ex)
         {
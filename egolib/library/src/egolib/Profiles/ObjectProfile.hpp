@@ -39,6 +39,7 @@
 typedef int SoundID;
 class Object;
 namespace Ego { class ModelDescriptor; }
+namespace Ego { namespace CacheFile { struct Reader; } }
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -591,7 +592,7 @@ public:
     size_t _spawnRequestCount;                       ///< the number of attempted spawns
     size_t _spawnCount;                         ///< the number of successful spawns
 
-private:
+protected:
 
     /**
     * @brief Loads the md2 model for this profile
@@ -614,13 +615,24 @@ private:
     **/
     bool loadDataFile(const std::string &filePath);
 
+    /**
+    * @brief Append the data from the datafile (data.txt) of this profile to a profile cache payload
+    **/
+    void writeDataToCache(std::vector<char>& buffer) const;
+
+    /**
+    * @brief Read the data from the datafile (data.txt) of this profile from a profile cache payload
+    * @return true on success
+    **/
+    bool readDataFromCache(Ego::CacheFile::Reader& reader);
+
     /**
     * @author ZF
     * @details This calculates the xp needed to reach next level and stores it in an array for later use
     **/
     void setupXPTable();
 
-private:
+protected:
     std::string _pathname;                      ///< Usually the source filename
 
     // the sub-profiles
@@ -19,6 +19,7 @@
 
 #define EGOLIB_PROFILES_PRIVATE 1
 #include "egolib/Profiles/ParticleProfile.hpp"
+#include "egolib/Profiles/ProfileCache.hpp"
 #include "egolib/Audio/AudioSystem.hpp"
 #include "egolib/Core/StringUtilities.hpp"
 #include "egolib/fileutil.h"
@@ -161,6 +162,17 @@ ParticleProfile::~ParticleProfile()
 
 std::shared_ptr<ParticleProfile> ParticleProfile::readFromFile(const std::string& pathname)
 {
+    // Load the particle profile from the profile cache if possible.
+    {
+        auto profile = std::make_shared<ParticleProfile>();
+        if (Ego::ProfileCache::get().load(pathname, Ego::ProfileCache::Kind::Particle,
+                                          [&profile](Ego::CacheFile::Reader& reader) { return profile->readFromCache(reader); }))
+        {
+            profile->_name = pathname;
+            return profile;
+        }
+    }
+
     char cTmp;
 
     std::unique_ptr<ReadContext> ctxt = nullptr;
@@ -420,9 +432,56 @@ std::shared_ptr<ParticleProfile> ParticleProfile::readFromFile(const std::string
     // Limit the soundspawn index.
     profile->soundspawn = Ego::Math::constrain<int8_t>(profile->soundspawn, INVALID_SOUND_ID, MAX_WAVE);
 
+    Ego::ProfileCache::get().store(pathname, Ego::ProfileCache::Kind::Particle,
+                                   [&profile](std::vector<char>& buffer) { profile->writeToCache(buffer); });
+
     return profile;
 }
 
+void ParticleProfile::writeToCache(std::vector<char>& buffer) const
+{
+    using Ego::CacheFile::writeAll;
+    // Spawning and ending.
+    writeAll(buffer, soundspawn, force, newtargetonspawn, needtarget, startontarget,
+             end_time, end_water, end_bump, end_ground, end_wall, end_lastframe,
+             end_sound, end_sound_floor, end_sound_wall,
+             contspawn, endspawn, bumpspawn);
+    // Bumping and hitting.
+    writeAll(buffer, bump_money, bump_size, bump_height,
+             damage, damageType, dazeTime, grogTime, _intellectDamageBonus, spawnenchant,
+             onlydamagefriendly, friendlyfire, hateonly, cause_roll, cause_pancake,
+             lifeDrain, manaDrain);
+    // Homing and physics.
+    writeAll(buffer, homing, targetangle, homingaccel, homingfriction, zaimspd, rotatetoface, targetcaster,
+             spdlimit, dampen, allowpush, ignore_gravity);
+    // Visual properties.
+    writeAll(buffer, dynalight.mode, dynalight.on, dynalight.level, dynalight.level_add,
+             dynalight.falloff, dynalight.falloff_add, type,
+             image_max, image_stt, image_add, rotate_pair, rotate_add, size_base, size_add, facingadd, orientation);
+    writeAll(buffer, _comment, _particleEffectBits, _gravityPull,
+             _spawnFacing, _spawnPositionOffsetXY, _spawnPositionOffsetZ, _spawnVelocityOffsetXY, _spawnVelocityOffsetZ);
+}
+
+bool ParticleProfile::readFromCache(Ego::CacheFile::Reader& reader)
+{
+    using Ego::CacheFile::readAll;
+    return readAll(reader, soundspawn, force, newtargetonspawn, needtarget, startontarget,
+                   end_time, end_water, end_bump, end_ground, end_wall, end_lastframe,
+                   end_sound, end_sound_floor, end_sound_wall,
+                   contspawn, endspawn, bumpspawn)
+        && readAll(reader, bump_money, bump_size, bump_height,
+                   damage, damageType, dazeTime, grogTime, _intellectDamageBonus, spawnenchant,
+                   onlydamagefriendly, friendlyfire, hateonly, cause_roll, cause_pancake,
+                   lifeDrain, manaDrain)
+        && readAll(reader, homing, targetangle, homingaccel, homingfriction, zaimspd, rotatetoface, targetcaster,
+                   spdlimit, dampen, allowpush, ignore_gravity)
+        && readAll(reader, dynalight.mode, dynalight.on, dynalight.level, dynalight.level_add,
+                   dynalight.falloff, dynalight.falloff_add, type,
+                   image_max, image_stt, image_add, rotate_pair, rotate_add, size_base, size_add, facingadd, orientation)
+        && readAll(reader, _comment, _particleEffectBits, _gravityPull,
+                   _spawnFacing, _spawnPositionOffsetXY, _spawnPositionOffsetZ, _spawnVelocityOffsetXY, _spawnVelocityOffsetZ);
+}
+
 bool ParticleProfile::hasBit(const ParticleDamageEffectBits bit) const
 {
     if(bit == NR_OF_DAMFX_BITS) return false; //should never happen
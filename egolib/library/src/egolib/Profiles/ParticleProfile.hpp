@@ -25,6 +25,8 @@
 #include "egolib/Profiles/AbstractProfile.hpp"
 #include "egolib/_math.h"
 
+namespace Ego { namespace CacheFile { struct Reader; } }
+
 /// Pre-defined global particle types
 /// @note I can't place all the money particles in the same place because it is expected
 /// that certain particles have certain slots (i.e. PIP_WEATHER4 being slot 4...)
@@ -163,6 +165,20 @@ public:
     *   if it has a gravity push
     **/
     float getGravityPull() const;
+
+    /**
+     * @brief
+     *  Append the parsed data of this particle profile to a profile cache payload.
+     */
+    void writeToCache(std::vector<char>& buffer) const;
+
+    /**
+     * @brief
+     *  Read the parsed data of this particle profile from a profile cache payload.
+     * @return
+     *  @a true on success, @a false on failure
+     */
+    bool readFromCache(Ego::CacheFile::Reader& reader);
     
 public:
 
@@ -262,7 +278,7 @@ public:
     uint16_t facingadd;           ///< Facing
     prt_ori_t orientation;      ///< The way the particle orientation is calculated for display
 
-private:
+protected:
     std::string _comment;
     std::bitset<NR_OF_DAMFX_BITS> _particleEffectBits;
     float _gravityPull;            ///< != 0 if this particle has a gravitational pull, pulling all living objects into it
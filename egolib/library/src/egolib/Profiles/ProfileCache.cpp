@@ -0,0 +1,210 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Profiles/ProfileCache.cpp
+/// @brief An on-disk cache of parsed enchant, object and particle profiles.
+
+#define EGOLIB_PROFILES_PRIVATE 1
+#include "egolib/Profiles/ProfileCache.hpp"
+#include "egolib/egoboo_setup.h"
+#include "egolib/vfs.h"
+
+namespace Ego {
+
+namespace {
+
+/// @brief The magic number of a profile cache file ("EGPC").
+constexpr uint32_t CACHE_MAGIC = 0x43504745;
+
+/// @brief The version of the profile cache file format.
+/// Increment whenever the file format, the layout of a profile payload or the parsing of a profile changes.
+constexpr uint32_t CACHE_VERSION = 1;
+
+using CacheFile::hash;
+using CacheFile::Reader;
+
+} // namespace
+
+ProfileCache::ProfileCache() :
+    _hits(0), _misses(0) {
+}
+
+ProfileCache::~ProfileCache() {
+}
+
+bool ProfileCache::isEnabled() const {
+    return egoboo_config_t::get().game_profileCache_enable.getValue();
+}
+
+size_t ProfileCache::getHits() const {
+    return _hits;
+}
+
+size_t ProfileCache::getMisses() const {
+    return _misses;
+}
+
+bool ProfileCache::getStamp(const std::string& pathname, Stamp& stamp) {
+    auto resolved = vfs_resolveReadFilename(pathname);
+    if (!resolved.first) {
+        return false;
+    }
+    stamp.resolvedPathname = resolved.second;
+    stamp.length = vfs_getFileLength(pathname);
+    stamp.modificationTime = vfs_getLastModTime(pathname);
+    return -1 != stamp.length && -1 != stamp.modificationTime;
+}
+
+bool ProfileCache::getSourceHash(const std::string& pathname, uint64_t& value) {
+    char *data = nullptr;
+    size_t length = 0;
+    if (!vfs_readEntireFile(pathname, &data, &length)) {
+        return false;
+    }
+    std::unique_ptr<char, decltype(&std::free)> guard(data, &std::free);
+    value = hash(data, length);
+    return true;
+}
+
+std::string ProfileCache::getCachePathname(const std::string& key) {
+    std::ostringstream os;
+    os << "/cache/profiles/" << std::hex << std::setw(16) << std::setfill('0') << hash(key) << ".pro";
+    return os.str();
+}
+
+std::vector<char> ProfileCache::encode(const Stamp& stamp, uint64_t sourceHash, Kind kind, const WriteFunction& write) {
+    std::vector<char> payload;
+    write(payload);
+
+    std::vector<char> buffer;
+    buffer.reserve(128 + stamp.resolvedPathname.size() + payload.size());
+
+    // Write the header.
+    CacheFile::write(buffer, CACHE_MAGIC);
+    CacheFile::write(buffer, CACHE_VERSION);
+    CacheFile::write(buffer, static_cast<uint32_t>(kind));
+    CacheFile::write(buffer, stamp.resolvedPathname);
+    CacheFile::write(buffer, stamp.length);
+    CacheFile::write(buffer, stamp.modificationTime);
+    CacheFile::write(buffer, sourceHash);
+
+    // Write the payload.
+    CacheFile::write(buffer, static_cast<uint32_t>(payload.size()));
+    CacheFile::write(buffer, hash(payload.data(), payload.size()));
+    buffer.insert(buffer.end(), payload.begin(), payload.end());
+
+    return buffer;
+}
+
+ProfileCache::Validity ProfileCache::decode(const char *data, size_t length, const Stamp& stamp, Kind kind,
+                                            const SourceHashFunction& getSourceHash, const ReadFunction& read) {
+    Reader reader{data, data + length};
+
+    // Validate the header.
+    uint32_t magic, version, storedKind;
+    std::string storedKey;
+    int64_t storedLength, storedModificationTime;
+    uint64_t storedSourceHash;
+    if (!reader.read(magic) || CACHE_MAGIC != magic ||
+        !reader.read(version) || CACHE_VERSION != version ||
+        !reader.read(storedKind) || static_cast<uint32_t>(kind) != storedKind ||
+        !reader.read(storedKey) || stamp.resolvedPathname != storedKey ||
+        !reader.read(storedLength) || stamp.length != storedLength ||
+        !reader.read(storedModificationTime) ||
+        !reader.read(storedSourceHash)) {
+        return Validity::Stale;
+    }
+    // A modified source file (e.g. a module which was copied or re-extracted) is still
+    // valid if its contents are unchanged.
+    if (stamp.modificationTime != storedModificationTime) {
+        uint64_t sourceHash;
+        if (!getSourceHash(sourceHash) || storedSourceHash != sourceHash) {
+            return Validity::Stale;
+        }
+    }
+
+    // Validate and deserialize the payload.
+    uint32_t payloadLength;
+    uint64_t payloadHash;
+    if (!reader.read(payloadLength) || !reader.read(payloadHash) ||
+        reader.end - reader.current != static_cast<ptrdiff_t>(payloadLength) ||
+        payloadHash != hash(reader.current, payloadLength)) {
+        return Validity::Corrupted;
+    }
+    if (!read(reader) || reader.current != reader.end) {
+        return Validity::Malformed;
+    }
+    return Validity::Valid;
+}
+
+bool ProfileCache::load(const std::string& pathname, Kind kind, const ReadFunction& read) {
+    if (!isEnabled()) {
+        return false;
+    }
+    Stamp stamp;
+    if (!getStamp(pathname, stamp)) {
+        return false;
+    }
+    const std::string cachePathname = getCachePathname(stamp.resolvedPathname);
+    if (!vfs_exists(cachePathname)) {
+        _misses++;
+        return false;
+    }
+    char *data = nullptr;
+    size_t length = 0;
+    if (!vfs_readEntireFile(cachePathname, &data, &length)) {
+        _misses++;
+        return false;
+    }
+    std::unique_ptr<char, decltype(&std::free)> guard(data, &std::free);
+    auto sourceHash = [&pathname](uint64_t& value) { return getSourceHash(pathname, value); };
+    switch (decode(data, length, stamp, kind, sourceHash, read)) {
+        case Validity::Valid:
+            _hits++;
+            return true;
+        case Validity::Corrupted:
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "corrupted profile cache file ", "`", cachePathname, "`", Log::EndOfEntry);
+            break;
+        case Validity::Malformed:
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "malformed profile cache file ", "`", cachePathname, "`", Log::EndOfEntry);
+            break;
+        case Validity::Stale:
+            break;
+    }
+    _misses++;
+    return false;
+}
+
+void ProfileCache::store(const std::string& pathname, Kind kind, const WriteFunction& write) {
+    if (!isEnabled()) {
+        return;
+    }
+    Stamp stamp;
+    uint64_t sourceHash;
+    if (!getStamp(pathname, stamp) || !getSourceHash(pathname, sourceHash)) {
+        return;
+    }
+    const std::vector<char> buffer = encode(stamp, sourceHash, kind, write);
+    const std::string cachePathname = getCachePathname(stamp.resolvedPathname);
+    if (!vfs_writeEntireFile(cachePathname, buffer.data(), buffer.size())) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to write profile cache file ", "`", cachePathname, "`", Log::EndOfEntry);
+    }
+}
+
+} // namespace Ego
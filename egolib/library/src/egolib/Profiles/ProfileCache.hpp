@@ -0,0 +1,317 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Profiles/ProfileCache.hpp
+/// @brief An on-disk cache of parsed enchant, object and particle profiles.
+
+#pragma once
+#if !defined(EGOLIB_PROFILES_PRIVATE) || EGOLIB_PROFILES_PRIVATE != 1
+#error(do not include directly, include `egolib/Profiles/_Include.hpp` instead)
+#endif
+
+#include "egolib/Profiles/AbstractProfile.hpp"
+#include "egolib/Core/CacheFile.hpp"
+#include "egolib/IDSZ.hpp"
+
+namespace Ego {
+
+namespace CacheFile {
+
+/// @{
+/// @brief Append a profile value to a buffer or read a profile value from a buffer.
+template <typename T>
+bool read(Reader& reader, T& value) {
+    return reader.read(value);
+}
+
+inline void write(std::vector<char>& buffer, const IPair& value) {
+    write(buffer, static_cast<int32_t>(value.base));
+    write(buffer, static_cast<int32_t>(value.rand));
+}
+
+inline bool read(Reader& reader, IPair& value) {
+    int32_t base, rand;
+    if (!reader.read(base) || !reader.read(rand)) return false;
+    value.base = base;
+    value.rand = rand;
+    return true;
+}
+
+inline void write(std::vector<char>& buffer, const idlib::interval<float>& value) {
+    write(buffer, value.lower());
+    write(buffer, value.upper());
+}
+
+inline bool read(Reader& reader, idlib::interval<float>& value) {
+    float lower, upper;
+    if (!reader.read(lower) || !reader.read(upper) || lower > upper) return false;
+    value = idlib::interval<float>(lower, upper);
+    return true;
+}
+
+inline void write(std::vector<char>& buffer, const IDSZ2& value) {
+    write(buffer, value.toUint32());
+}
+
+inline bool read(Reader& reader, IDSZ2& value) {
+    uint32_t bits;
+    if (!reader.read(bits)) return false;
+    value = IDSZ2(bits);
+    return true;
+}
+
+inline void write(std::vector<char>& buffer, const LocalParticleProfileRef& value) {
+    write(buffer, static_cast<int32_t>(value.get()));
+}
+
+inline bool read(Reader& reader, LocalParticleProfileRef& value) {
+    int32_t index;
+    if (!reader.read(index)) return false;
+    value = LocalParticleProfileRef(index);
+    return true;
+}
+
+inline void write(std::vector<char>& buffer, const SpawnDescriptor& value) {
+    write(buffer, value._amount);
+    write(buffer, value._facingAdd);
+    write(buffer, value._lpip);
+}
+
+inline bool read(Reader& reader, SpawnDescriptor& value) {
+    return reader.read(value._amount) && reader.read(value._facingAdd) && read(reader, value._lpip);
+}
+
+inline void write(std::vector<char>& buffer, const ContinuousSpawnDescriptor& value) {
+    write(buffer, static_cast<const SpawnDescriptor&>(value));
+    write(buffer, value._delay);
+}
+
+inline bool read(Reader& reader, ContinuousSpawnDescriptor& value) {
+    return read(reader, static_cast<SpawnDescriptor&>(value)) && reader.read(value._delay);
+}
+
+template <size_t N>
+void write(std::vector<char>& buffer, const std::bitset<N>& value) {
+    write(buffer, value.to_string());
+}
+
+template <size_t N>
+bool read(Reader& reader, std::bitset<N>& value) {
+    std::string bits;
+    if (!reader.read(bits) || N != bits.size() || std::string::npos != bits.find_first_not_of("01")) return false;
+    value = std::bitset<N>(bits);
+    return true;
+}
+
+template <typename T, size_t N>
+void write(std::vector<char>& buffer, const std::array<T, N>& values) {
+    for (const auto& value : values) write(buffer, value);
+}
+
+template <typename T, size_t N>
+bool read(Reader& reader, std::array<T, N>& values) {
+    for (auto& value : values) {
+        if (!read(reader, value)) return false;
+    }
+    return true;
+}
+/// @}
+
+/// @brief Append values to a buffer.
+inline void writeAll(std::vector<char>&) {}
+
+template <typename T, typename ... Ts>
+void writeAll(std::vector<char>& buffer, const T& value, const Ts& ... values) {
+    write(buffer, value);
+    writeAll(buffer, values ...);
+}
+
+/// @brief Read values from a buffer, failing on the first short read.
+inline bool readAll(Reader&) { return true; }
+
+template <typename T, typename ... Ts>
+bool readAll(Reader& reader, T& value, Ts& ... values) {
+    return read(reader, value) && readAll(reader, values ...);
+}
+
+} // namespace CacheFile
+
+/**
+ * @brief
+ *  An on-disk cache of parsed enchant, object and particle profiles.
+ * @remark
+ *  An entry is identified by the resolved pathname of the profile source file and stored under
+ *  <tt>/cache/profiles</tt> of the user directory in a file named after a hash of that pathname.
+ *  An entry is valid if the length of the source file is unchanged and if either its modification
+ *  time is unchanged or the hash of its contents is unchanged. The payload of an entry is read in
+ *  one piece and verified by its own hash before it is deserialized.
+ */
+class ProfileCache : public idlib::singleton<ProfileCache> {
+protected:
+    friend idlib::default_new_functor<ProfileCache>;
+    friend idlib::default_delete_functor<ProfileCache>;
+
+    /**
+     * @brief
+     *  Construct this profile cache.
+     * @remark
+     *  Intentionally protected.
+     */
+    ProfileCache();
+
+    /**
+     * @brief
+     *  Destruct this profile cache.
+     * @remark
+     *  Intentionally protected.
+     */
+    virtual ~ProfileCache();
+
+public:
+    /// @brief The kinds of profiles.
+    enum class Kind : uint32_t {
+        Enchant = 1,
+        Object = 2,
+        Particle = 3,
+    };
+
+    /// @brief Deserialize a profile from a payload.
+    /// @return @a true on success, @a false on failure
+    using ReadFunction = std::function<bool(CacheFile::Reader&)>;
+
+    /// @brief Serialize a profile into a payload.
+    using WriteFunction = std::function<void(std::vector<char>&)>;
+
+    /**
+     * @brief
+     *  Get if this profile cache is enabled.
+     * @return
+     *  @a true if this profile cache is enabled, @a false otherwise
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief
+     *  Load a profile.
+     * @param pathname
+     *  the pathname of the profile source file
+     * @param kind
+     *  the kind of the profile
+     * @param read
+     *  the function deserializing the profile from the payload of the entry
+     * @return
+     *  @a true if a valid entry exists and @a read succeeded and consumed the entire payload, @a false otherwise
+     */
+    bool load(const std::string& pathname, Kind kind, const ReadFunction& read);
+
+    /**
+     * @brief
+     *  Store a profile.
+     * @param pathname
+     *  the pathname of the profile source file
+     * @param kind
+     *  the kind of the profile
+     * @param write
+     *  the function serializing the profile into the payload of the entry
+     */
+    void store(const std::string& pathname, Kind kind, const WriteFunction& write);
+
+    /// @brief Get the number of lookups which were served from the cache.
+    size_t getHits() const;
+
+    /// @brief Get the number of lookups which were not served from the cache.
+    size_t getMisses() const;
+
+    /// @brief The stamp of a profile source file.
+    struct Stamp {
+        std::string resolvedPathname;
+        int64_t length;
+        int64_t modificationTime;
+    };
+
+    /// @brief The outcome of decoding an entry.
+    enum class Validity {
+        /// The entry is valid and was deserialized.
+        Valid,
+        /// The entry does not belong to the source file or the source file has changed.
+        Stale,
+        /// The payload of the entry does not match its hash.
+        Corrupted,
+        /// The payload could not be deserialized.
+        Malformed,
+    };
+
+    /// @brief Get the hash of the contents of a profile source file.
+    /// @return @a true on success, @a false on failure
+    using SourceHashFunction = std::function<bool(uint64_t&)>;
+
+    /**
+     * @brief
+     *  Encode an entry.
+     * @param stamp, sourceHash
+     *  the stamp and the hash of the contents of the profile source file
+     * @param kind
+     *  the kind of the profile
+     * @param write
+     *  the function serializing the profile into the payload of the entry
+     * @return
+     *  the contents of the cache file of the entry
+     */
+    static std::vector<char> encode(const Stamp& stamp, uint64_t sourceHash, Kind kind, const WriteFunction& write);
+
+    /**
+     * @brief
+     *  Decode an entry.
+     * @param data, length
+     *  the contents of the cache file of the entry
+     * @param stamp
+     *  the current stamp of the profile source file
+     * @param kind
+     *  the kind of the profile
+     * @param getSourceHash
+     *  the function computing the hash of the contents of the profile source file,
+     *  only invoked if the modification time of the source file has changed
+     * @param read
+     *  the function deserializing the profile from the payload of the entry
+     * @return
+     *  Validity::Valid if @a read was invoked, succeeded and consumed the entire payload
+     */
+    static Validity decode(const char *data, size_t length, const Stamp& stamp, Kind kind,
+                           const SourceHashFunction& getSourceHash, const ReadFunction& read);
+
+private:
+    /// @brief Get the stamp of a profile source file.
+    /// @return @a true on success, @a false on failure
+    static bool getStamp(const std::string& pathname, Stamp& stamp);
+
+    /// @brief Get the hash of the contents of a profile source file.
+    /// @return @a true on success, @a false on failure
+    static bool getSourceHash(const std::string& pathname, uint64_t& hash);
+
+    /// @brief Get the pathname of the cache file of an entry.
+    static std::string getCachePathname(const std::string& key);
+
+    /// @brief The number of lookups which were served from the cache.
+    size_t _hits;
+
+    /// @brief The number of lookups which were not served from the cache.
+    size_t _misses;
+};
+
+} // namespace Ego
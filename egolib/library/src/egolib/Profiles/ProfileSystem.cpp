@@ -30,6 +30,10 @@
 #include "egolib/Entities/_Include.hpp"
 #include "egolib/game/game.h"
 #include "egolib/game/script_compile.h"
+#include "egolib/Script/ScriptCache.hpp"
+#include "egolib/Profiles/ProfileCache.hpp"
+#include "egolib/Core/ParallelFor.hpp"
+#include "egolib/Graphics/ModelDescriptor.hpp"
 
 AbstractProfileSystem<EnchantProfile, EnchantProfileRef> EnchantProfileSystem("enchant", "/debug/enchant_profile_usage.txt");
 AbstractProfileSystem<ParticleProfile, ParticleProfileRef> ParticleProfileSystem("particle", "/debug/particle_profile_usage.txt");
@@ -48,15 +52,19 @@ ProfileSystem::ProfileSystem() :
     EnchantProfileSystem("enchant", "/debug/enchant_profile_usage.txt"),
     ParticleProfileSystem("particle", "/debug/particle_profile_usage.txt")
 {
-    // Initialize the script compiler.
+    // Initialize the profile cache, the script cache and the script compiler.
+    Ego::ProfileCache::initialize();
+    Ego::Script::ScriptCache::initialize();
     parser_state_t::initialize();
 }
 
 
 ProfileSystem::~ProfileSystem()
 {
-    // Uninitialize the script compiler.
+    // Uninitialize the script compiler, the script cache and the profile cache.
     parser_state_t::uninitialize();
+    Ego::Script::ScriptCache::uninitialize();
+    Ego::ProfileCache::uninitialize();
 }
 
 void ProfileSystem::reset()
@@ -71,6 +79,9 @@ void ProfileSystem::reset()
     // Release list of loadable characters.
     _loadPlayerList.clear();
 
+    // Release models which were prefetched but not used.
+    _prefetchedModels.clear();
+
     // Reset particle, enchant and models.
     ParticleProfileSystem.unloadAll();
     EnchantProfileSystem.unloadAll();
@@ -210,6 +221,49 @@ ObjectProfileRef ProfileSystem::loadOneProfile(const std::string &pathName, int
     return iobj;
 }
 
+void ProfileSystem::prefetchModels(const std::vector<std::string>& folderPaths)
+{
+    std::vector<std::shared_ptr<Ego::ModelDescriptor>> models(folderPaths.size());
+    Ego::Core::parallelFor(folderPaths.size(), 1, [&folderPaths, &models](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            try
+            {
+                models[i] = std::make_shared<Ego::ModelDescriptor>(folderPaths[i]);
+            }
+            catch (...)
+            {
+                // Left to ObjectProfile::loadFromFile.
+            }
+        }
+    });
+    for (size_t i = 0; i < folderPaths.size(); ++i)
+    {
+        if (models[i])
+        {
+            _prefetchedModels[folderPaths[i]] = models[i];
+        }
+    }
+}
+
+std::shared_ptr<Ego::ModelDescriptor> ProfileSystem::takePrefetchedModel(const std::string& folderPath)
+{
+    auto it = _prefetchedModels.find(folderPath);
+    if (it == _prefetchedModels.end())
+    {
+        return nullptr;
+    }
+    auto model = it->second;
+    _prefetchedModels.erase(it);
+    return model;
+}
+
+void ProfileSystem::clearPrefetchedModels()
+{
+    _prefetchedModels.clear();
+}
+
 const Ego::DeferredTexture& ProfileSystem::getSpellBookIcon(size_t index) const
 {
     return _profilesLoaded.find(SPELLBOOK)->second->getIcon(index);
@@ -33,7 +33,7 @@ class ModuleProfile;
 class ParticleProfile;
 class EnchantProfile;
 class LoadPlayerElement;
-namespace Ego { class DeferredTexture; }
+namespace Ego { class DeferredTexture; class ModelDescriptor; }
 
 /// Placeholders used while importing profiles
 struct pro_import_t
@@ -89,6 +89,33 @@ public:
      */
     ObjectProfileRef loadOneProfile(const std::string &folderPath, int slot_override = -1);
 
+    /**
+     * @brief
+     *  Load the models of object profiles in parallel ahead of loadOneProfile.
+     * @param folderPaths
+     *  the folder paths of the object profiles
+     * @remark
+     *  Loading a model is the expensive part of loading an object profile which does not depend on other profiles.
+     *  A model which fails to load is skipped, loadOneProfile will load and report it as usual.
+     */
+    void prefetchModels(const std::vector<std::string>& folderPaths);
+
+    /**
+     * @brief
+     *  Remove and return a model loaded by prefetchModels.
+     * @param folderPath
+     *  the folder path of the object profile
+     * @return
+     *  the model if a model was prefetched for the folder path, a null pointer otherwise
+     */
+    std::shared_ptr<Ego::ModelDescriptor> takePrefetchedModel(const std::string& folderPath);
+
+    /**
+     * @brief
+     *  Remove all models loaded by prefetchModels.
+     */
+    void clearPrefetchedModels();
+
     /**
      * @brief Loads only the slot number from data.txt
      *        If slot_override is valid, then that is used indead
@@ -151,6 +178,8 @@ private:
     std::vector<std::shared_ptr<ModuleProfile>> _moduleProfilesLoaded;  // List of all valid game modules loaded
 
     std::vector<std::shared_ptr<LoadPlayerElement>> _loadPlayerList; // List of characters that can be loaded (lightweight)
+
+    std::unordered_map<std::string, std::shared_ptr<Ego::ModelDescriptor>> _prefetchedModels; //Maps folder paths to models loaded by prefetchModels
 };
 
 // TODO: Remove this.
@@ -0,0 +1,105 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/Buffers.cpp
+/// @brief Implementation of the buffer facades for the null renderer.
+
+#include "egolib/Renderer/Null/Buffers.hpp"
+
+namespace Ego {
+namespace Null {
+
+AccumulationBuffer::AccumulationBuffer(CommandStream& commandStream) :
+    Ego::AccumulationBuffer(), m_commandStream(commandStream), m_colourDepth({ 16, 16, 16 }, 16)
+{}
+
+AccumulationBuffer::~AccumulationBuffer()
+{}
+
+void AccumulationBuffer::clear() {
+    m_commandStream.append(Command::Kind::Clear, "AccumulationBuffer::clear");
+}
+
+void AccumulationBuffer::setClearValue(const Colour4f& value) {
+    m_commandStream.append(Command::Kind::StateChange, "AccumulationBuffer::setClearValue");
+}
+
+const idlib::rgba_depth& AccumulationBuffer::getColourDepth() {
+    return m_colourDepth;
+}
+
+ColourBuffer::ColourBuffer(CommandStream& commandStream) :
+    Ego::ColourBuffer(), m_commandStream(commandStream), m_colourDepth({ 8, 8, 8 }, 8)
+{}
+
+ColourBuffer::~ColourBuffer()
+{}
+
+void ColourBuffer::clear() {
+    m_commandStream.append(Command::Kind::Clear, "ColourBuffer::clear");
+}
+
+void ColourBuffer::setClearValue(const Colour4f& value) {
+    m_commandStream.append(Command::Kind::StateChange, "ColourBuffer::setClearValue");
+}
+
+const idlib::rgba_depth& ColourBuffer::getColourDepth() {
+    return m_colourDepth;
+}
+
+DepthBuffer::DepthBuffer(CommandStream& commandStream) :
+    Ego::DepthBuffer(), m_commandStream(commandStream)
+{}
+
+DepthBuffer::~DepthBuffer()
+{}
+
+void DepthBuffer::clear() {
+    m_commandStream.append(Command::Kind::Clear, "DepthBuffer::clear");
+}
+
+void DepthBuffer::setClearValue(const float& value) {
+    m_commandStream.append(Command::Kind::StateChange, "DepthBuffer::setClearValue");
+}
+
+uint8_t DepthBuffer::getDepth() {
+    return 24;
+}
+
+StencilBuffer::StencilBuffer(CommandStream& commandStream) :
+    Ego::StencilBuffer(), m_commandStream(commandStream)
+{}
+
+StencilBuffer::~StencilBuffer()
+{}
+
+void StencilBuffer::clear() {
+    m_commandStream.append(Command::Kind::Clear, "StencilBuffer::clear");
+}
+
+void StencilBuffer::setClearValue(const float& value) {
+    m_commandStream.append(Command::Kind::StateChange, "StencilBuffer::setClearValue");
+}
+
+uint8_t StencilBuffer::getDepth() {
+    return 8;
+}
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,134 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/Buffers.hpp
+/// @brief Implementation of the buffer facades for the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/CommandStream.hpp"
+
+namespace Ego {
+namespace Null {
+
+class AccumulationBuffer : public Ego::AccumulationBuffer
+{
+private:
+    CommandStream& m_commandStream;
+    idlib::rgba_depth m_colourDepth;
+
+public:
+    /// @brief Construct this accumulation buffer facade.
+    /// @param commandStream the command stream to record to
+    AccumulationBuffer(CommandStream& commandStream);
+
+    /// @brief Destruct this accumulation buffer facade.
+    virtual ~AccumulationBuffer();
+
+public:
+    /** @copydoc Ego::Buffer<Ego::Colour4f>::clear */
+    virtual void clear() override;
+
+    /** @copydoc Ego::Buffer<Ego::Colour4f>::setClearValue */
+    virtual void setClearValue(const Colour4f& value) override;
+
+    /** @copydoc Ego::AccumulationBuffer::getColourDepth */
+    virtual const idlib::rgba_depth& getColourDepth() override;
+
+}; // class AccumulationBuffer
+
+class ColourBuffer : public Ego::ColourBuffer
+{
+private:
+    CommandStream& m_commandStream;
+    idlib::rgba_depth m_colourDepth;
+
+public:
+    /// @brief Construct this colour buffer facade.
+    /// @param commandStream the command stream to record to
+    ColourBuffer(CommandStream& commandStream);
+
+    /// @brief Destruct this colour buffer facade.
+    virtual ~ColourBuffer();
+
+public:
+    /** @copydoc Ego::Buffer<Ego::Colour4f>::clear */
+    virtual void clear() override;
+
+    /** @copydoc Ego::Buffer<Ego::Colour4f>::setClearValue */
+    virtual void setClearValue(const Colour4f& value) override;
+
+    /** @copydoc Ego::ColourBuffer::getColourDepth */
+    virtual const idlib::rgba_depth& getColourDepth() override;
+
+}; // class ColourBuffer
+
+class DepthBuffer : public Ego::DepthBuffer
+{
+private:
+    CommandStream& m_commandStream;
+
+public:
+    /// @brief Construct this depth buffer facade.
+    /// @param commandStream the command stream to record to
+    DepthBuffer(CommandStream& commandStream);
+
+    /// @brief Destruct this depth buffer facade.
+    virtual ~DepthBuffer();
+
+public:
+    /** @copydoc Ego::Buffer<float>::clear */
+    virtual void clear() override;
+
+    /** @copydoc Ego::Buffer<float>::setClearValue */
+    virtual void setClearValue(const float& value) override;
+
+    /** @copydoc Ego::DepthBuffer::getDepth */
+    virtual uint8_t getDepth() override;
+
+}; // class DepthBuffer
+
+class StencilBuffer : public Ego::StencilBuffer
+{
+private:
+    CommandStream& m_commandStream;
+
+public:
+    /// @brief Construct this stencil buffer facade.
+    /// @param commandStream the command stream to record to
+    StencilBuffer(CommandStream& commandStream);
+
+    /// @brief Destruct this stencil buffer facade.
+    virtual ~StencilBuffer();
+
+public:
+    /** @copydoc Ego::Buffer<float>::clear */
+    virtual void clear() override;
+
+    /** @copydoc Ego::Buffer<float>::setClearValue */
+    virtual void setClearValue(const float& value) override;
+
+    /** @copydoc Ego::StencilBuffer::getDepth */
+    virtual uint8_t getDepth() override;
+
+}; // class StencilBuffer
+
+} // namespace Null
+} // namespace Ego
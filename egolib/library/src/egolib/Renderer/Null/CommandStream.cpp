@@ -0,0 +1,176 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/CommandStream.cpp
+/// @brief A stream of commands recorded by the null renderer.
+
+#include "egolib/Renderer/Null/CommandStream.hpp"
+#include "idlib/idlib.hpp"
+
+namespace Ego {
+namespace Null {
+
+CommandStream::Counters& CommandStream::Counters::operator+=(const Counters& other)
+{
+    stateChanges += other.stateChanges;
+    clears += other.clears;
+    binds += other.binds;
+    draws += other.draws;
+    vertices += other.vertices;
+    uploads += other.uploads;
+    bytesUploaded += other.bytesUploaded;
+    return *this;
+}
+
+void CommandStream::Counters::write(std::ostream& os) const
+{
+    os << "state changes = " << stateChanges << std::endl
+       << "clears = " << clears << std::endl
+       << "binds = " << binds << std::endl
+       << "draws = " << draws << std::endl
+       << "vertices = " << vertices << std::endl
+       << "uploads = " << uploads << std::endl
+       << "bytes uploaded = " << bytesUploaded << std::endl;
+}
+
+CommandStream::CommandStream() :
+    m_recording(false), m_commands(), m_counters()
+{}
+
+bool CommandStream::isRecording() const
+{
+    return m_recording;
+}
+
+void CommandStream::setRecording(bool recording)
+{
+    m_recording = recording;
+}
+
+void CommandStream::append(Command::Kind kind, const char *name, size_t size)
+{
+    switch (kind)
+    {
+        case Command::Kind::StateChange:
+            m_counters.stateChanges++;
+            break;
+        case Command::Kind::Clear:
+            m_counters.clears++;
+            break;
+        case Command::Kind::Bind:
+            m_counters.binds++;
+            break;
+        case Command::Kind::Draw:
+            m_counters.draws++;
+            m_counters.vertices += size;
+            break;
+        case Command::Kind::Upload:
+            m_counters.uploads++;
+            m_counters.bytesUploaded += size;
+            break;
+        default:
+            throw idlib::unhandled_switch_case_error(__FILE__, __LINE__);
+    };
+    if (m_recording)
+    {
+        m_commands.push_back({ kind, name, size });
+    }
+}
+
+void CommandStream::clear()
+{
+    m_commands.clear();
+    m_counters = Counters();
+}
+
+const CommandStream::Counters& CommandStream::getCounters() const
+{
+    return m_counters;
+}
+
+const std::vector<Command>& CommandStream::getCommands() const
+{
+    return m_commands;
+}
+
+size_t CommandStream::getStateChanges() const
+{
+    return m_counters.stateChanges;
+}
+
+size_t CommandStream::getClears() const
+{
+    return m_counters.clears;
+}
+
+size_t CommandStream::getBinds() const
+{
+    return m_counters.binds;
+}
+
+size_t CommandStream::getDraws() const
+{
+    return m_counters.draws;
+}
+
+size_t CommandStream::getVertices() const
+{
+    return m_counters.vertices;
+}
+
+size_t CommandStream::getUploads() const
+{
+    return m_counters.uploads;
+}
+
+size_t CommandStream::getBytesUploaded() const
+{
+    return m_counters.bytesUploaded;
+}
+
+void CommandStream::write(std::ostream& os) const
+{
+    m_counters.write(os);
+    for (const auto& command : m_commands)
+    {
+        os << toString(command.kind) << " " << command.name;
+        if (command.size)
+        {
+            os << " " << command.size;
+        }
+        os << std::endl;
+    }
+}
+
+const char *CommandStream::toString(Command::Kind kind)
+{
+    switch (kind)
+    {
+        case Command::Kind::StateChange: return "state";
+        case Command::Kind::Clear: return "clear";
+        case Command::Kind::Bind: return "bind";
+        case Command::Kind::Draw: return "draw";
+        case Command::Kind::Upload: return "upload";
+        default:
+            throw idlib::unhandled_switch_case_error(__FILE__, __LINE__);
+    };
+}
+
+} // namespace Null
+} // namespace Ego
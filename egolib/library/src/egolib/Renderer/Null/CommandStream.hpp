@@ -0,0 +1,172 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/CommandStream.hpp
+/// @brief A stream of commands recorded by the null renderer.
+
+#pragma once
+
+#include "egolib/platform.h"
+#include <ostream>
+#include <vector>
+
+namespace Ego {
+namespace Null {
+
+/// @brief A command recorded by the null renderer.
+struct Command
+{
+    /// @brief The kind of a command.
+    enum class Kind
+    {
+        /// @brief A state change e.g. enabling blending.
+        StateChange,
+        /// @brief A buffer clear.
+        Clear,
+        /// @brief A texture bind or unbind.
+        Bind,
+        /// @brief A draw call.
+        Draw,
+        /// @brief An upload of pixels into a texture.
+        Upload,
+    };
+
+    /// @brief The kind of this command.
+    Kind kind;
+
+    /// @brief The name of the operation e.g. "setBlendingEnabled".
+    /// @remark Always a string literal.
+    const char *name;
+
+    /// @brief The number of vertices of a draw command, the number of Bytes of an upload command, @a 0 otherwise.
+    size_t size;
+};
+
+/// @brief A stream of commands recorded by the null renderer.
+/// @remark
+/// The counters are always maintained. The commands themselves are only stored if recording is enabled,
+/// such that long runs do not grow the stream without bounds.
+class CommandStream
+{
+public:
+    /// @brief The counters of a command stream.
+    struct Counters
+    {
+        /// @brief The number of state change commands.
+        size_t stateChanges = 0;
+
+        /// @brief The number of clear commands.
+        size_t clears = 0;
+
+        /// @brief The number of bind commands.
+        size_t binds = 0;
+
+        /// @brief The number of draw commands.
+        size_t draws = 0;
+
+        /// @brief The number of vertices drawn.
+        size_t vertices = 0;
+
+        /// @brief The number of upload commands.
+        size_t uploads = 0;
+
+        /// @brief The number of Bytes uploaded.
+        size_t bytesUploaded = 0;
+
+        /// @brief Add the counters of another command stream to these counters.
+        Counters& operator+=(const Counters& other);
+
+        /// @brief Write these counters in a line-based text format.
+        /// @param os the output stream
+        void write(std::ostream& os) const;
+    };
+
+private:
+    /// @brief If commands are stored.
+    bool m_recording;
+
+    /// @brief The stored commands.
+    std::vector<Command> m_commands;
+
+    /// @brief The counters.
+    Counters m_counters;
+
+public:
+    /// @brief Construct this command stream.
+    /// @post The stream is empty, all counters are @a 0 and recording is disabled.
+    CommandStream();
+
+    /// @brief Get if commands are stored.
+    /// @return @a true if commands are stored, @a false otherwise
+    bool isRecording() const;
+
+    /// @brief Enable/disable storing commands.
+    /// @param recording @a true enables storing commands, @a false disables it
+    void setRecording(bool recording);
+
+    /// @brief Append a command to this command stream.
+    /// @param kind the kind of the command
+    /// @param name the name of the operation
+    /// @param size the number of vertices of a draw command, the number of Bytes of an upload command, @a 0 otherwise
+    void append(Command::Kind kind, const char *name, size_t size = 0);
+
+    /// @brief Remove all commands and reset all counters.
+    void clear();
+
+    /// @brief Get the stored commands.
+    /// @return the stored commands
+    const std::vector<Command>& getCommands() const;
+
+    /// @brief Get the counters.
+    /// @return the counters
+    const Counters& getCounters() const;
+
+    /// @brief Get the number of state change commands.
+    size_t getStateChanges() const;
+
+    /// @brief Get the number of clear commands.
+    size_t getClears() const;
+
+    /// @brief Get the number of bind commands.
+    size_t getBinds() const;
+
+    /// @brief Get the number of draw commands.
+    size_t getDraws() const;
+
+    /// @brief Get the number of vertices drawn.
+    size_t getVertices() const;
+
+    /// @brief Get the number of upload commands.
+    size_t getUploads() const;
+
+    /// @brief Get the number of Bytes uploaded.
+    size_t getBytesUploaded() const;
+
+    /// @brief Write the counters and the stored commands in a line-based text format.
+    /// @param os the output stream
+    void write(std::ostream& os) const;
+
+    /// @brief Get the name of a command kind.
+    /// @param kind the command kind
+    /// @return the name of the command kind
+    static const char *toString(Command::Kind kind);
+};
+
+} // namespace Null
+} // namespace Ego
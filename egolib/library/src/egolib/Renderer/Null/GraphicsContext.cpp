@@ -0,0 +1,41 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/GraphicsContext.cpp
+/// @brief A graphics context for the null renderer.
+
+#include "egolib/Renderer/Null/GraphicsContext.hpp"
+
+namespace Ego {
+namespace Null {
+
+GraphicsContext::GraphicsContext(GraphicsWindow *window) :
+    Ego::GraphicsContext(window)
+{
+    if (!window)
+    {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "window");
+    }
+}
+
+GraphicsContext::~GraphicsContext()
+{}
+
+} // namespace Null
+} // namespace Ego
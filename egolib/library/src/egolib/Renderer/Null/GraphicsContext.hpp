@@ -0,0 +1,46 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/GraphicsContext.hpp
+/// @brief A graphics context for the null renderer.
+
+#pragma once
+
+#include "egolib/Graphics/GraphicsContext.hpp"
+
+namespace Ego {
+namespace Null {
+
+/// @brief A graphics context for the null renderer.
+/// @remark No OpenGL context is created such that the null renderer runs on machines without a GPU.
+class GraphicsContext : public Ego::GraphicsContext
+{
+public:
+    /// @brief Construct this graphics context with the specified window.
+    /// @param window a pointer to the window
+    /// @throw idlib::argument_null_error @a window is a null pointer
+    GraphicsContext(GraphicsWindow *window);
+
+    /// @brief Destruct this graphics context.
+    virtual ~GraphicsContext();
+
+}; // class GraphicsContext
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,282 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/Renderer.cpp
+/// @brief Implementation of a null renderer which records commands instead of rendering.
+
+#include "egolib/Renderer/Null/Renderer.hpp"
+#include "egolib/Renderer/Null/RendererInfo.hpp"
+#include "egolib/Renderer/Null/Texture.hpp"
+#include "egolib/vfs.h"
+#include "idlib/idlib.hpp"
+#include <sstream>
+
+namespace Ego {
+namespace Null {
+
+Renderer::Renderer() :
+    m_commandStream(),
+    m_accumulationBuffer(m_commandStream), m_colourBuffer(m_commandStream),
+    m_depthBuffer(m_commandStream), m_stencilBuffer(m_commandStream),
+    m_textureUnit(m_commandStream),
+    m_info(std::make_shared<RendererInfo>()),
+    m_lastFrameCounters(), m_totalCounters(), m_numberOfFrames(0)
+{}
+
+Renderer::~Renderer()
+{}
+
+CommandStream& Renderer::getCommandStream() {
+    return m_commandStream;
+}
+
+const CommandStream::Counters& Renderer::getLastFrameCounters() const {
+    return m_lastFrameCounters;
+}
+
+const CommandStream::Counters& Renderer::getTotalCounters() const {
+    return m_totalCounters;
+}
+
+size_t Renderer::getNumberOfFrames() const {
+    return m_numberOfFrames;
+}
+
+bool Renderer::dump(const std::string& pathname) const {
+    auto target = std::shared_ptr<vfs_FILE>(vfs_openWrite(pathname),
+                                            [](vfs_FILE *file) { if (nullptr != file) { vfs_close(file); } });
+    if (nullptr == target) {
+        return false;
+    }
+    std::ostringstream os;
+    os << "frames = " << m_numberOfFrames << std::endl;
+    os << "[total]" << std::endl;
+    m_totalCounters.write(os);
+    os << "[last frame]" << std::endl;
+    m_lastFrameCounters.write(os);
+    vfs_printf(target.get(), "%s", os.str().c_str());
+    return true;
+}
+
+std::shared_ptr<Ego::RendererInfo> Renderer::getInfo() {
+    return m_info;
+}
+
+Ego::AccumulationBuffer& Renderer::getAccumulationBuffer() {
+    return m_accumulationBuffer;
+}
+
+Ego::ColourBuffer& Renderer::getColourBuffer() {
+    return m_colourBuffer;
+}
+
+Ego::DepthBuffer& Renderer::getDepthBuffer() {
+    return m_depthBuffer;
+}
+
+Ego::StencilBuffer& Renderer::getStencilBuffer() {
+    return m_stencilBuffer;
+}
+
+Ego::TextureUnit& Renderer::getTextureUnit() {
+    return m_textureUnit;
+}
+
+void Renderer::recordStateChange(const char *name) {
+    m_commandStream.append(Command::Kind::StateChange, name);
+    m_statistics.stateChanges++;
+}
+
+void Renderer::setAlphaTestEnabled(bool enabled) {
+    recordStateChange("setAlphaTestEnabled");
+}
+
+void Renderer::setAlphaFunction(idlib::compare_function function, float value) {
+    if (value < 0.0f || value > 1.0f) {
+        throw std::invalid_argument("reference alpha value out of bounds");
+    }
+    recordStateChange("setAlphaFunction");
+}
+
+void Renderer::setBlendingEnabled(bool enabled) {
+    recordStateChange("setBlendingEnabled");
+}
+
+void Renderer::setBlendFunction(idlib::color_blend_parameter sourceColour, idlib::color_blend_parameter sourceAlpha,
+                                idlib::color_blend_parameter destinationColour, idlib::color_blend_parameter destinationAlpha) {
+    recordStateChange("setBlendFunction");
+}
+
+void Renderer::setColour(const Colour4f& colour) {
+    recordStateChange("setColour");
+}
+
+void Renderer::setCullingMode(idlib::culling_mode mode) {
+    recordStateChange("setCullingMode");
+}
+
+void Renderer::setDepthFunction(idlib::compare_function function) {
+    recordStateChange("setDepthFunction");
+}
+
+void Renderer::setDepthTestEnabled(bool enabled) {
+    recordStateChange("setDepthTestEnabled");
+}
+
+void Renderer::setDepthWriteEnabled(bool enabled) {
+    recordStateChange("setDepthWriteEnabled");
+}
+
+void Renderer::setScissorTestEnabled(bool enabled) {
+    recordStateChange("setScissorTestEnabled");
+}
+
+void Renderer::setScissorRectangle(float left, float bottom, float width, float height) {
+    if (width < 0) {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "width < 0");
+    }
+    if (height < 0) {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "height < 0");
+    }
+    recordStateChange("setScissorRectangle");
+}
+
+void Renderer::setStencilMaskBack(uint32_t mask) {
+    recordStateChange("setStencilMaskBack");
+}
+
+void Renderer::setStencilMaskFront(uint32_t mask) {
+    recordStateChange("setStencilMaskFront");
+}
+
+void Renderer::setStencilTestEnabled(bool enabled) {
+    recordStateChange("setStencilTestEnabled");
+}
+
+void Renderer::setViewportRectangle(float left, float bottom, float width, float height) {
+    if (width < 0) {
+        throw std::invalid_argument("width < 0");
+    }
+    if (height < 0) {
+        throw std::invalid_argument("height < 0");
+    }
+    recordStateChange("setViewportRectangle");
+}
+
+void Renderer::setWindingMode(idlib::winding_mode mode) {
+    recordStateChange("setWindingMode");
+}
+
+void Renderer::multiplyMatrix(const Matrix4f4f& matrix) {
+    recordStateChange("multiplyMatrix");
+}
+
+void Renderer::setPerspectiveCorrectionEnabled(bool enabled) {
+    recordStateChange("setPerspectiveCorrectionEnabled");
+}
+
+void Renderer::setDitheringEnabled(bool enabled) {
+    recordStateChange("setDitheringEnabled");
+}
+
+void Renderer::setPointSmoothEnabled(bool enabled) {
+    recordStateChange("setPointSmoothEnabled");
+}
+
+void Renderer::setLineSmoothEnabled(bool enabled) {
+    recordStateChange("setLineSmoothEnabled");
+}
+
+void Renderer::setLineWidth(float width) {
+    recordStateChange("setLineWidth");
+}
+
+void Renderer::setPointSize(float size) {
+    recordStateChange("setPointSize");
+}
+
+void Renderer::setPolygonSmoothEnabled(bool enabled) {
+    recordStateChange("setPolygonSmoothEnabled");
+}
+
+void Renderer::setMultisamplesEnabled(bool enabled) {
+    recordStateChange("setMultisamplesEnabled");
+}
+
+void Renderer::setLightingEnabled(bool enabled) {
+    recordStateChange("setLightingEnabled");
+}
+
+void Renderer::setRasterizationMode(idlib::rasterization_mode mode) {
+    recordStateChange("setRasterizationMode");
+}
+
+void Renderer::setGouraudShadingEnabled(bool enabled) {
+    recordStateChange("setGouraudShadingEnabled");
+}
+
+void Renderer::render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_descriptor& vertexDescriptor, idlib::primitive_type primitiveType, size_t index, size_t length) {
+    if (vertexDescriptor.get_size() != vertexBuffer.vertex_size()) {
+        throw std::invalid_argument("vertex size mismatch");
+    }
+    if (index + length > vertexBuffer.number_of_vertices()) {
+        throw std::invalid_argument("out of bounds");
+    }
+    m_commandStream.append(Command::Kind::Draw, "render", length);
+    m_statistics.draws++;
+}
+
+std::shared_ptr<Ego::Texture> Renderer::createTexture() {
+    return std::make_shared<Texture>(this);
+}
+
+bool Renderer::isDirectRenderingEnabled() const {
+    return false;
+}
+
+void Renderer::countDirectDraw(const char *name, size_t length) {
+    this->Ego::Renderer::countDirectDraw(name, length);
+    m_commandStream.append(Command::Kind::Draw, name, length);
+}
+
+void Renderer::endFrame() {
+    this->Ego::Renderer::endFrame();
+    m_lastFrameCounters = m_commandStream.getCounters();
+    m_totalCounters += m_lastFrameCounters;
+    m_numberOfFrames++;
+    m_commandStream.clear();
+}
+
+void Renderer::setProjectionMatrix(const Matrix4f4f& projectionMatrix) {
+    this->Ego::Renderer::setProjectionMatrix(projectionMatrix);
+    recordStateChange("setProjectionMatrix");
+}
+
+void Renderer::setViewMatrix(const Matrix4f4f& viewMatrix) {
+    this->Ego::Renderer::setViewMatrix(viewMatrix);
+    recordStateChange("setViewMatrix");
+}
+
+void Renderer::setWorldMatrix(const Matrix4f4f& worldMatrix) {
+    this->Ego::Renderer::setWorldMatrix(worldMatrix);
+    recordStateChange("setWorldMatrix");
+}
+
+} // namespace Null
+} // namespace Ego
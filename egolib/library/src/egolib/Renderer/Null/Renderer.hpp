@@ -0,0 +1,252 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/Renderer.hpp
+/// @brief Implementation of a null renderer which records commands instead of rendering.
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/Buffers.hpp"
+#include "egolib/Renderer/Null/CommandStream.hpp"
+#include "egolib/Renderer/Null/TextureUnit.hpp"
+
+namespace Ego {
+namespace Null {
+
+// Forward declaration.
+class RendererInfo;
+
+/// @brief A renderer which does not require a GPU.
+/// @remark
+/// All operations validate their arguments like the OpenGL renderer and are recorded in a command stream,
+/// such that the CPU side of rendering can be profiled and benchmarked on machines without a GPU.
+/// Code issuing OpenGL commands directly skips them as direct rendering is disabled, but counts its draws
+/// via countDirectDraw such that the command stream covers the terrain and model draws, too.
+class Renderer : public Ego::Renderer
+{
+public:
+    // Befriend with the create functor.
+    friend RendererCreateFunctor;
+
+protected:
+    /// @brief The command stream.
+    /// @remark Must be declared before the facades.
+    CommandStream m_commandStream;
+
+    /// @brief The accumulation buffer facade.
+    AccumulationBuffer m_accumulationBuffer;
+
+    /// @brief The colour buffer facade.
+    ColourBuffer m_colourBuffer;
+
+    /// @brief The depth buffer facade.
+    DepthBuffer m_depthBuffer;
+
+    /// @brief The stencil buffer facade.
+    StencilBuffer m_stencilBuffer;
+
+    /// @brief The texture unit facade.
+    TextureUnit m_textureUnit;
+
+    /// @brief Information on the renderer.
+    std::shared_ptr<RendererInfo> m_info;
+
+    /// @brief The counters of the command stream in the last completed frame.
+    CommandStream::Counters m_lastFrameCounters;
+
+    /// @brief The counters of the command stream in all completed frames.
+    CommandStream::Counters m_totalCounters;
+
+    /// @brief The number of completed frames.
+    size_t m_numberOfFrames;
+
+public:
+    /// @brief Construct this null renderer.
+    Renderer();
+
+    /// @brief Destruct this null renderer.
+    virtual ~Renderer();
+
+    /// @brief Get the command stream of this renderer.
+    /// @return the command stream
+    /// @remark The command stream holds the commands of the current frame only.
+    CommandStream& getCommandStream();
+
+    /// @brief Get the counters of the command stream in the last completed frame.
+    /// @return the counters of the last completed frame
+    const CommandStream::Counters& getLastFrameCounters() const;
+
+    /// @brief Get the counters of the command stream in all completed frames.
+    /// @return the counters of all completed frames
+    const CommandStream::Counters& getTotalCounters() const;
+
+    /// @brief Get the number of completed frames.
+    /// @return the number of completed frames
+    size_t getNumberOfFrames() const;
+
+    /// @brief Write the number of completed frames, the counters of all completed frames
+    /// and the counters of the last completed frame to a file.
+    /// @param pathname the pathname of the file
+    /// @return @a true on success, @a false on failure
+    bool dump(const std::string& pathname) const;
+
+public:
+    /** @copydoc Ego::Renderer::getInfo() */
+    virtual std::shared_ptr<Ego::RendererInfo> getInfo() override;
+
+public:
+    /** @copydoc Ego::Renderer::getAccumulationBuffer() */
+    virtual Ego::AccumulationBuffer& getAccumulationBuffer() override;
+
+    /** @copydoc Ego::Renderer::getColourBuffer */
+    virtual Ego::ColourBuffer& getColourBuffer() override;
+
+    /** @copydoc Ego::Renderer::getDepthBuffer() */
+    virtual Ego::DepthBuffer& getDepthBuffer() override;
+
+    /** @copydoc Ego::Renderer::getStencilBuffer() */
+    virtual Ego::StencilBuffer& getStencilBuffer() override;
+
+    /** @copydoc Ego::Renderer::getTextureUnit() */
+    virtual Ego::TextureUnit& getTextureUnit() override;
+
+    /** @copydoc Ego::Renderer::setAlphaTestEnabled */
+    virtual void setAlphaTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setAlphaFunction */
+    virtual void setAlphaFunction(idlib::compare_function function, float value) override;
+
+    /** @copydoc Ego::Renderer::setBlendingEnabled */
+    virtual void setBlendingEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setBlendFunction */
+    virtual void setBlendFunction(idlib::color_blend_parameter sourceColour, idlib::color_blend_parameter sourceAlpha,
+                                  idlib::color_blend_parameter destinationColour, idlib::color_blend_parameter destinationAlpha) override;
+
+    /** @copydoc Ego::Renderer::setColour */
+    virtual void setColour(const Colour4f& colour) override;
+
+    /** @copydoc Ego::Renderer::setCullingMode */
+    virtual void setCullingMode(idlib::culling_mode mode) override;
+
+    /** @copydoc Ego::Renderer::setDepthFunction */
+    virtual void setDepthFunction(idlib::compare_function function) override;
+
+    /** @copydoc Ego::Renderer::setDepthTestEnabled */
+    virtual void setDepthTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setDepthWriteEnabled */
+    virtual void setDepthWriteEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setScissorTestEnabled */
+    virtual void setScissorTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setScissorRectangle */
+    virtual void setScissorRectangle(float left, float bottom, float width, float height) override;
+
+    /** @copydoc Ego::Renderer::setStencilMaskBack */
+    virtual void setStencilMaskBack(uint32_t mask) override;
+
+    /** @copydoc Ego::Renderer::setStencilMaskFront */
+    virtual void setStencilMaskFront(uint32_t mask) override;
+
+    /** @copydoc Ego::Renderer::setStencilTestEnabled */
+    virtual void setStencilTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setViewportRectangle */
+    virtual void setViewportRectangle(float left, float bottom, float width, float height) override;
+
+    /** @copydoc Ego::Renderer::setWindingMode */
+    virtual void setWindingMode(idlib::winding_mode mode) override;
+
+    /** @copydoc Ego::Renderer::multiplyMatrix */
+    virtual void multiplyMatrix(const Matrix4f4f& matrix) override;
+
+    /** @copydoc Ego::Renderer::setPerspectiveCorrectionEnabled */
+    virtual void setPerspectiveCorrectionEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setDitheringEnabled */
+    virtual void setDitheringEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setPointSmoothEnabled */
+    virtual void setPointSmoothEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setLineSmoothEnabled */
+    virtual void setLineSmoothEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setLineWidth */
+    virtual void setLineWidth(float width) override;
+
+    /** @copydoc Ego::Renderer::setPointSize */
+    virtual void setPointSize(float size) override;
+
+    /** @copydoc Ego::Renderer::setPolygonSmoothEnabled */
+    virtual void setPolygonSmoothEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setMultisamplesEnabled */
+    virtual void setMultisamplesEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setLightingEnabled */
+    virtual void setLightingEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setRasterizationMode */
+    virtual void setRasterizationMode(idlib::rasterization_mode mode) override;
+
+    /** @copydoc Ego::Renderer::setGouraudShadingEnabled */
+    virtual void setGouraudShadingEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::render */
+    virtual void render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_descriptor& vertexDescriptor, idlib::primitive_type primitiveType, size_t index, size_t length) override;
+
+    /** @copydoc Ego::Renderer::createTexture */
+    virtual std::shared_ptr<Ego::Texture> createTexture() override;
+
+    /// @copydoc Ego::Renderer::isDirectRenderingEnabled
+    /// @remark The null renderer has no OpenGL context, hence direct rendering is disabled.
+    virtual bool isDirectRenderingEnabled() const override;
+
+    /// @copydoc Ego::Renderer::countDirectDraw
+    /// @remark A draw command is appended to the command stream.
+    virtual void countDirectDraw(const char *name, size_t length) override;
+
+    /// @copydoc Ego::Renderer::endFrame
+    /// @remark The counters of the command stream become the counters of the last frame
+    /// and are added to the counters of all frames, then the command stream is cleared.
+    virtual void endFrame() override;
+
+public:
+    /** @copydoc Ego::Renderer::setProjectionMatrix */
+    void setProjectionMatrix(const Matrix4f4f& projectionMatrix) override;
+
+    /** @copydoc Ego::Renderer::setViewMatrix */
+    void setViewMatrix(const Matrix4f4f& viewMatrix) override;
+
+    /** @copydoc Ego::Renderer::setWorldMatrix */
+    void setWorldMatrix(const Matrix4f4f& worldMatrix) override;
+
+private:
+    /// @brief Record a state change.
+    /// @param name the name of the operation
+    void recordStateChange(const char *name);
+
+}; // class Renderer
+
+} // namespace Null
+} // namespace Ego
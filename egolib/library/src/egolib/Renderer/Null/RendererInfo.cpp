@@ -0,0 +1,84 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/RendererInfo.cpp
+/// @brief Information on the null renderer.
+
+#include "egolib/Renderer/Null/RendererInfo.hpp"
+
+namespace Ego {
+namespace Null {
+
+RendererInfo::RendererInfo() :
+    Ego::RendererInfo()
+{}
+
+RendererInfo::~RendererInfo()
+{}
+
+std::string RendererInfo::getRenderer() const
+{
+    return "null renderer";
+}
+
+std::string RendererInfo::getVendor() const
+{
+    return "Egoboo";
+}
+
+std::string RendererInfo::getVersion() const
+{
+    return "1.0";
+}
+
+bool RendererInfo::isAnisotropySupported() const noexcept
+{
+    return false;
+}
+
+float RendererInfo::getMinimumSupportedAnisotropy() const noexcept
+{
+    return std::numeric_limits<float>::quiet_NaN();
+}
+
+float RendererInfo::getMaximumSupportedAnisotropy() const noexcept
+{
+    return std::numeric_limits<float>::quiet_NaN();
+}
+
+int RendererInfo::getMaximumTextureSize() const noexcept
+{
+    return 8192;
+}
+
+std::string RendererInfo::toString() const
+{
+    std::ostringstream os;
+    os << "Null" << std::endl
+       << "  version    = " << getVersion() << std::endl
+       << "  vendor     = " << getVendor() << std::endl
+       << "  renderer   = " << getRenderer() << std::endl;
+    os << "maximum texture size = " << getMaximumTextureSize() << std::endl;
+    os << "anisotropy supported = " << isAnisotropySupported() << std::endl;
+    os << std::endl;
+    return os.str();
+}
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,66 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/RendererInfo.hpp
+/// @brief Information on the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/RendererInfo.hpp"
+
+namespace Ego {
+namespace Null {
+
+/// @brief Information on the null renderer.
+class RendererInfo : public Ego::RendererInfo
+{
+public:
+    /// @brief Construct this renderer info.
+    RendererInfo();
+
+    /// @brief Destruct this renderer info.
+    virtual ~RendererInfo();
+
+    /// @copydoc Ego::RendererInfo::getRenderer
+    std::string getRenderer() const override;
+
+    /// @copydoc Ego::RendererInfo::getVendor
+    std::string getVendor() const override;
+
+    /// @copydoc Ego::RendererInfo::getVersion
+    std::string getVersion() const override;
+
+    /// @copydoc Ego::RendererInfo::isAnisotropySupported
+    bool isAnisotropySupported() const noexcept override;
+
+    /// @copydoc Ego::RendererInfo::getMinimumSupportedAnisotropy
+    float getMinimumSupportedAnisotropy() const noexcept override;
+
+    /// @copydoc Ego::RendererInfo::getMaximumSupportedAnisostropy
+    float getMaximumSupportedAnisotropy() const noexcept override;
+
+    /// @copydoc Ego::RendererInfo::getMaximumTextureSize
+    int getMaximumTextureSize() const noexcept override;
+
+    /// @copydoc Ego::RendererInfo::toString
+    std::string toString() const override;
+};
+
+} // namespace Null
+} // namespace Ego
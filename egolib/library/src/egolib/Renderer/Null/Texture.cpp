@@ -0,0 +1,153 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/Texture.cpp
+/// @brief Implementation of a texture for the null renderer.
+
+#include "egolib/Renderer/Null/Texture.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
+#include "egolib/Image/ImageManager.hpp"
+
+namespace Ego {
+namespace Null {
+
+Texture::Texture(Renderer *renderer) :
+    Ego::Texture
+    (
+        "<default texture 2D>",
+        idlib::texture_type::_2D,
+        getDefaultSampler(),
+        ImageManager::get().getDefaultImage()->w, ImageManager::get().getDefaultImage()->h,
+        ImageManager::get().getDefaultImage()->w, ImageManager::get().getDefaultImage()->h,
+        nullptr,
+        false
+    ),
+    m_renderer(renderer), m_isDefault(true)
+{}
+
+Texture::~Texture()
+{}
+
+idlib::texture_sampler Texture::getDefaultSampler()
+{
+    return idlib::texture_sampler(idlib::texture_filter_method::nearest, idlib::texture_filter_method::nearest,
+                                  idlib::texture_filter_method::none, idlib::texture_address_mode::repeat,
+                                  idlib::texture_address_mode::repeat, 1.0f);
+}
+
+idlib::texture_sampler Texture::getDesiredSampler()
+{
+    auto info = Ego::Renderer::get().getInfo();
+    return idlib::texture_sampler(info->getDesiredMinimizationFilter(),
+                                  info->getDesiredMaximizationFilter(),
+                                  info->getDesiredMipMapFilter(),
+                                  idlib::texture_address_mode::repeat, idlib::texture_address_mode::repeat,
+                                  info->getDesiredAnisotropy());
+}
+
+void Texture::load(const std::string& name, const std::shared_ptr<const TexturePixels>& pixels, const std::shared_ptr<SDL_Surface>& source, idlib::texture_type type, const idlib::texture_sampler& sampler)
+{
+    release();
+    if (!pixels || pixels->levels.empty())
+    {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "pixels");
+    }
+    // Record the upload of all levels the OpenGL renderer would upload.
+    const bool withMipmaps = idlib::texture_type::_2D == type
+                          && idlib::texture_filter_method::none != sampler.mip_filter_method();
+    size_t size = 0;
+    for (const auto& level : pixels->levels)
+    {
+        size += level.pixels.size();
+        if (!withMipmaps) break;
+    }
+    m_renderer->getCommandStream().append(Command::Kind::Upload, "Texture::load", size);
+
+    const auto& base = pixels->levels.front();
+    m_sampler = sampler;
+    m_type = type;
+    m_width = base.width;
+    m_height = base.height;
+    m_source = source;
+    m_sourceWidth = pixels->sourceWidth;
+    m_sourceHeight = pixels->sourceHeight;
+    m_hasAlpha = pixels->hasAlpha;
+    m_name = name;
+    m_isDefault = false;
+}
+
+bool Texture::load(const std::string& name, const std::shared_ptr<const TexturePixels>& pixels)
+{
+    if (!pixels || pixels->levels.empty())
+    {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "pixels");
+    }
+    auto type = ((1 == pixels->sourceHeight) && (pixels->sourceWidth > 1)) ? idlib::texture_type::_1D : idlib::texture_type::_2D;
+    load(name, pixels, pixels->createSource(), type, getDesiredSampler());
+    return true;
+}
+
+bool Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>& source)
+{
+    if (!source)
+    {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "source");
+    }
+    auto sampler = getDesiredSampler();
+    auto type = ((1 == source->h) && (source->w > 1)) ? idlib::texture_type::_1D : idlib::texture_type::_2D;
+    // Convert, pad and compute the mipmaps as the OpenGL renderer does, such that the CPU cost is the same.
+    bool withMipmaps = idlib::texture_type::_2D == type
+                    && idlib::texture_filter_method::none != sampler.mip_filter_method();
+    load(name, TexturePixels::create(source, withMipmaps), source, type, sampler);
+    return true;
+}
+
+bool Texture::load(const std::shared_ptr<SDL_Surface>& source)
+{
+    std::ostringstream stream;
+    stream << "<source " << static_cast<void *>(source.get()) << ">";
+    return load(stream.str(), source);
+}
+
+void Texture::release()
+{
+    if (isDefault())
+    {
+        return;
+    }
+    auto image = ImageManager::get().getDefaultImage();
+    m_type = idlib::texture_type::_2D;
+    m_sampler = getDefaultSampler();
+    m_width = image->w;
+    m_height = image->h;
+    m_sourceWidth = image->w;
+    m_sourceHeight = image->h;
+    m_source = nullptr;
+    m_name = "<default texture 2D>";
+    m_hasAlpha = false;
+    m_isDefault = true;
+}
+
+bool Texture::isDefault() const
+{
+    return m_isDefault;
+}
+
+} // namespace Null
+} // namespace Ego
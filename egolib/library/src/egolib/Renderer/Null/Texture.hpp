@@ -0,0 +1,83 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/Texture.hpp
+/// @brief Implementation of a texture for the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Texture.hpp"
+
+namespace Ego {
+namespace Null {
+
+class Renderer;
+
+/// @brief A texture of the null renderer.
+/// @remark The pixels are converted and padded as by the OpenGL renderer but are not kept.
+class Texture : public Ego::Texture
+{
+protected:
+    /// @brief The renderer owning this texture.
+    Renderer *m_renderer;
+
+    /// @brief @a true if this texture is the default texture, @a false otherwise.
+    bool m_isDefault;
+
+public:
+    /// @brief Construct this texture.
+    /// @post This texture is the default texture.
+    Texture(Renderer *renderer);
+
+    /// @brief Destruct this texture.
+    virtual ~Texture();
+
+    /// @brief Load pixels into this texture.
+    /// @param name the name of the texture
+    /// @param pixels the pixels
+    /// @param source the source surface of the pixels
+    /// @param type the texture type
+    /// @param sampler the texture sampler
+    void load(const std::string& name, const std::shared_ptr<const TexturePixels>& pixels, const std::shared_ptr<SDL_Surface>& source, idlib::texture_type type, const idlib::texture_sampler& sampler);
+
+    /** @override Ego::Texture::load(const std::string&, const std::shared_ptr<const TexturePixels>&) */
+    bool load(const std::string& name, const std::shared_ptr<const TexturePixels>& pixels) override;
+
+    /** @override Ego::Texture::load(const String& name, const SharedPtr<SDL_Surface>&) */
+    bool load(const std::string& name, const std::shared_ptr<SDL_Surface>& surface) override;
+
+    /** @override Ego::Texture::load(const std::shared_ptr<SDL_Surface>&) */
+    bool load(const std::shared_ptr<SDL_Surface>& surface) override;
+
+    /** @override Ego::Texture::release */
+    void release() override;
+
+    /** @override Ego::Texture::isDefault */
+    bool isDefault() const override;
+
+private:
+    /// @brief Get the sampler a texture is loaded with.
+    static idlib::texture_sampler getDesiredSampler();
+
+    /// @brief Get the sampler of the default texture.
+    static idlib::texture_sampler getDefaultSampler();
+};
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,47 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/Null/TextureUnit.cpp
+/// @brief Implementation of a texture unit facade for the null renderer.
+
+#include "egolib/Renderer/Null/TextureUnit.hpp"
+
+namespace Ego {
+namespace Null {
+
+TextureUnit::TextureUnit(CommandStream& commandStream) :
+    m_commandStream(commandStream), m_texture(nullptr)
+{}
+
+TextureUnit::~TextureUnit()
+{}
+
+void TextureUnit::setActivated(const Ego::Texture *texture)
+{
+    m_texture = texture;
+    m_commandStream.append(Command::Kind::Bind, texture ? "TextureUnit::setActivated" : "TextureUnit::setDeactivated");
+}
+
+const Ego::Texture *TextureUnit::getActivated() const
+{
+    return m_texture;
+}
+
+} // namespace Null
+} // namespace Ego
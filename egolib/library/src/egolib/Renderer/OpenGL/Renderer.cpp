@@ -32,8 +32,9 @@ namespace Ego {
 namespace OpenGL {
 
 Renderer::Renderer(const std::shared_ptr<RendererInfo>& info) :
-    m_info(info), m_textureUnit(info)
+    m_stateCache(), m_info(info), m_textureUnit(info, *this)
 {
+    StateCache::setActive(&m_stateCache);
     try
     {
         m_defaultTexture1d = std::make_unique<DefaultTexture>(m_info, "<default texture 1D>", idlib::texture_type::_1D);
@@ -49,6 +50,7 @@ Renderer::Renderer(const std::shared_ptr<RendererInfo>& info) :
     }
     catch (...)
     {
+        StateCache::setActive(nullptr);
         std::rethrow_exception(std::current_exception());
     }
 }
@@ -61,6 +63,51 @@ Renderer::~Renderer()
 {
     m_defaultTexture2d = nullptr;
     m_defaultTexture1d = nullptr;
+    if (&m_stateCache == StateCache::getActive())
+    {
+        StateCache::setActive(nullptr);
+    }
+}
+
+Renderer::ErrorCheckMode Renderer::getErrorCheckMode() const {
+    return m_stateCache.checkErrorsPerCall ? ErrorCheckMode::PerCall : ErrorCheckMode::PerFrame;
+}
+
+void Renderer::setErrorCheckMode(ErrorCheckMode errorCheckMode) {
+    m_stateCache.checkErrorsPerCall = (ErrorCheckMode::PerCall == errorCheckMode);
+}
+
+void Renderer::endFrame() {
+    if (!m_stateCache.checkErrorsPerCall) {
+        Utilities::isError();
+    }
+    this->Ego::Renderer::endFrame();
+}
+
+void Renderer::checkError() {
+    m_stateCache.checkError();
+}
+
+void Renderer::setEnabled(StateCache::Entry<bool>& entry, GLenum capability, bool enabled) {
+    if (!update(entry, enabled)) {
+        return;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+void Renderer::setClientStateEnabled(StateCache::Entry<bool>& entry, GLenum capability, bool enabled) {
+    if (!update(entry, enabled)) {
+        return;
+    }
+    if (enabled) {
+        glEnableClientState(capability);
+    } else {
+        glDisableClientState(capability);
+    }
 }
 
 std::shared_ptr<Ego::RendererInfo> Renderer::getInfo() {
@@ -88,138 +135,148 @@ Ego::TextureUnit& Renderer::getTextureUnit() {
 }
 
 void Renderer::setAlphaTestEnabled(bool enabled) {
-    if (enabled) {
-        glEnable(GL_ALPHA_TEST);
-    } else {
-        glDisable(GL_ALPHA_TEST);
-    }
-    Utilities::isError();
+    setEnabled(m_stateCache.alphaTestEnabled, GL_ALPHA_TEST, enabled);
+    checkError();
 }
 
 void Renderer::setAlphaFunction(idlib::compare_function function, float value) {
     if (value < 0.0f || value > 1.0f) {
         throw std::invalid_argument("reference alpha value out of bounds");
     }
+    GLenum function_gl;
     switch (function) {
         case idlib::compare_function::always_fail:
-            glAlphaFunc(GL_NEVER, value);
+            function_gl = GL_NEVER;
             break;
         case idlib::compare_function::always_pass:
-            glAlphaFunc(GL_ALWAYS, value);
+            function_gl = GL_ALWAYS;
             break;
         case idlib::compare_function::equal:
-            glAlphaFunc(GL_EQUAL, value);
+            function_gl = GL_EQUAL;
             break;
         case idlib::compare_function::not_equal:
-            glAlphaFunc(GL_NOTEQUAL, value);
+            function_gl = GL_NOTEQUAL;
             break;
         case idlib::compare_function::less:
-            glAlphaFunc(GL_LESS, value);
+            function_gl = GL_LESS;
             break;
         case idlib::compare_function::less_or_equal:
-            glAlphaFunc(GL_LEQUAL, value);
+            function_gl = GL_LEQUAL;
             break;
         case idlib::compare_function::greater:
-            glAlphaFunc(GL_GREATER, value);
+            function_gl = GL_GREATER;
             break;
         case idlib::compare_function::greater_or_equal:
-            glAlphaFunc(GL_GEQUAL, value);
+            function_gl = GL_GEQUAL;
             break;
         default:
             throw idlib::unhandled_switch_case_error(__FILE__, __LINE__);
     };
-    Utilities::isError();
+    if (update(m_stateCache.alphaFunction, std::make_pair(function_gl, value))) {
+        glAlphaFunc(function_gl, value);
+    }
+    checkError();
 }
 
 void Renderer::setBlendingEnabled(bool enabled) {
-    if (enabled) {
-        glEnable(GL_BLEND);
-    } else {
-        glDisable(GL_BLEND);
-    }
-    Utilities::isError();
+    setEnabled(m_stateCache.blendingEnabled, GL_BLEND, enabled);
+    checkError();
 }
 
 void Renderer::setBlendFunction(idlib::color_blend_parameter sourceColour, idlib::color_blend_parameter sourceAlpha,
                                 idlib::color_blend_parameter destinationColour, idlib::color_blend_parameter destinationAlpha) {
-    glBlendFuncSeparate(toOpenGL(sourceColour), toOpenGL(destinationColour),
-                        toOpenGL(sourceAlpha), toOpenGL(destinationAlpha));
-    Utilities::isError();
+    const std::array<GLenum, 4> blendFunction = { toOpenGL(sourceColour), toOpenGL(destinationColour),
+                                                  toOpenGL(sourceAlpha), toOpenGL(destinationAlpha) };
+    if (update(m_stateCache.blendFunction, blendFunction)) {
+        glBlendFuncSeparate(blendFunction[0], blendFunction[1], blendFunction[2], blendFunction[3]);
+    }
+    checkError();
 }
 
 void Renderer::setColour(const Colour4f& colour) {
-    glColor4f(colour.get_r(), colour.get_g(),
-              colour.get_b(), colour.get_a());
-    Utilities::isError();
+    const std::array<float, 4> colour_gl = { colour.get_r(), colour.get_g(),
+                                             colour.get_b(), colour.get_a() };
+    if (update(m_stateCache.colour, colour_gl)) {
+        glColor4fv(colour_gl.data());
+    }
+    checkError();
 }
 
 void Renderer::setCullingMode(idlib::culling_mode mode) {
     switch (mode) {
 		case idlib::culling_mode::none:
-            glDisable(GL_CULL_FACE);
+            setEnabled(m_stateCache.cullingEnabled, GL_CULL_FACE, false);
             break;
 		case idlib::culling_mode::front:
-            glEnable(GL_CULL_FACE);
-            glCullFace(GL_FRONT);
+            setEnabled(m_stateCache.cullingEnabled, GL_CULL_FACE, true);
+            if (update(m_stateCache.cullFace, GLenum(GL_FRONT))) {
+                glCullFace(GL_FRONT);
+            }
             break;
 		case idlib::culling_mode::back:
-            glEnable(GL_CULL_FACE);
-            glCullFace(GL_BACK);
+            setEnabled(m_stateCache.cullingEnabled, GL_CULL_FACE, true);
+            if (update(m_stateCache.cullFace, GLenum(GL_BACK))) {
+                glCullFace(GL_BACK);
+            }
             break;
 		case idlib::culling_mode::back_and_front:
-            glEnable(GL_CULL_FACE);
-            glCullFace(GL_FRONT_AND_BACK);
+            setEnabled(m_stateCache.cullingEnabled, GL_CULL_FACE, true);
+            if (update(m_stateCache.cullFace, GLenum(GL_FRONT_AND_BACK))) {
+                glCullFace(GL_FRONT_AND_BACK);
+            }
             break;
         default:
             throw idlib::unhandled_switch_case_error(__FILE__, __LINE__);
     };
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setDepthFunction(idlib::compare_function function) {
+    GLenum function_gl;
     switch (function) {
         case idlib::compare_function::always_fail:
-            glDepthFunc(GL_NEVER);
+            function_gl = GL_NEVER;
             break;
         case idlib::compare_function::always_pass:
-            glDepthFunc(GL_ALWAYS);
+            function_gl = GL_ALWAYS;
             break;
         case idlib::compare_function::less:
-            glDepthFunc(GL_LESS);
+            function_gl = GL_LESS;
             break;
         case idlib::compare_function::less_or_equal:
-            glDepthFunc(GL_LEQUAL);
+            function_gl = GL_LEQUAL;
             break;
         case idlib::compare_function::equal:
-            glDepthFunc(GL_EQUAL);
+            function_gl = GL_EQUAL;
             break;
         case idlib::compare_function::not_equal:
-            glDepthFunc(GL_NOTEQUAL);
+            function_gl = GL_NOTEQUAL;
             break;
         case idlib::compare_function::greater_or_equal:
-            glDepthFunc(GL_GEQUAL);
+            function_gl = GL_GEQUAL;
             break;
         case idlib::compare_function::greater:
-            glDepthFunc(GL_GREATER);
+            function_gl = GL_GREATER;
             break;
         default:
             throw idlib::unhandled_switch_case_error(__FILE__, __LINE__);
     };
-    Utilities::isError();
+    if (update(m_stateCache.depthFunction, function_gl)) {
+        glDepthFunc(function_gl);
+    }
+    checkError();
 }
 
 void Renderer::setDepthTestEnabled(bool enabled) {
-    if (enabled) {
-        glEnable(GL_DEPTH_TEST);
-    } else {
-        glDisable(GL_DEPTH_TEST);
-    }
-    Utilities::isError();
+    setEnabled(m_stateCache.depthTestEnabled, GL_DEPTH_TEST, enabled);
+    checkError();
 }
 
 void Renderer::setDepthWriteEnabled(bool enabled) {
-    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
-    Utilities::isError();
+    if (update(m_stateCache.depthWriteEnabled, enabled)) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+    checkError();
 }
 
 void Renderer::setScissorRectangle(float left, float bottom, float width, float height) {
@@ -230,37 +287,29 @@ void Renderer::setScissorRectangle(float left, float bottom, float width, float
         throw idlib::invalid_argument_error(__FILE__, __LINE__, "height < 0");
     }
     glScissor(left, bottom, width, height);
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setScissorTestEnabled(bool enabled) {
-    if (enabled) {
-        glEnable(GL_SCISSOR_TEST);
-    } else {
-        glDisable(GL_SCISSOR_TEST);
-    }
-    Utilities::isError();
+    setEnabled(m_stateCache.scissorTestEnabled, GL_SCISSOR_TEST, enabled);
+    checkError();
 }
 
 void Renderer::setStencilMaskBack(uint32_t mask) {
     static_assert(sizeof(GLint) >= sizeof(uint32_t), "GLint is smaller than uint32_t");
     glStencilMaskSeparate(GL_BACK, mask);
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setStencilMaskFront(uint32_t mask) {
     static_assert(sizeof(GLint) >= sizeof(uint32_t), "GLint is smaller than uint32_t");
     glStencilMaskSeparate(GL_FRONT, mask);
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setStencilTestEnabled(bool enabled) {
-    if (enabled) {
-        glEnable(GL_STENCIL_TEST);
-    } else {
-        glDisable(GL_STENCIL_TEST);
-    }
-    Utilities::isError();
+    setEnabled(m_stateCache.stencilTestEnabled, GL_STENCIL_TEST, enabled);
+    checkError();
 }
 
 void Renderer::setViewportRectangle(float left, float bottom, float width, float height) {
@@ -271,21 +320,25 @@ void Renderer::setViewportRectangle(float left, float bottom, float width, float
         throw std::invalid_argument("height < 0");
     }
     glViewport(left, bottom, width, height);
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setWindingMode(idlib::winding_mode mode) {
     switch (mode) {
 		case idlib::winding_mode::clockwise:
-            glFrontFace(GL_CW);
+            if (update(m_stateCache.frontFace, GLenum(GL_CW))) {
+                glFrontFace(GL_CW);
+            }
             break;
 		case idlib::winding_mode::anti_clockwise:
-            glFrontFace(GL_CCW);
+            if (update(m_stateCache.frontFace, GLenum(GL_CCW))) {
+                glFrontFace(GL_CCW);
+            }
             break;
         default:
             throw idlib::unhandled_switch_case_error(__FILE__, __LINE__);
     }
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::multiplyMatrix(const Matrix4f4f& matrix) {
@@ -297,7 +350,7 @@ void Renderer::multiplyMatrix(const Matrix4f4f& matrix) {
         }
     }
     glMultMatrixf(t);
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setPerspectiveCorrectionEnabled(bool enabled) {
@@ -306,7 +359,7 @@ void Renderer::setPerspectiveCorrectionEnabled(bool enabled) {
     } else {
         glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_FASTEST);
     }
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setDitheringEnabled(bool enabled) {
@@ -317,7 +370,7 @@ void Renderer::setDitheringEnabled(bool enabled) {
         glHint(GL_GENERATE_MIPMAP_HINT, GL_FASTEST);
         glDisable(GL_DITHER);
     }
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setPointSmoothEnabled(bool enabled) {
@@ -327,7 +380,7 @@ void Renderer::setPointSmoothEnabled(bool enabled) {
     } else {
         glDisable(GL_POINT_SMOOTH);
     }
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setLineSmoothEnabled(bool enabled) {
@@ -337,17 +390,17 @@ void Renderer::setLineSmoothEnabled(bool enabled) {
     } else {
         glDisable(GL_LINE_SMOOTH);
     }
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setLineWidth(float width) {
     glLineWidth(width);
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setPointSize(float size) {
     glPointSize(size);
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setPolygonSmoothEnabled(bool enabled) {
@@ -357,7 +410,7 @@ void Renderer::setPolygonSmoothEnabled(bool enabled) {
     } else {
         glDisable(GL_POLYGON_SMOOTH);
     }
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setMultisamplesEnabled(bool enabled) {
@@ -377,40 +430,41 @@ void Renderer::setMultisamplesEnabled(bool enabled) {
             glDisable(GL_MULTISAMPLE);
         }
     }
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setLightingEnabled(bool enabled) {
-    if (enabled) {
-        glEnable(GL_LIGHTING);
-    } else {
-        glDisable(GL_LIGHTING);
-    }
-    Utilities::isError();
+    setEnabled(m_stateCache.lightingEnabled, GL_LIGHTING, enabled);
+    checkError();
 }
 
 void Renderer::setRasterizationMode(idlib::rasterization_mode mode) {
     switch (mode) {
         case idlib::rasterization_mode::point:
-            glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+            if (update(m_stateCache.polygonMode, GLenum(GL_POINT))) {
+                glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+            }
             break;
         case idlib::rasterization_mode::line:
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+            if (update(m_stateCache.polygonMode, GLenum(GL_LINE))) {
+                glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+            }
             break;
         case idlib::rasterization_mode::solid:
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+            if (update(m_stateCache.polygonMode, GLenum(GL_FILL))) {
+                glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+            }
             break;
     }
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setGouraudShadingEnabled(bool enabled) {
-    if (enabled) {
-        glShadeModel(GL_SMOOTH);
-    } else {
-        glShadeModel(GL_FLAT);
+    const GLenum shadeModel = enabled ? GL_SMOOTH : GL_FLAT;
+    if (update(m_stateCache.shadeModel, shadeModel)) {
+        glShadeModel(shadeModel);
     }
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_descriptor& vertexDescriptor, idlib::primitive_type primitiveType, size_t index, size_t length) {
@@ -418,10 +472,9 @@ void Renderer::render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_de
     {
         throw std::invalid_argument("vertex size mismatch");
     }
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
+    // The client-side capabilities required by the vertex format.
+    bool vertexArrayEnabled = false, colourArrayEnabled = false,
+         normalArrayEnabled = false, textureCoordinateArrayEnabled = false;
     const char *vertices = static_cast<char *>(vertexBuffer.lock());
     for (auto it = vertexDescriptor.begin(); it != vertexDescriptor.end(); ++it) {
         const auto& vertexElementDescriptor = (*it);
@@ -429,7 +482,7 @@ void Renderer::render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_de
         case idlib::vertex_component_semantics::POSITION:
             {
                 // Enable the required client-side capabilities.
-                glEnableClientState(GL_VERTEX_ARRAY);
+                vertexArrayEnabled = true;
                 // Set the pointers.
                 GLint size;
                 GLenum type;
@@ -459,7 +512,7 @@ void Renderer::render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_de
             case idlib::vertex_component_semantics::COLOR:
             {
                 // Enable required client-side capabilities.
-                glEnableClientState(GL_COLOR_ARRAY);
+                colourArrayEnabled = true;
                 // Set the pointers.
                 GLint size;
                 GLenum type;
@@ -485,7 +538,7 @@ void Renderer::render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_de
             case idlib::vertex_component_semantics::NORMAL:
             {
                 // Enable the required client-side capabilities.
-                glEnableClientState(GL_NORMAL_ARRAY);
+                normalArrayEnabled = true;
                 // Set the pointers.
                 GLenum type;
                 switch (vertexElementDescriptor.get_syntactics()) {
@@ -506,7 +559,7 @@ void Renderer::render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_de
             case idlib::vertex_component_semantics::TEXTURE:
             {
                 // Enable the required client-side capabilities.
-                glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+                textureCoordinateArrayEnabled = true;
                 // Set the pointers.
                 GLint size;
                 GLenum type;
@@ -542,12 +595,19 @@ void Renderer::render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_de
     if (index + length > vertexBuffer.number_of_vertices()) {
         throw std::invalid_argument("out of bounds");
     }
-    // Disable the enabled client-side capabilities again. 
+    // Enable the required and disable the other client-side capabilities.
+    // The client-side capabilities stay enabled such that consecutive draws with the same vertex format do not change them.
+    setClientStateEnabled(m_stateCache.vertexArrayEnabled, GL_VERTEX_ARRAY, vertexArrayEnabled);
+    setClientStateEnabled(m_stateCache.colourArrayEnabled, GL_COLOR_ARRAY, colourArrayEnabled);
+    setClientStateEnabled(m_stateCache.normalArrayEnabled, GL_NORMAL_ARRAY, normalArrayEnabled);
+    setClientStateEnabled(m_stateCache.textureCoordinateArrayEnabled, GL_TEXTURE_COORD_ARRAY, textureCoordinateArrayEnabled);
     glDrawArrays(primitiveType_gl, index, length);
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
+    m_statistics.draws++;
+    if (colourArrayEnabled) {
+        // The current colour is undefined after drawing with a colour array.
+        m_stateCache.colour.valid = false;
+    }
+    checkError();
 }
 
 std::array<float, 16> Renderer::toOpenGL(const Matrix4f4f& source) {
@@ -590,12 +650,16 @@ std::shared_ptr<Ego::Texture> Renderer::createTexture() {
     return std::make_shared<Texture>(this);
 }
 
+bool Renderer::isDirectRenderingEnabled() const {
+    return true;
+}
+
 void Renderer::setProjectionMatrix(const Matrix4f4f& projectionMatrix) {
     this->Ego::Renderer::setProjectionMatrix(projectionMatrix);
     glMatrixMode(GL_PROJECTION);
     auto matrix = projectionMatrix;
     glLoadMatrixf(toOpenGL(matrix).data());
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setViewMatrix(const Matrix4f4f& viewMatrix) {
@@ -604,7 +668,7 @@ void Renderer::setViewMatrix(const Matrix4f4f& viewMatrix) {
     // model -> world, world -> view
     auto matrix = getViewMatrix() * getWorldMatrix();
     glLoadMatrixf(toOpenGL(matrix).data());
-    Utilities::isError();
+    checkError();
 }
 
 void Renderer::setWorldMatrix(const Matrix4f4f& worldMatrix) {
@@ -613,7 +677,7 @@ void Renderer::setWorldMatrix(const Matrix4f4f& worldMatrix) {
     // model -> world, world -> view
     auto matrix = getViewMatrix() * getWorldMatrix();
     glLoadMatrixf(toOpenGL(matrix).data());
-    Utilities::isError();
+    checkError();
 }
 
 } // namespace OpenGL
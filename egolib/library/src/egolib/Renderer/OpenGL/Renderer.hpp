@@ -29,6 +29,7 @@
 #include "egolib/Renderer/OpenGL/ColourBuffer.hpp"
 #include "egolib/Renderer/OpenGL/DepthBuffer.hpp"
 #include "egolib/Renderer/OpenGL/StencilBuffer.hpp"
+#include "egolib/Renderer/OpenGL/StateCache.hpp"
 #include "egolib/Renderer/OpenGL/TextureUnit.hpp"
 #include "egolib/platform.h"
 #include "egolib/Math/_Include.hpp"
@@ -47,6 +48,17 @@ class Renderer : public Ego::Renderer
 public:
 	// Befriend with the create functor.
 	friend RendererCreateFunctor;
+    // Befriend with the texture unit facade.
+    friend class Ego::OpenGL::TextureUnit;
+
+    /// @brief When OpenGL errors are checked.
+    enum class ErrorCheckMode
+    {
+        /// @brief OpenGL errors are checked after each call.
+        PerCall,
+        /// @brief OpenGL errors are checked once per frame in Ego::OpenGL::Renderer::endFrame.
+        PerFrame,
+    };
 
     /// @brief Unique pointer to the 1D default texture.
     std::unique_ptr<DefaultTexture> m_defaultTexture1d;
@@ -54,7 +66,11 @@ public:
     /// @brief Unique pointer to the 2D default texture.
     std::unique_ptr<DefaultTexture> m_defaultTexture2d;
 
-protected:  
+protected:
+    /// @brief The shadow of the OpenGL state.
+    /// @remark Must be declared before the facades.
+    StateCache m_stateCache;
+
     /// @brief The accumulation buffer facade.
     AccumulationBuffer m_accumulationBuffer;
     
@@ -85,6 +101,20 @@ public:
     /// @brief Destruct this OpenGL renderer.
     virtual ~Renderer();
 
+public:
+    /// @brief Get the error check mode.
+    /// @return the error check mode
+    /// @remark The default is Ego::OpenGL::Renderer::ErrorCheckMode::PerCall in debug builds
+    /// and Ego::OpenGL::Renderer::ErrorCheckMode::PerFrame otherwise.
+    ErrorCheckMode getErrorCheckMode() const;
+
+    /// @brief Set the error check mode.
+    /// @param errorCheckMode the error check mode
+    void setErrorCheckMode(ErrorCheckMode errorCheckMode);
+
+    /** @copydoc Ego::Renderer::endFrame */
+    void endFrame() override;
+
 public:
     /** @copydoc Ego::Renderer::getInfo() */
     virtual std::shared_ptr<Ego::RendererInfo> getInfo() override;
@@ -197,6 +227,9 @@ public:
     /** @copydoc Ego::Renderer::createTexture */
     virtual std::shared_ptr<Ego::Texture> createTexture() override;
 
+    /** @copydoc Ego::Renderer::isDirectRenderingEnabled */
+    virtual bool isDirectRenderingEnabled() const override;
+
 public:
     /** @copydoc Ego::Renderer::setProjectionMatrix */
     void setProjectionMatrix(const Matrix4f4f& projectionMatrix) override;
@@ -208,6 +241,29 @@ public:
     void setWorldMatrix(const Matrix4f4f& worldMatrix) override;
 
 private:
+    /// @brief Update an entry of the state cache and count the state change.
+    /// @return @a true if the state must be set, @a false if the state change is redundant
+    template <typename Type>
+    bool update(StateCache::Entry<Type>& entry, const Type& value)
+    {
+        if (entry.update(value))
+        {
+            m_statistics.stateChanges++;
+            return true;
+        }
+        m_statistics.redundantStateChanges++;
+        return false;
+    }
+
+    /// @brief Enable/disable a server-side capability unless the change is redundant.
+    void setEnabled(StateCache::Entry<bool>& entry, GLenum capability, bool enabled);
+
+    /// @brief Enable/disable a client-side capability unless the change is redundant.
+    void setClientStateEnabled(StateCache::Entry<bool>& entry, GLenum capability, bool enabled);
+
+    /// @brief Check for OpenGL errors if errors are checked after each call.
+    void checkError();
+
     std::array<float, 16> toOpenGL(const Matrix4f4f& source);
     GLenum toOpenGL(idlib::color_blend_parameter source);
 
@@ -0,0 +1,198 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/OpenGL/StateCache.cpp
+/// @brief A shadow of the OpenGL state to skip redundant state changes.
+
+#include "egolib/Renderer/OpenGL/StateCache.hpp"
+#include "egolib/Renderer/OpenGL/Utilities.hpp"
+
+namespace Ego {
+namespace OpenGL {
+
+namespace {
+
+/// @brief The state cache of the active OpenGL renderer.
+StateCache *g_active = nullptr;
+
+/// @brief Invalidate an entry or restore it from a saved entry.
+template <typename Type>
+void reset(StateCache::Entry<Type>& target, const StateCache::Entry<Type> *source)
+{
+    if (source)
+    {
+        target = *source;
+    }
+    else
+    {
+        target.valid = false;
+    }
+}
+
+/// @brief Invalidate the entries of the specified attribute groups or restore them from a saved state cache.
+/// @param saved a pointer to the saved state cache or a null pointer
+void reset(StateCache& self, const StateCache *saved, GLbitfield mask)
+{
+#define RESET(NAME) reset(self.NAME, saved ? &(saved->NAME) : nullptr)
+    if (mask & (GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT))
+    {
+        RESET(alphaTestEnabled);
+        RESET(blendingEnabled);
+    }
+    if (mask & GL_COLOR_BUFFER_BIT)
+    {
+        RESET(alphaFunction);
+        RESET(blendFunction);
+    }
+    if (mask & GL_CURRENT_BIT)
+    {
+        RESET(colour);
+    }
+    if (mask & (GL_ENABLE_BIT | GL_POLYGON_BIT))
+    {
+        RESET(cullingEnabled);
+    }
+    if (mask & GL_POLYGON_BIT)
+    {
+        RESET(cullFace);
+        RESET(frontFace);
+        RESET(polygonMode);
+    }
+    if (mask & (GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT))
+    {
+        RESET(depthTestEnabled);
+    }
+    if (mask & GL_DEPTH_BUFFER_BIT)
+    {
+        RESET(depthFunction);
+        RESET(depthWriteEnabled);
+    }
+    if (mask & (GL_ENABLE_BIT | GL_SCISSOR_BIT))
+    {
+        RESET(scissorTestEnabled);
+    }
+    if (mask & (GL_ENABLE_BIT | GL_STENCIL_BUFFER_BIT))
+    {
+        RESET(stencilTestEnabled);
+    }
+    if (mask & (GL_ENABLE_BIT | GL_LIGHTING_BIT))
+    {
+        RESET(lightingEnabled);
+    }
+    if (mask & GL_LIGHTING_BIT)
+    {
+        RESET(shadeModel);
+    }
+    if (mask & (GL_ENABLE_BIT | GL_TEXTURE_BIT))
+    {
+        RESET(texture1dEnabled);
+        RESET(texture2dEnabled);
+    }
+    if (mask & GL_TEXTURE_BIT)
+    {
+        // The attribute stack also restores the parameters of the bound texture objects:
+        // Invalidate the bindings such that the texture unit re-applies the samplers.
+        self.texture1d.valid = false;
+        self.texture2d.valid = false;
+    }
+#undef RESET
+}
+
+/// @brief Invalidate the entries of the specified client attribute groups or restore them from a saved state cache.
+/// @param saved a pointer to the saved state cache or a null pointer
+void resetClient(StateCache& self, const StateCache *saved, GLbitfield mask)
+{
+#define RESET(NAME) reset(self.NAME, saved ? &(saved->NAME) : nullptr)
+    if (mask & GL_CLIENT_VERTEX_ARRAY_BIT)
+    {
+        RESET(vertexArrayEnabled);
+        RESET(colourArrayEnabled);
+        RESET(normalArrayEnabled);
+        RESET(textureCoordinateArrayEnabled);
+    }
+#undef RESET
+}
+
+} // namespace
+
+StateCache::StateCache() :
+#if defined(_DEBUG)
+    checkErrorsPerCall(true)
+#else
+    checkErrorsPerCall(false)
+#endif
+{}
+
+bool StateCache::checkError() const
+{
+    return checkErrorsPerCall && Utilities2::isError();
+}
+
+void StateCache::invalidate(GLbitfield mask)
+{
+    reset(*this, nullptr, mask);
+}
+
+void StateCache::invalidateClient(GLbitfield mask)
+{
+    resetClient(*this, nullptr, mask);
+}
+
+void StateCache::restore(const StateCache& saved, GLbitfield mask)
+{
+    reset(*this, &saved, mask);
+}
+
+void StateCache::restoreClient(const StateCache& saved, GLbitfield mask)
+{
+    resetClient(*this, &saved, mask);
+}
+
+void StateCache::invalidateTexture(GLuint id)
+{
+    if (texture1d.valid && id == texture1d.value)
+    {
+        texture1d.valid = false;
+    }
+    if (texture2d.valid && id == texture2d.value)
+    {
+        texture2d.valid = false;
+    }
+}
+
+StateCache *StateCache::getActive()
+{
+    return g_active;
+}
+
+void StateCache::setActive(StateCache *stateCache)
+{
+    g_active = stateCache;
+}
+
+void StateCache::invalidateActive(GLbitfield mask)
+{
+    if (g_active)
+    {
+        g_active->invalidate(mask);
+    }
+}
+
+} // namespace OpenGL
+} // namespace Ego
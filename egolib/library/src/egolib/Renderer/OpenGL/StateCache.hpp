@@ -0,0 +1,139 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/OpenGL/StateCache.hpp
+/// @brief A shadow of the OpenGL state to skip redundant state changes.
+
+#pragma once
+
+#include "egolib/platform.h"
+#include <array>
+#include <utility>
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+namespace Ego {
+namespace OpenGL {
+
+/// @brief A shadow of the OpenGL state set through the renderer.
+/// @remark
+/// Each entry is either valid, i.e. it is known to be equal to the OpenGL state, or invalid.
+/// An entry becomes valid when the state is set through the renderer and becomes invalid if
+/// the state is modified behind the back of the renderer. OpenGL attribute stack pops restore
+/// the entries saved at the time of the push (see Ego::OpenGL::PushAttrib).
+struct StateCache
+{
+    /// @brief An entry of the state cache.
+    template <typename Type>
+    struct Entry
+    {
+        Type value;
+        bool valid;
+
+        Entry() : value(), valid(false) {}
+
+        /// @brief Update this entry.
+        /// @param value the new value
+        /// @return @a true if the value changed (or was unknown) and the state must be set, @a false otherwise
+        bool update(const Type& value)
+        {
+            if (valid && this->value == value)
+            {
+                return false;
+            }
+            this->value = value;
+            valid = true;
+            return true;
+        }
+    };
+
+    Entry<bool> alphaTestEnabled;
+    Entry<std::pair<GLenum, float>> alphaFunction;
+    Entry<bool> blendingEnabled;
+    Entry<std::array<GLenum, 4>> blendFunction;
+    Entry<std::array<float, 4>> colour;
+    Entry<bool> cullingEnabled;
+    Entry<GLenum> cullFace;
+    Entry<GLenum> depthFunction;
+    Entry<bool> depthTestEnabled;
+    Entry<bool> depthWriteEnabled;
+    Entry<bool> scissorTestEnabled;
+    Entry<bool> stencilTestEnabled;
+    Entry<GLenum> frontFace;
+    Entry<bool> lightingEnabled;
+    Entry<GLenum> polygonMode;
+    Entry<GLenum> shadeModel;
+    Entry<bool> texture1dEnabled;
+    Entry<bool> texture2dEnabled;
+    Entry<GLuint> texture1d;
+    Entry<GLuint> texture2d;
+    Entry<bool> vertexArrayEnabled;
+    Entry<bool> colourArrayEnabled;
+    Entry<bool> normalArrayEnabled;
+    Entry<bool> textureCoordinateArrayEnabled;
+
+    /// @brief @a true if OpenGL errors are checked after each call, @a false if they are checked once per frame.
+    bool checkErrorsPerCall;
+
+    /// @brief Construct this state cache.
+    /// @post All entries are invalid.
+    StateCache();
+
+    /// @brief Check for OpenGL errors if errors are checked after each call.
+    /// @return @a true if an error was detected, @a false otherwise
+    bool checkError() const;
+
+    /// @brief Invalidate the entries of the specified attribute groups.
+    /// @param mask a bitmask of OpenGL server attribute group bits e.g. @a GL_CURRENT_BIT
+    void invalidate(GLbitfield mask);
+
+    /// @brief Invalidate the entries of the specified client attribute groups.
+    /// @param mask a bitmask of OpenGL client attribute group bits e.g. @a GL_CLIENT_VERTEX_ARRAY_BIT
+    void invalidateClient(GLbitfield mask);
+
+    /// @brief Restore the entries of the specified attribute groups from a saved state cache.
+    /// @param saved the saved state cache
+    /// @param mask a bitmask of OpenGL server attribute group bits
+    void restore(const StateCache& saved, GLbitfield mask);
+
+    /// @brief Restore the entries of the specified client attribute groups from a saved state cache.
+    /// @param saved the saved state cache
+    /// @param mask a bitmask of OpenGL client attribute group bits
+    void restoreClient(const StateCache& saved, GLbitfield mask);
+
+    /// @brief Invalidate the bindings of a texture if it is bound.
+    /// @param id the OpenGL texture ID
+    void invalidateTexture(GLuint id);
+
+public:
+    /// @brief Get the state cache of the active OpenGL renderer.
+    /// @return a pointer to the state cache if an OpenGL renderer is active, a null pointer otherwise
+    static StateCache *getActive();
+
+    /// @brief Set the state cache of the active OpenGL renderer.
+    static void setActive(StateCache *stateCache);
+
+    /// @brief Invalidate entries of the state cache of the active OpenGL renderer (if any).
+    /// @param mask a bitmask of OpenGL server attribute group bits e.g. @a GL_CURRENT_BIT
+    /// @remark Invoke after modifying OpenGL state directly i.e. not through the renderer.
+    static void invalidateActive(GLbitfield mask);
+};
+
+} // namespace OpenGL
+} // namespace Ego
@@ -92,16 +92,23 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
         throw idlib::argument_null_error(__FILE__, __LINE__, "surface");
     }
 
-    std::shared_ptr<SDL_Surface> newSurface = surface;
+    // Convert, pad and compute the mipmaps if required.
+    bool withMipmaps = idlib::texture_type::_2D == type
+                    && idlib::texture_filter_method::none != sampler.mip_filter_method();
+    load(name, TexturePixels::create(surface, withMipmaps), surface, type, sampler);
+}
 
-    // Convert to RGBA if the image has non-opaque alpha values or alpha modulation and convert to RGB otherwise.
-    bool hasAlpha = SDL::testAlpha(newSurface.get());
-    const auto& pixel_format = hasAlpha ? pixel_descriptor::get<idlib::pixel_format::R8G8B8A8>()
-                                        : pixel_descriptor::get<idlib::pixel_format::R8G8B8>();
-    newSurface = convert(newSurface, pixel_format);
+void Texture::load(const std::string& name, const std::shared_ptr<const TexturePixels>& pixels, const std::shared_ptr<SDL_Surface>& source, idlib::texture_type type, const idlib::texture_sampler& sampler)
+{
+    // Bind this texture to the backing error texture.
+    release();
 
-    // Convert to power of two.
-    newSurface = idlib::power_of_two(newSurface);
+    if (!pixels || pixels->levels.empty())
+    {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "pixels");
+    }
+    const auto& pixel_format = pixels->getPixelDescriptor();
+    const auto& base = pixels->levels.front();
 
     // (1)Generate a new OpenGL texture ID.
     Utilities::clearError();
@@ -128,6 +135,8 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
         }
     };
     glBindTexture(target_gl, id);
+    // The texture binding of the renderer is overridden.
+    StateCache::invalidateActive(GL_TEXTURE_BIT);
     if (Utilities::isError())
     {
         glDeleteTextures(1, &id);
@@ -150,17 +159,17 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
         {
             if (idlib::texture_filter_method::none != sampler.mip_filter_method())
             {
-                Utilities2::upload_2d_mipmap(pixel_format, newSurface->w, newSurface->h, newSurface->pixels);
+                Utilities2::upload_2d_mipmap(*pixels);
             }
             else
             {
-                Utilities2::upload_2d(pixel_format, newSurface->w, newSurface->h, newSurface->pixels);
+                Utilities2::upload_2d(pixel_format, base.width, base.height, base.pixels.data());
             }
         }
         break;
         case idlib::texture_type::_1D:
         {
-            Utilities2::upload_1d(pixel_format, newSurface->w, newSurface->pixels);
+            Utilities2::upload_1d(pixel_format, base.width, base.pixels.data());
         }
         break;
         default:
@@ -175,12 +184,12 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
     m_sampler = sampler;
     m_type = type;
     m_id = id;
-    m_width = newSurface->w;
-    m_height = newSurface->h;
-    m_source = surface;
-    m_sourceWidth = surface->w;
-    m_sourceHeight = surface->h;
-    m_hasAlpha = hasAlpha;
+    m_width = base.width;
+    m_height = base.height;
+    m_source = source;
+    m_sourceWidth = pixels->sourceWidth;
+    m_sourceHeight = pixels->sourceHeight;
+    m_hasAlpha = pixels->hasAlpha;
     m_name = name;
 }
 
@@ -199,6 +208,34 @@ bool Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
     return true;
 }
 
+bool Texture::load(const std::string& name, const std::shared_ptr<const TexturePixels>& pixels)
+{
+    if (!pixels || pixels->levels.empty())
+    {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "pixels");
+    }
+    auto info = Ego::Renderer::get().getInfo();
+    // Determine the texture sampler.
+    idlib::texture_sampler sampler(info->getDesiredMinimizationFilter(),
+                                   info->getDesiredMaximizationFilter(),
+                                   info->getDesiredMipMapFilter(),
+                                   idlib::texture_address_mode::repeat, idlib::texture_address_mode::repeat,
+                                   info->getDesiredAnisotropy());
+    // Determine the texture type.
+    auto type = ((1 == pixels->sourceHeight) && (pixels->sourceWidth > 1)) ? idlib::texture_type::_1D : idlib::texture_type::_2D;
+    auto source = pixels->createSource();
+    // If mipmaps are desired but not provided, compute them.
+    const auto& base = pixels->levels.front();
+    if (idlib::texture_type::_2D == type && idlib::texture_filter_method::none != sampler.mip_filter_method()
+        && !pixels->hasMipmaps() && !(1 == base.width && 1 == base.height))
+    {
+        load(name, source, type, sampler);
+        return true;
+    }
+    load(name, pixels, source, type, sampler);
+    return true;
+}
+
 bool Texture::load(const std::shared_ptr<SDL_Surface>& source)
 {
     std::ostringstream stream;
@@ -215,6 +252,10 @@ void  Texture::release()
 
     // Delete the OpenGL texture and assign the error texture.
     glDeleteTextures(1, &(m_id));
+    if (auto stateCache = StateCache::getActive())
+    {
+        stateCache->invalidateTexture(m_id);
+    }
     Utilities::isError();
 
     // Delete the source if it exists
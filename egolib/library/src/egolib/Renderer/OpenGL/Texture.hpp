@@ -42,6 +42,14 @@ protected:
 
 public:
 	void load(const std::string& name, const std::shared_ptr<SDL_Surface>& surface, idlib::texture_type type, const idlib::texture_sampler& sampler);
+
+	/// @brief Upload GPU-ready pixels.
+	/// @param source the source surface of the pixels
+	void load(const std::string& name, const std::shared_ptr<const TexturePixels>& pixels, const std::shared_ptr<SDL_Surface>& source, idlib::texture_type type, const idlib::texture_sampler& sampler);
+
+    /** @override Ego::Texture::load(const std::string&, const std::shared_ptr<const TexturePixels>&) */
+	bool load(const std::string& name, const std::shared_ptr<const TexturePixels>& pixels) override;
+
     /** @override Ego::Texture::load(const String& name, const SharedPtr<SDL_Surface>&) */
 	bool load(const std::string& name, const std::shared_ptr<SDL_Surface>& surface) override;
 
@@ -25,12 +25,13 @@
 #include "egolib/Renderer/OpenGL/Texture.hpp"
 #include "egolib/Renderer/OpenGL/Utilities.hpp"
 #include "egolib/Renderer/OpenGL/RendererInfo.hpp"
+#include "egolib/Renderer/OpenGL/Renderer.hpp"
 
 namespace Ego {
 namespace OpenGL {
 
-TextureUnit::TextureUnit(const std::shared_ptr<RendererInfo>& info) :
-    m_info(info)
+TextureUnit::TextureUnit(const std::shared_ptr<RendererInfo>& info, Renderer& renderer) :
+    m_info(info), m_renderer(renderer)
 {}
 
 TextureUnit::~TextureUnit()
@@ -38,46 +39,61 @@ TextureUnit::~TextureUnit()
 
 void TextureUnit::setActivated(Texture *texture)
 {
+    auto& stateCache = m_renderer.m_stateCache;
     if (!texture)
     {
-        glDisable(GL_TEXTURE_1D);
-        glDisable(GL_TEXTURE_2D);
+        m_renderer.setEnabled(stateCache.texture1dEnabled, GL_TEXTURE_1D, false);
+        m_renderer.setEnabled(stateCache.texture2dEnabled, GL_TEXTURE_2D, false);
     }
     else
     {
-        Utilities::clearError();
         GLenum target_gl;
+        StateCache::Entry<GLuint> *binding;
         switch (texture->getType())
         {
             case idlib::texture_type::_2D:
-                glEnable(GL_TEXTURE_2D);
-                glDisable(GL_TEXTURE_1D);
+                m_renderer.setEnabled(stateCache.texture2dEnabled, GL_TEXTURE_2D, true);
+                m_renderer.setEnabled(stateCache.texture1dEnabled, GL_TEXTURE_1D, false);
                 target_gl = GL_TEXTURE_2D;
+                binding = &stateCache.texture2d;
                 break;
             case idlib::texture_type::_1D:
-                glEnable(GL_TEXTURE_1D);
-                glDisable(GL_TEXTURE_2D);
+                m_renderer.setEnabled(stateCache.texture1dEnabled, GL_TEXTURE_1D, true);
+                m_renderer.setEnabled(stateCache.texture2dEnabled, GL_TEXTURE_2D, false);
                 target_gl = GL_TEXTURE_1D;
+                binding = &stateCache.texture1d;
                 break;
             default:
                 throw std::runtime_error("unreachable code reached");
         }
-        if (Utilities::isError())
+        if (stateCache.checkError())
         {
             return;
         }
-        glBindTexture(target_gl, texture->getId());
-        if (Utilities::isError())
+        // If the binding is unknown, the parameters of the texture object might be unknown as well.
+        const bool wasValid = binding->valid;
+        if (m_renderer.update(*binding, texture->getId()))
         {
-            return;
+            glBindTexture(target_gl, texture->getId());
+            if (stateCache.checkError())
+            {
+                binding->valid = false;
+                return;
+            }
         }
-        Utilities2::setSampler(m_info, texture->getType(), texture->getSampler());
-        if (Utilities::isError())
+        // The sampler is stored in the texture object: Only set it if it has changed.
+        // Default textures share their texture object, hence their sampler is always set.
+        if (!wasValid || texture->m_isSamplerDirty || texture->isDefault())
         {
-            return;
+            Utilities2::setSampler(m_info, texture->getType(), texture->getSampler());
+            if (stateCache.checkError())
+            {
+                return;
+            }
+            texture->m_isSamplerDirty = false;
         }
     }
-    Utilities::isError();
+    m_renderer.checkError();
 }
 
 void TextureUnit::setActivated(const Ego::Texture *texture)
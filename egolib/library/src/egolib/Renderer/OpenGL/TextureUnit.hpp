@@ -28,16 +28,20 @@ namespace Ego {
 namespace OpenGL {
 
 class Texture;
+class Renderer;
 class RendererInfo;
 
 class TextureUnit : public Ego::TextureUnit
 {
 private:
     std::shared_ptr<RendererInfo> m_info;
+    /// @brief The renderer owning this texture unit facade.
+    Renderer& m_renderer;
 public:
     /// @brief Construct this texture unit facade.
     /// @param info pointer to the render device information
-    TextureUnit(const std::shared_ptr<RendererInfo>& info);
+    /// @param renderer the renderer owning this texture unit facade
+    TextureUnit(const std::shared_ptr<RendererInfo>& info, Renderer& renderer);
 
     /// @brief Destruct this texture unit facade.
     virtual ~TextureUnit();
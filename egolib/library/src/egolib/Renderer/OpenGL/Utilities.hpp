@@ -2,6 +2,7 @@
 
 #include "egolib/integrations/video.hpp"
 #include "egolib/Graphics/PixelFormat.hpp"
+#include "egolib/Renderer/TexturePixels.hpp"
 #define GLEW_STATIC
 #include <GL/glew.h>
 
@@ -100,11 +101,9 @@ public:
     /// @param data a pointer to the pixels
     static void upload_2d(const pixel_descriptor& pfd, GLsizei w, GLsizei h, const void *data);
     
-    /// @brief Upload a 2D texture generating the mipmaps.
-    /// @param pdf the pixel descriptor describing the format of a pixels
-    /// @param w, h the width and height of the pixel rectangle
-    /// @param data a pointer to the pixels
-    static void upload_2d_mipmap(const pixel_descriptor& pfd, GLsizei w, GLsizei h, const void *data);
+    /// @brief Upload a 2D texture including its mipmaps.
+    /// @param pixels the texture pixels. If the pixels have no mipmaps, only the base level is uploaded.
+    static void upload_2d_mipmap(const TexturePixels& pixels);
 
     static void toOpenGL(idlib::texture_filter_method minFilter, idlib::texture_filter_method magFilter, idlib::texture_filter_method mipMapFilter, GLint& minFilter_gl, GLint& magFilter_gl);
 
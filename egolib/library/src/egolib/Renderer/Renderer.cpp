@@ -23,12 +23,19 @@
 
 #include "egolib/Renderer/Renderer.hpp"
 #include "egolib/Renderer/OpenGL/Renderer.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
 
 namespace Ego
 {
 
 Renderer *RendererCreateFunctor::operator()() const
-{ return new Ego::OpenGL::Renderer(); }
+{
+    if (egoboo_config_t::get().debug_nullRenderer_enable.getValue())
+    {
+        return new Ego::Null::Renderer();
+    }
+    return new Ego::OpenGL::Renderer();
+}
 
 void RendererDestroyFunctor::operator()(Renderer *p) const
 { delete p; }
@@ -64,7 +71,8 @@ TextureUnit::~TextureUnit()
 {}
 
 Renderer::Renderer()
-    : m_projectionMatrix(idlib::perspective_projection_matrix(Degrees(45.0f), 4.0f/3.0f, +0.1f, +1.0f)),
+    : m_statistics(), m_lastFrameStatistics(),
+      m_projectionMatrix(idlib::perspective_projection_matrix(Degrees(45.0f), 4.0f/3.0f, +0.1f, +1.0f)),
       m_viewMatrix(idlib::identity<Matrix4f4f>()), m_worldMatrix(idlib::identity<Matrix4f4f>())
 {
     idlib::video_buffer_manager::initialize();
@@ -85,6 +93,23 @@ void Renderer::download(egoboo_config_t& cfg)
     /* Nothing to do. */
 }
 
+const Renderer::Statistics& Renderer::getStatistics() const {
+    return m_statistics;
+}
+
+const Renderer::Statistics& Renderer::getLastFrameStatistics() const {
+    return m_lastFrameStatistics;
+}
+
+void Renderer::countDirectDraw(const char *name, size_t length) {
+    m_statistics.draws++;
+}
+
+void Renderer::endFrame() {
+    m_lastFrameStatistics = m_statistics;
+    m_statistics = Statistics();
+}
+
 void Renderer::setProjectionMatrix(const Matrix4f4f& projectionMatrix) {
     m_projectionMatrix = projectionMatrix;
 }
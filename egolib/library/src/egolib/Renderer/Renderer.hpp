@@ -500,6 +500,52 @@ public:
     /// @post The texture is the default texture.
     virtual std::shared_ptr<Texture> createTexture() = 0;
 
+    /// @brief Get if OpenGL commands may be issued directly, bypassing this renderer.
+    /// @return @a true if this renderer renders into an OpenGL context, @a false otherwise
+    /// @remark Code issuing OpenGL commands directly must skip them if this is @a false.
+    virtual bool isDirectRenderingEnabled() const = 0;
+
+    /// @brief Count a draw call issued directly via OpenGL, bypassing this renderer.
+    /// @param name the name of the draw call
+    /// @param length the number of vertices drawn
+    /// @remark Invoke for each direct draw call, also if it is skipped because direct rendering is disabled,
+    /// such that the statistics of this renderer cover all draw calls of a frame.
+    virtual void countDirectDraw(const char *name, size_t length);
+
+public:
+    /// @brief Per-frame statistics of a renderer.
+    struct Statistics
+    {
+        /// @brief The number of state changes passed to the back-end.
+        size_t stateChanges;
+        /// @brief The number of state changes skipped because they were redundant.
+        size_t redundantStateChanges;
+        /// @brief The number of draw calls.
+        size_t draws;
+
+        Statistics() : stateChanges(0), redundantStateChanges(0), draws(0) {}
+    };
+
+    /// @brief Get the statistics of the current frame.
+    /// @return the statistics of the current frame
+    const Statistics& getStatistics() const;
+
+    /// @brief Get the statistics of the last completed frame.
+    /// @return the statistics of the last completed frame
+    const Statistics& getLastFrameStatistics() const;
+
+    /// @brief Notify the renderer that a frame is complete.
+    /// @remark Invoke once per frame before the buffers are swapped.
+    /// The statistics of the current frame become the statistics of the last frame and are reset.
+    virtual void endFrame();
+
+protected:
+    /// @brief The statistics of the current frame.
+    Statistics m_statistics;
+
+    /// @brief The statistics of the last completed frame.
+    Statistics m_lastFrameStatistics;
+
 private:
     Matrix4f4f m_projectionMatrix;
     Matrix4f4f m_viewMatrix;
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "egolib/Image/Image.hpp"
+#include "egolib/Renderer/TexturePixels.hpp"
 #include <string>
 #include <memory>
 
@@ -178,6 +179,14 @@ public:
 	virtual bool load(const std::string& name, const std::shared_ptr<SDL_Surface>& surface) = 0;
 	virtual bool load(const std::shared_ptr<SDL_Surface>& image) = 0;
 
+	/**
+	 * @brief
+	 *  Load GPU-ready pixels into this texture.
+	 * @remark
+	 *  Conversion and padding are skipped. The mipmaps of the pixels are used if available.
+	 */
+	virtual bool load(const std::string& name, const std::shared_ptr<const TexturePixels>& pixels) = 0;
+
 	/**
 	 * @brief
 	 *  Delete backing image, delete OpenGL ID, assign OpenGL ID of the error texture, assign no backing image.
@@ -0,0 +1,134 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/TexturePixels.cpp
+/// @brief GPU-ready pixels of a texture.
+
+#include "egolib/Renderer/TexturePixels.hpp"
+#include "egolib/Image/ImageManager.hpp"
+#include "egolib/Image/SDL_Image_Extensions.h"
+
+namespace Ego {
+
+/// @brief Copy the pixels of a surface into a tightly packed level.
+static TexturePixels::Level copyLevel(SDL_Surface *surface, size_t bytesPerPixel)
+{
+    TexturePixels::Level level;
+    level.width = surface->w;
+    level.height = surface->h;
+    const size_t rowLength = level.width * bytesPerPixel;
+    level.pixels.resize(rowLength * level.height);
+    if (SDL_MUSTLOCK(surface)) SDL_LockSurface(surface);
+    for (int y = 0; y < level.height; ++y)
+    {
+        const uint8_t *source = static_cast<const uint8_t *>(surface->pixels) + y * surface->pitch;
+        std::memcpy(level.pixels.data() + y * rowLength, source, rowLength);
+    }
+    if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+    return level;
+}
+
+TexturePixels::TexturePixels() :
+    hasAlpha(false), sourceWidth(0), sourceHeight(0), levels()
+{}
+
+const pixel_descriptor& TexturePixels::getPixelDescriptor() const
+{
+    return hasAlpha ? pixel_descriptor::get<idlib::pixel_format::R8G8B8A8>()
+                    : pixel_descriptor::get<idlib::pixel_format::R8G8B8>();
+}
+
+size_t TexturePixels::getBytesPerPixel() const
+{
+    return getPixelDescriptor().get_color_depth().depth() / 8;
+}
+
+bool TexturePixels::hasMipmaps() const
+{
+    return levels.size() > 1;
+}
+
+std::shared_ptr<TexturePixels> TexturePixels::create(const std::shared_ptr<SDL_Surface>& surface, bool withMipmaps)
+{
+    if (!surface)
+    {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "surface");
+    }
+    auto pixels = std::make_shared<TexturePixels>();
+
+    // Convert to RGBA if the image has non-opaque alpha values or alpha modulation and convert to RGB otherwise.
+    pixels->hasAlpha = SDL::testAlpha(surface.get());
+    pixels->sourceWidth = surface->w;
+    pixels->sourceHeight = surface->h;
+    const auto& pfd = pixels->getPixelDescriptor();
+    const size_t bytesPerPixel = pixels->getBytesPerPixel();
+    auto base = convert(surface, pfd);
+
+    // Convert to power of two.
+    base = idlib::power_of_two(base);
+    pixels->levels.push_back(copyLevel(base.get(), bytesPerPixel));
+
+    if (!withMipmaps)
+    {
+        return pixels;
+    }
+
+    // Compute the mipmap levels down to 1 x 1.
+    int width = base->w, height = base->h;
+    while (!(width == 1 && height == 1))
+    {
+        if (width > 1) width /= 2;
+        if (height > 1) height /= 2;
+        auto level = ImageManager::get().createImage(width, height, pfd);
+        if (!level)
+        {
+            throw idlib::environment_error(__FILE__, __LINE__, "SDL", "unable to create surface");
+        }
+        /// @todo this is 'low-quality' and not thread-safe
+        SDL_SoftStretch(base.get(), nullptr, level.get(), nullptr);
+        pixels->levels.push_back(copyLevel(level.get(), bytesPerPixel));
+    }
+    return pixels;
+}
+
+std::shared_ptr<SDL_Surface> TexturePixels::createSource() const
+{
+    if (levels.empty())
+    {
+        return nullptr;
+    }
+    const auto& base = levels.front();
+    auto surface = ImageManager::get().createImage(sourceWidth, sourceHeight, getPixelDescriptor());
+    if (!surface)
+    {
+        return nullptr;
+    }
+    const size_t bytesPerPixel = getBytesPerPixel();
+    const size_t rowLength = sourceWidth * bytesPerPixel;
+    SDL_LockSurface(surface.get());
+    for (int y = 0; y < sourceHeight; ++y)
+    {
+        uint8_t *target = static_cast<uint8_t *>(surface->pixels) + y * surface->pitch;
+        std::memcpy(target, base.pixels.data() + y * base.width * bytesPerPixel, rowLength);
+    }
+    SDL_UnlockSurface(surface.get());
+    return surface;
+}
+
+} // namespace Ego
@@ -0,0 +1,89 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/TexturePixels.hpp
+/// @brief GPU-ready pixels of a texture.
+
+#pragma once
+
+#include "egolib/Graphics/PixelFormat.hpp"
+#include <SDL.h>
+#undef main
+
+namespace Ego {
+
+/// @brief The GPU-ready pixels of a texture.
+/// @remark
+/// The pixels are converted to R8G8B8 (no alpha) or R8G8B8A8 (alpha), padded to
+/// power-of-two dimensions and - if requested - accompanied by all mipmap levels.
+/// Rows are tightly packed (no row padding).
+struct TexturePixels
+{
+    /// @brief A single mipmap level.
+    struct Level
+    {
+        /// @brief The width, in pixels, of this level.
+        int width;
+        /// @brief The height, in pixels, of this level.
+        int height;
+        /// @brief The pixels of this level.
+        std::vector<uint8_t> pixels;
+    };
+
+    /// @brief @a true if the pixels have an alpha component, @a false otherwise.
+    bool hasAlpha;
+
+    /// @brief The width, in pixels, of the source (before padding).
+    int sourceWidth;
+
+    /// @brief The height, in pixels, of the source (before padding).
+    int sourceHeight;
+
+    /// @brief The mipmap levels starting with the base level.
+    std::vector<Level> levels;
+
+    /// @brief Construct these texture pixels.
+    /// @post The pixels have no alpha, the source width and height are @a 0 and there are no levels.
+    TexturePixels();
+
+    /// @brief Get the pixel descriptor of the pixels.
+    /// @return the pixel descriptor
+    const pixel_descriptor& getPixelDescriptor() const;
+
+    /// @brief Get the size, in Bytes, of a pixel.
+    /// @return the size, in Bytes, of a pixel
+    size_t getBytesPerPixel() const;
+
+    /// @brief Get if these pixels have mipmaps.
+    /// @return @a true if these pixels have mipmaps, @a false otherwise
+    bool hasMipmaps() const;
+
+    /// @brief Convert and pad a surface and optionally compute its mipmaps.
+    /// @param surface the surface
+    /// @param withMipmaps if @a true the mipmap levels are computed
+    /// @return the texture pixels
+    /// @throw idlib::argument_null_error @a surface is a null pointer
+    static std::shared_ptr<TexturePixels> create(const std::shared_ptr<SDL_Surface>& surface, bool withMipmaps);
+
+    /// @brief Re-create the source surface (i.e. the unpadded base level) of these pixels.
+    /// @return the surface
+    std::shared_ptr<SDL_Surface> createSource() const;
+};
+
+} // namespace Ego
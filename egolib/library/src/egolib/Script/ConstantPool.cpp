@@ -29,7 +29,7 @@ ConstantPool& ConstantPool::operator=(const ConstantPool&& other)
     return *this;
 }
 
-const Constant& ConstantPool::getConstant(ConstantPool::Index index)
+const Constant& ConstantPool::getConstant(ConstantPool::Index index) const
 {
     if (index >= m_constants.size())
     {
@@ -55,7 +55,7 @@ public:
     /// @param index the index
     /// @return a reference to the constant
     /// @throw idlib::runtime_error the index was out of bounds
-    const Constant& getConstant(Index index);
+    const Constant& getConstant(Index index) const;
 
     /// @brief Get the number of constants.
     /// @return the number of constants
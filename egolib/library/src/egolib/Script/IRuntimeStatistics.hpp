@@ -58,7 +58,7 @@ protected:
 
         /// @brief Copy-construct these function statistics from other function statistics.
         /// @param other the other function statistics
-        FunctionStatistics(const FunctionStatistics& other) : numberOfCalls(other.numberOfCalls), totalTime(other.totalTime) {}
+        FunctionStatistics(const FunctionStatistics& other) : numberOfCalls(other.numberOfCalls), totalTime(other.totalTime), maxTime(other.maxTime) {}
 
         /// @brief Assign these function statistics from other function statistics.
         /// @param other the other function statistics
@@ -92,12 +92,17 @@ public:
         if (_functionStatistics.cend() == it) {
             _functionStatistics.emplace(functionName, FunctionStatistics(1, time, time));
         } else {
-            (*it).second.numberOfCalls = (*it).first + 1;
-            (*it).second.totalTime = time;
+            (*it).second.numberOfCalls++;
+            (*it).second.totalTime += time;
             (*it).second.maxTime = std::max((*it).second.maxTime, time);
         }
     }
 
+    /// @brief Remove all statistics.
+    void reset() {
+        _functionStatistics.clear();
+    }
+
     /// @brief Append the runtime statistics to the specified file.
     /// @param pathname the pathname of the file to append the runtime statistics to
     virtual void append(const std::string& pathname) = 0;
@@ -0,0 +1,284 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Script/LoweredScript.cpp
+/// @brief The lowered form of a compiled script which is executed by the interpreter.
+
+#include "egolib/Script/LoweredScript.hpp"
+
+namespace Ego {
+namespace Script {
+
+namespace {
+/// @brief Get if a function is a comparison of tmpx and tmpy and which comparison it is.
+bool isComparison(uint32_t function, LoweredInstruction::Comparison& comparison)
+{
+    switch (function)
+    {
+        case IfXIsEqualToY:
+            comparison = LoweredInstruction::Comparison::Equal;
+            return true;
+        case IfXIsLessThanY:
+            comparison = LoweredInstruction::Comparison::Less;
+            return true;
+        case IfYIsLessThanX:
+            comparison = LoweredInstruction::Comparison::Greater;
+            return true;
+        default:
+            return false;
+    };
+}
+
+/// @brief Get if a function spawns a particle at tmpx and tmpy.
+bool isSpawnParticle(uint32_t function)
+{
+    return SpawnParticle == function || SpawnAttachedParticle == function
+        || SpawnExactParticle == function || SpawnExactParticleEndSpawn == function;
+}
+
+/// @brief Get if an instruction of the unfused lowered form assigns the variable @a variable.
+bool isAssignmentOf(const LoweredInstruction& instruction, uint32_t variable)
+{
+    return (LoweredInstruction::Kind::Assign == instruction.kind || LoweredInstruction::Kind::AssignConstant == instruction.kind)
+        && variable == instruction.index;
+}
+
+/// @brief Get if an instruction of the unfused lowered form calls the function @a function.
+bool isCallOf(const LoweredInstruction& instruction, uint32_t function)
+{
+    return LoweredInstruction::Kind::Call == instruction.kind && function == instruction.index;
+}
+} // namespace
+
+std::shared_ptr<LoweredScript> LoweredScript::lower(const InstructionList& instructions, const Runtime& runtime)
+{
+    static const uint32_t NoLine = std::numeric_limits<uint32_t>::max();
+    const auto numberOfInstructions = instructions.getNumberOfInstructions();
+    const auto& constantPool = instructions.getConstantPool();
+
+    // If the compiled script is malformed, the interpreter executes the compiled form.
+    auto fallback = [&instructions](const std::string& problem, uint32_t instruction)
+    {
+        auto lowered = std::make_shared<LoweredScript>();
+        lowered->problem = problem + " at source line " + std::to_string(instructions.getSourceLine(instruction));
+        return lowered;
+    };
+
+    // Find the first instruction of each line.
+    // A function call is the function instruction followed by a jump instruction.
+    // An assignment is the variable instruction followed by the operand count and the operands.
+    std::vector<uint32_t> lineOfInstruction(numberOfInstructions, NoLine);
+    std::vector<uint32_t> lines;
+    for (uint32_t i = 0; i < numberOfInstructions;)
+    {
+        if (i + 1 >= numberOfInstructions)
+        {
+            return fallback("truncated line", i);
+        }
+        lineOfInstruction[i] = static_cast<uint32_t>(lines.size());
+        lines.push_back(i);
+        if (instructions[i].isInv())
+        {
+            i += 2;
+        }
+        else
+        {
+            i += 2 + instructions[i + 1].getBits();
+        }
+    }
+    if (lines.empty())
+    {
+        return std::make_shared<LoweredScript>();
+    }
+
+    // A block starts at the first line and at each jump target.
+    std::vector<uint32_t> targetLine(lines.size(), NoLine);
+    std::vector<bool> isLeader(lines.size(), false);
+    isLeader[0] = true;
+    for (uint32_t line = 0; line < lines.size(); ++line)
+    {
+        if (instructions[lines[line]].isInv())
+        {
+            uint32_t target = instructions[lines[line] + 1].getBits();
+            if (target >= numberOfInstructions)
+            {
+                continue;
+            }
+            if (NoLine == lineOfInstruction[target])
+            {
+                return fallback("jump into a line", lines[line]);
+            }
+            targetLine[line] = lineOfInstruction[target];
+            isLeader[targetLine[line]] = true;
+        }
+    }
+    std::vector<uint32_t> blockOfLine(lines.size());
+    uint32_t numberOfBlocks = 0;
+    for (uint32_t line = 0; line < lines.size(); ++line)
+    {
+        if (isLeader[line])
+        {
+            numberOfBlocks++;
+        }
+        blockOfLine[line] = numberOfBlocks - 1;
+    }
+
+    // Lower the lines. The instruction index is the line index.
+    std::vector<LoweredInstruction> lineInstructions;
+    std::vector<LoweredOperand> lineOperands;
+    lineInstructions.reserve(lines.size());
+    for (uint32_t line = 0; line < lines.size(); ++line)
+    {
+        const auto start = lines[line];
+        const auto& instruction = instructions[start];
+        LoweredInstruction target;
+        target.comparison = LoweredInstruction::Comparison::Equal;
+        target.indent = instruction.getDataBits();
+        target.previousIndent = 0;
+        target.sourceLine = instructions.getSourceLine(start);
+        target.numberOfLines = 1;
+        target.index = constantPool.getConstant(instruction.getValueBits()).getAsInteger();
+        target.function = nullptr;
+        target.failureTarget = 0;
+        target.firstOperand = 0;
+        target.numberOfOperands = 0;
+        target.numberOfSecondOperands = 0;
+        target.constant = 0;
+        if (instruction.isInv())
+        {
+            target.kind = LoweredInstruction::Kind::Call;
+            const auto it = runtime._functionValueCodeToFunctionPointer.find(target.index);
+            if (runtime._functionValueCodeToFunctionPointer.cend() != it)
+            {
+                target.function = it->second;
+            }
+            target.failureTarget = NoLine == targetLine[line] ? numberOfBlocks : blockOfLine[targetLine[line]];
+        }
+        else
+        {
+            const auto numberOfOperands = instructions[start + 1].getBits();
+            target.firstOperand = static_cast<uint32_t>(lineOperands.size());
+            target.numberOfOperands = numberOfOperands;
+            for (uint32_t i = 0; i < numberOfOperands; ++i)
+            {
+                const auto& operand = instructions[start + 2 + i];
+                lineOperands.push_back(LoweredOperand{operand.getDataBits(), operand.isLdc(),
+                                                      constantPool.getConstant(operand.getValueBits()).getAsInteger()});
+            }
+            // Fuse the assignment of a single constant (e.g. "tmpargument = 5").
+            if (0 == numberOfOperands)
+            {
+                target.kind = LoweredInstruction::Kind::AssignConstant;
+            }
+            else if (1 == numberOfOperands && lineOperands.back().isConstant && OPADD == lineOperands.back().operation)
+            {
+                target.kind = LoweredInstruction::Kind::AssignConstant;
+                target.constant = lineOperands.back().value;
+                lineOperands.pop_back();
+                target.numberOfOperands = 0;
+            }
+            else
+            {
+                target.kind = LoweredInstruction::Kind::Assign;
+            }
+        }
+        lineInstructions.push_back(target);
+    }
+
+    // Form the blocks and fuse common sequences of lines inside each block.
+    auto lowered = std::make_shared<LoweredScript>();
+    lowered->blocks.reserve(numberOfBlocks);
+    lowered->instructions.reserve(lines.size());
+    // Get if the lines [line, line + count) exist and belong to the block of line.
+    auto inBlock = [&](uint32_t line, uint32_t count)
+    {
+        if (line + count > lines.size())
+        {
+            return false;
+        }
+        for (uint32_t i = 1; i < count; ++i)
+        {
+            if (isLeader[line + i])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    // Append the operands of an unfused assignment, an assignment of a constant becomes a single operand.
+    auto appendOperands = [&](const LoweredInstruction& assignment)
+    {
+        if (LoweredInstruction::Kind::AssignConstant == assignment.kind)
+        {
+            lowered->operands.push_back(LoweredOperand{OPADD, true, assignment.constant});
+            return uint32_t(1);
+        }
+        lowered->operands.insert(lowered->operands.end(), lineOperands.begin() + assignment.firstOperand,
+                                 lineOperands.begin() + assignment.firstOperand + assignment.numberOfOperands);
+        return assignment.numberOfOperands;
+    };
+    for (uint32_t line = 0; line < lines.size();)
+    {
+        if (isLeader[line])
+        {
+            lowered->blocks.push_back(LoweredBlock{static_cast<uint32_t>(lowered->instructions.size()), 0});
+        }
+        LoweredInstruction target = lineInstructions[line];
+        LoweredInstruction::Comparison comparison;
+        if (inBlock(line, 2) && isCallOf(lineInstructions[line], IfTimeOut) && isCallOf(lineInstructions[line + 1], SetTime))
+        {
+            // "IfTimeOut" followed by "SetTime".
+            target.kind = LoweredInstruction::Kind::TimeOutSetTime;
+            target.previousIndent = lineInstructions[line].indent;
+            target.indent = lineInstructions[line + 1].indent;
+            target.numberOfLines = 2;
+        }
+        else if (LoweredInstruction::Kind::Call == target.kind && isComparison(target.index, comparison))
+        {
+            // "IfXIsEqualToY", "IfXIsLessThanY" and "IfYIsLessThanX" followed by their conditional jump.
+            target.kind = LoweredInstruction::Kind::Compare;
+            target.comparison = comparison;
+        }
+        else if (inBlock(line, 3) && isAssignmentOf(lineInstructions[line], VARTMPX) && isAssignmentOf(lineInstructions[line + 1], VARTMPY)
+              && LoweredInstruction::Kind::Call == lineInstructions[line + 2].kind && isSpawnParticle(lineInstructions[line + 2].index))
+        {
+            // "tmpx = ...", "tmpy = ..." followed by "SpawnParticle" or a related function.
+            target = lineInstructions[line + 2];
+            target.kind = LoweredInstruction::Kind::AssignXYCall;
+            target.sourceLine = lineInstructions[line].sourceLine;
+            target.previousIndent = lineInstructions[line + 1].indent;
+            target.numberOfLines = 3;
+            target.firstOperand = static_cast<uint32_t>(lowered->operands.size());
+            target.numberOfOperands = appendOperands(lineInstructions[line]);
+            target.numberOfSecondOperands = appendOperands(lineInstructions[line + 1]);
+        }
+        else if (LoweredInstruction::Kind::Assign == target.kind)
+        {
+            target.firstOperand = static_cast<uint32_t>(lowered->operands.size());
+            appendOperands(lineInstructions[line]);
+        }
+        lowered->instructions.push_back(target);
+        lowered->blocks.back().numberOfInstructions++;
+        line += target.numberOfLines;
+    }
+    return lowered;
+}
+
+} // namespace Script
+} // namespace Ego
@@ -0,0 +1,250 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Script/LoweredScript.hpp
+/// @brief The lowered form of a compiled script which is executed by the interpreter.
+
+#pragma once
+
+#include "egolib/Script/script.h"
+
+namespace Ego {
+namespace Script {
+
+/**
+ * @brief
+ *  An operand of an assignment in the lowered form of a script.
+ */
+struct LoweredOperand
+{
+    /// @brief The operator (see Ego::Script::ScriptOperators).
+    uint8_t operation;
+    /// @brief @a true if @a value is a constant, @a false if @a value is a variable index.
+    bool isConstant;
+    /// @brief The constant or the variable index.
+    int32_t value;
+};
+
+/**
+ * @brief
+ *  An instruction in the lowered form of a script. Each instruction corresponds to one line of the script
+ *  unless it is a fused instruction which corresponds to a sequence of lines.
+ * @remark
+ *  In contrast to the compiled form, constants are stored inline, function pointers are resolved
+ *  and jump targets are indices of blocks of the lowered form.
+ */
+struct LoweredInstruction
+{
+    enum class Kind : uint8_t
+    {
+        /// @brief Invoke a function. If it fails, continue with the block @a failureTarget.
+        Call,
+        /// @brief Evaluate the operands and store the result in the variable @a index.
+        Assign,
+        /// @brief Store the constant @a constant in the variable @a index.
+        AssignConstant,
+        /// @brief Compare @a tmpx and @a tmpy. If the comparison @a comparison fails, continue with the block @a failureTarget.
+        /// Replaces a call of @a IfXIsEqualToY, @a IfXIsLessThanY or @a IfYIsLessThanX.
+        Compare,
+        /// @brief If the timer did not time out, continue with the block @a failureTarget, otherwise set the timer.
+        /// Replaces a call of @a IfTimeOut followed by a call of @a SetTime.
+        TimeOutSetTime,
+        /// @brief Evaluate the operands and store the result in @a tmpx, evaluate the second operands and store the
+        /// result in @a tmpy, then invoke a function as Kind::Call does. Replaces the set up of @a tmpx and @a tmpy
+        /// before a call of @a SpawnParticle or a related function.
+        AssignXYCall,
+    };
+
+    /// @brief The comparisons of Kind::Compare.
+    enum class Comparison : uint8_t
+    {
+        /// @brief @a tmpx is equal to @a tmpy.
+        Equal,
+        /// @brief @a tmpx is less than @a tmpy.
+        Less,
+        /// @brief @a tmpx is greater than @a tmpy.
+        Greater,
+    };
+
+    /// @brief The kind of this instruction.
+    Kind kind;
+    /// @brief The comparison (for Kind::Compare).
+    Comparison comparison;
+    /// @brief The indention of the last line of this instruction.
+    uint8_t indent;
+    /// @brief The indention of the line before the last line of this instruction (for fused instructions).
+    uint8_t previousIndent;
+    /// @brief The source line of the first line of this instruction or @a 0 if it is not known.
+    uint32_t sourceLine;
+    /// @brief The number of lines of this instruction. Greater than @a 1 for fused instructions.
+    uint32_t numberOfLines;
+    /// @brief The function index (for Kind::Call and Kind::AssignXYCall)
+    /// or the variable index (for Kind::Assign and Kind::AssignConstant).
+    uint32_t index;
+    /// @brief The function (for Kind::Call and Kind::AssignXYCall). A null pointer if the function does not exist.
+    NativeInterface::Function *function;
+    /// @brief The block to continue with if the function or the comparison fails.
+    /// If this is the number of blocks, then the script ends.
+    uint32_t failureTarget;
+    /// @brief The index of the first operand and the number of operands (for Kind::Assign and Kind::AssignXYCall).
+    uint32_t firstOperand, numberOfOperands;
+    /// @brief The number of second operands (for Kind::AssignXYCall). The second operands follow the operands.
+    uint32_t numberOfSecondOperands;
+    /// @brief The constant (for Kind::AssignConstant).
+    int32_t constant;
+
+    /// @brief Get if this instruction is a fused instruction.
+    /// @return @a true if this instruction is a fused instruction, @a false otherwise
+    bool isFused() const
+    {
+        return numberOfLines > 1;
+    }
+};
+
+/**
+ * @brief
+ *  A block of the lowered form of a script.
+ * @remark
+ *  A block is a maximal sequence of lines which is entered at its first line only i.e. no jump targets
+ *  any other line of the block. Common sequences of lines inside a block are fused into single instructions:
+ *  Setting up @a tmpx and @a tmpy before a @a SpawnParticle, a comparison of @a tmpx and @a tmpy followed by
+ *  its conditional jump and an @a IfTimeOut followed by a @a SetTime. A function failing inside a block leaves the block.
+ */
+struct LoweredBlock
+{
+    /// @brief The index of the first instruction of this block.
+    uint32_t firstInstruction;
+    /// @brief The number of instructions of this block (not the number of lines).
+    uint32_t numberOfInstructions;
+};
+
+/**
+ * @brief
+ *  The lowered form of a script.
+ */
+struct LoweredScript
+{
+    /// @brief The blocks.
+    std::vector<LoweredBlock> blocks;
+    /// @brief The instructions, ordered by blocks.
+    std::vector<LoweredInstruction> instructions;
+    /// @brief The operands of the instructions of kind LoweredInstruction::Kind::Assign and LoweredInstruction::Kind::AssignXYCall.
+    std::vector<LoweredOperand> operands;
+    /// @brief The empty string if the compiled script was lowered. Otherwise a description of why it could not be lowered,
+    /// the interpreter then executes the compiled form.
+    std::string problem;
+
+    /// @brief Get if the compiled script was lowered.
+    /// @return @a true if the compiled script was lowered, @a false if the interpreter must execute the compiled form
+    bool isLowered() const
+    {
+        return problem.empty();
+    }
+
+    /**
+     * @brief
+     *  Lower a compiled script.
+     * @param instructions
+     *  the instruction list of the compiled script
+     * @param runtime
+     *  the runtime to resolve the functions with
+     * @return
+     *  the lowered form of the script. If the compiled script is malformed, an empty lowered form
+     *  describing the problem is returned (see LoweredScript::isLowered).
+     */
+    static std::shared_ptr<LoweredScript> lower(const InstructionList& instructions, const Runtime& runtime);
+
+    /**
+     * @brief
+     *  Execute this lowered script.
+     * @param machine
+     *  the machine executing the instructions. It provides
+     *  - <tt>bool isTerminated()</tt> (if the script run was terminated),
+     *  - <tt>enter(const LoweredInstruction&, size_t)</tt> (update the indention before an instruction and return a scope object),
+     *  - <tt>bool call(uint32_t index, NativeInterface::Function *function)</tt> (invoke a function),
+     *  - <tt>void assign(uint32_t index, const LoweredOperand *operands, size_t numberOfOperands)</tt> (evaluate operands and store the result),
+     *  - <tt>void assignConstant(uint32_t index, int32_t constant)</tt> (store a constant),
+     *  - <tt>bool compare(LoweredInstruction::Comparison comparison)</tt> (compare @a tmpx and @a tmpy) and
+     *  - <tt>bool timeOutSetTime()</tt> (test and set the timer).
+     * @remark
+     *  The interpreter and the tests execute the lowered form with this function.
+     */
+    template <typename Machine>
+    void execute(Machine& machine) const;
+};
+
+template <typename Machine>
+void LoweredScript::execute(Machine& machine) const
+{
+    using Kind = LoweredInstruction::Kind;
+    const size_t numberOfBlocks = blocks.size();
+    size_t blockIndex = 0;
+    while (!machine.isTerminated() && blockIndex < numberOfBlocks)
+    {
+        const auto& block = blocks[blockIndex];
+        // Unless a function or a comparison fails, continue with the next block.
+        size_t nextBlockIndex = blockIndex + 1;
+        const auto *instruction = instructions.data() + block.firstInstruction;
+        const auto *end = instruction + block.numberOfInstructions;
+        for (; instruction != end; ++instruction)
+        {
+            auto scope = machine.enter(*instruction, static_cast<size_t>(instruction - instructions.data()));
+            bool success = true;
+            switch (instruction->kind)
+            {
+                case Kind::Call:
+                    success = machine.call(instruction->index, instruction->function);
+                    break;
+                case Kind::Assign:
+                    machine.assign(instruction->index, operands.data() + instruction->firstOperand, instruction->numberOfOperands);
+                    break;
+                case Kind::AssignConstant:
+                    machine.assignConstant(instruction->index, instruction->constant);
+                    break;
+                case Kind::Compare:
+                    success = machine.compare(instruction->comparison);
+                    break;
+                case Kind::TimeOutSetTime:
+                    success = machine.timeOutSetTime();
+                    break;
+                case Kind::AssignXYCall:
+                {
+                    const auto *xOperands = operands.data() + instruction->firstOperand;
+                    machine.assign(VARTMPX, xOperands, instruction->numberOfOperands);
+                    machine.assign(VARTMPY, xOperands + instruction->numberOfOperands, instruction->numberOfSecondOperands);
+                    success = machine.call(instruction->index, instruction->function);
+                }
+                break;
+            };
+            if (!success)
+            {
+                nextBlockIndex = instruction->failureTarget;
+                break;
+            }
+            if (machine.isTerminated())
+            {
+                break;
+            }
+        }
+        blockIndex = nextBlockIndex;
+    }
+}
+
+} // namespace Script
+} // namespace Ego
@@ -0,0 +1,201 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Script/Profiler.cpp
+/// @brief A profiler attributing the time spent in scripts to scripts, source lines and objects.
+
+#include "egolib/Script/Profiler.hpp"
+#include "egolib/Script/LoweredScript.hpp"
+#include "egolib/vfs.h"
+
+namespace Ego {
+namespace Script {
+
+Profiler::Profiler() :
+    _running(false), _samplingInterval(1), _counter(0), _scripts(), _objects()
+{}
+
+void Profiler::start(uint32_t samplingInterval)
+{
+    if (0 == samplingInterval)
+    {
+        throw idlib::argument_out_of_bounds_error(__FILE__, __LINE__, "samplingInterval");
+    }
+    _samplingInterval = samplingInterval;
+    _counter = 0;
+    _running = true;
+}
+
+void Profiler::stop()
+{
+    _running = false;
+}
+
+void Profiler::reset()
+{
+    _scripts.clear();
+    _objects.clear();
+    _counter = 0;
+}
+
+bool Profiler::isRunning() const
+{
+    return _running;
+}
+
+uint32_t Profiler::getSamplingInterval() const
+{
+    return _samplingInterval;
+}
+
+Profiler::ScriptStatistics *Profiler::beginRun(const std::string& scriptName, const LoweredScript& lowered)
+{
+    if (!_running)
+    {
+        return nullptr;
+    }
+    if (++_counter < _samplingInterval)
+    {
+        return nullptr;
+    }
+    _counter = 0;
+    auto& script = _scripts[scriptName];
+    // (Re-)create the line statistics if the script is new or was reloaded with a different number of lines.
+    if (script.lines.size() != lowered.instructions.size())
+    {
+        script.name = scriptName;
+        script.lines.clear();
+        script.lines.reserve(lowered.instructions.size());
+        for (const auto& instruction : lowered.instructions)
+        {
+            script.lines.push_back(LineStatistics{instruction.sourceLine, 0, 0.0});
+        }
+    }
+    return &script;
+}
+
+void Profiler::endRun(ScriptStatistics& scriptStatistics, ObjectRef object, const std::string& className, double time)
+{
+    scriptStatistics.numberOfRuns++;
+    scriptStatistics.totalTime += time;
+    auto& objectStatistics = _objects[object];
+    if (objectStatistics.scriptName != scriptStatistics.name || objectStatistics.className != className)
+    {
+        // The object reference was reused by another object.
+        objectStatistics = ObjectStatistics{scriptStatistics.name, className, 0, 0.0};
+    }
+    objectStatistics.numberOfRuns++;
+    objectStatistics.totalTime += time;
+}
+
+std::vector<Profiler::HotSpot> Profiler::getHotSpots() const
+{
+    std::vector<HotSpot> hotSpots;
+    for (const auto& script : _scripts)
+    {
+        for (const auto& line : script.second.lines)
+        {
+            if (0 != line.numberOfExecutions)
+            {
+                hotSpots.push_back(HotSpot{&script.second, &line});
+            }
+        }
+    }
+    std::sort(hotSpots.begin(), hotSpots.end(),
+              [](const HotSpot& x, const HotSpot& y) { return x.line->totalTime > y.line->totalTime; });
+    return hotSpots;
+}
+
+std::vector<std::pair<ObjectRef, const Profiler::ObjectStatistics *>> Profiler::getHotObjects() const
+{
+    std::vector<std::pair<ObjectRef, const ObjectStatistics *>> hotObjects;
+    for (const auto& object : _objects)
+    {
+        hotObjects.emplace_back(object.first, &object.second);
+    }
+    std::sort(hotObjects.begin(), hotObjects.end(),
+              [](const auto& x, const auto& y) { return x.second->totalTime > y.second->totalTime; });
+    return hotObjects;
+}
+
+bool Profiler::write(const std::string& pathname) const
+{
+    auto target = std::shared_ptr<vfs_FILE>(vfs_openWrite(pathname),
+                                            [](vfs_FILE *file) { if (nullptr != file) { vfs_close(file); } });
+    if (nullptr == target)
+    {
+        return false;
+    }
+    vfs_printf(target.get(), "sampling interval = %" PRIu32 "\n\n", _samplingInterval);
+
+    // The scripts ordered by descending total time.
+    std::vector<const ScriptStatistics *> scripts;
+    for (const auto& script : _scripts)
+    {
+        scripts.push_back(&script.second);
+    }
+    std::sort(scripts.begin(), scripts.end(),
+              [](const ScriptStatistics *x, const ScriptStatistics *y) { return x->totalTime > y->totalTime; });
+    vfs_printf(target.get(), "scripts\n");
+    for (const auto *script : scripts)
+    {
+        vfs_printf(target.get(), "script = \"%s\"\tnumber of runs = %" PRIu64 "\ttotalTime = %lf\n",
+                   script->name.c_str(), script->numberOfRuns, script->totalTime);
+    }
+
+    vfs_printf(target.get(), "\nlines\n");
+    for (const auto& hotSpot : getHotSpots())
+    {
+        vfs_printf(target.get(), "script = \"%s\"\tline = %" PRIu32 "\tnumber of executions = %" PRIu64 "\ttotalTime = %lf\n",
+                   hotSpot.script->name.c_str(), hotSpot.line->sourceLine, hotSpot.line->numberOfExecutions, hotSpot.line->totalTime);
+    }
+
+    vfs_printf(target.get(), "\nobjects\n");
+    for (const auto& object : getHotObjects())
+    {
+        vfs_printf(target.get(), "object = %" PRIuZ "\tclass name = \"%s\"\tscript = \"%s\"\tnumber of runs = %" PRIu64 "\ttotalTime = %lf\n",
+                   object.first.get(), object.second->className.c_str(), object.second->scriptName.c_str(),
+                   object.second->numberOfRuns, object.second->totalTime);
+    }
+    return true;
+}
+
+std::string Profiler::getSummary(size_t numberOfLines) const
+{
+    std::ostringstream os;
+    os << "script profiler: " << (_running ? "running" : "stopped") << ", sampling interval " << _samplingInterval << std::endl;
+    auto hotSpots = getHotSpots();
+    for (size_t i = 0, n = std::min(numberOfLines, hotSpots.size()); i < n; ++i)
+    {
+        const auto& hotSpot = hotSpots[i];
+        os << hotSpot.script->name << ":" << hotSpot.line->sourceLine << " "
+           << hotSpot.line->totalTime << " ms / " << hotSpot.line->numberOfExecutions << std::endl;
+    }
+    auto hotObjects = getHotObjects();
+    for (size_t i = 0, n = std::min(numberOfLines, hotObjects.size()); i < n; ++i)
+    {
+        const auto& object = hotObjects[i];
+        os << "object " << object.first.get() << " (" << object.second->className << ") "
+           << object.second->totalTime << " ms / " << object.second->numberOfRuns << std::endl;
+    }
+    return os.str();
+}
+
+} // namespace Script
+} // namespace Ego
@@ -0,0 +1,178 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Script/Profiler.hpp
+/// @brief A profiler attributing the time spent in scripts to scripts, source lines and objects.
+
+#pragma once
+
+#include "egolib/typedef.h"
+
+namespace Ego {
+namespace Script {
+
+struct LoweredScript;
+
+/**
+ * @brief
+ *  A profiler attributing the time spent in scripts to scripts, source lines and objects.
+ * @remark
+ *  If the profiler is running, every n-th script run is sampled where n is the sampling interval.
+ *  The instructions of a sampled run are timed individually, runs which are not sampled are not timed.
+ *  Hence the numbers of a report are the numbers of the sampled runs only.
+ */
+class Profiler
+{
+public:
+    /// @brief The statistics of a source line.
+    struct LineStatistics
+    {
+        /// @brief The source line.
+        uint32_t sourceLine;
+        /// @brief The number of executions.
+        uint64_t numberOfExecutions;
+        /// @brief The sum of the times, in milliseconds, spent on the executions.
+        double totalTime;
+    };
+
+    /// @brief The statistics of a script.
+    struct ScriptStatistics
+    {
+        /// @brief The name of the script.
+        std::string name;
+        /// @brief The number of runs.
+        uint64_t numberOfRuns;
+        /// @brief The sum of the times, in milliseconds, spent on the runs.
+        double totalTime;
+        /// @brief The statistics of each line, indexed by the instructions of the lowered form of the script.
+        std::vector<LineStatistics> lines;
+    };
+
+    /// @brief The statistics of an object.
+    struct ObjectStatistics
+    {
+        /// @brief The name of the script of the object.
+        std::string scriptName;
+        /// @brief The class name of the profile of the object.
+        std::string className;
+        /// @brief The number of runs.
+        uint64_t numberOfRuns;
+        /// @brief The sum of the times, in milliseconds, spent on the runs.
+        double totalTime;
+    };
+
+    /// @brief Construct this profiler.
+    /// @post The profiler is not running.
+    Profiler();
+
+    /// @brief Start this profiler.
+    /// @param samplingInterval the sampling interval. Every n-th script run is sampled. Must be positive.
+    /// @throw idlib::argument_out_of_bounds_error @a samplingInterval is @a 0
+    void start(uint32_t samplingInterval);
+
+    /// @brief Stop this profiler. The statistics are kept.
+    void stop();
+
+    /// @brief Remove all statistics.
+    void reset();
+
+    /// @brief Get if this profiler is running.
+    bool isRunning() const;
+
+    /// @brief Get the sampling interval.
+    uint32_t getSamplingInterval() const;
+
+    /**
+     * @brief
+     *  Begin a script run.
+     * @param scriptName
+     *  the name of the script
+     * @param lowered
+     *  the lowered form of the script
+     * @return
+     *  a pointer to the statistics of the script if the run is sampled, a null pointer otherwise
+     */
+    ScriptStatistics *beginRun(const std::string& scriptName, const LoweredScript& lowered);
+
+    /**
+     * @brief
+     *  End a sampled script run.
+     * @param scriptStatistics
+     *  the statistics of the script as returned by beginRun
+     * @param object
+     *  the object which ran the script
+     * @param className
+     *  the class name of the profile of the object
+     * @param time
+     *  the time, in milliseconds, spent on the run
+     */
+    void endRun(ScriptStatistics& scriptStatistics, ObjectRef object, const std::string& className, double time);
+
+    /**
+     * @brief
+     *  Write a report to a file.
+     * @param pathname
+     *  the VFS pathname of the file
+     * @return
+     *  @a true on success, @a false on failure
+     */
+    bool write(const std::string& pathname) const;
+
+    /**
+     * @brief
+     *  Get a short report of the hot spots.
+     * @param numberOfLines
+     *  the maximum number of source lines and of objects to report
+     * @return
+     *  the report
+     */
+    std::string getSummary(size_t numberOfLines) const;
+
+private:
+    /// @brief A source line with its statistics for sorting.
+    struct HotSpot
+    {
+        const ScriptStatistics *script;
+        const LineStatistics *line;
+    };
+
+    /// @brief Get the source lines (with at least one execution) ordered by descending total time.
+    std::vector<HotSpot> getHotSpots() const;
+
+    /// @brief Get the objects ordered by descending total time.
+    std::vector<std::pair<ObjectRef, const ObjectStatistics *>> getHotObjects() const;
+
+    /// @brief If this profiler is running.
+    bool _running;
+
+    /// @brief The sampling interval.
+    uint32_t _samplingInterval;
+
+    /// @brief The number of script runs since the last sampled run.
+    uint32_t _counter;
+
+    /// @brief The statistics of the scripts.
+    std::unordered_map<std::string, ScriptStatistics> _scripts;
+
+    /// @brief The statistics of the objects.
+    std::unordered_map<ObjectRef, ObjectStatistics> _objects;
+};
+
+} // namespace Script
+} // namespace Ego
@@ -0,0 +1,170 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file egolib/Script/ReadContextBenchmark.cpp
+/// @brief A benchmark measuring the parse throughput of ReadContext.
+
+#include "egolib/Script/ReadContextBenchmark.hpp"
+#include "egolib/fileutil.h"
+#include "egolib/vfs.h"
+#include <chrono>
+
+namespace Ego {
+namespace Script {
+
+namespace {
+
+/// @brief Collect the pathnames of the <tt>.txt</tt> files in a directory and its subdirectories.
+void collectFiles(const std::string& pathname, std::vector<std::string>& pathnames)
+{
+    SearchContext *ctxt = new SearchContext(Ego::VfsPath(pathname), Ego::Extension("txt"), VFS_SEARCH_FILE);
+    while (ctxt->hasData())
+    {
+        pathnames.push_back(ctxt->getData().string());
+        ctxt->nextData();
+    }
+    delete ctxt;
+    std::vector<std::string> directories;
+    ctxt = new SearchContext(Ego::VfsPath(pathname), VFS_SEARCH_DIR);
+    while (ctxt->hasData())
+    {
+        directories.push_back(ctxt->getData().string());
+        ctxt->nextData();
+    }
+    delete ctxt;
+    for (const auto& directory : directories)
+    {
+        collectFiles(directory, pathnames);
+    }
+}
+
+/// @brief Parse an in-memory image of a file.
+/// @param [in,out] checksum a checksum of the values parsed
+/// @return the number of values parsed
+size_t parse(const std::string& pathname, const std::vector<char>& image, ReadContext::Mode mode, uint64_t& checksum)
+{
+    ReadContext ctxt(pathname, image);
+    ctxt.setMode(mode);
+    size_t numberOfValues = 0;
+    auto combine = [&checksum](uint64_t x) { checksum = (checksum ^ x) * UINT64_C(0x100000001b3); };
+    try
+    {
+        while (ctxt.skipToColon(true))
+        {
+            ctxt.skipWhiteSpaces();
+            const int c = ctxt.current();
+            if (('0' <= c && c <= '9') || '+' == c || '-' == c || '.' == c)
+            {
+                float value = ctxt.readRealLiteral();
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                combine(bits);
+            }
+            else if ('[' == c)
+            {
+                combine(ctxt.readIDSZ().toUint32());
+            }
+            else
+            {
+                for (char x : ctxt.readStringLiteral())
+                {
+                    combine(static_cast<unsigned char>(x));
+                }
+            }
+            combine(ctxt.get_line_number());
+            numberOfValues++;
+        }
+    }
+    catch (const idlib::hll::compilation_error&)
+    {
+        // Stop at the first error, in both modes at the same location.
+        combine(ctxt.get_line_number());
+    }
+    return numberOfValues;
+}
+
+} // namespace
+
+std::string ReadContextBenchmarkResult::getSummary() const
+{
+    auto throughput = [this](double time)
+    {
+        return 0.0 < time ? (double(numberOfBytes) * double(numberOfRepetitions) / (1024.0 * 1024.0)) / (time / 1000.0) : 0.0;
+    };
+    std::ostringstream os;
+    os << numberOfFiles << " files, " << numberOfBytes << " Bytes, " << numberOfValues << " values, "
+       << numberOfRepetitions << " repetitions" << std::endl
+       << "tokens: " << tokensTime << " ms, " << throughput(tokensTime) << " MB/s" << std::endl
+       << "direct: " << directTime << " ms, " << throughput(directTime) << " MB/s" << std::endl
+       << numberOfMismatches << " mismatches" << std::endl;
+    return os.str();
+}
+
+ReadContextBenchmarkResult benchmarkReadContext(const std::string& pathname, size_t numberOfRepetitions)
+{
+    if (0 == numberOfRepetitions)
+    {
+        throw idlib::argument_out_of_bounds_error(__FILE__, __LINE__, "numberOfRepetitions");
+    }
+    ReadContextBenchmarkResult result{0, 0, 0, numberOfRepetitions, 0.0, 0.0, 0};
+    std::vector<std::string> pathnames;
+    collectFiles(pathname, pathnames);
+    for (const auto& file : pathnames)
+    {
+        char *data = nullptr;
+        size_t length = 0;
+        if (!vfs_readEntireFile(file, &data, &length))
+        {
+            continue;
+        }
+        std::unique_ptr<char, decltype(&std::free)> guard(data, &std::free);
+        const std::vector<char> image(data, data + length);
+        result.numberOfFiles++;
+        result.numberOfBytes += image.size();
+        uint64_t checksums[2] = { UINT64_C(0xcbf29ce484222325), UINT64_C(0xcbf29ce484222325) };
+        const ReadContext::Mode modes[2] = { ReadContext::Mode::Tokens, ReadContext::Mode::Direct };
+        double *times[2] = { &result.tokensTime, &result.directTime };
+        for (size_t i = 0; i < 2; ++i)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            for (size_t j = 0; j < numberOfRepetitions; ++j)
+            {
+                uint64_t checksum = UINT64_C(0xcbf29ce484222325);
+                size_t numberOfValues = parse(file, image, modes[i], checksum);
+                if (0 == j)
+                {
+                    checksums[i] = checksum;
+                    if (0 == i) result.numberOfValues += numberOfValues;
+                }
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            *times[i] += std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        if (checksums[0] != checksums[1])
+        {
+            result.numberOfMismatches++;
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "parsing modes disagree on file ", "`", file, "`", Log::EndOfEntry);
+        }
+    }
+    return result;
+}
+
+} // namespace Script
+} // namespace Ego
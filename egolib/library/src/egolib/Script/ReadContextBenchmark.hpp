@@ -0,0 +1,76 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Script/ReadContextBenchmark.hpp
+/// @brief A benchmark measuring the parse throughput of ReadContext.
+
+#pragma once
+
+#include "egolib/typedef.h"
+
+namespace Ego {
+namespace Script {
+
+/**
+ * @brief
+ *  The result of a ReadContext benchmark.
+ */
+struct ReadContextBenchmarkResult
+{
+    /// @brief The number of files parsed.
+    size_t numberOfFiles;
+    /// @brief The total size, in Bytes, of the files parsed.
+    size_t numberOfBytes;
+    /// @brief The number of values parsed per repetition.
+    size_t numberOfValues;
+    /// @brief The number of repetitions.
+    size_t numberOfRepetitions;
+    /// @brief The total time, in milliseconds, spent on parsing in mode ReadContext::Mode::Tokens.
+    double tokensTime;
+    /// @brief The total time, in milliseconds, spent on parsing in mode ReadContext::Mode::Direct.
+    double directTime;
+    /// @brief The number of files for which the modes yielded different values.
+    size_t numberOfMismatches;
+
+    /// @brief Get a short report of this result.
+    /// @return the report
+    std::string getSummary() const;
+};
+
+/**
+ * @brief
+ *  Measure the parse throughput of ReadContext in the modes ReadContext::Mode::Tokens and ReadContext::Mode::Direct.
+ * @param pathname
+ *  the VFS pathname of the directory. All <tt>.txt</tt> files in that directory and its subdirectories are parsed.
+ * @param numberOfRepetitions
+ *  the number of times each file is parsed in each mode. Must be positive.
+ * @return
+ *  the result
+ * @throw idlib::argument_out_of_bounds_error
+ *  if @a numberOfRepetitions is @a 0
+ * @remark
+ *  Each file is read into memory once, hence the file system is not measured. A file is parsed as a sequence
+ *  of <tt>name : value</tt> entries like the profile and configuration files are. A value starting with a
+ *  digit, a sign or a period is read as a real, a value starting with <tt>[</tt> is read as an IDSZ and any
+ *  other value is read as a string. Parsing of a file stops at its first error.
+ */
+ReadContextBenchmarkResult benchmarkReadContext(const std::string& pathname, size_t numberOfRepetitions);
+
+} // namespace Script
+} // namespace Ego
@@ -48,6 +48,19 @@ private:
 	idlib::iterator_range<iterator_type> m_range;
 	/// @brief Iterator pointing to the current input symbols in the list of input symbols.
 	iterator_type m_current;
+    /// @brief The index of the current input symbol in the input buffer.
+    size_t m_position;
+
+    /// @brief Set the current input symbol to the first input symbol of the input buffer.
+    void reset_input()
+    {
+		auto begin = iterator_type(m_input_buffer.cbegin(), transform_functor{});
+		auto end = iterator_type(m_input_buffer.cend(), transform_functor{});
+		auto current = iterator_type(m_input_buffer.cbegin(), transform_functor{});
+		m_range = idlib::make_iterator_range(begin, end);
+		m_current = current;
+        m_position = 0;
+    }
 
 protected:
     /// @brief Construct this scanner.
@@ -56,7 +69,7 @@ protected:
     /// @post The scanner is in its initial state w.r.t. the specified input if no exception is raised.
     Scanner(const std::string& file_name) :
         m_file_name(file_name), m_line_number(1), m_input_buffer(),
-        m_buffer(), m_current(), m_range()
+        m_buffer(), m_current(), m_range(), m_position(0)
     {
         vfs_readEntireFile
         (
@@ -66,12 +79,18 @@ protected:
                 m_input_buffer.insert(m_input_buffer.end(), bytes, bytes + number_of_bytes);
             }
         );
-        //
-		auto begin = iterator_type(m_input_buffer.cbegin(), transform_functor{});
-		auto end = iterator_type(m_input_buffer.cend(), transform_functor{});
-		auto current = iterator_type(m_input_buffer.cbegin(), transform_functor{});
-		m_range = idlib::make_iterator_range(begin, end);
-		m_current = current;
+        reset_input();
+    }
+
+    /// @brief Construct this scanner.
+    /// @param file_name the filename (used for error reporting only)
+    /// @param input the contents of the file
+    /// @post The scanner is in its initial state w.r.t. the specified input.
+    Scanner(const std::string& file_name, std::vector<char> input) :
+        m_file_name(file_name), m_line_number(1), m_input_buffer(std::move(input)),
+        m_buffer(), m_current(), m_range(), m_position(0)
+    {
+        reset_input();
     }
 
     /// @brief Set the input.
@@ -90,12 +109,7 @@ protected:
         m_line_number = 1;
         m_file_name.swap(temporary_file_name);
         m_input_buffer.swap(temporary_input_buffer);
-        //
-		auto begin = iterator_type(m_input_buffer.cbegin(), transform_functor{});
-		auto end = iterator_type(m_input_buffer.cend(), transform_functor{});
-		auto current = iterator_type(m_input_buffer.cbegin(), transform_functor{});
-		m_range = idlib::make_iterator_range(begin, end);
-		m_current = current;
+        reset_input();
     }
 
     /// @brief Destruct this scanner.
@@ -150,8 +164,38 @@ public:
     void next()
     {
         m_current++;
+        m_position++;
+    }
+
+protected:
+    /// @brief Get a pointer to the current input symbol in the input buffer.
+    /// @return a pointer to the current input symbol
+    /// @remark Used by scanning functions which scan the input buffer directly.
+    const char *get_input_current() const
+    {
+        return m_input_buffer.data() + m_position;
     }
 
+    /// @brief Get a pointer past the last input symbol in the input buffer.
+    /// @return a pointer past the last input symbol
+    const char *get_input_end() const
+    {
+        return m_input_buffer.data() + m_input_buffer.size();
+    }
+
+    /// @brief Advance to an input symbol in the input buffer.
+    /// @param position a pointer to the input symbol, not before the current input symbol and not after the end of the input buffer
+    /// @param number_of_lines the number of new lines between the current input symbol and @a position
+    void seek(const char *position, size_t number_of_lines)
+    {
+        assert(get_input_current() <= position && position <= get_input_end());
+        m_position = position - m_input_buffer.data();
+        m_current = iterator_type(m_input_buffer.cbegin() + m_position, transform_functor{});
+        m_line_number += number_of_lines;
+    }
+
+public:
+
     /// @brief Write the specified symbol.
     /// @param symbol the symbol
     inline void write(const ExtendedSymbolType& symbol)
@@ -0,0 +1,270 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Script/ScriptCache.cpp
+/// @brief An in-memory and on-disk cache of compiled scripts.
+
+#include "egolib/Script/ScriptCache.hpp"
+#include "egolib/Core/CacheFile.hpp"
+#include "egolib/egoboo_setup.h"
+#include "egolib/vfs.h"
+
+namespace Ego {
+namespace Script {
+
+namespace {
+
+/// @brief The magic number of a script cache file ("EGSC").
+constexpr uint32_t CACHE_MAGIC = 0x43534745;
+
+/// @brief The version of the script cache file format.
+/// Increment whenever the file format or the code generation of the compiler changes.
+constexpr uint32_t CACHE_VERSION = 2;
+
+using CacheFile::write;
+using CacheFile::Reader;
+
+} // namespace
+
+ScriptCache::ScriptCache() :
+    _entries(), _hits(0), _misses(0)
+{}
+
+ScriptCache::~ScriptCache()
+{}
+
+bool ScriptCache::isEnabled() const
+{
+    return egoboo_config_t::get().game_scriptCache_enable.getValue();
+}
+
+size_t ScriptCache::getHits() const
+{
+    return _hits;
+}
+
+size_t ScriptCache::getMisses() const
+{
+    return _misses;
+}
+
+void ScriptCache::clear()
+{
+    _entries.clear();
+}
+
+std::string ScriptCache::getCachePathname(uint64_t key)
+{
+    std::ostringstream os;
+    os << "/cache/scripts/" << std::hex << std::setw(16) << std::setfill('0') << key << ".scr";
+    return os.str();
+}
+
+InstructionList CompiledScript::relocate(const std::function<size_t(const std::string&)>& addMessage) const
+{
+    InstructionList result = instructions;
+    for (const auto& message : messages)
+    {
+        const int value = static_cast<int>(addMessage(message.second));
+        const auto bits = result[message.first].getBits();
+        if (value != result.getConstantPool().getConstant(bits & Instruction::VALUEBITS).getAsInteger())
+        {
+            auto constantIndex = result.getOrCreateConstant(value);
+            result.set(message.first, Instruction((bits & ~Instruction::VALUEBITS) | constantIndex));
+        }
+    }
+    return result;
+}
+
+bool ScriptCache::encode(uint64_t key, uint64_t sourceLength, const CompiledScript& compiledScript, std::vector<char>& buffer)
+{
+    const auto& instructions = compiledScript.instructions;
+    const auto& constantPool = instructions.getConstantPool();
+    // Only integer constants are emitted by the compiler.
+    for (uint32_t i = 0; i < constantPool.getNumberOfConstants(); ++i)
+    {
+        if (Constant::Kind::Integer != constantPool.getConstant(i).getKind())
+        {
+            return false;
+        }
+    }
+
+    buffer.clear();
+    buffer.reserve(64 + 4 * constantPool.getNumberOfConstants() + 8 * instructions.getNumberOfInstructions());
+
+    // Write the header.
+    write(buffer, CACHE_MAGIC);
+    write(buffer, CACHE_VERSION);
+    write(buffer, key);
+    write(buffer, sourceLength);
+
+    // Write the constants, the instructions and the messages.
+    write(buffer, static_cast<uint32_t>(constantPool.getNumberOfConstants()));
+    for (uint32_t i = 0; i < constantPool.getNumberOfConstants(); ++i)
+    {
+        write(buffer, static_cast<int32_t>(constantPool.getConstant(i).getAsInteger()));
+    }
+    write(buffer, static_cast<uint32_t>(instructions.getNumberOfInstructions()));
+    for (uint32_t i = 0; i < instructions.getNumberOfInstructions(); ++i)
+    {
+        write(buffer, instructions[i].getBits());
+        write(buffer, instructions.getSourceLine(i));
+    }
+    write(buffer, static_cast<uint32_t>(compiledScript.messages.size()));
+    for (const auto& message : compiledScript.messages)
+    {
+        write(buffer, static_cast<uint32_t>(message.first));
+        write(buffer, message.second);
+    }
+    return true;
+}
+
+ScriptCache::Validity ScriptCache::decode(const char *data, size_t length, uint64_t key, uint64_t sourceLength, CompiledScript& compiledScript)
+{
+    Reader reader{data, data + length};
+
+    // Validate the header.
+    uint32_t magic, version;
+    uint64_t storedKey, storedSourceLength;
+    if (!reader.read(magic) || CACHE_MAGIC != magic ||
+        !reader.read(version) || CACHE_VERSION != version ||
+        !reader.read(storedKey) || key != storedKey ||
+        !reader.read(storedSourceLength) || sourceLength != storedSourceLength)
+    {
+        return Validity::Stale;
+    }
+
+    // Read the constants, the instructions and the messages.
+    compiledScript.instructions.clear();
+    compiledScript.messages.clear();
+    uint32_t numberOfConstants;
+    if (!reader.read(numberOfConstants))
+    {
+        return Validity::Corrupted;
+    }
+    for (uint32_t i = 0; i < numberOfConstants; ++i)
+    {
+        int32_t value;
+        // The constants are distinct, hence they are created in order.
+        if (!reader.read(value) || i != compiledScript.instructions.getOrCreateConstant(value))
+        {
+            return Validity::Corrupted;
+        }
+    }
+    uint32_t numberOfInstructions;
+    if (!reader.read(numberOfInstructions) || numberOfInstructions > MAXAICOMPILESIZE)
+    {
+        return Validity::Corrupted;
+    }
+    for (uint32_t i = 0; i < numberOfInstructions; ++i)
+    {
+        uint32_t bits, sourceLine;
+        if (!reader.read(bits) || !reader.read(sourceLine))
+        {
+            return Validity::Corrupted;
+        }
+        compiledScript.instructions.append(Instruction(bits), sourceLine);
+    }
+    uint32_t numberOfMessages;
+    if (!reader.read(numberOfMessages))
+    {
+        return Validity::Corrupted;
+    }
+    for (uint32_t i = 0; i < numberOfMessages; ++i)
+    {
+        uint32_t index;
+        std::string message;
+        if (!reader.read(index) || index >= numberOfInstructions || !reader.read(message))
+        {
+            return Validity::Corrupted;
+        }
+        compiledScript.messages.emplace_back(index, message);
+    }
+    return reader.current == reader.end ? Validity::Valid : Validity::Corrupted;
+}
+
+std::shared_ptr<const CompiledScript> ScriptCache::load(uint64_t key, uint64_t sourceLength)
+{
+    if (!isEnabled())
+    {
+        return nullptr;
+    }
+
+    // Look into memory.
+    auto it = _entries.find(key);
+    if (it != _entries.end() && it->second.sourceLength == sourceLength)
+    {
+        _hits++;
+        return it->second.compiledScript;
+    }
+
+    // Look onto disk.
+    const std::string cachePathname = getCachePathname(key);
+    if (!vfs_exists(cachePathname))
+    {
+        _misses++;
+        return nullptr;
+    }
+    char *data = nullptr;
+    size_t length = 0;
+    if (!vfs_readEntireFile(cachePathname, &data, &length))
+    {
+        _misses++;
+        return nullptr;
+    }
+    std::unique_ptr<char, decltype(&std::free)> guard(data, &std::free);
+    auto compiledScript = std::make_shared<CompiledScript>();
+    switch (decode(data, length, key, sourceLength, *compiledScript))
+    {
+        case Validity::Valid:
+            _hits++;
+            _entries[key] = Entry{sourceLength, compiledScript};
+            return compiledScript;
+        case Validity::Corrupted:
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "corrupted script cache file ", "`", cachePathname, "`", Log::EndOfEntry);
+            break;
+        case Validity::Stale:
+            break;
+    }
+    _misses++;
+    return nullptr;
+}
+
+void ScriptCache::store(uint64_t key, uint64_t sourceLength, const CompiledScript& compiledScript)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    std::vector<char> buffer;
+    if (!encode(key, sourceLength, compiledScript, buffer))
+    {
+        return;
+    }
+    _entries[key] = Entry{sourceLength, std::make_shared<CompiledScript>(compiledScript)};
+
+    const std::string cachePathname = getCachePathname(key);
+    if (!vfs_writeEntireFile(cachePathname, buffer.data(), buffer.size()))
+    {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to write script cache file ", "`", cachePathname, "`", Log::EndOfEntry);
+    }
+}
+
+} // namespace Script
+} // namespace Ego
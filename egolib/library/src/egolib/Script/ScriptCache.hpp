@@ -0,0 +1,192 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Script/ScriptCache.hpp
+/// @brief An in-memory and on-disk cache of compiled scripts.
+
+#pragma once
+
+#include "egolib/Script/script.h"
+
+namespace Ego {
+namespace Script {
+
+/**
+ * @brief
+ *  A compiled script.
+ */
+struct CompiledScript
+{
+    /// @brief The instruction list.
+    InstructionList instructions;
+
+    /// @brief The message literals of the script in the order of their occurrence.
+    /// Each message literal is stored with the index of the instruction which loads its message index.
+    /// @remark The message indices in the instruction list are the message indices of the object profile
+    /// which compiled the script. They must be relocated for other object profiles.
+    std::vector<std::pair<InstructionList::Index, std::string>> messages;
+
+    /**
+     * @brief
+     *  Get the instruction list with its message indices relocated to the messages of an object profile.
+     * @param addMessage
+     *  a function adding a message literal to the messages of the object profile and returning its message index
+     * @return
+     *  the instruction list, shared with this compiled script if no message index changed
+     */
+    InstructionList relocate(const std::function<size_t(const std::string&)>& addMessage) const;
+};
+
+/**
+ * @brief
+ *  An in-memory and on-disk cache of compiled scripts.
+ * @remark
+ *  An entry is identified by a hash of the script source and of the opcode table of the compiler.
+ *  Entries are stored under <tt>/cache/scripts</tt> of the user directory in a file named after the hash.
+ *  Entries loaded once are kept in memory and their instruction lists are shared between all object
+ *  profiles with identical script sources.
+ */
+class ScriptCache : public idlib::singleton<ScriptCache>
+{
+protected:
+    friend idlib::default_new_functor<ScriptCache>;
+    friend idlib::default_delete_functor<ScriptCache>;
+
+    /**
+     * @brief
+     *  Construct this script cache.
+     * @remark
+     *  Intentionally protected.
+     */
+    ScriptCache();
+
+    /**
+     * @brief
+     *  Destruct this script cache.
+     * @remark
+     *  Intentionally protected.
+     */
+    virtual ~ScriptCache();
+
+public:
+    /**
+     * @brief
+     *  Get if this script cache is enabled.
+     * @return
+     *  @a true if this script cache is enabled, @a false otherwise
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief
+     *  Load a compiled script.
+     * @param key
+     *  the key of the entry
+     * @param sourceLength
+     *  the length, in Bytes, of the script source
+     * @return
+     *  the compiled script if a valid entry exists, a null pointer otherwise
+     */
+    std::shared_ptr<const CompiledScript> load(uint64_t key, uint64_t sourceLength);
+
+    /**
+     * @brief
+     *  Store a compiled script.
+     * @param key
+     *  the key of the entry
+     * @param sourceLength
+     *  the length, in Bytes, of the script source
+     * @param compiledScript
+     *  the compiled script
+     */
+    void store(uint64_t key, uint64_t sourceLength, const CompiledScript& compiledScript);
+
+    /// @brief Remove all entries from memory. Entries on disk are kept.
+    void clear();
+
+    /// @brief Get the number of lookups which were served from the cache.
+    size_t getHits() const;
+
+    /// @brief Get the number of lookups which were not served from the cache.
+    size_t getMisses() const;
+
+    /// @brief The outcome of decoding an entry.
+    enum class Validity
+    {
+        /// The entry is valid and was deserialized.
+        Valid,
+        /// The entry does not belong to the script source.
+        Stale,
+        /// The entry could not be deserialized.
+        Corrupted,
+    };
+
+    /**
+     * @brief
+     *  Encode an entry.
+     * @param key, sourceLength
+     *  the key of the entry and the length, in Bytes, of the script source
+     * @param compiledScript
+     *  the compiled script
+     * @param [out] buffer
+     *  the contents of the cache file of the entry
+     * @return
+     *  @a true on success, @a false if the compiled script can not be cached
+     */
+    static bool encode(uint64_t key, uint64_t sourceLength, const CompiledScript& compiledScript, std::vector<char>& buffer);
+
+    /**
+     * @brief
+     *  Decode an entry.
+     * @param data, length
+     *  the contents of the cache file of the entry
+     * @param key, sourceLength
+     *  the key of the entry and the length, in Bytes, of the script source
+     * @param [out] compiledScript
+     *  the compiled script
+     * @return
+     *  Validity::Valid if the entry was deserialized into @a compiledScript
+     */
+    static Validity decode(const char *data, size_t length, uint64_t key, uint64_t sourceLength, CompiledScript& compiledScript);
+
+private:
+    /// @brief An entry in memory.
+    struct Entry
+    {
+        /// @brief The length, in Bytes, of the script source.
+        uint64_t sourceLength;
+        /// @brief The compiled script.
+        std::shared_ptr<const CompiledScript> compiledScript;
+    };
+
+    /// @brief Get the VFS pathname of the cache file of an entry.
+    static std::string getCachePathname(uint64_t key);
+
+    /// @brief The entries in memory.
+    std::unordered_map<uint64_t, Entry> _entries;
+
+    /// @brief The number of hits.
+    size_t _hits;
+
+    /// @brief The number of misses.
+    size_t _misses;
+};
+
+} // namespace Script
+} // namespace Ego
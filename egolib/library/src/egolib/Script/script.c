@@ -23,8 +23,11 @@
 
 #include "egolib/Script/script.h"
 
+#include <chrono>
+
 #include "egolib/AI/AStar.hpp"
 #include "egolib/Script/IRuntimeStatistics.hpp"
+#include "egolib/Script/LoweredScript.hpp"
 
 #include "egolib/game/script_compile.h"
 #include "egolib/game/script_implementation.h"
@@ -95,7 +98,8 @@ Runtime::Runtime() :
     #undef Define
     },
     _statistics(std::make_unique<RuntimeStatistics>()),
-    _clock(std::make_unique<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>>("runtime clock", 1))
+    _clock(std::make_unique<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>>("runtime clock", 1)),
+    _profiler(std::make_unique<Profiler>())
 {
     /* Intentionally empty. */
 }
@@ -234,33 +238,64 @@ void scr_run_chr_script(Object *pchr)
 
     // Reset the script state.
     script_state_t my_state;
+    my_state.resolveOperandContext(aiState, pchr);
 
     // Reset the ai.
     aiState.terminate = false;
     script.indent = 0;
 
     // Run the AI Script.
-    script.set_pos(0);
-    while (!aiState.terminate && script.get_pos() < script._instructions.getNumberOfInstructions())
+    if (!script._lowered)
     {
-        // This is used by the Else function
-        // it only keeps track of functions.
-        script.indent_last = script.indent;
-        script.indent = script._instructions[script.get_pos()].getDataBits();
-
-        // Was it a function.
-        if (script._instructions[script.get_pos()].isInv())
+        script._lowered = Ego::Script::LoweredScript::lower(script._instructions, Ego::Script::Runtime::get());
+        if (!script._lowered->isLowered())
         {
-            if (!my_state.run_function_call(aiState, script))
-            {
-                break;
-            }
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to lower script ", "`", script.getName(), "`",
+                                             ": ", script._lowered->problem, ", executing the compiled form", Log::EndOfEntry);
+        }
+    }
+    if (!(debug_scripts && debug_script_file) && script._lowered->isLowered())
+    {
+        // Run the lowered form unless the script is debugged or could not be lowered.
+        auto& profiler = Ego::Script::Runtime::get().getProfiler();
+        auto *statistics = profiler.beginRun(script.getName(), *script._lowered);
+        if (statistics)
+        {
+            const auto begin = std::chrono::high_resolution_clock::now();
+            my_state.run_lowered(aiState, script, *script._lowered, statistics);
+            const auto end = std::chrono::high_resolution_clock::now();
+            profiler.endRun(*statistics, aiState.getSelf(), script_error_classname,
+                            std::chrono::duration<double, std::milli>(end - begin).count());
         }
         else
         {
-            if (!my_state.run_operation(aiState, script))
+            my_state.run_lowered(aiState, script, *script._lowered, nullptr);
+        }
+    }
+    else
+    {
+        script.set_pos(0);
+        while (!aiState.terminate && script.get_pos() < script._instructions.getNumberOfInstructions())
+        {
+            // This is used by the Else function
+            // it only keeps track of functions.
+            script.indent_last = script.indent;
+            script.indent = script._instructions[script.get_pos()].getDataBits();
+
+            // Was it a function.
+            if (script._instructions[script.get_pos()].isInv())
             {
-                break;
+                if (!my_state.run_function_call(aiState, script))
+                {
+                    break;
+                }
+            }
+            else
+            {
+                if (!my_state.run_operation(aiState, script))
+                {
+                    break;
+                }
             }
         }
     }
@@ -315,6 +350,9 @@ bool script_state_t::run_function_call(ai_state_t& aiState, script_info_t& scrip
     // Run the function
     functionreturn = run_function(aiState, script);
 
+    // The function might have changed the objects the operands refer to.
+    refreshOperandContext(aiState);
+
     // move the execution pointer to the jump code
     script.increment_pos();
     if (functionreturn)
@@ -399,23 +437,180 @@ uint8_t script_state_t::run_function(ai_state_t& aiState, script_info_t& script)
     const auto& constant = script._instructions.getConstantPool().getConstant(constantIndex);
     uint32_t functionIndex = constant.getAsInteger();
 
+    auto& runtime = Ego::Script::Runtime::get();
+    const auto& result = runtime._functionValueCodeToFunctionPointer.find(functionIndex);
+    Ego::Script::NativeInterface::Function *function = nullptr;
+    if (runtime._functionValueCodeToFunctionPointer.cend() != result)
+    {
+        function = result->second;
+    }
+    return invoke_function(aiState, functionIndex, function);
+}
+
+uint8_t script_state_t::invoke_function(ai_state_t& aiState, uint32_t functionIndex, Ego::Script::NativeInterface::Function *function)
+{
+    if (!function)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "function not found");
+    }
     // Assume that the function will pass, as most do
     uint8_t returnCode = true;
     auto& runtime = Ego::Script::Runtime::get();
     {
-
         Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(runtime.getClock());
-        const auto& result = runtime._functionValueCodeToFunctionPointer.find(functionIndex);
-        if (runtime._functionValueCodeToFunctionPointer.cend() == result)
-        {
-            throw idlib::runtime_error(__FILE__, __LINE__, "function not found");
-        }
-        returnCode = result->second(*this, aiState);
+        returnCode = function(*this, aiState);
     }
     runtime.getStatistics().onFunctionInvoked(functionIndex, runtime.getClock().lst());
     return returnCode;
 }
 
+//--------------------------------------------------------------------------------------------
+namespace {
+/// @brief Attributes the time spent on an instruction to its source line if the script run is sampled.
+struct LineScope
+{
+    Ego::Script::Profiler::LineStatistics *line;
+    std::chrono::high_resolution_clock::time_point begin;
+    explicit LineScope(Ego::Script::Profiler::LineStatistics *line)
+        : line(line), begin(line ? std::chrono::high_resolution_clock::now() : std::chrono::high_resolution_clock::time_point())
+    {}
+    LineScope(LineScope&& other)
+        : line(other.line), begin(other.begin)
+    {
+        other.line = nullptr;
+    }
+    ~LineScope()
+    {
+        if (line)
+        {
+            const auto end = std::chrono::high_resolution_clock::now();
+            line->numberOfExecutions++;
+            line->totalTime += std::chrono::duration<double, std::milli>(end - begin).count();
+        }
+    }
+};
+
+/// @brief Executes the lowered form of a script (see Ego::Script::LoweredScript::execute) for an object.
+struct LoweredMachine
+{
+    script_state_t& state;
+    ai_state_t& aiState;
+    script_info_t& script;
+    Ego::Script::Profiler::ScriptStatistics *statistics;
+
+    bool isTerminated() const
+    {
+        return aiState.terminate;
+    }
+
+    LineScope enter(const Ego::Script::LoweredInstruction& instruction, size_t index)
+    {
+        // This is used by the Else function.
+        script.indent_last = instruction.isFused() ? instruction.previousIndent : script.indent;
+        script.indent = instruction.indent;
+        return LineScope(statistics ? &statistics->lines[index] : nullptr);
+    }
+
+    bool call(uint32_t index, Ego::Script::NativeInterface::Function *function)
+    {
+        uint8_t returnCode = state.invoke_function(aiState, index, function);
+        // The function might have changed the objects the operands refer to.
+        state.refreshOperandContext(aiState);
+        return 0 != returnCode;
+    }
+
+    void assign(uint32_t index, const Ego::Script::LoweredOperand *operands, size_t numberOfOperands)
+    {
+        // Operands are not evaluated if the object running the script was terminated.
+        state.operationsum = 0;
+        if (isSelfActive())
+        {
+            for (const auto *operand = operands, *end = operands + numberOfOperands; operand != end; ++operand)
+            {
+                int32_t value = operand->isConstant ? operand->value
+                                                    : state.load_operand_variable(aiState, static_cast<uint8_t>(operand->value));
+                state.apply_operator(operand->operation, value);
+            }
+        }
+        state.storeVariable(static_cast<uint8_t>(index));
+    }
+
+    void assignConstant(uint32_t index, int32_t constant)
+    {
+        state.operationsum = isSelfActive() ? constant : 0;
+        state.storeVariable(static_cast<uint8_t>(index));
+    }
+
+    bool compare(Ego::Script::LoweredInstruction::Comparison comparison)
+    {
+        // Inlined IfXIsEqualToY, IfXIsLessThanY and IfYIsLessThanX.
+        switch (comparison)
+        {
+            case Ego::Script::LoweredInstruction::Comparison::Equal:
+                return inlined(Ego::Script::IfXIsEqualToY, [this]() { return isSelfValid() && state.x == state.y; });
+            case Ego::Script::LoweredInstruction::Comparison::Less:
+                return inlined(Ego::Script::IfXIsLessThanY, [this]() { return isSelfValid() && state.x < state.y; });
+            case Ego::Script::LoweredInstruction::Comparison::Greater:
+                return inlined(Ego::Script::IfYIsLessThanX, [this]() { return isSelfValid() && state.x > state.y; });
+            default:
+                throw idlib::unhandled_switch_case_error(__FILE__, __LINE__);
+        };
+    }
+
+    bool timeOutSetTime()
+    {
+        // Inlined IfTimeOut followed by SetTime.
+        if (!inlined(Ego::Script::IfTimeOut, [this]() { return isSelfValid() && update_wld > aiState.timer; }))
+        {
+            return false;
+        }
+        return inlined(Ego::Script::SetTime, [this]()
+        {
+            aiState.timer = UpdateTime(aiState.timer, state.argument);
+            return true;
+        });
+    }
+
+private:
+    /// @brief Run an inlined function and record it in the runtime statistics as invoke_function records a called function.
+    template <typename Function>
+    bool inlined(uint32_t functionIndex, Function function)
+    {
+        auto& runtime = Ego::Script::Runtime::get();
+        bool success;
+        {
+            Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(runtime.getClock());
+            success = function();
+        }
+        runtime.getStatistics().onFunctionInvoked(functionIndex, runtime.getClock().lst());
+        return success;
+    }
+
+    /// @brief Get if the object running the script exists and was not terminated.
+    bool isSelfActive() const
+    {
+        return nullptr != state.operandContext.self && !state.operandContext.self->isTerminated();
+    }
+
+    /// @brief Get if the object running the script is valid as required by the script functions.
+    bool isSelfValid() const
+    {
+        if (!_currentModule->getObjectHandler().exists(aiState.getSelf()))
+        {
+            return false;
+        }
+        return nullptr != _currentModule->getObjectHandler().get(aiState.getSelf())->getProfile();
+    }
+};
+} // namespace
+
+void script_state_t::run_lowered(ai_state_t& aiState, script_info_t& script, const Ego::Script::LoweredScript& lowered,
+                                 Ego::Script::Profiler::ScriptStatistics *statistics)
+{
+    LoweredMachine machine{*this, aiState, script, statistics};
+    lowered.execute(machine);
+}
+
 //--------------------------------------------------------------------------------------------
 std::string getVariableName(int variableIndex)
 {
@@ -525,7 +720,6 @@ int32_t script_state_t::loadVariable(uint8_t variableIndex, ai_state_t& aiState,
 
 void script_state_t::storeVariable(uint8_t variableIndex)
 {
-    auto variableName = getVariableName(variableIndex);
     switch (variableIndex)
     {
         case Ego::Script::VARTMPX:
@@ -570,21 +764,10 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
     /// @author ZZ
     /// @details This function does the scripted arithmetic in OPERATOR, OPERAND pscriptrs
 
-    if (!_currentModule->getObjectHandler().exists(aiState.getSelf())) return;
-    Object *pobject = _currentModule->getObjectHandler().get(aiState.getSelf());
-
-    Object *ptarget = nullptr;
-    if (_currentModule->getObjectHandler().exists(aiState.getTarget()))
-    {
-        ptarget = _currentModule->getObjectHandler().get(aiState.getTarget());
-    }
-
-    Object *powner = nullptr;
-    if (_currentModule->getObjectHandler().exists(aiState.owner))
-    {
-        powner = _currentModule->getObjectHandler().get(aiState.owner);
-    }
+    Object *pobject = operandContext.self;
+    if (nullptr == pobject || pobject->isTerminated()) return;
 
+    const bool debug = debug_scripts && debug_script_file;
     std::string varname;
 
     // get the operator
@@ -597,7 +780,7 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
     {
         // Load the constant.
         iTmp = constant.getAsInteger();
-        if (debug_scripts)
+        if (debug)
         {
             std::stringstream stringStream;
             stringStream << iTmp;
@@ -608,13 +791,50 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
     {
         // Load the variable. 
         auto variableIndex = constant.getAsInteger();
-        varname = getVariableName(variableIndex);
-        auto pleader = _currentModule->getTeamList()[pobject->team].getLeader();
-        iTmp = loadVariable(variableIndex, aiState, pobject, ptarget, powner, pleader.get());
+        if (debug)
+        {
+            varname = getVariableName(variableIndex);
+        }
+        iTmp = load_operand_variable(aiState, variableIndex);
     }
 
     // Now do the math
-    std::string op = "UNKNOWN";
+    const char *op = apply_operator(operation, iTmp);
+
+    if (debug)
+    {
+        vfs_printf(debug_script_file, "%s %s(%d) ", op, varname.c_str(), iTmp);
+    }
+}
+
+int32_t script_state_t::load_operand_variable(ai_state_t& aiState, uint8_t variableIndex)
+{
+    Object *pobject = operandContext.self;
+
+    // Objects terminated by a function since the context was resolved do not exist anymore.
+    Object *ptarget = nullptr;
+    if (operandContext.target && !operandContext.target->isTerminated())
+    {
+        ptarget = operandContext.target.get();
+    }
+
+    Object *powner = nullptr;
+    if (operandContext.owner && !operandContext.owner->isTerminated())
+    {
+        powner = operandContext.owner.get();
+    }
+
+    if (!operandContext.leaderValid)
+    {
+        operandContext.leader = _currentModule->getTeamList()[pobject->team].getLeader();
+        operandContext.leaderValid = true;
+    }
+    return loadVariable(variableIndex, aiState, pobject, ptarget, powner, operandContext.leader.get());
+}
+
+const char *script_state_t::apply_operator(uint8_t operation, int32_t iTmp)
+{
+    const char *op = "UNKNOWN";
     switch (operation)
     {
         case Ego::Script::OPADD:
@@ -682,10 +902,7 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
             break;
     }
 
-    if (debug_scripts && debug_script_file)
-    {
-        vfs_printf(debug_script_file, "%s %s(%d) ", op.c_str(), varname.c_str(), iTmp);
-    }
+    return op;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1039,7 +1256,40 @@ void ai_state_t::spawn(ai_state_t& self, const ObjectRef index, const PRO_REF io
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
+script_state_t::OperandContext::OperandContext()
+    : self(nullptr), targetRef(ObjectRef::Invalid), target(), ownerRef(ObjectRef::Invalid), owner(),
+    leader(), leaderValid(false)
+{}
+
 script_state_t::script_state_t()
     : x(0), y(0), turn(0), distance(0),
-    argument(0), operationsum()
+    argument(0), operationsum(), operandContext()
 {}
+
+void script_state_t::resolveOperandContext(ai_state_t& aiState, Object *self)
+{
+    auto& objectHandler = _currentModule->getObjectHandler();
+    operandContext.self = self;
+    operandContext.targetRef = aiState.getTarget();
+    operandContext.target = objectHandler[operandContext.targetRef];
+    operandContext.ownerRef = aiState.owner;
+    operandContext.owner = objectHandler[operandContext.ownerRef];
+    operandContext.leader = nullptr;
+    operandContext.leaderValid = false;
+}
+
+void script_state_t::refreshOperandContext(ai_state_t& aiState)
+{
+    auto& objectHandler = _currentModule->getObjectHandler();
+    if (aiState.getTarget() != operandContext.targetRef)
+    {
+        operandContext.targetRef = aiState.getTarget();
+        operandContext.target = objectHandler[operandContext.targetRef];
+    }
+    if (aiState.owner != operandContext.ownerRef)
+    {
+        operandContext.ownerRef = aiState.owner;
+        operandContext.owner = objectHandler[operandContext.ownerRef];
+    }
+    operandContext.leaderValid = false;
+}
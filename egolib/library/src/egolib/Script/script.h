@@ -30,11 +30,27 @@
 #include "egolib/Script/ConstantPool.hpp"
 #include "egolib/Script/Interpreter/TaggedValue.hpp"
 #include "egolib/Script/OpcodeInfo.hpp"
+#include "egolib/Script/Profiler.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
 class Object;
+struct ai_state_t;
+struct script_state_t;
+
+namespace Ego {
+namespace Script {
+struct LoweredScript;
+namespace NativeInterface {
+	/**
+	 * @brief
+	 *  The type of a C/C++ native interface (NI) function.
+	 */
+	using Function = uint8_t(script_state_t&, ai_state_t&);
+} // namespace NativeInterface
+} // namespace Script
+} // namespace Ego
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -252,34 +268,53 @@ public:
     using Index = uint32_t;
 
 private:
-    /// @brief The number of instructions in this instruction list.
-    /// @remark The first @a numberOfInstructions entries in the instruction array are used.
-    Size numberOfInstructions;
+    /// @brief The instructions and the constant pool of an instruction list.
+    /// @remark Shared between copies of an instruction list until one of the copies is modified.
+    struct Data
+    {
+        /// @brief The instructions.
+        std::vector<Instruction> instructions;
+
+        /// @brief The source line of each instruction.
+        std::vector<uint32_t> sourceLines;
 
-    /// @brief The instructions.
-    std::array<Instruction, MAXAICOMPILESIZE> instructions;
+        /// @brief The constant pool.
+        Ego::Script::ConstantPool constantPool;
+    };
 
-    /// @brief The constant pool.
-    Ego::Script::ConstantPool constantPool;
+    /// @brief The (possibly shared) data of this instruction list.
+    std::shared_ptr<Data> data;
+
+    /// @brief Ensure that the data of this instruction list is not shared before it is modified.
+    void detach()
+    {
+        if (1 != data.use_count())
+        {
+            data = std::make_shared<Data>(*data);
+        }
+    }
 
 public:
     /// @brief Construct an empty instruction list.
     /// @post The instruction list has an empty constant pool and zero instructions.
     InstructionList()
-        : constantPool(), instructions(), numberOfInstructions(0)
+        : data(std::make_shared<Data>())
     {}
 
     /**@{*/
 
     /// @brief Construct an instruction list with the values of another instruction list.
     /// @param other the other instruction list
+    /// @remark The instructions and the constant pool are shared until either instruction list is modified.
     InstructionList(const InstructionList& other)
-        : constantPool(other.constantPool), instructions(other.instructions), numberOfInstructions(other.numberOfInstructions)
+        : data(other.data)
     {}
 
     InstructionList(InstructionList&& other)
-        : constantPool(std::move(other.constantPool)), instructions(std::move(other.instructions)), numberOfInstructions(std::move(other.numberOfInstructions))
-    {}
+        : data(std::move(other.data))
+    {
+        other.data = std::make_shared<Data>();
+    }
 
     /**@}*/
 
@@ -296,16 +331,22 @@ public:
     {
         using std::swap;
 
-        swap(x.instructions, y.instructions);
-        swap(x.constantPool, y.constantPool);
-        swap(x.numberOfInstructions, y.numberOfInstructions);
+        swap(x.data, y.data);
+    }
+
+    /// @brief Get if this instruction list shares its instructions and its constant pool with another instruction list.
+    /// @param other the other instruction list
+    /// @return @a true if the instruction lists share their instructions and their constant pool, @a false otherwise
+    bool isSharedWith(const InstructionList& other) const
+    {
+        return data == other.data;
     }
     
     /// @brief Get the number of instructions in this instruction list.
     /// @return the number of instructions in this instruction list
     Size getNumberOfInstructions() const
     {
-        return numberOfInstructions;
+        return static_cast<Size>(data->instructions.size());
     }
 
     /// @brief Get if this instruction list is full.
@@ -322,13 +363,32 @@ public:
         return 0 == getNumberOfInstructions();
     }
 
-    void append(const Instruction& instruction)
+    /// @brief Append an instruction.
+    /// @param instruction the instruction
+    /// @param sourceLine the source line of the instruction or @a 0 if it is not known
+    /// @throw idlib::runtime_error the instruction list would overflow
+    void append(const Instruction& instruction, uint32_t sourceLine = 0)
     {
         if (isFull())
         {
             throw idlib::runtime_error(__FILE__, __LINE__, "instruction list overflow");
         }
-        instructions[numberOfInstructions++] = instruction;
+        detach();
+        data->instructions.push_back(instruction);
+        data->sourceLines.push_back(sourceLine);
+    }
+
+    /// @brief Get the source line of the instruction at the specified index.
+    /// @param index the index
+    /// @return the source line or @a 0 if it is not known
+    /// @throw idlib::runtime_error @a index is out of bounds
+    uint32_t getSourceLine(Index index) const
+    {
+        if (index >= getNumberOfInstructions())
+        {
+            throw idlib::runtime_error(__FILE__, __LINE__, "instruction index out of bounds");
+        }
+        return data->sourceLines[index];
     }
 
     /// @brief Get the instruction at the specified index.
@@ -341,36 +401,41 @@ public:
         {
             throw idlib::runtime_error(__FILE__, __LINE__, "instruction index out of bounds");
         }
-		return instructions[index];
+		return data->instructions[index];
 	}
 
-    /// @brief Get the instruction at the specified index.
+    /// @brief Set the instruction at the specified index.
     /// @param index the index
-    /// @return a reference to the instruction
+    /// @param instruction the instruction
     /// @throw idlib::runtime_error @a index is out of bounds
-    Instruction& operator[](Index index)
+    void set(Index index, const Instruction& instruction)
     {
         if (index >= getNumberOfInstructions())
         {
             throw idlib::runtime_error(__FILE__, __LINE__, "instruction index out of bounds");
         }
-		return instructions[index];
-	}
+        detach();
+        data->instructions[index] = instruction;
+    }
 
     const Ego::Script::ConstantPool& getConstantPool() const
     {
-        return constantPool;
+        return data->constantPool;
     }
 
-    Ego::Script::ConstantPool& getConstantPool()
+    /// @brief Get or create an <c>integer</c> constant in the constant pool.
+    /// @param value the value of the constant
+    /// @return the index of the constant
+    /// @throw idlib::runtime_error the constant pool would overflow
+    Ego::Script::ConstantPool::Index getOrCreateConstant(int value)
     {
-        return constantPool;
+        detach();
+        return data->constantPool.getOrCreateConstant(value);
     }
 
     void clear()
     {
-        constantPool.clear();
-        numberOfInstructions = 0;
+        data = std::make_shared<Data>();
     }
 };
 
@@ -382,7 +447,8 @@ public:
         indent(0),
         indent_last(0),
         _position(0),
-        _instructions()
+        _instructions(),
+        _lowered()
     {
         //ctor
     }
@@ -420,6 +486,13 @@ public:
 	 */
 	InstructionList _instructions;
 
+	/**
+	 * @brief
+	 *	The lowered form of the instruction list.
+	 *	Created on demand by the interpreter and reset if the instruction list changes.
+	 */
+	std::shared_ptr<Ego::Script::LoweredScript> _lowered;
+
 	bool increment_pos();
 	size_t get_pos() const;
 	bool set_pos(size_t position);
@@ -506,9 +579,42 @@ struct script_state_t : private idlib::non_copyable
     using TaggedValue = Ego::Script::Interpreter::TaggedValue;
     TaggedValue operationsum; /// The result of an arithmetic operation
 
+    /// @brief The objects the operands of a script refer to.
+    /// @remark Resolved once per script run by resolveOperandContext and refreshed by
+    /// refreshOperandContext after a function changed the target or the owner.
+    struct OperandContext
+    {
+        /// @brief The object running the script.
+        Object *self;
+        /// @brief The target reference and the target object.
+        ObjectRef targetRef;
+        std::shared_ptr<Object> target;
+        /// @brief The owner reference and the owner object.
+        ObjectRef ownerRef;
+        std::shared_ptr<Object> owner;
+        /// @brief The leader of the team of the object running the script.
+        /// Resolved on demand as only few variables refer to it.
+        std::shared_ptr<Object> leader;
+        bool leaderValid;
+
+        OperandContext();
+    };
+    OperandContext operandContext;
+
 	// public
 	script_state_t();
 
+    /// @brief Resolve the operand context for a script run.
+    /// @param aiState the A.I. state
+    /// @param self the object running the script
+    void resolveOperandContext(ai_state_t& aiState, Object *self);
+
+    /// @brief Refresh the operand context after a function was invoked.
+    /// @param aiState the A.I. state
+    /// @remark The target and the owner are resolved again only if their references changed.
+    /// The leader is resolved again on demand as functions can change the team or its leader.
+    void refreshOperandContext(ai_state_t& aiState);
+
     /// @brief Error handler for the error "variable not defined".
     /// Writes a warning log messages and raises an idlib::runtime_error.
     /// @param variableIndex the variable index
@@ -521,6 +627,35 @@ struct script_state_t : private idlib::non_copyable
 	void run_operand(ai_state_t& aiState, script_info_t& script);
 	bool run_operation(ai_state_t& aiState, script_info_t& script);
 	bool run_function_call(ai_state_t& aiState, script_info_t& script);
+
+    /// @brief Run the lowered form of a script.
+    /// @param aiState the A.I. state
+    /// @param script the script
+    /// @param lowered the lowered form of the script
+    /// @param statistics a pointer to the profiler statistics of the script if this run is sampled, a null pointer otherwise
+    void run_lowered(ai_state_t& aiState, script_info_t& script, const Ego::Script::LoweredScript& lowered,
+                     Ego::Script::Profiler::ScriptStatistics *statistics);
+
+    /// @brief Invoke a function and record its runtime statistics.
+    /// @param aiState the A.I. state
+    /// @param functionIndex the function index
+    /// @param function a pointer to the function or a null pointer
+    /// @return the return code of the function
+    /// @throw idlib::runtime_error @a function is a null pointer
+    uint8_t invoke_function(ai_state_t& aiState, uint32_t functionIndex, Ego::Script::NativeInterface::Function *function);
+
+    /// @brief Load a variable operand using the operand context.
+    /// @param aiState the A.I. state
+    /// @param variableIndex the variable index
+    /// @return the value of the variable
+    /// @pre The object running the script exists.
+    int32_t load_operand_variable(ai_state_t& aiState, uint8_t variableIndex);
+
+    /// @brief Apply an operator to the result of the arithmetic operation and an operand.
+    /// @param operation the operator
+    /// @param operand the value of the operand
+    /// @return the name of the operator
+    const char *apply_operator(uint8_t operation, int32_t operand);
 };
 
 //--------------------------------------------------------------------------------------------
@@ -542,11 +677,6 @@ template <typename FunctionType>
 struct IRuntimeStatistics;
 
 namespace NativeInterface {
-	/**
-	 * @brief
-	 *  The type of a C/C++ native interface (NI) function.
-	 */
-	using Function = uint8_t(script_state_t&, ai_state_t&);
 	/**
 	 * @brief
 	 *  Combination of a pointer to a C/C++ NI function with its name in the DSL.
@@ -619,6 +749,9 @@ private:
     /// @brief Runtime statistics (of this runtime).
     std::unique_ptr<IRuntimeStatistics<uint32_t>> _statistics;
 
+    /// @brief The profiler (of this runtime).
+    std::unique_ptr<Profiler> _profiler;
+
 public:
     /// @brief Get the clock.
     /// @return the clock
@@ -628,6 +761,10 @@ public:
     /// @brief Get the statistics.
     /// @return the statistics
     IRuntimeStatistics<uint32_t>& getStatistics() { return *_statistics; }
+
+    /// @brief Get the profiler.
+    /// @return the profiler
+    Profiler& getProfiler() { return *_profiler; }
 };
 
 } // namespace Script
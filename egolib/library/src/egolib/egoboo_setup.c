@@ -80,10 +80,13 @@ egoboo_config_t::egoboo_config_t() :
         { "nearest", idlib::texture_filter_method::nearest },
         { "linear", idlib::texture_filter_method::linear }
     }),
-    graphic_simultaneousDynamicLights_max(32, "graphic.simultaneousDynamicLights.max", "inclusive upper bound of simultaneous dynamic lights"),
+    graphic_simultaneousDynamicLights_max(512, "graphic.simultaneousDynamicLights.max", "inclusive upper bound of simultaneous dynamic lights"),
     graphic_framesPerSecond_max(30, "graphic.framesPerSecond.max", "inclusive upper bound of frames per second"),
     graphic_simultaneousParticles_max(768, "graphic.simultaneousParticles.max", "inclusive upper bound of simultaneous particles"),
     graphic_hd_textures_enable(true, "graphic.graphic_hd_textures_enable", "enable/disable HD textures"),
+    graphic_textureCache_enable(true, "graphic.textureCache.enable", "enable/disable the on-disk cache of converted textures"),
+    graphic_textureCache_capacity(256, "graphic.textureCache.capacity", "maximum size, in Mebibytes, of the on-disk cache of converted textures"),
+    graphic_fontCache_capacity(128, "graphic.fontCache.capacity", "maximum number of laid out texts cached by each font"),
     //
     graphic_window_borderless(false, "graphic.window.bordless",
                               "if the window is borderless. A bordless window neither has a caption nor an edge frame"),
@@ -119,6 +122,8 @@ egoboo_config_t::egoboo_config_t() :
         { "Normal", Ego::GameDifficulty::Normal },
         { "Hard", Ego::GameDifficulty::Hard },
     }),
+    game_scriptCache_enable(true, "game.scriptCache.enable", "enable/disable the cache of compiled A.I. scripts"),
+    game_profileCache_enable(true, "game.profileCache.enable", "enable/disable the cache of parsed enchant, object and particle profiles"),
     // Camera configuration section.
     camera_control(CameraTurnMode::Auto, "camera.control", "type of camera control",
     {
@@ -147,7 +152,8 @@ egoboo_config_t::egoboo_config_t() :
     debug_hideMouse(true,"debug.hideMouse","show/hide mouse"),
     debug_grabMouse(true,"debug.grabMouse","grab/don't grab mouse"),
     debug_developerMode_enable(false,"debug.developerMode.enable","enable/disable developer mode"),
-    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function")
+    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function"),
+    debug_nullRenderer_enable(false,"debug.nullRenderer.enable","enable/disable the null renderer which records commands instead of rendering")
 {}
 
 egoboo_config_t::~egoboo_config_t()
@@ -86,6 +86,9 @@ protected:
                 config.graphic_framesPerSecond_max,
                 config.graphic_simultaneousParticles_max,
                 config.graphic_hd_textures_enable,
+                config.graphic_textureCache_enable,
+                config.graphic_textureCache_capacity,
+                config.graphic_fontCache_capacity,
                 //
                 config.graphic_window_borderless,
                 config.graphic_window_resizable,
@@ -107,6 +110,8 @@ protected:
                 config.network_playerName,
                 //
                 config.game_difficulty,
+                config.game_scriptCache_enable,
+                config.game_profileCache_enable,
                 //
                 config.camera_control,
                 //
@@ -125,7 +130,8 @@ protected:
                 config.debug_hideMouse,
                 config.debug_grabMouse,
                 config.debug_developerMode_enable,
-                config.debug_sdlImage_enable
+                config.debug_sdlImage_enable,
+                config.debug_nullRenderer_enable
             );
         return variables;
     }
@@ -283,6 +289,20 @@ public:
     /// @remark Default value is @a true.
     Ego::Configuration::Variable<bool> graphic_hd_textures_enable;
 
+    /// @brief If @a true, converted and padded texture pixels (including their mipmaps)
+    /// are cached in the user directory and reused as long as the source image is unchanged.
+    /// @remark Default value is @a true.
+    Ego::Configuration::Variable<bool> graphic_textureCache_enable;
+
+    /// @brief The maximum size, in Mebibytes, of the on-disk cache of converted texture pixels.
+    /// If a new entry makes the cache exceed this size, the oldest entries are removed.
+    /// @remark Default value is @a 256.
+    Ego::Configuration::Variable<uint16_t> graphic_textureCache_capacity;
+
+    /// @brief The maximum number of laid out texts (and of text sizes) cached by each font.
+    /// @remark Default value is @a 128. @a 0 disables the caches.
+    Ego::Configuration::Variable<uint16_t> graphic_fontCache_capacity;
+
     /// @brief If @a true, the window is borderless, otherwise it is not.
     /// @remark A borderless window displays neither a caption nor an edge frame.
     /// @default Default is @a false.
@@ -379,6 +399,15 @@ public:
     /// @remark Default value is Ego::GameDifficulty::Normal.
     Ego::Configuration::Variable<Ego::GameDifficulty> game_difficulty;
 
+    /// @brief If @a true, compiled A.I. scripts are cached in the user directory and
+    /// shared between object profiles with identical script sources.
+    /// @remark Default value is @a true.
+    Ego::Configuration::Variable<bool> game_scriptCache_enable;
+
+    /// @brief If @a true, parsed enchant, object and particle profiles are cached in the user directory.
+    /// @remark Default value is @a true.
+    Ego::Configuration::Variable<bool> game_profileCache_enable;
+
     // HUD configuration section.
 
     /// @brief Inclusive upper bound of simultaneous messages.
@@ -448,6 +477,10 @@ public:
     /// @remark Default value is @a true.
     Ego::Configuration::Variable<bool> debug_sdlImage_enable;
 
+    /// @brief Enable/disable the null renderer which records commands instead of rendering.
+    /// @remark Default value is @a false.
+    Ego::Configuration::Variable<bool> debug_nullRenderer_enable;
+
 public:
 
     /// @brief Construct this Egoboo configuration with default settings.
@@ -152,7 +152,7 @@
  * @ingroup
  *  compile-time
  */
-#define TOTAL_MAX_DYNA 64
+#define TOTAL_MAX_DYNA 4096
 
 /**
  * @brief
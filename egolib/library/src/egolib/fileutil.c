@@ -38,7 +38,12 @@
 #undef ERROR
 
 ReadContext::ReadContext(const std::string& fileName) :
-    Scanner(fileName)
+    Scanner(fileName), m_mode(Mode::Direct)
+{
+}
+
+ReadContext::ReadContext(const std::string& fileName, std::vector<char> image) :
+    Scanner(fileName, std::move(image)), m_mode(Mode::Direct)
 {
 }
 
@@ -46,6 +51,16 @@ ReadContext::~ReadContext()
 {
 }
 
+ReadContext::Mode ReadContext::getMode() const
+{
+    return m_mode;
+}
+
+void ReadContext::setMode(Mode mode)
+{
+    m_mode = mode;
+}
+
 float ReadContext::toReal() const
 {
     float temporary;
@@ -61,6 +76,15 @@ float ReadContext::toReal() const
 
 void ReadContext::skipWhiteSpaces()
 {
+    if (Mode::Direct == m_mode)
+    {
+        const char *current = get_input_current(), *end = get_input_end();
+        while (current != end && (' ' == *current || '\t' == *current))
+        {
+            current++;
+        }
+        seek(current, 0);
+    }
     if (ise(ERROR()))
     {
         throw idlib::hll::compilation_error(__FILE__, __LINE__, idlib::hll::compilation_error_kind::lexical, get_location(),
@@ -161,6 +185,38 @@ IDSZ2 ReadContext::readIDSZ() {
 //--------------------------------------------------------------------------------------------
 bool ReadContext::skipToDelimiter(char delimiter, bool optional)
 {
+    if (Mode::Direct == m_mode && '\n' != delimiter && '\r' != delimiter)
+    {
+        const char *current = get_input_current(), *end = get_input_end();
+        size_t numberOfLines = 0;
+        while (current != end)
+        {
+            const char c = *current++;
+            if (c == delimiter)
+            {
+                seek(current, numberOfLines);
+                return true;
+            }
+            // Count new lines like Scanner::new_line: "\n\r" and "\r\n" are a single new line.
+            if ('\n' == c || '\r' == c)
+            {
+                if (current != end && ('\n' == *current || '\r' == *current) && c != *current)
+                {
+                    current++;
+                }
+                numberOfLines++;
+            }
+        }
+        seek(current, numberOfLines);
+        if (optional)
+        {
+            return false;
+        }
+        else
+        {
+            throw Ego::Script::MissingDelimiterError(__FILE__, __LINE__, get_location(), delimiter);
+        }
+    }
     while (true)
     {
         if (ise(ERROR()))
@@ -967,8 +1023,193 @@ Ego::Script::DDLToken ReadContext::parseRealLiteral()
     return Ego::Script::DDLToken(Ego::Script::DDLTokenKind::Real, startLocation, get_lexeme_text());
 }
 
+namespace {
+
+/// @brief The powers of ten which are exactly representable by a value of type @a float.
+const float powersOfTen[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+/// @brief Scan a non-empty sequence of decimal digits.
+/// @param [in,out] current the current character
+/// @param end the end of the input
+/// @param [out] value the value of the digits
+/// @param [out] numberOfDigits the number of digits
+/// @return @a false if no digit was scanned or if the value does not fit into a @a uint64_t, @a true otherwise
+bool scanDigits(const char *& current, const char *end, uint64_t& value, size_t& numberOfDigits)
+{
+    value = 0;
+    numberOfDigits = 0;
+    while (current != end && '0' <= *current && *current <= '9')
+    {
+        const uint64_t digit = *current - '0';
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+        {
+            return false;
+        }
+        value = value * 10 + digit;
+        numberOfDigits++;
+        current++;
+    }
+    return 0 < numberOfDigits;
+}
+
+bool isDigit(const char *current, const char *end)
+{
+    return current != end && '0' <= *current && *current <= '9';
+}
+
+} // namespace
+
+bool ReadContext::readStringLiteralDirect(std::string& value)
+{
+    const char *start = get_input_current(), *end = get_input_end(), *current = start;
+    while (current != end && ' ' != *current && '\t' != *current)
+    {
+        const unsigned char c = static_cast<unsigned char>(*current);
+        if (c < 0x20 || c > 0x7e)
+        {
+            // New lines terminate the literal, other control characters and non-ASCII
+            // characters are left to the tokenizing scanner.
+            if ('\n' == c || '\r' == c)
+            {
+                break;
+            }
+            return false;
+        }
+        current++;
+    }
+    value.assign(start, current);
+    for (auto& c : value)
+    {
+        if ('~' == c) c = '\t';
+        else if ('_' == c) c = ' ';
+    }
+    seek(current, 0);
+    return true;
+}
+
+bool ReadContext::readIntegerLiteralDirect(signed int& value)
+{
+    const char *current = get_input_current(), *end = get_input_end();
+    bool negative = false;
+    if (current != end && '-' == *current)
+    {
+        negative = true;
+        current++;
+    }
+    uint64_t magnitude;
+    size_t numberOfDigits;
+    if (!scanDigits(current, end, magnitude, numberOfDigits) || (current != end && ('e' == *current || 'E' == *current)))
+    {
+        return false;
+    }
+    const uint64_t limit = negative ? uint64_t(std::numeric_limits<signed int>::max()) + 1
+                                    : uint64_t(std::numeric_limits<signed int>::max());
+    if (magnitude > limit)
+    {
+        return false;
+    }
+    value = negative ? static_cast<signed int>(-static_cast<int64_t>(magnitude)) : static_cast<signed int>(magnitude);
+    seek(current, 0);
+    return true;
+}
+
+bool ReadContext::readNaturalLiteralDirect(unsigned int& value)
+{
+    const char *current = get_input_current(), *end = get_input_end();
+    uint64_t magnitude;
+    size_t numberOfDigits;
+    if (!scanDigits(current, end, magnitude, numberOfDigits) || (current != end && ('e' == *current || 'E' == *current)) ||
+        magnitude > std::numeric_limits<unsigned int>::max())
+    {
+        return false;
+    }
+    value = static_cast<unsigned int>(magnitude);
+    seek(current, 0);
+    return true;
+}
+
+bool ReadContext::readRealLiteralDirect(float& value)
+{
+    const char *current = get_input_current(), *end = get_input_end();
+    bool negative = false;
+    if (current != end && ('+' == *current || '-' == *current))
+    {
+        negative = '-' == *current;
+        current++;
+    }
+    // real := sign? ((digit+ ('.' digit*)?) | ('.' digit+)) (('e'|'E') sign? digit+)?
+    uint64_t mantissa = 0;
+    size_t numberOfIntegralDigits = 0, numberOfFractionalDigits = 0;
+    if (isDigit(current, end) && !scanDigits(current, end, mantissa, numberOfIntegralDigits))
+    {
+        return false;
+    }
+    if (current != end && '.' == *current)
+    {
+        current++;
+        // Append the fractional digits to the mantissa.
+        while (isDigit(current, end))
+        {
+            const uint64_t digit = *current - '0';
+            if (mantissa > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+            {
+                return false;
+            }
+            mantissa = mantissa * 10 + digit;
+            numberOfFractionalDigits++;
+            current++;
+        }
+    }
+    if (0 == numberOfIntegralDigits + numberOfFractionalDigits)
+    {
+        return false;
+    }
+    int64_t exponent = -static_cast<int64_t>(numberOfFractionalDigits);
+    if (current != end && ('e' == *current || 'E' == *current))
+    {
+        current++;
+        bool negativeExponent = false;
+        if (current != end && ('+' == *current || '-' == *current))
+        {
+            negativeExponent = '-' == *current;
+            current++;
+        }
+        uint64_t explicitExponent;
+        size_t numberOfExponentDigits;
+        if (!scanDigits(current, end, explicitExponent, numberOfExponentDigits) || explicitExponent > 64)
+        {
+            return false;
+        }
+        exponent += negativeExponent ? -static_cast<int64_t>(explicitExponent) : static_cast<int64_t>(explicitExponent);
+    }
+    // The mantissa and the power of ten are exactly representable by values of type float,
+    // hence a single multiplication or division yields the correctly rounded value.
+    // All other literals are left to the decoder.
+    if (mantissa > (uint64_t(1) << 24) || exponent < -10 || exponent > 10)
+    {
+        return false;
+    }
+    float temporary = static_cast<float>(mantissa);
+    if (exponent < 0)
+    {
+        temporary /= powersOfTen[-exponent];
+    }
+    else
+    {
+        temporary *= powersOfTen[exponent];
+    }
+    value = negative ? -temporary : temporary;
+    seek(current, 0);
+    return true;
+}
+
 std::string ReadContext::readStringLiteral() {
     skipWhiteSpaces();
+    std::string value;
+    if (Mode::Direct == m_mode && readStringLiteralDirect(value))
+    {
+        return value;
+    }
     auto token = parseStringLiteral();
     return Ego::Script::DDLTokenDecoder<std::string>()(token);
 }
@@ -981,18 +1222,33 @@ char ReadContext::readCharacterLiteral() {
 
 signed int ReadContext::readIntegerLiteral() {
     skipWhiteSpaces();
+    signed int value;
+    if (Mode::Direct == m_mode && readIntegerLiteralDirect(value))
+    {
+        return value;
+    }
     auto token = parseIntegerLiteral();
     return Ego::Script::DDLTokenDecoder<signed int>()(token);
 }
 
 unsigned int ReadContext::readNaturalLiteral() {
     skipWhiteSpaces();
+    unsigned int value;
+    if (Mode::Direct == m_mode && readNaturalLiteralDirect(value))
+    {
+        return value;
+    }
     auto token = parseNaturalLiteral();
     return Ego::Script::DDLTokenDecoder<unsigned int>()(token);
 }
 
 float ReadContext::readRealLiteral() {
     skipWhiteSpaces();
+    float value;
+    if (Mode::Direct == m_mode && readRealLiteralDirect(value))
+    {
+        return value;
+    }
     auto token = parseRealLiteral();
     return Ego::Script::DDLTokenDecoder<float>()(token);
 }
@@ -59,8 +59,38 @@ struct ReadContext : public Ego::Script::Scanner<Ego::Script::Traits<char>>
 public:   
     using Traits = Ego::Script::Traits<char>;
 
+    /**
+     * @brief
+     *  The modes of a context.
+     */
+    enum class Mode
+    {
+        /**
+         * @brief
+         *  Literals are scanned into tokens and the tokens are decoded.
+         */
+        Tokens,
+        /**
+         * @brief
+         *  Literals are scanned and decoded directly from the in-memory image of the file.
+         *  Literals not supported by the direct scanning functions (e.g. integer literals with exponents)
+         *  and erroneous literals are handled as in mode Mode::Tokens.
+         */
+        Direct,
+    };
+
     ReadContext(const std::string& fileName);
 
+    /**
+     * @brief
+     *  Construct this context from an in-memory image of a file.
+     * @param fileName
+     *  the file name (used for error reporting only)
+     * @param image
+     *  the contents of the file
+     */
+    ReadContext(const std::string& fileName, std::vector<char> image);
+
     ~ReadContext();
 
     /**
@@ -302,6 +332,30 @@ public:
     ReadContext(const ReadContext& copy) = delete;
     ReadContext& operator=(const ReadContext&) = delete;
 
+    /// @brief Get the mode of this context.
+    /// @return the mode of this context
+    Mode getMode() const;
+
+    /// @brief Set the mode of this context.
+    /// @param mode the mode
+    /// @remark The default mode is Mode::Direct.
+    void setMode(Mode mode);
+
+private:
+    /// @brief The mode of this context.
+    Mode m_mode;
+
+    /// @{
+    /// @brief Scan and decode a literal directly from the in-memory image of the file.
+    /// @param [out] value the value of the literal
+    /// @return @a true if a literal was scanned and decoded, @a false if the literal must be scanned and decoded by its token
+    /// @post If @a true is returned, the literal was consumed. Otherwise, no input was consumed.
+    bool readStringLiteralDirect(std::string& value);
+    bool readIntegerLiteralDirect(signed int& value);
+    bool readNaturalLiteralDirect(unsigned int& value);
+    bool readRealLiteralDirect(float& value);
+    /// @}
+
 public:
 
 	std::string readStringLiteral();
@@ -31,10 +31,96 @@
 #include "egolib/game/game.h"
 #include "egolib/Entities/_Include.hpp"
 #include "egolib/game/Physics/CollisionSystem.hpp"
+#include "egolib/Script/script.h"
+#include "egolib/Script/IRuntimeStatistics.hpp"
+#include "egolib/Script/ReadContextBenchmark.hpp"
 
 //Global singelton
 std::unique_ptr<GameEngine> _gameEngine;
 
+/// @brief Handle the console commands of the script profiler.
+/// - <c>profileScripts()</c> and <c>profileScripts(n)</c> start profiling every (n-th) script run
+/// - <c>stopProfilingScripts()</c> stops profiling
+/// - <c>resetScriptProfile()</c> removes the statistics
+/// - <c>dumpScriptProfile()</c> writes the statistics to <c>/debug/script_profile.txt</c> and prints the hot spots
+/// @param command the command
+/// @return @a true if the command was handled, @a false otherwise
+static bool handleScriptProfilerCommand(const std::string& command)
+{
+    static const std::string profileScripts = "profileScripts(";
+    if (0 != command.compare(0, profileScripts.size(), profileScripts) &&
+        command != "stopProfilingScripts()" && command != "resetScriptProfile()" && command != "dumpScriptProfile()")
+    {
+        return false;
+    }
+    scripting_system_begin();
+    auto& runtime = Ego::Script::Runtime::get();
+    auto& profiler = runtime.getProfiler();
+    auto& console = Ego::Core::Console::get();
+    if (command == "stopProfilingScripts()")
+    {
+        profiler.stop();
+        console.add_output("script profiler stopped\n");
+    }
+    else if (command == "resetScriptProfile()")
+    {
+        profiler.reset();
+        runtime.getStatistics().reset();
+        console.add_output("script profile reset\n");
+    }
+    else if (command == "dumpScriptProfile()")
+    {
+        if (!profiler.write("/debug/script_profile.txt"))
+        {
+            console.add_output("unable to write /debug/script_profile.txt\n");
+        }
+        // The function timings are appended to /debug/script_function_timing.txt by scripting_system_end.
+        console.add_output(profiler.getSummary(5));
+    }
+    else
+    {
+        // "profileScripts(" [interval] ")"
+        const std::string argument = command.substr(profileScripts.size());
+        int samplingInterval = 1;
+        if (argument != ")" && (1 != sscanf(argument.c_str(), "%d)", &samplingInterval) || samplingInterval < 1))
+        {
+            console.add_output("usage: profileScripts() or profileScripts(n) with n > 0\n");
+            return true;
+        }
+        profiler.start(static_cast<uint32_t>(samplingInterval));
+        std::ostringstream os;
+        os << "script profiler started, sampling every " << samplingInterval << ". script run" << std::endl;
+        console.add_output(os.str());
+    }
+    return true;
+}
+
+/// @brief Handle the console command of the ReadContext benchmark.
+/// - <c>benchmarkReadContext()</c> and <c>benchmarkReadContext(n)</c> parse all <c>.txt</c> files (n times)
+///   in both ReadContext modes and print the throughputs
+/// @param command the command
+/// @return @a true if the command was handled, @a false otherwise
+static bool handleReadContextBenchmarkCommand(const std::string& command)
+{
+    static const std::string benchmarkReadContext = "benchmarkReadContext(";
+    if (0 != command.compare(0, benchmarkReadContext.size(), benchmarkReadContext))
+    {
+        return false;
+    }
+    auto& console = Ego::Core::Console::get();
+    // "benchmarkReadContext(" [repetitions] ")"
+    const std::string argument = command.substr(benchmarkReadContext.size());
+    int numberOfRepetitions = 1;
+    if (argument != ")" && (1 != sscanf(argument.c_str(), "%d)", &numberOfRepetitions) || numberOfRepetitions < 1))
+    {
+        console.add_output("usage: benchmarkReadContext() or benchmarkReadContext(n) with n > 0\n");
+        return true;
+    }
+    auto result = Ego::Script::benchmarkReadContext("/", static_cast<size_t>(numberOfRepetitions));
+    console.add_output(result.getSummary());
+    return true;
+}
+
 //Declaration of class constants
 const uint32_t GameEngine::GAME_TARGET_FPS;
 const uint32_t GameEngine::GAME_TARGET_UPS;
@@ -324,6 +410,14 @@ bool GameEngine::initialize()
 
 	Ego::Core::Console::initialize(rectangle);
 	Ego::Core::Console::get().ExecuteCommand.subscribe([this](std::string command) {
+		if (handleScriptProfilerCommand(command))
+		{
+			return;
+		}
+		if (handleReadContextBenchmarkCommand(command))
+		{
+			return;
+		}
 		if (command == "grog()" || command == "daze()")
 		{
 			auto activePlayingState = getActivePlayingState();
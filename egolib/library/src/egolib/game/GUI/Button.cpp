@@ -1,4 +1,5 @@
 #include "egolib/game/GUI/Button.hpp"
+#include "egolib/Graphics/TextBatch.hpp"
 
 namespace Ego {
 namespace GUI {
@@ -50,6 +51,9 @@ void Button::draw(DrawingContext& drawingContext) {
     //Update slidy button effect
     updateSlidyButtonEffect();
 
+    // Render the pending text first as the button might overlap it.
+    TextBatch::flushActive();
+
     auto &renderer = Renderer::get();
 
     // Draw the button
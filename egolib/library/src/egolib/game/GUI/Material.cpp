@@ -22,6 +22,7 @@
 /// @author Michael Heilmann
 
 #include "egolib/game/GUI/Material.hpp"
+#include "egolib/Graphics/TextBatch.hpp"
 
 namespace Ego {
 namespace GUI {
@@ -31,6 +32,9 @@ Material::Material(const std::shared_ptr<const Texture>& texture, const Colour4f
 	{}
 
 void Material::apply() const {
+	// (0) render the pending text before the state it relies on is changed
+	TextBatch::flushActive();
+
 	auto& renderer = Renderer::get();
 	
 	// (1) texture
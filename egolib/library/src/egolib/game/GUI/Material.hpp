@@ -50,6 +50,7 @@ public:
 	
 public:
 	/// @brief Apply the material to the renderer state.
+	/// @remark The active text batch is flushed before the renderer state is changed.
 	virtual void apply() const;
 
 public:
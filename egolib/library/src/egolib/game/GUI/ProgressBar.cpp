@@ -1,4 +1,5 @@
 #include "ProgressBar.hpp"
+#include "egolib/Graphics/TextBatch.hpp"
 
 namespace Ego {
 namespace GUI {
@@ -15,6 +16,9 @@ void ProgressBar::draw(DrawingContext& drawingContext) {
         float x, y;
     };
 
+    // Render the pending text first as the bar might overlap it.
+    TextBatch::flushActive();
+
     auto &renderer = Renderer::get();
     const auto &vd = _gameEngine->getUIManager()->_vertexDescriptor;
     const auto &vb = _gameEngine->getUIManager()->_vertexBuffer;
@@ -26,6 +26,7 @@
 #include "egolib/game/graphic.h"
 #include "egolib/game/GUI/Material.hpp"
 #include "egolib/Graphics/VertexFormat.hpp"
+#include "egolib/Graphics/TextBatch.hpp"
 #include "egolib/game/game.h" //TODO: Remove only for DisplayMessagePrintf
 
 namespace Ego {
@@ -34,6 +35,8 @@ namespace GUI {
 UIManager::UIManager() :
     _fonts(),
     _renderSemaphore(0),
+    _renderAttrib(),
+    _textBatch(std::make_unique<TextBatch>()),
     _bitmapFontTexture(TextureManager::get().getTexture("mp_data/font_new_shadow")),
     _vertexDescriptor(descriptor_factory<idlib::vertex_format::P2F>()()),
     _textureQuadVertexDescriptor(descriptor_factory<idlib::vertex_format::P2FT2F>()()),
@@ -74,8 +77,8 @@ void UIManager::beginRenderUI() {
 
     auto& renderer = Renderer::get();
 
-    // do not use the ATTRIB_PUSH macro, since the glPopAttrib() is in a different function
-    GL_DEBUG(glPushAttrib)(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_VIEWPORT_BIT);
+    // The attributes are popped in endRenderUI.
+    _renderAttrib = std::make_unique<OpenGL::PushAttrib>(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_VIEWPORT_BIT);
 
     // Don't worry about hidden surfaces.
     renderer.setDepthTestEnabled(false);
@@ -103,6 +106,9 @@ void UIManager::beginRenderUI() {
     renderer.setProjectionMatrix(projection);
     renderer.setViewMatrix(idlib::identity<Matrix4f4f>());
     renderer.setWorldMatrix(idlib::identity<Matrix4f4f>());
+
+    // Collect the text and render it with one draw per glyph atlas page.
+    TextBatch::setActive(_textBatch.get());
 }
 
 void UIManager::endRenderUI() {
@@ -112,9 +118,12 @@ void UIManager::endRenderUI() {
         return;
     }
 
+    // Render the pending text.
+    _textBatch->flush();
+    TextBatch::setActive(nullptr);
+
     // Re-enable any states disabled by gui_beginFrame
-    // do not use the ATTRIB_POP macro, since the glPushAttrib() is in a different function
-    GL_DEBUG(glPopAttrib)();
+    _renderAttrib = nullptr;
 }
 
 int UIManager::getScreenWidth() const {
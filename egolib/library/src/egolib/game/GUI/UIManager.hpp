@@ -28,9 +28,13 @@
 // Forward declarations.
 namespace Ego {
 class Font; 
+class TextBatch;
 namespace GUI {
 class Material;
 }
+namespace OpenGL {
+struct PushAttrib;
+}
 }
 
 namespace Ego {
@@ -145,6 +149,7 @@ public:
     /// Draw a 2D quad.
     /// @param target the target rectangle in screen coordinates
     /// @param source the source rectangle in texture coordinates
+    /// @remark The caller must flush the active text batch before it changes the renderer state for the quad.
     void drawQuad2d(const Rectangle2f& target, const Rectangle2f& source);
     /// Draw a 2D quadriliteral.
     /// @param target the target rectangle in screen coordinates
@@ -165,6 +170,10 @@ public:
 private:
     std::array<std::shared_ptr<Font>, NR_OF_UI_FONTS> _fonts;
     int _renderSemaphore;
+    /// @brief The attributes pushed by beginRenderUI and popped by endRenderUI.
+    std::unique_ptr<OpenGL::PushAttrib> _renderAttrib;
+    /// @brief The batch collecting the text drawn between beginRenderUI and endRenderUI.
+    std::unique_ptr<TextBatch> _textBatch;
     std::shared_ptr<Texture> _bitmapFontTexture;
 
     /// @brief Vertex descriptor & vertex buffer to render textured quadriliterals.
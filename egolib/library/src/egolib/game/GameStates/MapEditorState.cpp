@@ -104,6 +104,7 @@ void MapEditorState::update()
 
 void MapEditorState::drawContainer(Ego::GUI::DrawingContext& drawingContext)
 {
+    CameraSystem::get().prepareAll(gfx_system_prepare_world);
     CameraSystem::get().renderAll(gfx_system_render_world);
     draw_hud();
 
@@ -135,6 +135,7 @@ void PlayingState::update()
 
 void PlayingState::drawContainer(Ego::GUI::DrawingContext& drawingContext)
 {
+    CameraSystem::get().prepareAll(gfx_system_prepare_world);
     CameraSystem::get().renderAll(gfx_system_render_world);
     draw_hud();
 }
@@ -90,6 +90,29 @@ void CameraSystem::resetAllTargets( const ego_mesh_t * mesh )
     }
 }
 
+egolib_rv CameraSystem::prepareAll(std::function<void(const std::vector<std::shared_ptr<Camera>>&)> prepareFunction)
+{
+    if ( NULL == prepareFunction ) {
+        return rv_error;
+    }
+
+    std::vector<std::shared_ptr<Camera>> cameras;
+    for(const auto &camera : _cameraList)
+    {
+        // has this camera already rendered this frame?
+        if ( camera->getLastFrame() >= 0 && static_cast<uint32_t>(camera->getLastFrame()) >= _gameEngine->getNumberOfFramesRendered()) {
+            continue;
+        }
+        cameras.push_back(camera);
+    }
+
+    if (!cameras.empty()) {
+        prepareFunction(cameras);
+    }
+
+    return rv_success;
+}
+
 egolib_rv CameraSystem::renderAll(std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction)
 {
     if ( NULL == renderFunction ) {
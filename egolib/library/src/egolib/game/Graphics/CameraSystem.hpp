@@ -51,6 +51,17 @@ public:
 	void updateAll( const ego_mesh_t * mesh );
 	void resetAllTargets( const ego_mesh_t * mesh );
 
+	/**
+	 * @brief
+	 *  Prepare the scenes of all cameras which have not rendered in this frame yet.
+	 * @param prepareFunction
+	 *  a function invoked once with all these cameras
+	 * @remark
+	 *  Must be invoked before renderAll in each frame. The scenes of the cameras are prepared together
+	 *  such that the work shared by the cameras is done once and the work of each camera can run concurrently.
+	 */
+	egolib_rv prepareAll(std::function<void(const std::vector<std::shared_ptr<Camera>>&)> prepareFunction);
+
 	egolib_rv renderAll(std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction);
 
 	/**
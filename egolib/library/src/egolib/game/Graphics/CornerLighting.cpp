@@ -0,0 +1,115 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file egolib/game/Graphics/CornerLighting.cpp
+/// @brief Structure-of-arrays evaluation of the grid lighting at the corners of tiles.
+
+#include "egolib/game/Graphics/CornerLighting.hpp"
+
+namespace Ego {
+namespace Graphics {
+
+CornerLighting::CornerLighting()
+    : _tiles(), _low(), _high(),
+      _normalX(), _normalY(), _normalZ(),
+      _highWeight(), _directWeight(), _light() {
+}
+
+void CornerLighting::clear() {
+    _tiles.clear();
+}
+
+void CornerLighting::addTile(const Index1D& tile) {
+    _tiles.push_back(tile);
+    const size_t corners = 4 * _tiles.size();
+    if (_light.size() < corners) {
+        // Grow geometrically, the arrays are never shrunk.
+        const size_t size = std::max(corners, 2 * _light.size());
+        for (size_t i = 0; i < LIGHTING_VEC_SIZE; ++i) {
+            _low[i].resize(size);
+            _high[i].resize(size);
+        }
+        _normalX.resize(size);
+        _normalY.resize(size);
+        _normalZ.resize(size);
+        _highWeight.resize(size);
+        _directWeight.resize(size);
+        _light.resize(size);
+    }
+}
+
+size_t CornerLighting::getTileCount() const {
+    return _tiles.size();
+}
+
+const Index1D& CornerLighting::getTile(size_t tile) const {
+    return _tiles[tile];
+}
+
+void CornerLighting::setCorner(size_t tile, size_t corner, const lighting_cache_t& grid, const Ego::Vector3f& normal,
+                               float z, const Ego::AxisAlignedBox3f& bbox, bool reflective) {
+    const size_t i = 4 * tile + corner;
+    for (size_t j = 0; j < LIGHTING_VEC_SIZE; ++j) {
+        _low[j][i] = grid.low._lighting[j];
+        _high[j][i] = grid.hgh._lighting[j];
+    }
+    _normalX[i] = normal[kX];
+    _normalY[i] = normal[kY];
+    _normalZ[i] = normal[kZ];
+    const float highWeight = (z - bbox.get_min()[kZ]) / (bbox.get_max()[kZ] - bbox.get_min()[kZ]);
+    _highWeight[i] = Ego::Math::constrain(highWeight, 0.0f, 1.0f);
+    _directWeight[i] = reflective ? 0.5f : 1.0f;
+}
+
+void CornerLighting::evaluate(size_t firstTile, size_t lastTile) {
+    // Alias the arrays such that the compiler does not reload the data pointers in the loop.
+    const float *lowPX = _low[LVEC_PX].data(), *lowMX = _low[LVEC_MX].data(),
+                *lowPY = _low[LVEC_PY].data(), *lowMY = _low[LVEC_MY].data(),
+                *lowPZ = _low[LVEC_PZ].data(), *lowMZ = _low[LVEC_MZ].data(),
+                *lowAmb = _low[LVEC_AMB].data();
+    const float *highPX = _high[LVEC_PX].data(), *highMX = _high[LVEC_MX].data(),
+                *highPY = _high[LVEC_PY].data(), *highMY = _high[LVEC_MY].data(),
+                *highPZ = _high[LVEC_PZ].data(), *highMZ = _high[LVEC_MZ].data(),
+                *highAmb = _high[LVEC_AMB].data();
+    const float *normalX = _normalX.data(), *normalY = _normalY.data(), *normalZ = _normalZ.data();
+    const float *highWeight = _highWeight.data(), *directWeight = _directWeight.data();
+    float *light = _light.data();
+
+    // This is lighting_cache_t::lighting_evaluate_cache without branches: Light from the +x (-x) direction only
+    // illuminates corners with a positive (negative) x-component of the normal, likewise for y and z.
+    for (size_t i = 4 * firstTile, n = 4 * lastTile; i < n; ++i) {
+        const float px = std::max(normalX[i], 0.0f), mx = std::max(-normalX[i], 0.0f),
+                    py = std::max(normalY[i], 0.0f), my = std::max(-normalY[i], 0.0f),
+                    pz = std::max(normalZ[i], 0.0f), mz = std::max(-normalZ[i], 0.0f);
+        const float lowDirect = px * lowPX[i] + mx * lowMX[i] + py * lowPY[i] + my * lowMY[i] + pz * lowPZ[i] + mz * lowMZ[i];
+        const float highDirect = px * highPX[i] + mx * highMX[i] + py * highPY[i] + my * highMY[i] + pz * highPZ[i] + mz * highMZ[i];
+        const float high = highWeight[i], low = 1.0f - high;
+        const float ambient = low * lowAmb[i] + high * highAmb[i];
+        const float direct = low * lowDirect + high * highDirect;
+        light[i] = ambient + directWeight[i] * direct;
+    }
+}
+
+float CornerLighting::getLight(size_t tile, size_t corner) const {
+    return _light[4 * tile + corner];
+}
+
+} // namespace Graphics
+} // namespace Ego
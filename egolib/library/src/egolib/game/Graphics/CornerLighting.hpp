@@ -0,0 +1,104 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file egolib/game/Graphics/CornerLighting.hpp
+/// @brief Structure-of-arrays evaluation of the grid lighting at the corners of tiles.
+
+#pragma once
+
+#include "egolib/game/lighting.h"
+#include "egolib/Mesh/Info.hpp"
+
+namespace Ego {
+namespace Graphics {
+
+/**
+ * @brief
+ *  The inputs and outputs of the evaluation of the grid lighting at the four corners of a list of tiles.
+ * @remark
+ *  Each input and output is stored in its own contiguous array with one element per corner, the corners
+ *  of the i-th tile are the elements 4 * i to 4 * i + 3. The evaluation of a range of corners is a single
+ *  branch-free loop over these arrays which the compiler turns into SIMD code.
+ * @remark
+ *  The corners of different tiles can be set and evaluated from different threads.
+ *  Adding tiles must not happen concurrently with any other operation.
+ */
+class CornerLighting {
+public:
+    /// @brief Construct this object. It has no tiles.
+    CornerLighting();
+
+    /// @brief Remove all tiles. The arrays keep their capacities.
+    void clear();
+
+    /// @brief Append a tile.
+    void addTile(const Index1D& tile);
+
+    /// @brief Get the number of tiles.
+    size_t getTileCount() const;
+
+    /// @brief Get the i-th tile.
+    const Index1D& getTile(size_t tile) const;
+
+    /**
+     * @brief
+     *  Set the inputs of a corner.
+     * @param tile, corner
+     *  the index of the tile and the index of the corner of the tile
+     * @param grid
+     *  the grid lighting at the corner
+     * @param normal
+     *  the normal at the corner
+     * @param z
+     *  the height of the corner
+     * @param bbox
+     *  the bounding box of the mesh
+     * @param reflective
+     *  if the tile is reflective. The ambient light of reflective tiles only illuminates 1/2.
+     * @see lighting_cache_t::lighting_evaluate_cache
+     */
+    void setCorner(size_t tile, size_t corner, const lighting_cache_t& grid, const Ego::Vector3f& normal,
+                   float z, const Ego::AxisAlignedBox3f& bbox, bool reflective);
+
+    /**
+     * @brief
+     *  Evaluate the lighting at the corners of a range of tiles.
+     * @param firstTile, lastTile
+     *  the index of the first tile and the past-the-end index of the range
+     */
+    void evaluate(size_t firstTile, size_t lastTile);
+
+    /// @brief Get the lighting at a corner as computed by the last evaluation.
+    float getLight(size_t tile, size_t corner) const;
+
+private:
+    std::vector<Index1D> _tiles;
+    /// @brief The lighting vector components of the low and the high grid lighting.
+    std::array<std::vector<float>, LIGHTING_VEC_SIZE> _low, _high;
+    std::vector<float> _normalX, _normalY, _normalZ;
+    /// @brief The weight of the high grid lighting, the weight of the low grid lighting is one minus that weight.
+    std::vector<float> _highWeight;
+    /// @brief The weight of the directed light.
+    std::vector<float> _directWeight;
+    std::vector<float> _light;
+};
+
+} // namespace Graphics
+} // namespace Ego
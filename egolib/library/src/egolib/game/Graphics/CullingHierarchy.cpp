@@ -0,0 +1,129 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Graphics/CullingHierarchy.cpp
+/// @brief A bounding volume hierarchy over the tiles of a mesh for view frustum culling.
+
+#include "egolib/game/Graphics/CullingHierarchy.hpp"
+#include "egolib/frustum.h"
+
+namespace Ego {
+namespace Graphics {
+
+namespace {
+
+/// @brief Join bounds with other bounds. Unlike oct_bb_t::join, empty bounds are the neutral element.
+void joinBounds(oct_bb_t& target, const oct_bb_t& source) {
+    if (source.isEmpty()) {
+        return;
+    }
+    if (target.isEmpty()) {
+        oct_bb_t::copy(target, source);
+    } else {
+        target.join(source);
+    }
+}
+
+} // namespace
+
+CullingHierarchy::CullingHierarchy(const MeshInfo& info)
+    : _info(info),
+      _chunkCountX((info.getTileCountX() + ChunkSize - 1) / ChunkSize),
+      _chunkCountY((info.getTileCountY() + ChunkSize - 1) / ChunkSize),
+      _regionCountX((_chunkCountX + RegionSize - 1) / RegionSize),
+      _regionCountY((_chunkCountY + RegionSize - 1) / RegionSize),
+      _chunkBounds(_chunkCountX * _chunkCountY),
+      _regionBounds(_regionCountX * _regionCountY) {
+}
+
+void CullingHierarchy::build(const std::function<const oct_bb_t&(const Index1D&)>& tileBounds) {
+    for (auto& bounds : _chunkBounds) {
+        bounds = oct_bb_t();
+    }
+    for (auto& bounds : _regionBounds) {
+        bounds = oct_bb_t();
+    }
+    for (size_t y = 0; y < _info.getTileCountY(); ++y) {
+        for (size_t x = 0; x < _info.getTileCountX(); ++x) {
+            const Index1D index = _info.map(Index2D(static_cast<int>(x), static_cast<int>(y)));
+            joinBounds(_chunkBounds[(y / ChunkSize) * _chunkCountX + x / ChunkSize], tileBounds(index));
+        }
+    }
+    for (size_t y = 0; y < _chunkCountY; ++y) {
+        for (size_t x = 0; x < _chunkCountX; ++x) {
+            joinBounds(_regionBounds[(y / RegionSize) * _regionCountX + x / RegionSize], _chunkBounds[y * _chunkCountX + x]);
+        }
+    }
+}
+
+Math::Relation CullingHierarchy::intersects(const Frustum& frustum, const oct_bb_t& bounds) {
+    if (bounds.isEmpty()) {
+        return Math::Relation::outside;
+    }
+    // As for entities, the near and the far plane are ignored.
+    return frustum.intersects(bounds.toAxisAlignedBox(), false);
+}
+
+void CullingHierarchy::cullChunk(size_t chunkX, size_t chunkY, bool test, const Frustum& frustum,
+                                 const std::function<const oct_bb_t&(const Index1D&)>& tileBounds,
+                                 std::vector<Index1D>& tiles, oct_bb_t& bounds) const {
+    const size_t x0 = chunkX * ChunkSize, x1 = std::min(x0 + ChunkSize, _info.getTileCountX());
+    const size_t y0 = chunkY * ChunkSize, y1 = std::min(y0 + ChunkSize, _info.getTileCountY());
+    for (size_t y = y0; y < y1; ++y) {
+        for (size_t x = x0; x < x1; ++x) {
+            const Index1D index = _info.map(Index2D(static_cast<int>(x), static_cast<int>(y)));
+            const oct_bb_t& tile = tileBounds(index);
+            if (tile.isEmpty() || (test && Math::Relation::outside == intersects(frustum, tile))) {
+                continue;
+            }
+            tiles.push_back(index);
+            joinBounds(bounds, tile);
+        }
+    }
+}
+
+void CullingHierarchy::cull(const Frustum& frustum, const std::function<const oct_bb_t&(const Index1D&)>& tileBounds,
+                            std::vector<Index1D>& tiles, oct_bb_t& bounds) const {
+    bounds = oct_bb_t();
+    for (size_t regionY = 0; regionY < _regionCountY; ++regionY) {
+        for (size_t regionX = 0; regionX < _regionCountX; ++regionX) {
+            const Math::Relation regionRelation = intersects(frustum, _regionBounds[regionY * _regionCountX + regionX]);
+            if (Math::Relation::outside == regionRelation) {
+                continue;
+            }
+            const size_t cx0 = regionX * RegionSize, cx1 = std::min(cx0 + RegionSize, _chunkCountX);
+            const size_t cy0 = regionY * RegionSize, cy1 = std::min(cy0 + RegionSize, _chunkCountY);
+            for (size_t chunkY = cy0; chunkY < cy1; ++chunkY) {
+                for (size_t chunkX = cx0; chunkX < cx1; ++chunkX) {
+                    Math::Relation chunkRelation = regionRelation;
+                    if (Math::Relation::inside != regionRelation) {
+                        chunkRelation = intersects(frustum, _chunkBounds[chunkY * _chunkCountX + chunkX]);
+                        if (Math::Relation::outside == chunkRelation) {
+                            continue;
+                        }
+                    }
+                    cullChunk(chunkX, chunkY, Math::Relation::inside != chunkRelation, frustum, tileBounds, tiles, bounds);
+                }
+            }
+        }
+    }
+}
+
+} // namespace Graphics
+} // namespace Ego
@@ -0,0 +1,102 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Graphics/CullingHierarchy.hpp
+/// @brief A bounding volume hierarchy over the tiles of a mesh for view frustum culling.
+
+#pragma once
+
+#include "egolib/Mesh/Info.hpp"
+#include "egolib/bbox.h"
+#include "egolib/geometry.h"
+
+namespace Ego {
+namespace Graphics {
+
+struct Frustum;
+
+/**
+ * @brief
+ *  A bounding volume hierarchy over the tiles of a mesh for view frustum culling.
+ * @remark
+ *  The tiles are grouped into chunks of ChunkSize x ChunkSize tiles and the chunks are grouped into
+ *  regions of RegionSize x RegionSize chunks. The bounds of a chunk (region) are the join of the bounds
+ *  of its tiles (chunks). A region or chunk outside of the frustum is skipped, the tiles of a region or
+ *  chunk inside of the frustum are accepted without further tests. Only the tiles of chunks intersecting
+ *  the frustum boundary are tested individually, hence the cost scales with the visible area.
+ */
+class CullingHierarchy {
+public:
+    /// @brief The size, in tiles, of a chunk along the x- and y-axes.
+    static constexpr size_t ChunkSize = 8;
+    /// @brief The size, in chunks, of a region along the x- and y-axes.
+    static constexpr size_t RegionSize = 4;
+
+    /**
+     * @brief
+     *  Construct this hierarchy for a mesh. All bounds are empty.
+     * @param info
+     *  the mesh info
+     */
+    CullingHierarchy(const MeshInfo& info);
+
+    /**
+     * @brief
+     *  Build the bounds of the chunks and regions.
+     * @param tileBounds
+     *  a function returning the bounds of a tile
+     * @remark
+     *  Must be invoked whenever the bounds of the tiles change.
+     */
+    void build(const std::function<const oct_bb_t&(const Index1D&)>& tileBounds);
+
+    /**
+     * @brief
+     *  Get the tiles whose bounds are not outside of a view frustum.
+     * @param frustum
+     *  the view frustum
+     * @param tileBounds
+     *  a function returning the bounds of a tile
+     * @param [out] tiles
+     *  the visible tiles are appended to this list
+     * @param [out] bounds
+     *  the join of the bounds of the visible tiles. Empty if no tile is visible.
+     */
+    void cull(const Frustum& frustum, const std::function<const oct_bb_t&(const Index1D&)>& tileBounds,
+              std::vector<Index1D>& tiles, oct_bb_t& bounds) const;
+
+private:
+    /// @brief The relation of bounds to a frustum.
+    static Math::Relation intersects(const Frustum& frustum, const oct_bb_t& bounds);
+
+    /// @brief Append the tiles of a chunk.
+    /// @param test if @a true the tiles are tested individually, otherwise all tiles with non-empty bounds are appended
+    void cullChunk(size_t chunkX, size_t chunkY, bool test, const Frustum& frustum,
+                   const std::function<const oct_bb_t&(const Index1D&)>& tileBounds,
+                   std::vector<Index1D>& tiles, oct_bb_t& bounds) const;
+
+    MeshInfo _info;
+    size_t _chunkCountX, _chunkCountY;
+    size_t _regionCountX, _regionCountY;
+    std::vector<oct_bb_t> _chunkBounds;
+    std::vector<oct_bb_t> _regionBounds;
+};
+
+} // namespace Graphics
+} // namespace Ego
@@ -2,19 +2,33 @@
 #include "egolib/game/graphic.h"
 #include "egolib/game/graphic_prt.h"
 #include "egolib/Entities/_Include.hpp"
+#include "egolib/Core/RadixSort.hpp"
 
 namespace Ego {
 namespace Graphics {
 
 EntityList::EntityList()
-    : list(), set() {}
+    : list(), records(), sortBuffer(), generation(1), objectStamps(), particleStamps() {}
+
+void EntityList::stamp(std::vector<uint32_t>& stamps, size_t index) {
+    if (index >= stamps.size()) {
+        stamps.resize(index + 1, 0);
+    }
+    stamps[index] = generation;
+}
 
 void EntityList::clear() {
     if (list.empty()) {
         return;
     }
 
-    set.clear();
+    // Invalidate all stamps.
+    if (0 == ++generation) {
+        // The generation wrapped around: Reset all stamps.
+        std::fill(objectStamps.begin(), objectStamps.end(), 0);
+        std::fill(particleStamps.begin(), particleStamps.end(), 0);
+        generation = 1;
+    }
     auto& objectHandler = _currentModule->getObjectHandler();
     auto& particleHandler = ParticleHandler::get();
     for (auto& entry : list) {
@@ -42,7 +56,7 @@ size_t EntityList::add(::Camera& camera, Object& object) {
 
     // Add the object.
     list.emplace_back(object.getObjRef(), ParticleRef::Invalid);
-    set.emplace((void *)(&object));
+    stamp(objectStamps, object.getSlot());
     count++;
 
     // Add any weapons it is holding.
@@ -61,18 +75,76 @@ size_t EntityList::add(::Camera& camera, Object& object) {
 size_t EntityList::add(::Camera& camera, Ego::Particle& particle) {
     size_t count = 0;
     if (!test(camera, particle)) {
-        particle.inst.indolist = false;
         return count;
     }
-    particle.inst.indolist = true;
 
     list.emplace_back(ObjectRef::Invalid, particle.getParticleID());
-    set.emplace((void *)(&particle));
+    stamp(particleStamps, particle.getSlot());
     count++;
 
     return count;
 }
 
+/// Invoked concurrently for several cameras, hence the tile data is read directly rather than by
+/// ego_mesh_t::grid_is_valid and ego_mesh_t::test_fx which increment the global mesh statistics.
+static bool isReflective(const ego_mesh_t& mesh, const Index1D& tile) {
+    return mesh._info.isValid(tile) && !mesh._cmem.isFanOff(tile)
+        && 0 != (mesh._cmem.getFX(tile) & MAPFX_REFLECTIVE);
+}
+
+void EntityList::prepareRecords(const ego_mesh_t& mesh) {
+    records.resize(list.size());
+    auto& objectHandler = _currentModule->getObjectHandler();
+    auto& particleHandler = ParticleHandler::get();
+    for (size_t i = 0; i < list.size(); ++i) {
+        Element& element = list[i];
+        Record& record = records[i];
+        element.record = static_cast<uint32_t>(i);
+        record = Record();
+        if (ParticleRef::Invalid == element.iprt && ObjectRef::Invalid != element.iobj) {
+            record.object = objectHandler[element.iobj];
+            if (!record.object) {
+                continue;
+            }
+            const Index1D tile = record.object->getTile();
+            record.reflective = isReflective(mesh, tile);
+            prepareShadow(record);
+        } else if (ObjectRef::Invalid == element.iobj && ParticleRef::Invalid != element.iprt) {
+            record.particle = particleHandler[element.iprt].get();
+            if (!record.particle) {
+                continue;
+            }
+            const Index1D tile = record.particle->getTile();
+            record.reflective = isReflective(mesh, tile);
+        }
+    }
+}
+
+void EntityList::prepareShadow(Record& record) {
+    Object& object = *record.object;
+    // If the object is held or hidden or if its shadow size is 0, then it has no shadow.
+    if (object.isBeingHeld() || object.isHidden() || 0 == object.shadow_size) {
+        return;
+    }
+    // No shadow if completely transparent or completely glowing.
+    if (object.inst.light <= INVISIBLE || object.inst.alpha <= INVISIBLE) {
+        return;
+    }
+    float alpha = (255 == object.inst.light) ? object.inst.alpha * idlib::fraction<float, 1, 255>() : (object.inst.alpha - object.inst.light) * idlib::fraction<float, 1, 255>();
+    // much reduced shadow if on a reflective tile
+    if (record.reflective) {
+        alpha *= 0.1f;
+    }
+    if (alpha < idlib::fraction<float, 1, 255>()) {
+        return;
+    }
+    const auto& matrix = object.inst.getMatrix();
+    record.shadow = true;
+    record.shadowAlpha = alpha;
+    record.shadowLevel = object.getObjectPhysics().getGroundElevation() + SHADOWRAISE;
+    record.position = Vector3f(matrix(0, 3), matrix(1, 3), matrix(2, 3));
+}
+
 void EntityList::sort(Camera& cam, const bool do_reflect) {
     /// @author ZZ
     /// @details This function orders the entity list based on distance from camera,
@@ -118,13 +190,14 @@ void EntityList::sort(Camera& cam, const bool do_reflect) {
             list[count].iobj = list[i].iobj;
             list[count].iprt = list[i].iprt;
             list[count].dist = dist;
+            list[count].record = list[i].record;
             count++;
         }
     }
 
-    // use qsort to sort the list in-place
+    // sort the list by the distances
     if (count > 1) {
-        std::sort(list.begin(), list.end(), Compare());
+        Ego::Core::radixSort(list, sortBuffer, [](const Element& element) { return Ego::Core::toRadixKey(element.dist); });
     }
 }
 
@@ -146,7 +219,7 @@ bool EntityList::test(::Camera& camera, const Object& object) {
         return false;
     }
     // The object is not a candidate if it is already in this entity list.
-    return set.find((void *)(&object)) == set.cend();
+    return !isStamped(objectStamps, object.getSlot());
 }
 
 bool EntityList::test(::Camera& camera, const Ego::Particle& particle) {
@@ -176,7 +249,7 @@ bool EntityList::test(::Camera& camera, const Ego::Particle& particle) {
         return false;
     }
 
-    return set.find((void *)(&particle)) == set.cend();
+    return !isStamped(particleStamps, particle.getSlot());
 }
 
 } // namespace Graphics
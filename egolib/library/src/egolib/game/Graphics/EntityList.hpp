@@ -47,15 +47,44 @@ struct EntityList {
      */
     struct Element {
         Element()
-            : iobj(ObjectRef::Invalid), iprt(ParticleRef::Invalid), dist(0.0f) {}
+            : iobj(ObjectRef::Invalid), iprt(ParticleRef::Invalid), dist(0.0f), record(0) {}
         Element(const Element& other)
-            : iobj(other.iobj), iprt(other.iprt), dist(other.dist) {}
+            : iobj(other.iobj), iprt(other.iprt), dist(other.dist), record(other.record) {}
         Element(ObjectRef iobj, ParticleRef iprt)
-            : iobj(iobj), iprt(iprt), dist(0.0f) {}
+            : iobj(iobj), iprt(iprt), dist(0.0f), record(0) {}
 
         ObjectRef iobj;
         ParticleRef iprt;
         float dist;
+        /// The index of the render record of the entity.
+        uint32_t record;
+    };
+    /**
+     * @brief
+     *  The data of an entity shared by the render passes.
+     * @remark
+     *  The records are gathered once per frame by prepareRecords such that the render passes
+     *  neither resolve the entity references through the handlers nor query the mesh.
+     */
+    struct Record {
+        Record()
+            : object(), particle(nullptr), reflective(false),
+              shadow(false), shadowAlpha(0.0f), shadowLevel(0.0f), position() {}
+
+        /// The object or a null pointer.
+        std::shared_ptr<Object> object;
+        /// The particle or a null pointer.
+        Ego::Particle *particle;
+        /// If the entity is above a reflective tile.
+        bool reflective;
+        /// If the object casts a shadow.
+        bool shadow;
+        /// The opacity of the shadow of the object before the attenuation by the shadow quality.
+        float shadowAlpha;
+        /// The elevation of the shadow of the object.
+        float shadowLevel;
+        /// The translation of the matrix of the object.
+        Vector3f position;
     };
     struct Compare {
         bool operator()(const Element& x, const Element& y) const {
@@ -65,8 +94,35 @@ struct EntityList {
 private:
     /** An array of the entities in this entity list. */
     std::vector<Element> list;
-    /** For checking in amortized constant time if an object is already in this entity list. */
-    std::unordered_set<void *> set;
+    /** The render records of the entities. */
+    std::vector<Record> records;
+    /** The buffer of the radix sort of the entities. */
+    std::vector<Element> sortBuffer;
+    /**
+     * The generation of this entity list, incremented by each clear.
+     * An entity is in this list if its stamp is the current generation.
+     */
+    uint32_t generation;
+    /**
+     * The stamps of the objects, indexed by object slot.
+     * Slots are reused, hence the size is bounded by the maximum number of objects.
+     */
+    std::vector<uint32_t> objectStamps;
+    /**
+     * The stamps of the particles, indexed by particle slot.
+     * Slots are reused, hence the size is bounded by the maximum number of particles.
+     */
+    std::vector<uint32_t> particleStamps;
+
+    /** @brief Get if an entity is stamped with the current generation. */
+    bool isStamped(const std::vector<uint32_t>& stamps, size_t index) const {
+        return index < stamps.size() && generation == stamps[index];
+    }
+    /** @brief Stamp an entity with the current generation. */
+    void stamp(std::vector<uint32_t>& stamps, size_t index);
+
+    /** @brief Determine the shadow parameters of the record of an object. */
+    static void prepareShadow(Record& record);
 
 private:
     /**
@@ -103,8 +159,29 @@ public:
         return list.size();
     }
 
+    /**
+     * @brief Get the render record of an entity.
+     * @param index the index of the entity
+     * @pre prepareRecords was invoked after the last addition.
+     */
+    const Record& getRecord(size_t index) const {
+        return records[get(index).record];
+    }
+
+    /**
+     * @brief Gather the render records of the entities in this list.
+     * @param mesh the mesh
+     * @remark Must be invoked after the object and particle instances were updated in this frame.
+     * Only this list is modified, hence the records of different lists can be gathered concurrently.
+     */
+    void prepareRecords(const ego_mesh_t& mesh);
+
     /** @brief Clear this entity list. */
     void clear();
+    /**
+     * @brief Sort the entities by their distances from the camera, closest first.
+     * @remark The distances are sorted by a radix sort on their bits.
+     */
     void sort(Camera& camera, const bool reflect);
 
     /**
@@ -121,9 +198,8 @@ public:
      * @brief Add a particle entity if it is eligible for addition.
      * @param obj the particle entity to add
      * @return the total number of entities added
-     * @remark A (legacy) occlusion test is performed. If the particle is occluded,
-     * then particle.getInstance().isOccluded() is set to @a true, otherwise it is
-     * set to @a false.
+     * @remark The particle is not modified, hence entity lists of different cameras can be built concurrently.
+     * The caller determines ParticleGraphics::indolist from the entity lists of all cameras.
      */
     size_t add(::Camera& camera, Ego::Particle& particle);
 };
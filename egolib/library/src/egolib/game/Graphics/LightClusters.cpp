@@ -0,0 +1,127 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file egolib/game/Graphics/LightClusters.cpp
+/// @brief A grid of tile clusters binning the dynamic lights.
+
+#include "egolib/game/Graphics/LightClusters.hpp"
+
+namespace Ego {
+namespace Graphics {
+
+float LightClusters::Stats::getAverageLightsPerCluster() const {
+    return 0 == occupiedClusters ? 0.0f : static_cast<float>(references) / static_cast<float>(occupiedClusters);
+}
+
+LightClusters::LightClusters()
+    : _tileCountX(0), _tileCountY(0),
+      _clusterCountX(0), _clusterCountY(0),
+      _offsets(1, 0),
+      _lights(),
+      _stats{0, 0, 0, 0, 0} {
+}
+
+bool LightClusters::getClusterRange(float min, float max, size_t tileCount, size_t& first, size_t& last) {
+    if (0 == tileCount || min > max) {
+        return false;
+    }
+    // The tile i covers [(i - 1/2) * Grid::Size(), (i + 1/2) * Grid::Size()].
+    const float firstTile = std::ceil(min / Info<float>::Grid::Size() - 0.5f),
+                lastTile = std::floor(max / Info<float>::Grid::Size() + 0.5f);
+    if (lastTile < 0.0f || firstTile > static_cast<float>(tileCount - 1)) {
+        return false;
+    }
+    first = static_cast<size_t>(std::max(firstTile, 0.0f)) / ClusterSize;
+    last = static_cast<size_t>(std::min(lastTile, static_cast<float>(tileCount - 1))) / ClusterSize;
+    return true;
+}
+
+void LightClusters::build(const MeshInfo& info, const std::vector<ego_frect_t>& bounds) {
+    _tileCountX = info.getTileCountX();
+    _tileCountY = info.getTileCountY();
+    _clusterCountX = (_tileCountX + ClusterSize - 1) / ClusterSize;
+    _clusterCountY = (_tileCountY + ClusterSize - 1) / ClusterSize;
+    const size_t clusterCount = _clusterCountX * _clusterCountY;
+
+    // Count the lights of each cluster. The count of cluster i is stored at i + 1.
+    _offsets.assign(clusterCount + 1, 0);
+    size_t references = 0;
+    for (const auto& bound : bounds) {
+        size_t x0, x1, y0, y1;
+        if (!getClusterRange(bound.xmin, bound.xmax, _tileCountX, x0, x1) ||
+            !getClusterRange(bound.ymin, bound.ymax, _tileCountY, y0, y1)) {
+            continue;
+        }
+        for (size_t y = y0; y <= y1; ++y) {
+            for (size_t x = x0; x <= x1; ++x) {
+                _offsets[y * _clusterCountX + x + 1]++;
+            }
+        }
+        references += (x1 - x0 + 1) * (y1 - y0 + 1);
+    }
+
+    // Gather the statistics and turn the counts into offsets.
+    _stats = Stats{bounds.size(), clusterCount, 0, references, 0};
+    for (size_t i = 1; i <= clusterCount; ++i) {
+        if (0 != _offsets[i]) {
+            _stats.occupiedClusters++;
+            _stats.maxLightsPerCluster = std::max<size_t>(_stats.maxLightsPerCluster, _offsets[i]);
+        }
+        _offsets[i] += _offsets[i - 1];
+    }
+
+    // Fill the bins. The lights of a cluster are in ascending order.
+    _lights.resize(references);
+    for (uint32_t light = 0; light < bounds.size(); ++light) {
+        const auto& bound = bounds[light];
+        size_t x0, x1, y0, y1;
+        if (!getClusterRange(bound.xmin, bound.xmax, _tileCountX, x0, x1) ||
+            !getClusterRange(bound.ymin, bound.ymax, _tileCountY, y0, y1)) {
+            continue;
+        }
+        for (size_t y = y0; y <= y1; ++y) {
+            for (size_t x = x0; x <= x1; ++x) {
+                // Use the offset of the cluster as its insertion point.
+                _lights[_offsets[y * _clusterCountX + x]++] = light;
+            }
+        }
+    }
+    // The insertion points are the offsets of the succeeding clusters: Shift them back.
+    for (size_t i = clusterCount; i > 0; --i) {
+        _offsets[i] = _offsets[i - 1];
+    }
+    _offsets[0] = 0;
+}
+
+LightClusters::Range LightClusters::get(const Index2D& tile) const {
+    if (tile.x() < 0 || tile.y() < 0 ||
+        static_cast<size_t>(tile.x()) >= _tileCountX || static_cast<size_t>(tile.y()) >= _tileCountY) {
+        return Range{nullptr, nullptr};
+    }
+    const size_t cluster = (tile.y() / ClusterSize) * _clusterCountX + tile.x() / ClusterSize;
+    return Range{_lights.data() + _offsets[cluster], _lights.data() + _offsets[cluster + 1]};
+}
+
+const LightClusters::Stats& LightClusters::getStats() const {
+    return _stats;
+}
+
+} // namespace Graphics
+} // namespace Ego
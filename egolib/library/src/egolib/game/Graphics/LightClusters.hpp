@@ -0,0 +1,119 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file egolib/game/Graphics/LightClusters.hpp
+/// @brief A grid of tile clusters binning the dynamic lights.
+
+#pragma once
+
+#include "egolib/FileFormats/map_file.h"
+
+namespace Ego {
+namespace Graphics {
+
+/**
+ * @brief
+ *  The tiles of a mesh are grouped into clusters of ClusterSize x ClusterSize tiles.
+ *  Each frame, the dynamic lights are binned into the clusters their bounds overlap
+ *  such that a tile only has to test the lights of its cluster.
+ * @remark
+ *  A tile with the index (x, y) covers the rectangle of size Grid::Size() centered at
+ *  (x * Grid::Size(), y * Grid::Size()). The lights of a cluster are a superset of the
+ *  lights overlapping any of its tiles.
+ * @remark
+ *  The bins are stored as one list of light indices and one list of offsets into that list
+ *  per cluster. Both lists keep their capacities between frames.
+ */
+class LightClusters {
+public:
+    /// @brief The size, in tiles, of a cluster along the x- and y-axes.
+    static constexpr size_t ClusterSize = 4;
+
+    /// @brief Statistics on the last binning.
+    struct Stats {
+        /// @brief The number of lights.
+        size_t lights;
+        /// @brief The number of clusters.
+        size_t clusters;
+        /// @brief The number of clusters with at least one light.
+        size_t occupiedClusters;
+        /// @brief The sum of the number of lights over all clusters.
+        size_t references;
+        /// @brief The maximum number of lights of a cluster.
+        size_t maxLightsPerCluster;
+
+        /// @brief Get the average number of lights of a cluster with at least one light.
+        float getAverageLightsPerCluster() const;
+    };
+
+    /// @brief A range of light indices.
+    struct Range {
+        const uint32_t *first, *last;
+        const uint32_t *begin() const { return first; }
+        const uint32_t *end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    /**
+     * @brief
+     *  Construct this grid. The grid has no clusters.
+     */
+    LightClusters();
+
+    /**
+     * @brief
+     *  Bin lights into the clusters of a mesh.
+     * @param info
+     *  the mesh info
+     * @param bounds
+     *  the bounds of the lights. The index of a light is its index in this list.
+     */
+    void build(const MeshInfo& info, const std::vector<ego_frect_t>& bounds);
+
+    /**
+     * @brief
+     *  Get the lights of the cluster of a tile.
+     * @param tile
+     *  the tile
+     * @return
+     *  the indices of the lights in ascending order. Empty if the tile is outside of the grid.
+     *  Valid until the next call to build.
+     */
+    Range get(const Index2D& tile) const;
+
+    /// @brief Get the statistics on the last binning.
+    const Stats& getStats() const;
+
+private:
+    /// @brief Get the range of clusters whose tiles overlap the interval [min, max] along an axis.
+    /// @param tileCount the number of tiles along the axis
+    /// @return @a false if the interval overlaps no tile
+    static bool getClusterRange(float min, float max, size_t tileCount, size_t& first, size_t& last);
+
+    size_t _tileCountX, _tileCountY;
+    size_t _clusterCountX, _clusterCountY;
+    /// @brief The lights of cluster i are _lights[_offsets[i]] to _lights[_offsets[i + 1] - 1].
+    std::vector<uint32_t> _offsets;
+    std::vector<uint32_t> _lights;
+    Stats _stats;
+};
+
+} // namespace Graphics
+} // namespace Ego
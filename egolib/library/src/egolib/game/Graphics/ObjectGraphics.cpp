@@ -11,6 +11,14 @@ namespace Graphics
 // the flip tolerance is the default flip increment / 2
 static constexpr float FLIP_TOLERANCE = 0.25f * 0.5f;
 
+// the minimum apparent sizes, the size of an object divided by its distance from the camera,
+// for the full and the reduced animation detail
+static constexpr float ANIMATION_FULL_DETAIL_SIZE = 0.03f;
+static constexpr float ANIMATION_REDUCED_DETAIL_SIZE = 0.015f;
+
+// the counters of the vertex updates of all instances
+static ObjectGraphics::VertexCounters vertexCounters;
+
 ObjectGraphics::ObjectGraphics(Object &object) :
     matrix_cache(),
 
@@ -175,6 +183,15 @@ void ObjectGraphics::interpolateVerticesRaw(const std::vector<MD2_Vertex> &lst_a
 {
     /// raw indicates no bounds checking, so be careful
 
+    if ( 0.0f == flip || 1.0f == flip )
+    {
+        vertexCounters.copied += vmax - vmin + 1;
+    }
+    else
+    {
+        vertexCounters.interpolated += vmax - vmin + 1;
+    }
+
     if ( 0.0f == flip )
     {
         for (size_t i = vmin; i <= vmax; i++)
@@ -355,6 +372,86 @@ gfx_rv ObjectGraphics::updateVertices(int vmin, int vmax, bool force)
     return updateVertexCache(vmax, vmin, force, vertices_match, frames_match);
 }
 
+ObjectGraphics::AnimationDetail ObjectGraphics::getAnimationDetail(float distance, float size)
+{
+    if ( distance <= 0.0f || size >= distance * ANIMATION_FULL_DETAIL_SIZE )
+    {
+        return AnimationDetail::Full;
+    }
+    if ( size >= distance * ANIMATION_REDUCED_DETAIL_SIZE )
+    {
+        return AnimationDetail::Reduced;
+    }
+    return AnimationDetail::KeyFrame;
+}
+
+gfx_rv ObjectGraphics::updateVertices(AnimationDetail detail, uint32_t frame)
+{
+    vertexCounters.instances[static_cast<size_t>(detail)]++;
+
+    const int maxvert = static_cast<int>(_vertexList.size()) - 1;
+    const bool complete = 0 == _vertexCache.vmin && maxvert == _vertexCache.vmax;
+
+    switch ( detail )
+    {
+        case AnimationDetail::Full:
+            return updateVertices(-1, -1, true);
+
+        case AnimationDetail::Reduced:
+            // stagger the updates of the instances over the frames
+            if ( complete && 0 != ((frame + _object.getObjRef().get()) & 1) )
+            {
+                return gfx_fail;
+            }
+            return updateVertices(-1, -1, true);
+
+        case AnimationDetail::KeyFrame:
+        default:
+        {
+            const std::shared_ptr<MD2Model> &pmd2 = getModelDescriptor()->getMD2();
+            const auto& frameList = pmd2->getFrames();
+            if ( _vertexList.size() != pmd2->getVertexCount() || maxvert < 0 ||
+                 _targetFrameIndex >= frameList.size() || _sourceFrameIndex >= frameList.size() )
+            {
+                // let the full update report the problem
+                return updateVertices(-1, -1, true);
+            }
+
+            // the nearest key frame
+            const uint16_t keyFrame = (_animationProgress < 0.5f) ? _sourceFrameIndex : _targetFrameIndex;
+            if ( complete && keyFrame == _vertexCache.frame_lst && keyFrame == _vertexCache.frame_nxt && 0.0f == _vertexCache.flip )
+            {
+                // the vertices are in the pose of the key frame
+                return gfx_fail;
+            }
+
+            const auto& vertexList = frameList[keyFrame].vertexList;
+            interpolateVerticesRaw(vertexList, vertexList, 0, maxvert, 0.0f);
+
+            // The cache records the pose of the key frame. As it does not match the current
+            // pose while the instance is animating, updates of some vertices are not suppressed.
+            _vertexCache.frame_lst = keyFrame;
+            _vertexCache.frame_nxt = keyFrame;
+            _vertexCache.flip      = 0.0f;
+            _vertexCache.vmin      = 0;
+            _vertexCache.vmax      = maxvert;
+            _vertexCache.frame_wld = update_wld;
+            _vertexCache.vert_wld  = update_wld;
+            return gfx_success;
+        }
+    }
+}
+
+const ObjectGraphics::VertexCounters& ObjectGraphics::getVertexCounters()
+{
+    return vertexCounters;
+}
+
+void ObjectGraphics::resetVertexCounters()
+{
+    vertexCounters = VertexCounters();
+}
+
 gfx_rv ObjectGraphics::updateVertexCache(int vmax, int vmin, bool force, bool vertices_match, bool frames_match)
 {
     // this is getting a bit ugly...
@@ -136,6 +136,61 @@ public:
 	BIT_FIELD getFrameFX() const;
 
     gfx_rv updateVertices(int vmin, int vmax, bool force);
+
+    /// @brief The animation level of detail of an instance.
+    enum class AnimationDetail {
+        /// The vertices are interpolated between the key frames in every frame.
+        Full,
+        /// The vertices are interpolated between the key frames in every second frame.
+        Reduced,
+        /// The vertices are copied from the nearest key frame and are only updated if that key frame changes.
+        KeyFrame,
+    };
+
+    /// @brief Counters of the vertex updates of all instances.
+    struct VertexCounters {
+        VertexCounters() :
+            interpolated(0), copied(0), instances() {}
+        /// The number of vertices interpolated between two key frames.
+        size_t interpolated;
+        /// The number of vertices copied from a key frame.
+        size_t copied;
+        /// The number of instances updated with each animation detail.
+        std::array<size_t, 3> instances;
+    };
+
+    /**
+    * @brief
+    *   Get the animation detail of an object.
+    * @param distance
+    *   the distance of the object from the nearest camera. Infinity if the object is not visible.
+    * @param size
+    *   the size of the object
+    * @return
+    *   the animation detail. It decreases with the apparent size i.e. the size divided by the distance.
+    **/
+    static AnimationDetail getAnimationDetail(float distance, float size);
+
+    /**
+    * @brief
+    *   Update all vertices of this instance with an animation detail.
+    * @param detail
+    *   the animation detail
+    * @param frame
+    *   the number of the rendered frame. The reduced updates of the instances are staggered over the frames.
+    * @return
+    *   gfx_error if the update failed, gfx_fail if the vertices were not updated, gfx_success otherwise
+    * @remark
+    *   Updates of some vertices with updateVertices(int, int, bool), e.g. of the grip vertices,
+    *   still interpolate the current pose of the animation.
+    **/
+    gfx_rv updateVertices(AnimationDetail detail, uint32_t frame);
+
+    /// @brief Get the counters of the vertex updates since the last reset.
+    static const VertexCounters& getVertexCounters();
+
+    /// @brief Reset the counters of the vertex updates.
+    static void resetVertexCounters();
         
     void getTint(GLXvector4f tint, const bool reflection, const int type);
 
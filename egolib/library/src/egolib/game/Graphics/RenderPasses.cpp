@@ -45,100 +45,78 @@ namespace Graphics {
 
 namespace Internal {
 
-ElementV2::ElementV2()
-    : ElementV2(std::numeric_limits<float>::infinity(), 
-                Index1D::Invalid, 
-                std::numeric_limits<uint32_t>::max()) {
-}
-
-ElementV2::ElementV2(float distance, const Index1D& tileIndex, uint32_t textureIndex)
-	: distance(distance), tileIndex(tileIndex), textureIndex(textureIndex) {
-}
-
-ElementV2::ElementV2(const ElementV2& other)
-	: ElementV2(other.getDistance(), other.getTileIndex(), other.getTextureIndex()) {
-}
-
-const ElementV2& ElementV2::operator=(const ElementV2& other) {
-	distance = other.getDistance();
-	tileIndex = other.getTileIndex();
-	textureIndex = other.getTextureIndex();
-	return *this;
-}
-
-float ElementV2::getDistance() const {
-    return distance;
-}
-
-const Index1D& ElementV2::getTileIndex() const {
-    return tileIndex;
-}
-
-uint32_t ElementV2::getTextureIndex() const {
-    return textureIndex;
-}
-
-bool ElementV2::compare(const ElementV2& x, const ElementV2& y) {
-	int result = (int)x.getTextureIndex() - (int)y.getTextureIndex();
-	if (result < 0) {
-		return true;
-	} else if (result > 0) {
-		return false;
-	} else {
-        float result = x.getDistance() - y.getDistance();
-		if (result < 0.0f) {
-			return true;
-		} else {
-			return false;
-		}
-	}
+TerrainChunks::Tile TileListV2::get_chunk_tile(const ego_mesh_t& mesh, const Index1D& tileIndex) {
+    const ego_tile_info_t& tile = mesh.getTileInfo(tileIndex);
+    // Do not render the tile if the image is invalid.
+    if (tile.isFanOff()) {
+        return TerrainChunks::Tile{TerrainChunks::NoTexture, 0, nullptr};
+    }
+    uint32_t texture = TILE_GET_LOWER_BITS(tile._img);
+    if (tile._type >= tile_dict.offset) {
+        texture += Graphics::MESH_IMG_COUNT;
+    }
+    return TerrainChunks::Tile{texture, static_cast<uint32_t>(tile._vrtstart), tile_dict.get(tile._type)};
 }
 
 void TileListV2::render(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tiles)
 {
-	size_t tcnt = mesh._tmem.getInfo().getTileCount();
-
 	if (0 == tiles.size()) {
 		return;
 	}
 
-	// insert the rlst values into lst_vals
-	std::vector<ElementV2> lst_vals(tiles.size());
-	for (size_t i = 0; i < tiles.size(); ++i)
-	{
-        uint32_t textureIndex;
-		if (tiles[i].getIndex() >= tcnt)
-		{
-			textureIndex = std::numeric_limits<uint32_t>::max();
+	// Get the draw calls. Chunks whose tile textures changed are rebuilt.
+	const auto& draws = mesh._chunks.makeDraws(tiles, [&mesh](const Index1D& tileIndex) {
+		return get_chunk_tile(mesh, tileIndex);
+	});
+
+	// restart the mesh texture code
+	TileRenderer::invalidate();
+
+	const tile_mem_t& ptmem = mesh._tmem;
+	auto& renderer = Renderer::get();
+	// Per-vertex coloring.
+	renderer.setGouraudShadingEnabled(gfx.gouraudShading_enable); // GL_LIGHTING_BIT
+	if (!renderer.isDirectRenderingEnabled()) {
+		// Without an OpenGL context the binds go through the renderer and the draws are counted only.
+		for (const auto& draw : draws) {
+			TileRenderer::bind(draw.texture % Graphics::MESH_IMG_COUNT, draw.texture / Graphics::MESH_IMG_COUNT);
+			renderer.countDirectDraw("TileListV2::render", draw.count);
 		}
-		else
+	} else {
+		OpenGL::PushClientAttrib pca(GL_CLIENT_VERTEX_ARRAY_BIT);
 		{
-			const ego_tile_info_t& tile = mesh._tmem.get(tiles[i].getIndex());
-
-			int img = TILE_GET_LOWER_BITS(tile._img);
-			if (tile._type >= tile_dict.offset)
-			{
-				img += Graphics::MESH_IMG_COUNT;
+			// The indices of the batches refer to the vertex arrays of the whole mesh.
+			GL_DEBUG(glEnableClientState)(GL_VERTEX_ARRAY);
+			GL_DEBUG(glVertexPointer)(3, GL_FLOAT, 0, ptmem._plst.get());
+
+			GL_DEBUG(glEnableClientState)(GL_TEXTURE_COORD_ARRAY);
+			GL_DEBUG(glTexCoordPointer)(2, GL_FLOAT, 0, ptmem._tlst.get());
+
+			if (gfx.gouraudShading_enable) {
+				GL_DEBUG(glEnableClientState)(GL_COLOR_ARRAY);
+				GL_DEBUG(glColorPointer)(3, GL_FLOAT, 0, ptmem._clst.get());
+			} else {
+				GL_DEBUG(glDisableClientState)(GL_COLOR_ARRAY);
+			}
+			// The renderer leaves client arrays enabled between draws.
+			GL_DEBUG(glDisableClientState)(GL_NORMAL_ARRAY);
+
+			for (const auto& draw : draws) {
+				// Bind the texture. Redundant binds are skipped by the tile renderer.
+				TileRenderer::bind(draw.texture % Graphics::MESH_IMG_COUNT, draw.texture / Graphics::MESH_IMG_COUNT);
+				GL_DEBUG(glDrawElements)(GL_TRIANGLES, draw.count, GL_UNSIGNED_INT, draw.indices);
+				renderer.countDirectDraw("TileListV2::render", draw.count);
 			}
-
-			textureIndex = img;
 		}
-        lst_vals[i] = ElementV2(tiles[i].getDistance(), tiles[i].getIndex(), textureIndex);
+	}
+	if (gfx.gouraudShading_enable) {
+		// The current colour is undefined after drawing with a colour array.
+		OpenGL::StateCache::invalidateActive(GL_CURRENT_BIT);
 	}
 
-	std::sort(lst_vals.begin(), lst_vals.end(), ElementV2::compare);
-
-	// restart the mesh texture code
-	TileRenderer::invalidate();
-
-	for (size_t i = 0; i < tiles.size(); ++i)
-	{
-		Index1D tmp_itile = lst_vals[i].getTileIndex();
-
-		gfx_rv render_rv = render_fan(mesh, tmp_itile);
-		if (egoboo_config_t::get().debug_developerMode_enable.getValue() && gfx_error == render_rv)
-		{
-			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "error rendering tile ", tmp_itile.i(), Log::EndOfEntry);
+	if (egoboo_config_t::get().debug_mesh_renderNormals.getValue()) {
+		for (const auto& tile : tiles) {
+			render_normals(mesh, tile.getIndex());
 		}
 	}
 
@@ -146,75 +124,35 @@ void TileListV2::render(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tile
 	TileRenderer::invalidate();
 }
 
-gfx_rv TileListV2::render_fan(ego_mesh_t& mesh, const Index1D& i) {
-    // grab a pointer to the tile
+void TileListV2::render_normals(ego_mesh_t& mesh, const Index1D& i) {
+    if (!mesh.grid_is_valid(i)) return;
     const ego_tile_info_t& ptile = mesh.getTileInfo(i);
+    if (ptile.isFanOff()) return;
 
     const tile_mem_t& ptmem = mesh._tmem;
 
-    // do not render the itile if the image image is invalid
-    if (ptile.isFanOff())  return gfx_success;
-
-    tile_definition_t *pdef = tile_dict.get(ptile._type);
-    if (NULL == pdef) return gfx_fail;
-
-    // bind the correct texture
-    TileRenderer::bind(ptile);
-
-    {
-        OpenGL::PushClientAttrib pca(GL_CLIENT_VERTEX_ARRAY_BIT);
-        {
-            // Per-vertex coloring.
-            Renderer::get().setGouraudShadingEnabled(gfx.gouraudShading_enable); // GL_LIGHTING_BIT
-
-                                                                                      /// @note claforte@> Put this in an initialization function.
-            GL_DEBUG(glEnableClientState)(GL_VERTEX_ARRAY);
-            GL_DEBUG(glVertexPointer)(3, GL_FLOAT, 0, &(ptmem._plst[ptile._vrtstart]));
-
-            GL_DEBUG(glEnableClientState)(GL_TEXTURE_COORD_ARRAY);
-            GL_DEBUG(glTexCoordPointer)(2, GL_FLOAT, 0, &(ptmem._tlst[ptile._vrtstart]));
-
-            if (gfx.gouraudShading_enable) {
-                GL_DEBUG(glEnableClientState)(GL_COLOR_ARRAY);
-                GL_DEBUG(glColorPointer)(3, GL_FLOAT, 0, &(ptmem._clst[ptile._vrtstart]));
-            } else {
-                GL_DEBUG(glDisableClientState)(GL_COLOR_ARRAY);
-            }
-            // grab some model info
-            uint16_t commands = pdef->command_count;
-
-            // Render each command
-            for (size_t cnt = 0, entry = 0; cnt < commands; cnt++) {
-                uint8_t numEntries = pdef->command_entries[cnt];
-
-                GL_DEBUG(glDrawElements)(GL_TRIANGLE_FAN, numEntries, GL_UNSIGNED_SHORT, &(pdef->command_verts[entry]));
-                entry += numEntries;
-            }
+    TileRenderer::invalidate();
+    auto& renderer = Renderer::get();
+    renderer.getTextureUnit().setActivated(nullptr);
+    renderer.setColour(Colour4f::white());
+    for (size_t i = ptile._vrtstart, j = 0; j < 4; ++i, ++j) {
+        renderer.countDirectDraw("TileListV2::render_normals", 2);
+        if (!renderer.isDirectRenderingEnabled()) {
+            continue;
         }
-    }
-
-    if (egoboo_config_t::get().debug_mesh_renderNormals.getValue()) {
-        TileRenderer::invalidate();
-        auto& renderer = Renderer::get();
-        renderer.getTextureUnit().setActivated(nullptr);
-        renderer.setColour(Colour4f::white());
-        for (size_t i = ptile._vrtstart, j = 0; j < 4; ++i, ++j) {
-            glBegin(GL_LINES);
-            {
-                glVertex3fv(ptmem._plst[i]);
-                glVertex3f
-                    (
-                        ptmem._plst[i][XX] + Info<float>::Grid::Size()*(ptile._ncache[j][XX]),
-                        ptmem._plst[i][YY] + Info<float>::Grid::Size()*(ptile._ncache[j][YY]),
-                        ptmem._plst[i][ZZ] + Info<float>::Grid::Size()*(ptile._ncache[j][ZZ])
-                        );
+        glBegin(GL_LINES);
+        {
+            glVertex3fv(ptmem._plst[i]);
+            glVertex3f
+                (
+                    ptmem._plst[i][XX] + Info<float>::Grid::Size()*(ptile._ncache[j][XX]),
+                    ptmem._plst[i][YY] + Info<float>::Grid::Size()*(ptile._ncache[j][YY]),
+                    ptmem._plst[i][ZZ] + Info<float>::Grid::Size()*(ptile._ncache[j][ZZ])
+                    );
 
-            }
-            glEnd();
         }
+        glEnd();
     }
-
-    return gfx_success;
 }
 
 void TileListV2::render_heightmap(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tiles)
@@ -280,15 +218,20 @@ gfx_rv TileListV2::render_heightmap_fan(ego_mesh_t& mesh, const Index1D& tileInd
     renderer.setRasterizationMode(idlib::rasterization_mode::line);
 
     // Render each command
-    GL_DEBUG(glBegin)(GL_TRIANGLE_FAN);
+    renderer.countDirectDraw("TileListV2::render_heightmap_fan", 4);
+    if (renderer.isDirectRenderingEnabled())
     {
-        for (vertex = 0; vertex < 4; vertex++)
+        GL_DEBUG(glBegin)(GL_TRIANGLE_FAN);
         {
-            GL_DEBUG(glColor3fv)(v[vertex].col);
-            GL_DEBUG(glVertex3fv)(v[vertex].pos);
+            for (vertex = 0; vertex < 4; vertex++)
+            {
+                GL_DEBUG(glColor3fv)(v[vertex].col);
+                GL_DEBUG(glVertex3fv)(v[vertex].pos);
+            }
         }
+        GL_DEBUG_END();
+        OpenGL::StateCache::invalidateActive(GL_CURRENT_BIT);
     }
-    GL_DEBUG_END();
 
     renderer.setRasterizationMode(idlib::rasterization_mode::solid);
 
@@ -31,24 +31,6 @@ namespace Graphics {
 
 namespace Internal {
 
-struct ElementV2 {
-private:
-    float distance;
-    Index1D tileIndex;
-    uint32_t textureIndex;
-public:
-    ElementV2();
-    ElementV2(float distance, const Index1D& tileIndex, uint32_t textureIndex);
-    ElementV2(const ElementV2& other);
-    const ElementV2& operator=(const ElementV2& other);
-public:
-    float getDistance() const;
-    const Index1D& getTileIndex() const;
-    uint32_t getTextureIndex() const;
-public:
-    static bool compare(const ElementV2& x, const ElementV2& y);
-};
-
 struct TileListV2 {
 public:
     /// @brief Draw fans.
@@ -62,10 +44,15 @@ public:
     static void render_heightmap(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tiles);
 
 private:
-    /// @brief Draw a fan.
+    /// @brief Get the information about a tile required to build the terrain batches.
+    /// @param mesh the mesh
+    /// @param tileIndex the tile index
+    static TerrainChunks::Tile get_chunk_tile(const ego_mesh_t& mesh, const Index1D& tileIndex);
+
+    /// @brief Draw the normals of a fan.
     /// @param mesh the mesh
     /// @param tileIndex the tile index
-    static gfx_rv render_fan(ego_mesh_t& mesh, const Index1D& tileIndex);
+    static void render_normals(ego_mesh_t& mesh, const Index1D& tileIndex);
 
     /// @brief Draw a heightmap fan.
     /// @param mesh the mesh
@@ -41,9 +41,10 @@ void EntityReflectionsRenderPass::doRun(::Camera& camera, const TileList& tl, co
         for (size_t j = el.getSize(); j > 0; --j)
         {
             size_t i = j - 1;
+            const EntityList::Record& record = el.getRecord(i);
             if (ParticleRef::Invalid == el.get(i).iprt && ObjectRef::Invalid != el.get(i).iobj)
             {
-                const std::shared_ptr<Object> &object = _currentModule->getObjectHandler()[el.get(i).iobj];
+                const std::shared_ptr<Object> &object = record.object;
                 if (!object || object->isTerminated())
                 {
                     continue;
@@ -59,9 +60,8 @@ void EntityReflectionsRenderPass::doRun(::Camera& camera, const TileList& tl, co
 
                 // use the alpha channel to modulate the transparency
                 renderer.setBlendFunction(idlib::color_blend_parameter::source0_alpha, idlib::color_blend_parameter::one_minus_source0_alpha);
-                Index1D itile = object->getTile();
 
-                if (mesh->grid_is_valid(itile) && (0 != mesh->test_fx(itile, MAPFX_REFLECTIVE)))
+                if (record.reflective)
                 {
                     renderer.setColour(Colour4f::white());
 
@@ -79,9 +79,8 @@ void EntityReflectionsRenderPass::doRun(::Camera& camera, const TileList& tl, co
                 // set the default particle blending
                 renderer.setBlendFunction(idlib::color_blend_parameter::source0_alpha, idlib::color_blend_parameter::one_minus_source0_alpha);
                 ParticleRef iprt = el.get(i).iprt;
-                Index1D itile = ParticleHandler::get()[iprt]->getTile();
 
-                if (mesh->grid_is_valid(itile) && (0 != mesh->test_fx(itile, MAPFX_REFLECTIVE)))
+                if (record.particle && record.reflective)
                 {
                     renderer.setColour(Colour4f::white());
                     ParticleGraphicsRenderer::render_one_prt_ref(iprt);
@@ -38,10 +38,9 @@ void EntityShadowsRenderPass::doRun(::Camera& camera, const TileList& tl, const
         // Render high-quality shadows.
         for (size_t i = 0; i < el.getSize(); ++i)
         {
-            ObjectRef ichr = el.get(i).iobj;
-            if (ObjectRef::Invalid == ichr) continue;
-            if (0 == _currentModule->getObjectHandler().get(ichr)->shadow_size) continue;
-            doHighQualityShadow(ichr);
+            const EntityList::Record& record = el.getRecord(i);
+            if (!record.object || !record.shadow) continue;
+            doHighQualityShadow(record);
             count++;
         }
     }
@@ -50,45 +49,23 @@ void EntityShadowsRenderPass::doRun(::Camera& camera, const TileList& tl, const
         // Render low-quality shadows.
         for (size_t i = 0; i < el.getSize(); ++i)
         {
-            ObjectRef ichr = el.get(i).iobj;
-            if (ObjectRef::Invalid == ichr) continue;
-            if (0 == _currentModule->getObjectHandler().get(ichr)->shadow_size) continue;
-            doLowQualityShadow(ichr);
+            const EntityList::Record& record = el.getRecord(i);
+            if (!record.object || !record.shadow) continue;
+            doLowQualityShadow(record);
             count++;
         }
     }
 }
 
-void EntityShadowsRenderPass::doLowQualityShadow(const ObjectRef character)
+void EntityShadowsRenderPass::doLowQualityShadow(const EntityList::Record& record)
 {
-    Object *pchr = _currentModule->getObjectHandler().get(character);
-    if (pchr->isBeingHeld()) return;
-
-    // If the object is hidden it is not drawn at all, so it has no shadow.
-    // If the object's shadow size is qa 0, then it has no shadow.
-    if (pchr->isHidden() || 0 == pchr->shadow_size)
-    {
-        return;
-    }
-
-    // No shadow if completely transparent or completely glowing.
-    float alpha = (255 == pchr->inst.light) ? pchr->inst.alpha  * idlib::fraction<float, 1, 255>() : (pchr->inst.alpha - pchr->inst.light) * idlib::fraction<float, 1, 255>();
-
-    /// @test ZF@> previous test didn't work, but this one does
-    //if ( alpha * 255 < 1 ) return;
-    if (pchr->inst.light <= INVISIBLE || pchr->inst.alpha <= INVISIBLE) return;
-
-    // much reduced shadow if on a reflective tile
-    auto mesh = _currentModule->getMeshPointer();
-    if (0 != mesh->test_fx(pchr->getTile(), MAPFX_REFLECTIVE))
-    {
-        alpha *= 0.1f;
-    }
-    if (alpha < idlib::fraction<float, 1, 255>()) return;
+    // The visibility, the transparency and the reflective tile were accounted for by the entity list.
+    float alpha = record.shadowAlpha;
+    const Object *pchr = record.object.get();
 
     // Original points
-    float level = pchr->getObjectPhysics().getGroundElevation() + SHADOWRAISE;
-    float height = pchr->inst.getMatrix()(2, 3) - level;
+    float level = record.shadowLevel;
+    float height = record.position[kZ] - level;
     float height_factor = 1.0f - height / (pchr->shadow_size * 5.0f);
     if (height_factor <= 0.0f) return;
 
@@ -96,8 +73,8 @@ void EntityShadowsRenderPass::doLowQualityShadow(const ObjectRef character)
     alpha *= height_factor * 0.5f + 0.25f;
     if (alpha < idlib::fraction<float, 1, 255>()) return;
 
-    float x = pchr->inst.getMatrix()(0, 3); ///< @todo MH: This should be the x/y position of the model.
-    float y = pchr->inst.getMatrix()(1, 3); ///<           Use a more self-descriptive method to describe this.
+    float x = record.position[kX]; ///< @todo MH: This should be the x/y position of the model.
+    float y = record.position[kY]; ///<           Use a more self-descriptive method to describe this.
 
     std::shared_ptr<const Texture> texture = ParticleHandler::get().getLightParticleTexture();
 
@@ -144,33 +121,15 @@ void EntityShadowsRenderPass::doLowQualityShadow(const ObjectRef character)
     doShadowSprite(alpha, *_vertexBuffer, _vertexDescriptor);
 }
 
-void EntityShadowsRenderPass::doHighQualityShadow(const ObjectRef character)
+void EntityShadowsRenderPass::doHighQualityShadow(const EntityList::Record& record)
 {
-
-    Object *pchr = _currentModule->getObjectHandler().get(character);
-    if (pchr->isBeingHeld()) return;
-
-    // if the character is hidden, not drawn at all, so no shadow
-    if (pchr->isHidden() || 0 == pchr->shadow_size) return;
-
-    // no shadow if completely transparent
-    float alpha = (255 == pchr->inst.light) ? pchr->inst.alpha  * idlib::fraction<float, 1, 255>() : (pchr->inst.alpha - pchr->inst.light) * idlib::fraction<float, 1, 255>();
-
-    /// @test ZF@> The previous test didn't work, but this one does
-    //if ( alpha * 255 < 1 ) return;
-    if (pchr->inst.light <= INVISIBLE || pchr->inst.alpha <= INVISIBLE) return;
-
-    // much reduced shadow if on a reflective tile
-    auto mesh = _currentModule->getMeshPointer();
-    if (0 != mesh->test_fx(pchr->getTile(), MAPFX_REFLECTIVE))
-    {
-        alpha *= 0.1f;
-    }
-    if (alpha < idlib::fraction<float, 1, 255>()) return;
+    // The visibility, the transparency and the reflective tile were accounted for by the entity list.
+    float alpha = record.shadowAlpha;
+    const Object *pchr = record.object.get();
 
     // Original points
-    float level = pchr->getObjectPhysics().getGroundElevation() + SHADOWRAISE;
-    float height = pchr->inst.getMatrix()(2, 3) - level;
+    float level = record.shadowLevel;
+    float height = record.position[kZ] - level;
     if (height < 0) height = 0;
 
     float size_umbra = 1.5f * (pchr->bump.size - height / 30.0f);
@@ -197,8 +156,8 @@ void EntityShadowsRenderPass::doHighQualityShadow(const ObjectRef character)
         alpha_penumbra = Math::constrain(alpha_penumbra, 0.0f, 1.0f);
     }
 
-    float x = pchr->inst.getMatrix()(0, 3);
-    float y = pchr->inst.getMatrix()(1, 3);
+    float x = record.position[kX];
+    float y = record.position[kY];
 
     // Choose texture and matrix
     Renderer::get().getTextureUnit().setActivated(texture.get());
@@ -23,9 +23,9 @@ private:
     idlib::vertex_descriptor _vertexDescriptor;
     std::shared_ptr<idlib::vertex_buffer> _vertexBuffer;
     // Used if low-quality shadows are enabled.
-    void doLowQualityShadow(const ObjectRef character);
+    void doLowQualityShadow(const EntityList::Record& record);
     // Used if high-quality shadows are enabled.
-    void doHighQualityShadow(const ObjectRef character);
+    void doHighQualityShadow(const EntityList::Record& record);
     // Used by all shadow qualities.
     void doShadowSprite(float intensity, idlib::vertex_buffer& vertexBuffer, idlib::vertex_descriptor& vertexDescriptor);
 };
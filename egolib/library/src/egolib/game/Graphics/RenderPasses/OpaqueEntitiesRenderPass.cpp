@@ -29,11 +29,12 @@ void OpaqueEntitiesRenderPass::doRun(::Camera& camera, const TileList& tl, const
             renderer.setAlphaTestEnabled(true);
             renderer.setAlphaFunction(idlib::compare_function::greater, 0.0f);
 
+            const EntityList::Record& record = el.getRecord(i);
             if (ParticleRef::Invalid == el.get(i).iprt && ObjectRef::Invalid != el.get(i).iobj)
             {
-                ObjectGraphicsRenderer::render_solid(camera, _currentModule->getObjectHandler()[el.get(i).iobj]);
+                ObjectGraphicsRenderer::render_solid(camera, record.object);
             }
-            else if (ObjectRef::Invalid == el.get(i).iobj && ParticleHandler::get()[el.get(i).iprt] != nullptr)
+            else if (ObjectRef::Invalid == el.get(i).iobj && nullptr != record.particle)
             {
                 // draw draw front and back faces of polygons
                 renderer.setCullingMode(idlib::culling_mode::none);
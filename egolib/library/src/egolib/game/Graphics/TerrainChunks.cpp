@@ -0,0 +1,185 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Graphics/TerrainChunks.cpp
+/// @brief Pre-built, texture-batched triangle lists of the mesh tiles.
+
+#include "egolib/game/Graphics/TerrainChunks.hpp"
+#include "egolib/game/Graphics/TileList.hpp"
+#include "egolib/Core/RadixSort.hpp"
+
+namespace Ego {
+namespace Graphics {
+
+TerrainChunks::TerrainChunks(const MeshInfo& info)
+    : _info(info),
+      _chunkCountX((info.getTileCountX() + ChunkSize - 1) / ChunkSize),
+      _chunkCountY((info.getTileCountY() + ChunkSize - 1) / ChunkSize),
+      _chunks(_chunkCountX * _chunkCountY, Chunk{true, {}, 0, 0.0f}),
+      _rebuildCount(0),
+      _generation(0),
+      _visible(info.getTileCount(), 0),
+      _visited(),
+      _draws(),
+      _visitedBuffer(),
+      _drawsBuffer() {
+}
+
+void TerrainChunks::invalidate() {
+    for (auto& chunk : _chunks) {
+        chunk.dirty = true;
+    }
+}
+
+void TerrainChunks::invalidate(const Index1D& tile) {
+    if (!_info.isValid(tile)) {
+        return;
+    }
+    auto i2 = _info.map(tile);
+    _chunks[(i2.y() / ChunkSize) * _chunkCountX + i2.x() / ChunkSize].dirty = true;
+}
+
+size_t TerrainChunks::getChunkCountX() const {
+    return _chunkCountX;
+}
+
+size_t TerrainChunks::getChunkCountY() const {
+    return _chunkCountY;
+}
+
+size_t TerrainChunks::getRebuildCount() const {
+    return _rebuildCount;
+}
+
+void TerrainChunks::rebuild(size_t chunkIndex, const TileFunction& function) {
+    Chunk& chunk = _chunks[chunkIndex];
+    // Keep the capacities of the batches.
+    for (auto& batch : chunk.batches) {
+        batch.indices.clear();
+        batch.tiles.clear();
+    }
+    const size_t x0 = (chunkIndex % _chunkCountX) * ChunkSize,
+                 y0 = (chunkIndex / _chunkCountX) * ChunkSize;
+    const size_t x1 = std::min(x0 + ChunkSize, _info.getTileCountX()),
+                 y1 = std::min(y0 + ChunkSize, _info.getTileCountY());
+    for (size_t y = y0; y < y1; ++y) {
+        for (size_t x = x0; x < x1; ++x) {
+            const Index1D index = _info.map(Index2D(static_cast<int>(x), static_cast<int>(y)));
+            const Tile tile = function(index);
+            if (NoTexture == tile.texture || !tile.definition) {
+                continue;
+            }
+            auto it = std::find_if(chunk.batches.begin(), chunk.batches.end(),
+                                   [&tile](const Batch& batch) { return batch.texture == tile.texture; });
+            if (it == chunk.batches.end()) {
+                chunk.batches.push_back(Batch{tile.texture, {}, {}});
+                it = chunk.batches.end() - 1;
+            }
+            // Triangulate the fans of the tile.
+            const tile_definition_t& definition = *tile.definition;
+            const uint32_t first = it->indices.size();
+            for (size_t command = 0, entry = 0; command < definition.command_count; ++command) {
+                const size_t entries = definition.command_entries[command];
+                for (size_t k = 1; k + 1 < entries; ++k) {
+                    it->indices.push_back(tile.vertexStart + definition.command_verts[entry]);
+                    it->indices.push_back(tile.vertexStart + definition.command_verts[entry + k]);
+                    it->indices.push_back(tile.vertexStart + definition.command_verts[entry + k + 1]);
+                }
+                entry += entries;
+            }
+            it->tiles.push_back(TileRange{static_cast<uint32_t>(index.i()), first, static_cast<uint32_t>(it->indices.size()) - first});
+        }
+    }
+    // Remove the batches of textures no longer used.
+    chunk.batches.erase(std::remove_if(chunk.batches.begin(), chunk.batches.end(),
+                                       [](const Batch& batch) { return batch.tiles.empty(); }),
+                        chunk.batches.end());
+    chunk.dirty = false;
+    _rebuildCount++;
+}
+
+const std::vector<TerrainChunks::Draw>& TerrainChunks::makeDraws(const std::vector<ClippingEntry>& tiles, const TileFunction& function) {
+    _draws.clear();
+    _visited.clear();
+    if (0 == ++_generation) {
+        // The generation wrapped around: Reset all stamps.
+        std::fill(_visible.begin(), _visible.end(), 0);
+        for (auto& chunk : _chunks) {
+            chunk.generation = 0;
+        }
+        _generation = 1;
+    }
+
+    // Stamp the visible tiles and visit their chunks.
+    for (const auto& entry : tiles) {
+        const Index1D& index = entry.getIndex();
+        if (!_info.isValid(index)) {
+            continue;
+        }
+        _visible[index.i()] = _generation;
+        auto i2 = _info.map(index);
+        const uint32_t chunkIndex = (i2.y() / ChunkSize) * _chunkCountX + i2.x() / ChunkSize;
+        Chunk& chunk = _chunks[chunkIndex];
+        if (chunk.generation != _generation) {
+            chunk.generation = _generation;
+            chunk.distance = entry.getDistance();
+            _visited.push_back(chunkIndex);
+        } else {
+            chunk.distance = std::min(chunk.distance, entry.getDistance());
+        }
+    }
+    Core::radixSort(_visited, _visitedBuffer, [this](uint32_t chunkIndex) {
+        return Core::toRadixKey(_chunks[chunkIndex].distance);
+    });
+
+    // Merge the consecutive visible tiles of each batch into draw calls.
+    for (auto chunkIndex : _visited) {
+        if (_chunks[chunkIndex].dirty) {
+            rebuild(chunkIndex, function);
+        }
+        for (const auto& batch : _chunks[chunkIndex].batches) {
+            uint32_t first = 0, count = 0;
+            for (const auto& range : batch.tiles) {
+                if (_visible[range.tile] != _generation) {
+                    continue;
+                }
+                if (0 != count && first + count == range.first) {
+                    count += range.count;
+                } else {
+                    if (0 != count) {
+                        _draws.push_back(Draw{batch.texture, batch.indices.data() + first, count});
+                    }
+                    first = range.first;
+                    count = range.count;
+                }
+            }
+            if (0 != count) {
+                _draws.push_back(Draw{batch.texture, batch.indices.data() + first, count});
+            }
+        }
+    }
+
+    // Minimize the texture changes while keeping near chunks first.
+    // The radix sort is stable and the texture indices are small, hence it takes one or two passes.
+    Core::radixSort(_draws, _drawsBuffer, [](const Draw& draw) { return draw.texture; });
+    return _draws;
+}
+
+} // namespace Graphics
+} // namespace Ego
@@ -0,0 +1,162 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Graphics/TerrainChunks.hpp
+/// @brief Pre-built, texture-batched triangle lists of the mesh tiles.
+
+#pragma once
+
+#include "egolib/Mesh/Info.hpp"
+#include "egolib/FileFormats/map_tile_dictionary.h"
+
+namespace Ego {
+namespace Graphics {
+
+struct ClippingEntry;
+
+/**
+ * @brief
+ *  The mesh is split into chunks of ChunkSize x ChunkSize tiles. For each chunk and each tile texture,
+ *  the triangles of the tiles of that texture are pre-built into a single index list. The tiles are
+ *  appended in ascending order of their indices such that the triangles of consecutive tiles are
+ *  contiguous in the index list.
+ * @remark
+ *  The indices refer to the vertex arrays of the mesh, hence the batches only need to be rebuilt
+ *  if the texture or the type of a tile changes and not if its vertices change. A rebuild of a
+ *  chunk is deferred until the chunk is drawn.
+ * @remark
+ *  This class does not depend on a graphics context.
+ */
+class TerrainChunks {
+public:
+    /// @brief The size, in tiles, of a chunk along the x- and y-axes.
+    static constexpr size_t ChunkSize = 8;
+
+    /// @brief The texture index of tiles which are not drawn.
+    static constexpr uint32_t NoTexture = std::numeric_limits<uint32_t>::max();
+
+    /// @brief The information about a tile required to build the batches.
+    struct Tile {
+        /// @brief The texture index of the tile or NoTexture.
+        uint32_t texture;
+        /// @brief The index of the first vertex of the tile.
+        uint32_t vertexStart;
+        /// @brief The definition of the tile type or a null pointer.
+        const tile_definition_t *definition;
+    };
+
+    /// @brief A function providing the information about a tile.
+    using TileFunction = std::function<Tile(const Index1D&)>;
+
+    /// @brief A draw call.
+    struct Draw {
+        /// @brief The texture index.
+        uint32_t texture;
+        /// @brief A pointer to the first index.
+        const uint32_t *indices;
+        /// @brief The number of indices (three per triangle).
+        uint32_t count;
+    };
+
+private:
+    /// @brief The indices of the triangles of a tile in the index list of a batch.
+    struct TileRange {
+        uint32_t tile;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    /// @brief The triangles of the tiles of a chunk using the same texture.
+    struct Batch {
+        uint32_t texture;
+        std::vector<uint32_t> indices;
+        std::vector<TileRange> tiles;
+    };
+
+    struct Chunk {
+        /// @brief If the batches must be rebuilt.
+        bool dirty;
+        std::vector<Batch> batches;
+        /// @brief The generation in which this chunk was last visited by makeDraws.
+        uint32_t generation;
+        /// @brief The smallest distance of a visible tile in this chunk.
+        float distance;
+    };
+
+public:
+    /**
+     * @brief
+     *  Construct the chunks of a mesh. All chunks are dirty.
+     * @param info
+     *  the mesh info
+     */
+    TerrainChunks(const MeshInfo& info);
+
+    /// @brief Mark all chunks dirty.
+    void invalidate();
+
+    /// @brief Mark the chunk of a tile dirty.
+    void invalidate(const Index1D& tile);
+
+    /// @brief Get the number of chunks along the x- and y-axes.
+    size_t getChunkCountX() const;
+    size_t getChunkCountY() const;
+
+    /// @brief Get the number of chunks rebuilt since the construction of this object.
+    size_t getRebuildCount() const;
+
+    /**
+     * @brief
+     *  Get the draw calls for a list of tiles.
+     * @param tiles
+     *  the list of tiles
+     * @param function
+     *  a function providing the information about the tiles of dirty chunks
+     * @return
+     *  the draw calls. Sorted by texture and, for the same texture, from near to far chunks.
+     *  The list and the index pointers are valid until the next call to this function.
+     * @remark
+     *  Within a chunk, consecutive tiles of the same texture in the list are merged into one draw call.
+     */
+    const std::vector<Draw>& makeDraws(const std::vector<ClippingEntry>& tiles, const TileFunction& function);
+
+private:
+    /// @brief Rebuild the batches of a chunk.
+    void rebuild(size_t chunkIndex, const TileFunction& function);
+
+    MeshInfo _info;
+    size_t _chunkCountX, _chunkCountY;
+    std::vector<Chunk> _chunks;
+    size_t _rebuildCount;
+
+    /// @brief The current generation, incremented by each call to makeDraws.
+    uint32_t _generation;
+    /// @brief The generation in which a tile was last in the list passed to makeDraws.
+    std::vector<uint32_t> _visible;
+    /// @brief The chunks visited in the current generation.
+    std::vector<uint32_t> _visited;
+    /// @brief The draw calls of the current generation.
+    std::vector<Draw> _draws;
+    /// @brief The buffers of the radix sorts of the visited chunks and the draw calls.
+    std::vector<uint32_t> _visitedBuffer;
+    std::vector<Draw> _drawsBuffer;
+};
+
+} // namespace Graphics
+} // namespace Ego
@@ -2,6 +2,7 @@
 #include "egolib/game/Core/GameEngine.hpp"
 #include "egolib/game/Module/Module.hpp"
 #include "egolib/Image/SDL_Image_Extensions.h"
+#include "egolib/Graphics/TextureCache.hpp"
 #include "egolib/game/graphic.h" //only for MESH_IMG_COUNT constant
 
 namespace Ego { namespace Graphics {
@@ -63,6 +64,19 @@ void TextureAtlasManager::decimate(const std::shared_ptr<const Ego::Texture>& so
             // Create the destination texture.
             auto targetTexture = Renderer::get().createTexture();
 
+            // The tiles of a tile set are cached as variants of the tile set image.
+            std::ostringstream variant;
+            variant << "tile:" << minification << ":" << ix << ":" << iy;
+            const std::string name = sourceTexture->getName() + "#" + variant.str();
+
+            // Use the cached pixels if available.
+            auto targetPixels = TextureCache::get().load(sourceTexture->getName(), variant.str());
+            if (targetPixels) {
+                targetTexture->load(name, targetPixels);
+                targetTextureList.push_back(targetTexture);
+                continue;
+            }
+
             // Create the destination surface.
             const auto& pfd = pixel_descriptor::get<idlib::pixel_format::R8G8B8A8>();
             auto targetImage = ImageManager::get().createImage(rectangle.w, rectangle.h, pfd);
@@ -74,8 +88,10 @@ void TextureAtlasManager::decimate(const std::shared_ptr<const Ego::Texture>& so
             idlib::blit(sourceImage.get(), Rectangle2f(Point2f(rectangle.x, rectangle.y), Point2f(rectangle.x + rectangle.w, rectangle.y + rectangle.h)), targetImage.get());
 
             // upload the SDL_Surface into OpenGL
-            targetTexture->load(targetImage);
+            targetPixels = TexturePixels::create(targetImage, true);
+            targetTexture->load(name, targetPixels);
             targetTextureList.push_back(targetTexture);
+            TextureCache::get().store(sourceTexture->getName(), variant.str(), *targetPixels);
         }
     }
 }
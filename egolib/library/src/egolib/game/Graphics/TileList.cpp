@@ -36,9 +36,13 @@ TileList::TileList() :
 	_reflective(), 
 	_nonReflective(), 
 	_water(),
+	_visibleTiles(),
+	_bounds(),
+	_cornerLighting(),
 
 	_renderTiles(),
-	_lastRenderTiles()
+	_lastRenderTiles(),
+	_enteredTiles()
 {
     try
     {
@@ -75,6 +79,8 @@ void TileList::reset()
 	_lastRenderTiles = _renderTiles;
 	_renderTiles.reset();
 
+	_enteredTiles.clear();
+
 	// Re-initialize the renderlist.
 	init();
 }
@@ -89,8 +95,8 @@ gfx_rv TileList::insert(const Index1D& index, const ::Camera &cam)
 	ego_tile_info_t& ptile = getMesh()->_tmem.get(index);
 
     auto i2 = Grid::map<int>(index, (int)getMesh()->_info.getTileCountX());
-	float dx = (i2.x() + Info<float>::Grid::Size() * 0.5f) - cam.getCenter()[kX];
-	float dy = (i2.y() + Info<float>::Grid::Size() * 0.5f) - cam.getCenter()[kY];
+	float dx = (i2.x() + 0.5f) * Info<float>::Grid::Size() - cam.getCenter()[kX];
+	float dy = (i2.y() + 0.5f) * Info<float>::Grid::Size() - cam.getCenter()[kY];
 	float distance = dx * dx + dy * dy;
 
 	// Put each tile in basic list
@@ -134,9 +140,7 @@ gfx_rv TileList::add(const Index1D& index, ::Camera& camera)
 
 	// if the tile was not in the renderlist last frame, then we need to force a lighting update of this tile
 	if(!_lastRenderTiles[index.i()]) {
-		ego_tile_info_t& tile = getMesh()->_tmem.get(index);
-		tile._lightingCache.setNeedUpdate(true);
-		tile._lightingCache.setLastFrame(-1);
+		_enteredTiles.push_back(index);
 	}
 
 	if (gfx_error == insert(index, camera))
@@ -147,6 +151,17 @@ gfx_rv TileList::add(const Index1D& index, ::Camera& camera)
 	return gfx_success;
 }
 
+void TileList::invalidateEnteredTiles()
+{
+	auto mesh = getMesh();
+	for (const auto& index : _enteredTiles) {
+		ego_tile_info_t& tile = mesh->_tmem.get(index);
+		tile._lightingCache.setNeedUpdate(true);
+		tile._lightingCache.setLastFrame(-1);
+	}
+	_enteredTiles.clear();
+}
+
 bool TileList::inRenderList(const Index1D& index) const
 {
 	if(index == Index1D::Invalid) return false;
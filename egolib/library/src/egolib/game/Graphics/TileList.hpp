@@ -26,6 +26,7 @@
 #include "egolib/game/egoboo.h"
 #include "egolib/game/mesh.h"
 #include "egolib/game/Graphics/CameraSystem.hpp"
+#include "egolib/game/Graphics/CornerLighting.hpp"
 
 namespace Ego {
 namespace Graphics {
@@ -86,6 +87,13 @@ struct TileList
 	/// @remark Tiles on which the MAPFX_WATER bit is set are added to this list.
     std::vector<ClippingEntry> _water;
 
+	/// @brief The tiles in the view frustum, as determined by the culling hierarchy of the mesh.
+	std::vector<Index1D> _visibleTiles;
+	/// @brief The join of the bounds of the tiles in the view frustum.
+	oct_bb_t _bounds;
+	/// @brief The tiles whose corners are lit in this frame and their corner lighting.
+	CornerLighting _cornerLighting;
+
 	TileList();
 	virtual ~TileList();
 	void init();
@@ -107,6 +115,11 @@ struct TileList
 	/// @param camera the camera
 	gfx_rv add(const Index1D& index, ::Camera& camera);
 
+	/// @brief Force a lighting update of the tiles which were added to this render list
+	///        but were not in it in the previous frame.
+	/// @remark Unlike add, this modifies the tiles of the mesh and must not run concurrently with other render lists.
+	void invalidateEnteredTiles();
+
 	/// @brief check wheter a tile was rendered this render frame.
 	/// @param index the index number of the tile
 	/// @return true if the specified tile is currently in the render list for this render frame
@@ -115,6 +128,7 @@ struct TileList
 private:
 	std::bitset<MAP_TILE_MAX> _renderTiles;		//index of all tiles to be rendered
 	std::bitset<MAP_TILE_MAX> _lastRenderTiles; //index of all tiles that were rendered last frame
+	std::vector<Index1D> _enteredTiles;         //tiles in this frame which were not rendered last frame
 };
 
 }
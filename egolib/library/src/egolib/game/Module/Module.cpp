@@ -966,21 +966,42 @@ void GameModule::spawnAllObjects()
             }
         }
 
-        //Now spawn each object in order
+        //Dynamic slot number? Then figure out what slot number is assigned to us
+        std::unordered_map<std::string, int> dynamicSlots;
+        for(const auto &element : reservedSlots)
+        {
+            if(!element.second.empty() && dynamicObjectList.count(element.second)) {
+                dynamicSlots.emplace(element.second, element.first);
+            }
+        }
         for(spawn_file_info_t &spawnInfo : objectsToSpawn)
         {
-            //Dynamic slot number? Then figure out what slot number is assigned to us
             if(spawnInfo.slot <= -1) {
-                for(const auto &element : reservedSlots)
-                {
-                    if(element.second == spawnInfo.spawn_comment)
-                    {
-                        spawnInfo.slot = element.first;
-                        break;
-                    }
+                auto it = dynamicSlots.find(spawnInfo.spawn_comment);
+                if(it != dynamicSlots.end()) {
+                    spawnInfo.slot = it->second;
                 }
             }
+        }
 
+        //Load the models of the profiles to be loaded in parallel, the profiles are then loaded in order
+        std::vector<std::string> modelsToLoad;
+        std::unordered_set<std::string> modelsToLoadSet;
+        for(const spawn_file_info_t &spawnInfo : objectsToSpawn)
+        {
+            if(spawnInfo.slot < 0 || spawnInfo.spawn_comment.empty() || ProfileSystem::get().isLoaded(spawnInfo.slot)) {
+                continue;
+            }
+            const std::string folderPath = "mp_objects/" + spawnInfo.spawn_comment;
+            if(modelsToLoadSet.insert(folderPath).second && vfs_exists(folderPath)) {
+                modelsToLoad.push_back(folderPath);
+            }
+        }
+        ProfileSystem::get().prefetchModels(modelsToLoad);
+
+        //Now spawn each object in order
+        for(spawn_file_info_t &spawnInfo : objectsToSpawn)
+        {
             // If nothing is already in that slot, try to load it.
             if (!ProfileSystem::get().isLoaded(spawnInfo.slot))
             {
@@ -1010,6 +1031,9 @@ void GameModule::spawnAllObjects()
         }
     }
 
+    //Release the models which were loaded but not used (e.g. because the slot was taken by another profile)
+    ProfileSystem::get().clearPrefetchedModels();
+
     // Fix tilting trees problem
     tiltCharactersToTerrain();
 
@@ -1176,8 +1200,8 @@ void GameModule::update()
     //Check abilities of all local players
     MainLoop::updateLocalStats();
 
-    // keep the mpdfx lists up-to-date. No calculation is done unless one
-    // of the mpdfx values was changed during the last update
+    // keep the mpdfx lists up-to-date. No calculation is done unless the lists
+    // were reset: changes of the mpdfx values update the lists incrementally
     _mesh->_fxlists.synch(_mesh->_tmem, false);
 
     //Rebuild the quadtree for fast object lookup
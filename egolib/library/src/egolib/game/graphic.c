@@ -53,6 +53,7 @@
 #include "egolib/game/Graphics/TextureAtlasManager.hpp"
 #include "egolib/game/Module/Passage.hpp"
 #include "egolib/game/GUI/Material.hpp"
+#include "egolib/Core/ParallelFor.hpp"
 
 //--------------------------------------------------------------------------------------------
 
@@ -113,7 +114,7 @@ void reinitClocks() {
     GFX::get().getBackground().clock.reinit();
 }
 
-static gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, dynalist_t& dyl, Camera& cam);
+static gfx_rv render_scene_init(const std::vector<std::shared_ptr<Camera>>& cameras, dynalist_t& dyl);
 static gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el);
 
 /**
@@ -123,8 +124,13 @@ static gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphi
  *  the list to add characters to
  * @param camera
  *	the camera
+ * @param particles
+ *  the particles to test
+ * @remark
+ *  Only the list and the camera are modified, hence the lists of different cameras can be built concurrently.
  */
-static gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& camera);
+static gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, const Ego::Graphics::TileList& tl, Camera& camera,
+                                  const std::vector<std::shared_ptr<Ego::Particle>>& particles);
 static gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& camera);
 static gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& camera);
 
@@ -157,12 +163,28 @@ GFX::GFX() :
     entityReflections(std::make_unique<Ego::Graphics::EntityReflectionsRenderPass>()),
     foreground(std::make_unique<Ego::Graphics::ForegroundRenderPass>()),
     background(std::make_unique<Ego::Graphics::BackgroundRenderPass>()),
-    heightmap(std::make_unique<Ego::Graphics::HeightmapRenderPass>())
+    heightmap(std::make_unique<Ego::Graphics::HeightmapRenderPass>()),
+    objectDistances()
 {}
 
 GFX::~GFX()
 {}
 
+//--------------------------------------------------------------------------------------------
+void gfx_system_prepare_world(const std::vector<std::shared_ptr<Camera>>& cameras)
+{
+    for (const auto& camera : cameras)
+    {
+        if (!camera)
+        {
+            throw idlib::argument_null_error(__FILE__, __LINE__, "camera");
+        }
+    }
+
+    ClockScope<ClockPolicy::NonRecursive> clockScope(render_scene_init_timer);
+    render_scene_init(cameras, GFX::get().getDynalist());
+}
+
 //--------------------------------------------------------------------------------------------
 void gfx_system_render_world(std::shared_ptr<Camera> camera, std::shared_ptr<Ego::Graphics::TileList> tileList, std::shared_ptr<Ego::Graphics::EntityList> entityList)
 {
@@ -184,7 +206,8 @@ void gfx_system_render_world(std::shared_ptr<Camera> camera, std::shared_ptr<Ego
         render_scene(*camera, *tileList, *entityList);
 		GFX::get().getForeground().run(*camera, *tileList, *entityList);
 
-        if (camera->getMotionBlur() > 0)
+        // The accumulation buffer is used directly.
+        if (camera->getMotionBlur() > 0 && Ego::Renderer::get().isDirectRenderingEnabled())
         {
             if (camera->getMotionBlurOld() < 0.001f)
             {
@@ -403,6 +426,12 @@ float draw_fps(float y)
         if (egoboo_config_t::get().debug_developerMode_enable.getValue())
         {
 			/** @todo This should be made available through the GUI. Too much information just to print out things on screen. */
+            const auto& statistics = Ego::Renderer::get().getLastFrameStatistics();
+            os.str("");
+            os << statistics.draws << " draws, "
+               << statistics.stateChanges << " state changes, "
+               << statistics.redundantStateChanges << " redundant state changes";
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0.0f, 1.0f);
         }
     }
 
@@ -507,6 +536,18 @@ float draw_debug(float y)
         os.str(std::string()); os << "~~FREECHR: " << OBJECTS_MAX - _currentModule->getObjectHandler().getObjectCount();
         y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0, 1.0f);
 
+        const auto& lightStats = GFX::get().getDynalist().clusters.getStats();
+        os.str(std::string()); os << "~~LIGHTS:  " << lightStats.lights
+                                  << " CLUSTERS: " << lightStats.occupiedClusters << "/" << lightStats.clusters
+                                  << " MAX: " << lightStats.maxLightsPerCluster
+                                  << " AVG: " << std::setprecision(3) << lightStats.getAverageLightsPerCluster();
+        y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0, 1.0f);
+
+        const auto& vertexCounters = Ego::Graphics::ObjectGraphics::getVertexCounters();
+        os.str(std::string()); os << "~~VERTS:   " << vertexCounters.interpolated << " LERP " << vertexCounters.copied << " COPY"
+                                  << " LOD: " << vertexCounters.instances[0] << "/" << vertexCounters.instances[1] << "/" << vertexCounters.instances[2];
+        y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0, 1.0f);
+
         os.str(std::string()); os << "~~EXPORT:  " << (_currentModule->isExportValid() ? "TRUE" : "FALSE");
         y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0, 1.0f);
 
@@ -671,21 +712,38 @@ void draw_mouse_cursor()
 //--------------------------------------------------------------------------------------------
 // render_scene FUNCTIONS
 //--------------------------------------------------------------------------------------------
-gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, dynalist_t& dyl, Camera& cam)
+gfx_rv render_scene_init(const std::vector<std::shared_ptr<Camera>>& cameras, dynalist_t& dyl)
 {
     // assume the best;
     gfx_rv retval = gfx_success;
 
+    if (cameras.empty())
+    {
+        return retval;
+    }
+
+    // The visible tiles and entities are determined concurrently for all cameras. The task of a
+    // camera writes only to the camera and its lists, all other work below is done on this thread.
+    std::vector<gfx_rv> results(cameras.size(), gfx_success);
+
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(gfx_make_tileList_timer);
         // Which tiles can be displayed
-        if (gfx_error == gfx_make_tileList(tl, cam))
+        Ego::Core::parallelFor(cameras.size(), 1, [&](size_t first, size_t last)
         {
-            retval = gfx_error;
+            for (size_t i = first; i < last; ++i)
+            {
+                results[i] = gfx_make_tileList(*cameras[i]->getTileList(), *cameras[i]);
+            }
+        });
+        // force a lighting update of the tiles which became visible
+        for (const auto& camera : cameras)
+        {
+            camera->getTileList()->invalidateEnteredTiles();
         }
     }
 
-    auto mesh = tl.getMesh();
+    auto mesh = cameras.front()->getTileList()->getMesh();
     if (!mesh)
     {
 		throw idlib::runtime_error(__FILE__, __LINE__, "tile list is not attached to a mesh");
@@ -693,8 +751,46 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
 
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(gfx_make_entityList_timer);
+        // The particle handler must not be iterated concurrently.
+        std::vector<std::shared_ptr<Ego::Particle>> particles;
+        for (const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator())
+        {
+            particles.push_back(particle);
+        }
+
         // determine which objects are visible
-        if (gfx_error == gfx_make_entityList(el, cam))
+        Ego::Core::parallelFor(cameras.size(), 1, [&](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                if (gfx_error == gfx_make_entityList(*cameras[i]->getEntityList(), *cameras[i]->getTileList(), *cameras[i], particles))
+                {
+                    results[i] = gfx_error;
+                }
+            }
+        });
+
+        // a particle is in the dolist if it is in the entity list of any camera
+        for (const auto& particle : particles)
+        {
+            particle->inst.indolist = false;
+        }
+        for (const auto& camera : cameras)
+        {
+            const auto& el = *camera->getEntityList();
+            for (size_t i = 0, n = el.getSize(); i < n; ++i)
+            {
+                if (ParticleRef::Invalid != el.get(i).iprt)
+                {
+                    ParticleHandler::get()[el.get(i).iprt]->inst.indolist = true;
+                }
+            }
+        }
+    }
+
+    for (const auto result : results)
+    {
+        if (gfx_error == result)
         {
             retval = gfx_error;
         }
@@ -703,25 +799,31 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
     // put off sorting the entity list until later
     // because it has to be sorted differently for reflected and non-reflected objects
 
+    // The lighting is done camera by camera: It is parallel over the tiles of a camera.
+    // Tiles visible to several cameras are lit only once per frame.
+    for (const auto& camera : cameras)
     {
-		ClockScope<ClockPolicy::NonRecursive> scope(do_grid_lighting_timer);
-        // figure out the terrain lighting
-		if (gfx_error == GridIllumination::do_grid_lighting(tl, dyl, cam))
         {
-            retval = gfx_error;
+			ClockScope<ClockPolicy::NonRecursive> scope(do_grid_lighting_timer);
+            // figure out the terrain lighting
+			if (gfx_error == GridIllumination::do_grid_lighting(*camera->getTileList(), dyl, *camera))
+            {
+                retval = gfx_error;
+            }
         }
-    }
 
-    {
-		ClockScope<ClockPolicy::NonRecursive> scope(light_fans_timer);
-        // apply the lighting to the characters and particles
-		GridIllumination::light_fans(tl);
+        {
+			ClockScope<ClockPolicy::NonRecursive> scope(light_fans_timer);
+            // apply the lighting to the characters and particles
+			GridIllumination::light_fans(*camera->getTileList());
+        }
     }
 
+    // The instances are shared by all cameras, hence they are updated once.
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(GFX::get().update_object_instances_timer);
         // Update object instances.
-        if (gfx_error == GFX::get().update_object_instances(cam))
+        if (gfx_error == GFX::get().update_object_instances(cameras))
         {
             retval = gfx_error;
         }
@@ -730,16 +832,33 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(GFX::get().update_particle_instances_timer);
         // Update particle instances.
-        if (gfx_error == GFX::get().update_particle_instances(cam))
+        if (gfx_error == GFX::get().update_particle_instances(*cameras.front()))
         {
             retval = gfx_error;
         }
     }
 
     // do the flashing for kursed objects
-    if (gfx_error == gfx_update_flashing(el))
+    for (const auto& camera : cameras)
+    {
+        if (gfx_error == gfx_update_flashing(*camera->getEntityList()))
+        {
+            retval = gfx_error;
+        }
+    }
+
     {
-        retval = gfx_error;
+        // Gather the render records shared by the entity render passes and
+        // sort the dolists for reflected rendering.
+        ClockScope<ClockPolicy::NonRecursive> scope(sortDoListReflected_timer);
+        Ego::Core::parallelFor(cameras.size(), 1, [&](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                cameras[i]->getEntityList()->prepareRecords(*mesh);
+                cameras[i]->getEntityList()->sort(*cameras[i], true);
+            }
+        });
     }
 
     return retval;
@@ -751,20 +870,9 @@ gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphics::Ent
 {
     // assume the best
     gfx_rv retval = gfx_success;
-    {
-		ClockScope<ClockPolicy::NonRecursive> clockScope(render_scene_init_timer);
-        if (gfx_error == render_scene_init(tl, el, GFX::get().getDynalist(), cam))
-        {
-            retval = gfx_error;
-        }
-    }
     {
 		ClockScope<ClockPolicy::NonRecursive> clockScope(render_scene_mesh_timer);
-        {
-			// Sort dolist for reflected rendering.
-			ClockScope<ClockPolicy::NonRecursive> clockScope2(sortDoListReflected_timer);
-			el.sort(cam, true);
-        }
+        // The dolist was sorted for reflected rendering by render_scene_init.
         // Advance the animation of animated tiles.
         animate_all_tiles(*tl.getMesh());
         // Render non-reflective tiles.
@@ -930,23 +1038,25 @@ float GridIllumination::grid_lighting_test(const ego_mesh_t& mesh, GLXvector3f p
 }
 
 //--------------------------------------------------------------------------------------------
-float GridIllumination::light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, bool reflective, float mesh_lighting_keep)
+void GridIllumination::gather_corners(const ego_mesh_t& mesh, const ego_tile_info_t& tile, Ego::Graphics::CornerLighting& lighting, size_t index)
 {
-	// if no update is requested, return an "error value"
-	if (!tile._lightingCache.getNeedUpdate())
+	const bool reflective = (0 != tile.testFX(MAPFX_REFLECTIVE));
+	for (size_t corner = 0; corner < 4; corner++)
 	{
-		return -1.0f;
-	}
+		const GLXvector3f& pnrm = tile._ncache[corner];
+		const GLXvector3f& ppos = mesh._tmem._plst[tile._vrtstart + corner];
 
-	// has the lighting already been calculated this frame?
-	if (tile._lightingCache.isValid(_gameEngine->getNumberOfFramesRendered()))
-	{
-		return -1.0f;
+		// interpolate the lighting for the given corner of the mesh
+		lighting_cache_t grid_light;
+		grid_lighting_interpolate(mesh, grid_light, Ego::Vector2f(ppos[0], ppos[1]));
+
+		lighting.setCorner(index, corner, grid_light, Ego::Vector3f(pnrm[0], pnrm[1], pnrm[2]), ppos[2], mesh._tmem._bbox, reflective);
 	}
+}
 
-	// get the normal and lighting cache for this tile
-	tile_mem_t& ptmem = mesh._tmem;
-	normal_cache_t& ncache = tile._ncache;
+float GridIllumination::light_corners(ego_tile_info_t& tile, const Ego::Graphics::CornerLighting& lighting, size_t index, float mesh_lighting_keep, uint32_t frame)
+{
+	// get the lighting cache for this tile
 	light_cache_t& lcache = tile._lightingCache._contents;
 	light_cache_t& d1_cache = tile._vertexLightingCache._d1_cache;
 	light_cache_t& d2_cache = tile._vertexLightingCache._d2_cache;
@@ -954,18 +1064,12 @@ float GridIllumination::light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, b
 	float max_delta = 0.0f;
 	for (size_t corner = 0; corner < 4; corner++)
 	{
-		GLXvector3f& pnrm = ncache[corner];
 		float& plight = lcache[corner];
 		float& pdelta1 = d1_cache[corner];
 		float& pdelta2 = d2_cache[corner];
-		GLXvector3f& ppos = ptmem._plst[tile._vrtstart + corner];
 
 		float light_old, delta, light_tmp;
-		float light_new = 0.0f;
-		light_one_corner(mesh, tile, reflective, 
-			             Ego::Vector3f(ppos[0], ppos[1], ppos[2]),
-			             Ego::Vector3f(pnrm[0], pnrm[1], pnrm[2]),
-			             light_new);
+		float light_new = lighting.getLight(index, corner);
 
 		if (plight != light_new)
 		{
@@ -999,7 +1103,7 @@ float GridIllumination::light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, b
 
 	// un-mark the lcache
 	tile._lightingCache.setNeedUpdate(false);
-	tile._lightingCache.setLastFrame(_gameEngine->getNumberOfFramesRendered());
+	tile._lightingCache.setLastFrame(frame);
 
 	return max_delta;
 }
@@ -1088,23 +1192,6 @@ bool GridIllumination::test_corners(const ego_mesh_t& mesh, ego_tile_info_t& til
 	return retval;
 }
 
-void GridIllumination::light_one_corner(ego_mesh_t& mesh, ego_tile_info_t& tile, const bool reflective, const Ego::Vector3f& pos, const Ego::Vector3f& nrm, float& plight)
-{
-	// interpolate the lighting for the given corner of the mesh
-	lighting_cache_t grid_light;
-	grid_lighting_interpolate(mesh, grid_light, Ego::Vector2f(pos[kX], pos[kY]));
-
-	if (reflective) {
-		float light_dir, light_amb;
-		lighting_cache_t::lighting_evaluate_cache(grid_light, nrm, pos[ZZ], mesh._tmem._bbox, &light_amb, &light_dir);
-
-		// make ambient light only illuminate 1/2
-		plight = light_amb + 0.5f * light_dir;
-	} else {
-		plight = lighting_cache_t::lighting_evaluate_cache(grid_light, nrm, pos[ZZ], mesh._tmem._bbox, NULL, NULL);
-	}
-}
-
 bool GridIllumination::light_corner(ego_mesh_t& mesh, const Index1D& fan, float height, float nrm[], float& plight)
 {
 	ego_tile_info_t& ptile = mesh.getTileInfo(fan);
@@ -1152,7 +1239,12 @@ void gfx_do_clear_screen()
 void gfx_do_flip_pages()
 {
     Ego::Core::Console::get().draw();
-    SDL_GL_SwapWindow(Ego::GraphicsSystem::get().window->get());
+    Ego::Renderer::get().endFrame();
+    // Without an OpenGL context (null renderer) there is nothing to swap.
+    if (Ego::Renderer::get().isDirectRenderingEnabled())
+    {
+        SDL_GL_SwapWindow(Ego::GraphicsSystem::get().window->get());
+    }
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1206,8 +1298,9 @@ void GridIllumination::light_fans_update_lcache(Ego::Graphics::TileList& tl)
 	/// @note it is normally assumed that 64 colors of gray can make a smoothly colored black and white picture
 	/// which means that the threshold could be set as low as 1/64 = 0.015625.
 	const float delta_threshold = 0.05f;
-	
-	bool is_valid;
+
+	/// @note the minimum number of tiles per task of the parallel update.
+	const size_t light_fans_grain_size = 64;
 
 	auto mesh = tl.getMesh();
 	if (!mesh)
@@ -1230,58 +1323,80 @@ void GridIllumination::light_fans_update_lcache(Ego::Graphics::TileList& tl)
 	float local_mesh_lighting_keep = std::pow(0.9f, frame_skip);
 #endif
 
-    // cache the grid lighting
-    for (size_t entry = 0; entry < tl._all.size(); entry++)
+    const uint32_t frame = _gameEngine->getNumberOfFramesRendered();
+
+    // Determine which tiles need an update. The tiles are independent within a frame:
+    // The update of a tile reads the grid lighting of its neighbours and only writes to the tile.
+    const std::vector<Ego::Graphics::ClippingEntry>& entries = tl._all;
+    Ego::Core::parallelFor(entries.size(), light_fans_grain_size, [&](size_t first, size_t last)
     {
-        // which tile?
-        Index1D fan = tl._all[entry].getIndex();
+        for (size_t entry = first; entry < last; entry++)
+        {
+            // which tile?
+            Index1D fan = entries[entry].getIndex();
 
-        // grab a pointer to the tile
-		ego_tile_info_t& ptile = mesh->getTileInfo(fan);
+            // grab a pointer to the tile
+            ego_tile_info_t& ptile = mesh->getTileInfo(fan);
 
-        // Test to see whether the lcache was already updated
-        // - ptile->_lcache_frame < 0 means that the cache value is invalid.
-        // - ptile->_lcache_frame is updated inside ego_mesh_light_corners()
+            // Test to see whether the lcache was already updated
+            // - ptile->_lcache_frame < 0 means that the cache value is invalid.
+            // - ptile->_lcache_frame is updated inside GridIllumination::light_corners()
 #if defined(CLIP_LIGHT_FANS)
-        // clip the updated on each individual tile
-        is_valid = ptile._lightingCache.isValid(_gameEngine->getNumberOfFramesRendered(), frame_skip);
+            // clip the updated on each individual tile
+            const bool is_valid = ptile._lightingCache.isValid(frame, frame_skip);
 #else
-        // let the function clip all tile updates
-        is_valid = ptile._lightingCache.isValid(_gameEngine->getNumberOfFramesRendered());
+            // let the function clip all tile updates
+            const bool is_valid = ptile._lightingCache.isValid(frame);
 #endif
-	if (is_valid)
-        {
-            continue;
+            // If no update was requested ...
+            if (!is_valid && !ptile._lightingCache.getNeedUpdate())
+            {
+                // ... do we need one?
+                gfx_rv light_fans_rv = light_fans_throttle_update(mesh.get(), ptile, fan, delta_threshold);
+                ptile._lightingCache.setNeedUpdate(gfx_success == light_fans_rv);
+            }
         }
+    });
 
-        // If no update was requested ...
-        if (!ptile._lightingCache.getNeedUpdate())
+    // Gather the tiles which still need an update.
+    Ego::Graphics::CornerLighting& lighting = tl._cornerLighting;
+    lighting.clear();
+    for (const auto& entry : entries)
+    {
+        ego_tile_info_t& ptile = mesh->getTileInfo(entry.getIndex());
+#if defined(CLIP_LIGHT_FANS)
+        const bool is_valid = ptile._lightingCache.isValid(frame, frame_skip);
+#else
+        const bool is_valid = ptile._lightingCache.isValid(frame);
+#endif
+        if (!is_valid && ptile._lightingCache.getNeedUpdate())
         {
-			// ... do we need one?
-            gfx_rv light_fans_rv = light_fans_throttle_update(mesh.get(), ptile, fan, delta_threshold);
-            ptile._lightingCache.setNeedUpdate(gfx_success == light_fans_rv);
+            lighting.addTile(entry.getIndex());
         }
+    }
 
-		// If there is still no need for an update, go to the next tile.
-		if (!ptile._lightingCache.getNeedUpdate()) {
-			continue;
-		}
-
-        // is the tile reflective?
-        bool reflective = (0 != ptile.testFX(MAPFX_REFLECTIVE));
-
-        // light the corners of this tile
-        float delta = GridIllumination::light_corners(*mesh, ptile, reflective, local_mesh_lighting_keep);
+    // light the corners of these tiles
+    Ego::Core::parallelFor(lighting.getTileCount(), light_fans_grain_size, [&](size_t first, size_t last)
+    {
+        for (size_t index = first; index < last; index++)
+        {
+            gather_corners(*mesh, mesh->getTileInfo(lighting.getTile(index)), lighting, index);
+        }
+        lighting.evaluate(first, last);
+        for (size_t index = first; index < last; index++)
+        {
+            ego_tile_info_t& ptile = mesh->getTileInfo(lighting.getTile(index));
+            float delta = GridIllumination::light_corners(ptile, lighting, index, local_mesh_lighting_keep, frame);
 
 #if defined(CLIP_LIGHT_FANS)
-        // Use the actual maximum change in the intensity at a tile corner to
-        // signal whether we need to calculate the next stage.
-        ptile._vertexLightingCache.setNeedUpdate(delta > delta_threshold);
+            // Use the actual maximum change in the intensity at a tile corner to
+            // signal whether we need to calculate the next stage.
+            ptile._vertexLightingCache.setNeedUpdate(delta > delta_threshold);
 #else
-        // make sure that ego_mesh_light_corners() did not return an "error value"
-        ptile._vertexLightingCache.setNeedUpdate(delta > 0.0f);
+            ptile._vertexLightingCache.setNeedUpdate(delta > 0.0f);
 #endif
-    }
+        }
+    });
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1360,66 +1475,74 @@ void GridIllumination::light_fans_update_clst(Ego::Graphics::TileList& tl)
     auto mesh = tl.getMesh();
     if (!mesh)
     {
-		throw idlib::runtime_error(__FILE__, __LINE__, "tile list is not attached to a mesh");
+        throw idlib::runtime_error(__FILE__, __LINE__, "tile list is not attached to a mesh");
     }
 
     // alias the tile memory
-	tile_mem_t& ptmem = mesh->_tmem;
+    tile_mem_t& ptmem = mesh->_tmem;
 
-    // use the grid to light the tiles
-    for (size_t entry = 0; entry < tl._all.size(); entry++)
+    /// @note the minimum number of tiles per task of the parallel update.
+    const size_t light_fans_grain_size = 64;
+    const uint32_t frame = _gameEngine->getNumberOfFramesRendered();
+
+    // use the grid to light the tiles. Each tile only writes to its own vertices.
+    const std::vector<Ego::Graphics::ClippingEntry>& entries = tl._all;
+    Ego::Core::parallelFor(entries.size(), light_fans_grain_size, [&](size_t first, size_t last)
     {
-        Index1D fan = tl._all[entry].getIndex();
-        if (Index1D::Invalid == fan) continue;
+        for (size_t entry = first; entry < last; entry++)
+        {
+            Index1D fan = entries[entry].getIndex();
+            if (Index1D::Invalid == fan) continue;
 
-        // valid tile?
-		ego_tile_info_t& ptile = mesh->getTileInfo(fan);
+            // valid tile?
+            ego_tile_info_t& ptile = mesh->getTileInfo(fan);
 
-        // Do nothing if this tile does not need an update.
-        if (!ptile._vertexLightingCache.getNeedUpdate()) {
-            continue;
-        }
+            // Do nothing if this tile does not need an update.
+            if (!ptile._vertexLightingCache.getNeedUpdate()) {
+                continue;
+            }
 
-        // Do nothing if the update was performed in this frame.
-        if (ptile._vertexLightingCache.isValid(_gameEngine->getNumberOfFramesRendered())) {
-            continue;
-        }
+            // Do nothing if the update was performed in this frame.
+            if (ptile._vertexLightingCache.isValid(frame)) {
+                continue;
+            }
 
-		size_t numberOfVertices;
-		tile_definition_t *pdef = tile_dict.get(ptile._type);
-        if (nullptr != pdef) {
-			numberOfVertices = pdef->numvertices;
-        } else {
-			numberOfVertices = 4;
-        }
+            size_t numberOfVertices;
+            tile_definition_t *pdef = tile_dict.get(ptile._type);
+            if (nullptr != pdef) {
+                numberOfVertices = pdef->numvertices;
+            } else {
+                numberOfVertices = 4;
+            }
 
-		size_t index, vertex;
-        // copy the 1st 4 vertices
-        for (index = 0, vertex = ptile._vrtstart; index < 4; index++, vertex++)
-        {
-            GLXvector3f& color = ptmem._clst[vertex];
-            float light = ptile._lightingCache._contents[index];
-			color[RR] = color[GG] = color[BB] 
-				= idlib::fraction<float, 1, 255>() * Ego::Math::constrain(light, 0.0f, 255.0f);
-        }
+            size_t index, vertex;
+            // copy the 1st 4 vertices
+            for (index = 0, vertex = ptile._vrtstart; index < 4; index++, vertex++)
+            {
+                GLXvector3f& color = ptmem._clst[vertex];
+                float light = ptile._lightingCache._contents[index];
+                color[RR] = color[GG] = color[BB]
+                    = idlib::fraction<float, 1, 255>() * Ego::Math::constrain(light, 0.0f, 255.0f);
+            }
 
-        for ( /* Intentionall left empty. */; index < numberOfVertices; index++, vertex++)
-        {
-			GLXvector3f& color = ptmem._clst[vertex];
-			const GLXvector3f& position = ptmem._plst[vertex];
-			float light = ego_mesh_interpolate_vertex(ptile, position);
-			color[RR] = color[GG] = color[BB] 
-				= idlib::fraction<float, 1, 255>() * Ego::Math::constrain(light, 0.0f, 255.0f);
-        }
+            for ( /* Intentionall left empty. */; index < numberOfVertices; index++, vertex++)
+            {
+                GLXvector3f& color = ptmem._clst[vertex];
+                const GLXvector3f& position = ptmem._plst[vertex];
+                float light = ego_mesh_interpolate_vertex(ptile, position);
+                color[RR] = color[GG] = color[BB]
+                    = idlib::fraction<float, 1, 255>() * Ego::Math::constrain(light, 0.0f, 255.0f);
+            }
 
-        // clear out the deltas
-        ptile._vertexLightingCache._d1_cache.fill(0.0f);
-        ptile._vertexLightingCache._d2_cache.fill(0.0f);
+            // clear out the deltas
+            ptile._vertexLightingCache._d1_cache.fill(0.0f);
+            ptile._vertexLightingCache._d2_cache.fill(0.0f);
 
-        // This tile was updated this frame and does not require an update (for some time).
-		ptile._vertexLightingCache.setNeedUpdate(false);
-		ptile._vertexLightingCache._lastFrame = _gameEngine->getNumberOfFramesRendered();
-    }
+            // This tile was updated this frame and does not require an update (for some time).
+            ptile._vertexLightingCache.setNeedUpdate(false);
+            ptile._vertexLightingCache._lastFrame = frame;
+        }
+    });
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1496,11 +1619,11 @@ bool sum_global_lighting(std::array<float, LIGHTING_VEC_SIZE> &lighting)
 //--------------------------------------------------------------------------------------------
 
 dynalist_t::dynalist_t()
-    : frame(-1), size(0), lst{}
+    : frame(-1), lst(), bounds(), references(), clusters()
 {}
 
 void dynalist_t::init(dynalist_t& self) {
-    self.size = 0;
+    self.lst.clear();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1510,15 +1633,6 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
     /// @details This function figures out which particles are visible, and it sets up dynamic
     ///    lighting
 
-    size_t    tnc;
-	Ego::Vector3f  vdist;
-
-    float         distance = 0.0f;
-    dynalight_data_t * plight = NULL;
-
-    float         distance_max = 0.0f;
-    dynalight_data_t * plight_max = NULL;
-
     // HACK: if dynalist is ahead of the game by 30 frames or more, reset and force an update
     if ((uint32_t)(dyl.frame + 30) >= _gameEngine->getNumberOfFramesRendered())
         dyl.frame = -1;
@@ -1532,6 +1646,7 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
     // Don't really make a list, just set to visible or not
     dynalist_t::init(dyl);
 
+    // collect all lights
     for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
     {
         if(particle->isTerminated()) continue;
@@ -1541,58 +1656,20 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
         // is the light on?
         if (!pprt_dyna.on || 0.0f == pprt_dyna.level) continue;
 
-        // reset the dynalight pointer
-        plight = NULL;
-
-        // find the distance to the camera
-        vdist = particle->getPosition() - cam.getTrackPosition();
-        distance = idlib::squared_euclidean_norm(vdist);
-
-        // insert the dynalight
-        if (dyl.size < gfx.dynalist_max && dyl.size < TOTAL_MAX_DYNA)
-        {
-            if (0 == dyl.size)
-            {
-                distance_max = distance;
-            }
-            else
-            {
-                distance_max = std::max(distance_max, distance);
-            }
-
-            // grab a new light from the list
-            plight = dyl.lst + dyl.size;
-            dyl.size++;
-
-            if (distance_max == distance)
-            {
-                plight_max = plight;
-            }
-        }
-        else if (distance < distance_max)
-        {
-            plight = plight_max;
-
-            // find the new maximum distance
-            distance_max = dyl.lst[0].distance;
-            plight_max = dyl.lst + 0;
-            for (tnc = 1; tnc < gfx.dynalist_max; tnc++)
-            {
-                if (dyl.lst[tnc].distance > distance_max)
-                {
-                    plight_max = dyl.lst + tnc;
-                    distance_max = plight_max->distance;
-                }
-            }
-        }
+        dynalight_data_t light;
+        light.distance = idlib::squared_euclidean_norm(particle->getPosition() - cam.getTrackPosition());
+        light.pos = particle->getPosition();
+        light.level = pprt_dyna.level;
+        light.falloff = pprt_dyna.falloff;
+        dyl.lst.push_back(light);
+    }
 
-        if (NULL != plight)
-        {
-            plight->distance = distance;
-            plight->pos = particle->getPosition();
-            plight->level = pprt_dyna.level;
-            plight->falloff = pprt_dyna.falloff;
-        }
+    // keep the lights nearest to the camera
+    if (dyl.lst.size() > gfx.dynalist_max)
+    {
+        std::nth_element(dyl.lst.begin(), dyl.lst.begin() + gfx.dynalist_max, dyl.lst.end(),
+                         [](const dynalight_data_t& x, const dynalight_data_t& y) { return x.distance < y.distance; });
+        dyl.lst.resize(gfx.dynalist_max);
     }
 
     // the list is updated, so update the frame count
@@ -1616,9 +1693,6 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
 
     std::array<float, LIGHTING_VEC_SIZE> global_lighting = {0};
 
-    size_t               reg_count = 0;
-    dynalight_registry_t reg[TOTAL_MAX_DYNA];
-
     ego_frect_t mesh_bound, light_bound;
     dynalight_data_t fake_dynalight;
 
@@ -1654,7 +1728,8 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
         return gfx_success;
 
     // clear out the dynalight registry
-    reg_count = 0;
+    dyl.bounds.clear();
+    dyl.references.clear();
 
     // refresh the dynamic light list
     gfx_make_dynalist(dyl, cam);
@@ -1674,7 +1749,7 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     // make bounding boxes for each dynamic light
     if (gfx.gouraudShading_enable)
     {
-        for (cnt = 0; cnt < dyl.size; cnt++)
+        for (cnt = 0; cnt < dyl.lst.size(); cnt++)
         {
             float radius;
             ego_frect_t ftmp;
@@ -1694,9 +1769,8 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
             // check to see if it intersects the "frustum"
             if (ftmp.xmin >= ftmp.xmax || ftmp.ymin >= ftmp.ymax) continue;
 
-            reg[reg_count].bound = ftmp;
-            reg[reg_count].reference = cnt;
-            reg_count++;
+            dyl.bounds.push_back(ftmp);
+            dyl.references.push_back(static_cast<int>(cnt));
 
             // determine the maxumum bounding box that encloses all valid lights
             light_bound.xmin = std::min(light_bound.xmin, ftmp.xmin);
@@ -1706,7 +1780,7 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
         }
 
         // are there any dynalights visible?
-        if (reg_count > 0 && light_bound.xmax >= light_bound.xmin && light_bound.ymax >= light_bound.ymin)
+        if (!dyl.bounds.empty() && light_bound.xmax >= light_bound.xmin && light_bound.ymax >= light_bound.ymin)
         {
             needs_dynalight = true;
         }
@@ -1717,7 +1791,7 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
         float dyna_weight_sum = 0.0f;
 
         // evaluate all the lights at the camera position
-        for (cnt = 0; cnt < dyl.size; cnt++)
+        for (cnt = 0; cnt < dyl.lst.size(); cnt++)
         {
 			dynalight_data_t& pdyna = dyl.lst[cnt];
 
@@ -1757,15 +1831,17 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
             light_bound = ftmp;
 
             // register the fake dynalight
-            reg[reg_count].bound = ftmp;
-            reg[reg_count].reference = -1;
-            reg_count++;
+            dyl.bounds.push_back(ftmp);
+            dyl.references.push_back(-1);
 
             // let the downstream calc know we are coming
             needs_dynalight = true;
         }
     }
 
+    // bin the registered lights into tile clusters
+    dyl.clusters.build(pinfo, dyl.bounds);
+
     // sum up the lighting from global sources
     sum_global_lighting(global_lighting);
 
@@ -1827,25 +1903,26 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
             {
                 if (fgrid_rect.ymin <= light_bound.ymax && fgrid_rect.ymax >= light_bound.ymin)
                 {
-                    // this grid has dynamic lighting. add it.
-                    for (cnt = 0; cnt < reg_count; cnt++)
+                    // this grid has dynamic lighting. add the lights of its cluster.
+                    for (uint32_t light : dyl.clusters.get(i2))
                     {
 						Ego::Vector3f nrm;
                         dynalight_data_t *pdyna;
+                        const ego_frect_t& bound = dyl.bounds[light];
 
                         // does this dynamic light intersects this grid?
-                        if (fgrid_rect.xmin > reg[cnt].bound.xmax || fgrid_rect.xmax < reg[cnt].bound.xmin) continue;
-                        if (fgrid_rect.ymin > reg[cnt].bound.ymax || fgrid_rect.ymax < reg[cnt].bound.ymin) continue;
+                        if (fgrid_rect.xmin > bound.xmax || fgrid_rect.xmax < bound.xmin) continue;
+                        if (fgrid_rect.ymin > bound.ymax || fgrid_rect.ymax < bound.ymin) continue;
 
                         // this should be a valid intersection, so proceed
-                        tnc = reg[cnt].reference;
+                        tnc = dyl.references[light];
                         if (tnc < 0)
                         {
                             pdyna = &fake_dynalight;
                         }
                         else
                         {
-                            pdyna = dyl.lst + tnc;
+                            pdyna = &dyl.lst[tnc];
                         }
 
                         nrm[kX] = pdyna->pos[kX] - x0;
@@ -1879,45 +1956,19 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
 //--------------------------------------------------------------------------------------------
 gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam)
 {
-	// @a true if clipping is enabled, @a false otherwise.
-	static const bool clippingEnabled = true;
-
-    // Because the main loop of the program will always flip the
-    // page before rendering the 1st frame of the actual game,
-    // _gameEngine->getNumberOfFramesRendered() will always start at 1
-    if (1 != (_gameEngine->getNumberOfFramesRendered() & 3))
-    {
-        return gfx_success;
-    }
-
     // reset the renderlist
     tl.reset();
 
-    // get the tiles in the center of the view (TODO: calculate actual tile view from camera frustrum)
-	int startX, startY, endX, endY;
-	if (clippingEnabled)
-	{
-		static const float offset = 10;
-		float centerX = cam.getTrackPosition()[kX] / Info<float>::Grid::Size();
-		float centerY = cam.getTrackPosition()[kY] / Info<float>::Grid::Size();
-		startX = Ego::Math::constrain<int>(centerX - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		startY = Ego::Math::constrain<int>(centerY - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-		endX = Ego::Math::constrain<int>(centerX + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		endY = Ego::Math::constrain<int>(centerY + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-	}
-	else
-	{
-		startX = 0;
-		startY = 0;
-		endX = _currentModule->getMeshPointer()->_info.getTileCountX();
-		endY = _currentModule->getMeshPointer()->_info.getTileCountY();
-	}
-    for(size_t x = startX; x < endX; ++x) {
-        for(size_t y = startY; y < endY; ++y) {
-            if (gfx_error == tl.add(x + y * _currentModule->getMeshPointer()->_info.getTileCountX(), cam))
-            {
-                return gfx_error;
-            }        
+    // get the tiles in the view frustum
+    auto mesh = _currentModule->getMeshPointer();
+    tl._visibleTiles.clear();
+    mesh->_culling.cull(cam.getFrustum(),
+                        [&mesh](const Index1D& index) -> const oct_bb_t& { return mesh->_tmem.get(index)._oct; },
+                        tl._visibleTiles, tl._bounds);
+    for (const auto& index : tl._visibleTiles) {
+        if (gfx_error == tl.add(index, cam))
+        {
+            return gfx_error;
         }
     }
 
@@ -1925,24 +1976,51 @@ gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam)
 }
 
 //--------------------------------------------------------------------------------------------
-gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& cam)
+static bool gfx_object_in_frustum(const Ego::Graphics::Frustum& frustum, const Object& object)
+{
+    // A sphere around the bumper of the object. The model may exceed the bumper,
+    // hence the radius is at least half of a grid.
+    const float height = object.bump.height;
+    const float radius = std::max({object.bump.size_big, height, Info<float>::Grid::Size() * 0.5f});
+    const Ego::Vector3f& position = object.getPosition();
+    const Ego::Sphere3f sphere(Ego::Point3f(position[kX], position[kY], position[kZ] + height * 0.5f), radius);
+    if (Ego::Math::Relation::outside != frustum.intersects(sphere, false)) {
+        return true;
+    }
+    // The reflection of the object.
+    const float reflectedZ = 2.0f * object.getFloorElevation() - (position[kZ] + height * 0.5f);
+    const Ego::Sphere3f reflectedSphere(Ego::Point3f(position[kX], position[kY], reflectedZ), radius);
+    return Ego::Math::Relation::outside != frustum.intersects(reflectedSphere, false);
+}
+
+gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, const Ego::Graphics::TileList& tl, Camera& cam,
+                           const std::vector<std::shared_ptr<Ego::Particle>>& particles)
 {
     // Remove all entities from the entity list.
     el.clear();
 
-    // collide the characters with the frustum
-    std::vector<std::shared_ptr<Object>> visibleObjects = 
-        _currentModule->getObjectHandler().findObjects(
-            cam.getCenter()[kX], 
-            cam.getCenter()[kY], 
-			Info<float>::Grid::Size() * 10,  //@todo: use camera view size here instead
-            true);
+    const auto& frustum = cam.getFrustum();
 
-    for(const std::shared_ptr<Object> object : visibleObjects) {
-        el.add(cam, *object.get());
+    // Find the objects above or near the visible tiles. An object flying high above the
+    // tiles may be visible even if the tiles below it are not, hence the margin.
+    if (!tl._bounds.isEmpty())
+    {
+        static const float margin = Info<float>::Grid::Size() * 4;
+        const auto bounds = tl._bounds.toAxisAlignedBox();
+        const Ego::AxisAlignedBox2f searchArea(Ego::Point2f(bounds.get_min()[kX] - margin, bounds.get_min()[kY] - margin),
+                                               Ego::Point2f(bounds.get_max()[kX] + margin, bounds.get_max()[kY] + margin));
+        std::vector<std::shared_ptr<Object>> candidates;
+        _currentModule->getObjectHandler().findObjects(searchArea, candidates, true);
+
+        // collide the characters with the frustum
+        for (const std::shared_ptr<Object>& object : candidates) {
+            if (gfx_object_in_frustum(frustum, *object)) {
+                el.add(cam, *object.get());
+            }
+        }
     }
 
-    for(const std::shared_ptr<Ego::Particle> particle : ParticleHandler::get().iterator()) {
+    for(const std::shared_ptr<Ego::Particle>& particle : particles) {
         el.add(cam, *particle.get());
     }
 
@@ -2051,13 +2129,33 @@ gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el)
 }
 
 //--------------------------------------------------------------------------------------------
-gfx_rv GFX::update_object_instances(Camera& cam)
+gfx_rv GFX::update_object_instances(const std::vector<std::shared_ptr<Camera>>& cameras)
 {
     gfx_rv retval;
 
     // assume the best
     retval = gfx_success;
 
+    Ego::Graphics::ObjectGraphics::resetVertexCounters();
+
+    // Determine the distance of each object from the nearest camera which sees it.
+    // Objects not seen by any camera keep an infinite distance.
+    // The slots are bounded by the maximum number of objects.
+    objectDistances.assign(_currentModule->getObjectHandler().getSlotCount(), std::numeric_limits<float>::infinity());
+    for (const auto& camera : cameras)
+    {
+        const auto& el = *camera->getEntityList();
+        for (size_t i = 0, n = el.getSize(); i < n; ++i)
+        {
+            const Object *object = _currentModule->getObjectHandler().get(el.get(i).iobj);
+            if (!object) continue;
+            const float distance = idlib::euclidean_norm(object->getPosition() - camera->getPosition());
+            objectDistances[object->getSlot()] = std::min(objectDistances[object->getSlot()], distance);
+        }
+    }
+
+    const uint32_t frame = _gameEngine->getNumberOfFramesRendered();
+
     for (const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
     {
         //Dont do terminated characters
@@ -2069,8 +2167,11 @@ gfx_rv GFX::update_object_instances(Camera& cam)
 		auto mesh = _currentModule->getMeshPointer();
         if (!mesh->grid_is_valid(pchr->getTile())) continue;
 
-        // make sure that the vertices are interpolated
-        if(pchr->inst.updateVertices(-1, -1, true) == gfx_error) {
+        // make sure that the vertices are interpolated, with less detail for objects which appear small
+        const size_t index = pchr->getSlot();
+        const float distance = index < objectDistances.size() ? objectDistances[index] : std::numeric_limits<float>::infinity();
+        const auto detail = Ego::Graphics::ObjectGraphics::getAnimationDetail(distance, std::max(pchr->bump.size_big, pchr->bump.height));
+        if(pchr->inst.updateVertices(detail, frame) == gfx_error) {
             retval = gfx_error;
         }
 
@@ -2110,7 +2211,11 @@ void TileRenderer::invalidate()
 
 void TileRenderer::bind(const ego_tile_info_t& tile)
 {
-	uint8_t newImage, newSize;
+	bind(TILE_GET_LOWER_BITS(tile._img), (tile._type < tile_dict.offset) ? 0 : 1);
+}
+
+void TileRenderer::bind(uint8_t newImage, uint8_t newSize)
+{
     std::shared_ptr<Ego::Texture> texture = nullptr;
 	bool needsBinding = false;
 
@@ -2122,9 +2227,6 @@ void TileRenderer::bind(const ego_tile_info_t& tile)
 	}
 	else
 	{
-		newImage = TILE_GET_LOWER_BITS(tile._img);
-		newSize = (tile._type < tile_dict.offset) ? 0 : 1;
-
 		if ((image != newImage) || (size != newSize))
 		{
 			texture = get_texture(newImage, newSize);
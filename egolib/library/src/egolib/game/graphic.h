@@ -23,6 +23,7 @@
 
 #include "egolib/Graphics/MD2Model.hpp"
 #include "egolib/game/lighting.h"
+#include "egolib/game/Graphics/LightClusters.hpp"
 #include "egolib/Extensions/ogl_extensions.h"
 
 // Forward declaration.
@@ -35,6 +36,7 @@ class BillboardSystem;
 class Md2ModelRenderer;
 struct RenderPass;
 struct TileList;
+class CornerLighting;
 struct EntityList;
 } }
 
@@ -128,8 +130,10 @@ extern float           indextoenvirox[MD2Model::normalCount];
 struct dynalist_t
 {
     int frame; ///< The last frame in shich the list was updated. @a -1 if there was no update yet.
-    size_t size; ///< The size of the list.
-    dynalight_data_t lst[TOTAL_MAX_DYNA];  ///< The list.
+    std::vector<dynalight_data_t> lst;  ///< The list, at most gfx.dynalist_max lights nearest to the camera.
+    std::vector<ego_frect_t> bounds; ///< The bounds of the lights affecting the visible tiles.
+    std::vector<int> references; ///< For each bound, the index of its light in the list or @a -1 for the combined light.
+    Ego::Graphics::LightClusters clusters; ///< The bounds binned into tile clusters.
     dynalist_t();
     static void init(dynalist_t& self);
 };
@@ -198,9 +202,14 @@ private:
     std::unique_ptr<Ego::Graphics::RenderPass> motionBlur;
     std::unique_ptr<Ego::Graphics::RenderPass> heightmap;
 
+    /// The distances of the objects from the nearest camera, indexed by object slot.
+    std::vector<float> objectDistances;
+
 public:
     Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_object_instances_timer;
-    gfx_rv update_object_instances(Camera& cam);
+    /// @brief Update the vertices and the lighting of the object instances.
+    /// @remark The animation detail of an object depends on its distance from the nearest camera whose entity list contains it.
+    gfx_rv update_object_instances(const std::vector<std::shared_ptr<Camera>>& cameras);
     Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_particle_instances_timer;
     gfx_rv update_particle_instances(Camera& cam);
 
@@ -277,7 +286,14 @@ void gfx_system_init_all_graphics();
 void gfx_system_release_all_graphics();
 void gfx_system_load_assets();
 
+// the scene preparation callback
+/// @brief Prepare the scenes of cameras for rendering.
+/// @remark The tile and entity lists of the cameras are built concurrently.
+/// The mesh lighting and the object and particle instances are updated once for all cameras.
+void gfx_system_prepare_world(const std::vector<std::shared_ptr<Camera>>& cameras);
+
 // the render engine callback
+/// @pre The scene of the camera was prepared by gfx_system_prepare_world in this frame.
 void gfx_system_render_world(const std::shared_ptr<Camera> camera, std::shared_ptr<Ego::Graphics::TileList> tl, std::shared_ptr<Ego::Graphics::EntityList> el);
 
 void gfx_do_clear_screen();
@@ -290,12 +306,6 @@ void draw_mouse_cursor();
 void draw_passages(Camera& cam);
 
 
-/// Structure for keeping track of which dynalights are visible
-struct dynalight_registry_t {
-    int reference;
-    ego_frect_t bound;
-};
-
 /// Illuminate the "grid".
 struct GridIllumination {
 private:
@@ -303,7 +313,11 @@ private:
     static float ego_mesh_interpolate_vertex(const ego_tile_info_t& info, const GLXvector3f& position);
 	static void test_one_corner(const ego_mesh_t& mesh, GLXvector3f pos, float& pdelta);
 	static bool test_corners(const ego_mesh_t& mesh, ego_tile_info_t& tile, float threshold);
-	static void light_one_corner(ego_mesh_t& mesh, ego_tile_info_t& tile, const bool reflective, const Ego::Vector3f& pos, const Ego::Vector3f& nrm, float& plight);
+	/// Set the inputs of the lighting of the corners of a tile.
+	static void gather_corners(const ego_mesh_t& mesh, const ego_tile_info_t& tile, Ego::Graphics::CornerLighting& lighting, size_t index);
+	/// Blend the evaluated lighting of the corners of a tile into its lighting cache.
+	/// @return the maximum estimated change of the lighting at a corner
+	static float light_corners(ego_tile_info_t& tile, const Ego::Graphics::CornerLighting& lighting, size_t index, float mesh_lighting_keep, uint32_t frame);
 	static float grid_lighting_test(const ego_mesh_t& mesh, GLXvector3f pos, float& low_diff, float& hgh_diff);
 	static void light_fans_update_clst(Ego::Graphics::TileList& tl);
 	static gfx_rv light_fans_throttle_update(ego_mesh_t * mesh, ego_tile_info_t& tile, const Index1D& tileIndex, float threshold);
@@ -311,7 +325,6 @@ private:
 public:
 	static gfx_rv do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_t& dyl, Camera& cam);
 	static void light_fans(Ego::Graphics::TileList& tl);
-	static float light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, bool reflective, float mesh_lighting_keep);
 	static bool grid_lighting_interpolate(const ego_mesh_t& mesh, lighting_cache_t& dst, const Ego::Vector2f& pos);
 	static bool light_corner(ego_mesh_t& mesh, const Index1D& fan, float height, float nrm[], float& plight);
 };
@@ -337,4 +350,6 @@ public:
     static void invalidate();
     /// Bind the texture of the tile to the texture unit.
     static void bind(const ego_tile_info_t& tile);
+    /// Bind the texture of the specified image and size (0 for small, 1 for big tiles) to the texture unit.
+    static void bind(uint8_t image, uint8_t size);
 };
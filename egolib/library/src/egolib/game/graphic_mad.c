@@ -32,6 +32,11 @@
 
 struct Md2VertexBuffer {
     static void render(GLenum mode, size_t start, size_t length) {
+        auto& renderer = Ego::Renderer::get();
+        renderer.countDirectDraw("Md2VertexBuffer::render", length);
+        if (!renderer.isDirectRenderingEnabled()) {
+            return;
+        }
         auto& md2ModelRenderer = GFX::get().getMd2ModelRenderer();
         glBegin(mode); {
             auto *vertex = (Ego::Graphics::DefaultMd2ModelRenderer::Vertex *)md2ModelRenderer.lock();
@@ -44,6 +49,7 @@ struct Md2VertexBuffer {
             }
         }
         glEnd();
+        Ego::OpenGL::StateCache::invalidateActive(GL_CURRENT_BIT);
     }
 };
 
@@ -67,7 +73,7 @@ gfx_rv ObjectGraphicsRenderer::render_enviro( Camera& cam, const std::shared_ptr
 		ptex = textureManager.getTexture("mp_data/phong");
 	}
 
-	if (!GL_DEBUG(glIsEnabled)(GL_BLEND))
+	if (renderer.isDirectRenderingEnabled() && !GL_DEBUG(glIsEnabled)(GL_BLEND))
 	{
 		return gfx_fail;
 	}
@@ -617,7 +623,7 @@ void ObjectGraphicsRenderer::draw_chr_bbox(const std::shared_ptr<Object>& pchr)
         draw_chr_attached_grip( pchr );
 
         // Draw all the vertices of an object
-        GL_DEBUG(glPointSize(5));
+        Ego::Renderer::get().setPointSize(5);
         draw_chr_verts(pchr, 0, pchr->inst.getVertexCount());
     }
 }
@@ -638,6 +644,9 @@ void ObjectGraphicsRenderer::draw_chr_verts(const std::shared_ptr<Object>& pchr,
     if ( vmin < 0 || ( size_t )vmin > pchr->inst.getVertexCount() ) return;
     if ( vmax < 0 || ( size_t )vmax > pchr->inst.getVertexCount() ) return;
 
+    // Debug drawing issues OpenGL commands directly.
+    if (!Ego::Renderer::get().isDirectRenderingEnabled()) return;
+
     // disable the texturing so all the points will be white,
     // not the texture color of the last vertex we drawn
     Ego::Renderer::get().getTextureUnit().setActivated(nullptr);
@@ -681,6 +690,9 @@ void ObjectGraphicsRenderer::_draw_one_grip_raw( Ego::Graphics::ObjectGraphics *
 
     if ( NULL == pinst ) return;
 
+    // Debug drawing issues OpenGL commands directly.
+    if (!Ego::Renderer::get().isDirectRenderingEnabled()) return;
+
     vmin = ( int )pinst->getVertexCount() - ( int )slot_to_grip_offset(( slot_t )slot );
     vmax = vmin + GRIP_VERTS;
 
@@ -711,6 +723,7 @@ void ObjectGraphicsRenderer::_draw_one_grip_raw( Ego::Graphics::ObjectGraphics *
             }
         }
         GL_DEBUG_END();
+        Ego::OpenGL::StateCache::invalidateActive(GL_CURRENT_BIT);
     }
 
 	Ego::Renderer::get().setColour(Ego::Colour4f::white());
@@ -464,6 +464,8 @@ void ParticleGraphicsRenderer::draw_one_attachment_point(Ego::Graphics::ObjectGr
     if (vrt >= inst.getVertexCount()) return;
 
     auto& renderer = Ego::Renderer::get();
+    // Debug drawing issues OpenGL commands directly.
+    if (!renderer.isDirectRenderingEnabled()) return;
     // disable the texturing so all the points will be white,
     // not the texture color of the last vertex we drawn
     renderer.getTextureUnit().setActivated(nullptr);
@@ -116,7 +116,7 @@ struct lighting_cache_t
 
 //--------------------------------------------------------------------------------------------
 #define MAXDYNADIST                     2700        // Leeway for offscreen lights
-#define TOTAL_MAX_DYNA                    64          // Absolute max number of dynamic lights
+#define TOTAL_MAX_DYNA                  4096          // Absolute max number of dynamic lights
 
 /// A definition of a single in-game dynamic light
 struct dynalight_data_t
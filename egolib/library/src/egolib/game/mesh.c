@@ -96,6 +96,33 @@ void tile_mem_t::computeVertexIndices(const tile_dictionary_t& dict)
 
 //--------------------------------------------------------------------------------------------
 
+tile_collision_mem_t::tile_collision_mem_t(const Ego::MeshInfo& info)
+	: _fx(info.getTileCount(), 0), _twist(info.getTileCount(), TWIST_FLAT),
+	  _fanoff(info.getTileCount(), 1), _heights(info.getTileCount(), std::array<float, 4>{0.0f, 0.0f, 0.0f, 0.0f}) {
+}
+
+void tile_collision_mem_t::synch(const tile_mem_t& tmem, const Index1D& i)
+{
+	const ego_tile_info_t& tile = tmem.get(i);
+	_fx[i.i()] = tile.getFX();
+	_twist[i.i()] = tile._twist;
+	_fanoff[i.i()] = tile.isFanOff() ? 1 : 0;
+	std::array<float, 4>& heights = _heights[i.i()];
+	for (size_t corner = 0; corner < 4; ++corner) {
+		const size_t vertex = tile._vrtstart + corner;
+		heights[corner] = vertex < tmem.getInfo().getVertexCount() ? tmem._plst[vertex][ZZ] : 0.0f;
+	}
+}
+
+void tile_collision_mem_t::synch(const tile_mem_t& tmem)
+{
+	for (Index1D i = 0; i < tmem.getInfo().getTileCount(); ++i) {
+		synch(tmem, i);
+	}
+}
+
+//--------------------------------------------------------------------------------------------
+
 std::shared_ptr<ego_mesh_t> MeshLoader::convert(const map_t& source) const
 {
     // Create a mesh.
@@ -270,6 +297,9 @@ void ego_mesh_t::make_bbox()
         // Add the bounds of the tile to the bounds of the mesh.
         _tmem._bbox.join(poct.toAxisAlignedBox());
     }
+
+    // Update the bounds of the chunks and regions.
+    _culling.build([this](const Index1D& index) -> const oct_bb_t& { return _tmem.get(index)._oct; });
 }
 
 //--------------------------------------------------------------------------------------------
@@ -441,7 +471,7 @@ BIT_FIELD ego_mesh_t::test_wall(const BIT_FIELD bits, const mesh_wall_data_t& da
 	for (int iy = data._i.min().y(); iy <= data._i.max().y(); ++iy) {
 		for (int ix = data._i.min().x(); ix <= data._i.max().x(); ++ix) {
 			Index1D tileIndex(ix + iy * data._mesh->_tmem.getInfo().getTileCountX());
-			BIT_FIELD pass = data._mesh->getTileInfo(tileIndex).testFX(bits);
+			BIT_FIELD pass = data._mesh->_cmem.getFX(tileIndex) & bits;
 			if (EMPTY_BIT_FIELD != pass) {
 				return pass;
 			}
@@ -531,7 +561,7 @@ float ego_mesh_t::get_pressure(const Ego::Vector3f& pos, float radius, const BIT
                 }
                 else
                 {
-                    is_blocked = 0 != _tmem.get(itile).testFX(bits);
+                    is_blocked = 0 != (_cmem.getFX(itile) & bits);
                 }
             }
 
@@ -704,6 +734,24 @@ void mpdfx_list_ary_t::push_back(const Index1D& element)
     elements.push_back(element);
 }
 
+void mpdfx_list_ary_t::insert(const Index1D& element)
+{
+    auto it = std::lower_bound(elements.begin(), elements.end(), element);
+    if (it == elements.end() || *it != element)
+    {
+        elements.insert(it, element);
+    }
+}
+
+void mpdfx_list_ary_t::erase(const Index1D& element)
+{
+    auto it = std::lower_bound(elements.begin(), elements.end(), element);
+    if (it != elements.end() && *it == element)
+    {
+        elements.erase(it);
+    }
+}
+
 //--------------------------------------------------------------------------------------------
 
 mpdfx_lists_t::mpdfx_lists_t(const Ego::MeshInfo& info) {
@@ -741,78 +789,64 @@ void mpdfx_lists_t::reset()
 	dirty = true;
 }
 
+std::array<mpdfx_list_ary_t *, 8> mpdfx_lists_t::getLists()
+{
+    return {&sha, &drf, &anm, &wat, &wal, &imp, &dam, &slp};
+}
+
+std::array<bool, 8> mpdfx_lists_t::getMembership(GRID_FX_BITS fx_bits)
+{
+    // Tiles without any FX bits are in no list.
+    if ( 0 == fx_bits ) return {false, false, false, false, false, false, false, false};
+
+    return {HAS_NO_BITS( fx_bits, MAPFX_SHA ),
+            HAS_ALL_BITS( fx_bits, MAPFX_REFLECTIVE ),
+            HAS_ALL_BITS( fx_bits, MAPFX_ANIM ),
+            HAS_ALL_BITS( fx_bits, MAPFX_WATER ),
+            HAS_ALL_BITS( fx_bits, MAPFX_WALL ),
+            HAS_ALL_BITS( fx_bits, MAPFX_IMPASS ),
+            HAS_ALL_BITS( fx_bits, MAPFX_DAMAGE ),
+            HAS_ALL_BITS( fx_bits, MAPFX_SLIPPY )};
+}
+
 int mpdfx_lists_t::push( GRID_FX_BITS fx_bits, size_t value )
 {
     int retval = 0;
 
     if ( 0 == fx_bits ) return true;
 
-    if ( HAS_NO_BITS( fx_bits, MAPFX_SHA ) )
-    {
-        sha.push_back(value);
-        {
-            retval++;
-        }
-
-    }
-
-    if ( HAS_ALL_BITS( fx_bits, MAPFX_REFLECTIVE ) )
-    {
-        drf.push_back(value);
-        {
-            retval++;
-        }
-    }
-
-    if ( HAS_ALL_BITS( fx_bits, MAPFX_ANIM ) )
-    {
-        anm.push_back(value);
-        {
-            retval++;
-        }
-    }
-
-    if ( HAS_ALL_BITS( fx_bits, MAPFX_WATER ) )
+    const auto lists = getLists();
+    const auto membership = getMembership( fx_bits );
+    for ( size_t i = 0; i < lists.size(); i++ )
     {
-        wat.push_back(value);
+        if ( membership[i] )
         {
+            lists[i]->push_back(value);
             retval++;
         }
     }
 
-    if ( HAS_ALL_BITS( fx_bits, MAPFX_WALL ) )
-    {
-        wal.push_back(value);
-        {
-            retval++;
-        }
-    }
+    return retval;
+}
 
-    if ( HAS_ALL_BITS( fx_bits, MAPFX_IMPASS ) )
+void mpdfx_lists_t::update( const Index1D& i, GRID_FX_BITS old_bits, GRID_FX_BITS new_bits )
+{
+    const auto lists = getLists();
+    const auto old_membership = getMembership( old_bits );
+    const auto new_membership = getMembership( new_bits );
+    for ( size_t j = 0; j < lists.size(); j++ )
     {
-        imp.push_back(value);
-        {
-            retval++;
-        }
-    }
+        if ( old_membership[j] == new_membership[j] ) continue;
 
-    if ( HAS_ALL_BITS( fx_bits, MAPFX_DAMAGE ) )
-    {
-        dam.push_back(value);
+        if ( new_membership[j] )
         {
-            retval++;
+            lists[j]->insert(i);
         }
-    }
-
-    if ( HAS_ALL_BITS( fx_bits, MAPFX_SLIPPY ) )
-    {
-        slp.push_back(value);
+        else
         {
-            retval++;
+            lists[j]->erase(i);
         }
     }
-
-    return retval;
 }
 
 bool mpdfx_lists_t::synch( const tile_mem_t& tmem, bool force )
@@ -850,7 +884,7 @@ bool ego_mesh_t::tile_has_bits( const Index2D& i, const BIT_FIELD bits ) const
     }
 
     // Since we KNOW that this is in range, allow raw access to the data structure.
-    GRID_FX_BITS fx = _tmem.get(j).getFX();
+    GRID_FX_BITS fx = _cmem.getFX(j);
 
     return HAS_SOME_BITS(fx, bits);
 }
@@ -873,10 +907,11 @@ float ego_mesh_t::getElevation(const Ego::Vector2f& p) const
 	}
 
     // Get the height of each fan corner.
-    float z0 = _tmem._plst[_tmem.get(i1)._vrtstart + 0][ZZ];
-    float z1 = _tmem._plst[_tmem.get(i1)._vrtstart + 1][ZZ];
-    float z2 = _tmem._plst[_tmem.get(i1)._vrtstart + 2][ZZ];
-    float z3 = _tmem._plst[_tmem.get(i1)._vrtstart + 3][ZZ];
+    const std::array<float, 4>& heights = _cmem.getHeights(i1);
+    float z0 = heights[0];
+    float z1 = heights[1];
+    float z2 = heights[2];
+    float z3 = heights[3];
 
     //Calculate where on the tile we are relative to top left corner of the tile (0,0)
     Ego::Vector2f posOnTile = Ego::Vector2f(static_cast<float>(static_cast<int>(p.x()) % Info<int>::Grid::Size()), 
@@ -923,8 +958,10 @@ bool ego_mesh_t::clear_fx( const Index1D& i, const BIT_FIELD flags )
     }
 	g_meshStats.mpdfxTests++;
 
+    const GRID_FX_BITS old_bits = _tmem.get(i).getFX();
     if (_tmem.get(i).removeFX(flags)) {
-        _fxlists.dirty = true;
+        _cmem.synch(_tmem, i);
+        _fxlists.update(i, old_bits, _tmem.get(i).getFX());
         return true;
     } else {
         return false;
@@ -941,11 +978,13 @@ bool ego_mesh_t::add_fx(const Index1D& i, const BIT_FIELD flags)
 
     // Succeed only of something actually changed.
 	g_meshStats.mpdfxTests++;
+    const GRID_FX_BITS old_bits = _tmem.get(i).getFX();
     bool retval = _tmem.get(i).addFX(flags);
 
     if ( retval )
     {
-        _fxlists.dirty = true;
+        _cmem.synch(_tmem, i);
+        _fxlists.update(i, old_bits, _tmem.get(i).getFX());
     }
 
     return retval;
@@ -963,13 +1002,13 @@ uint32_t ego_mesh_t::test_fx(const Index1D& i, const BIT_FIELD flags) const
     }
 
     // if the tile is actually labelled as MAP_FANOFF, ignore it completely
-    if (_tmem.get(i).isFanOff())
+    if (_cmem.isFanOff(i))
     {
         return 0;
     }
 
 	g_meshStats.mpdfxTests++;
-    return _tmem.get(i).testFX(flags);
+    return _cmem.getFX(i) & flags;
 }
 
 ego_tile_info_t& ego_mesh_t::getTileInfo(const Index1D& i) {
@@ -987,7 +1026,7 @@ uint8_t ego_mesh_t::get_twist(const Index1D& i) const
     if (!_info.isValid(i)) {
         return TWIST_FLAT;
     }
-    return _tmem.get(i)._twist;
+    return _cmem.getTwist(i);
 }
 
 uint8_t ego_mesh_t::get_fan_twist(const Index1D& i) const
@@ -1021,17 +1060,13 @@ float ego_mesh_t::get_max_vertex_0(const Index2D& i) const
         return 0.0f;
     }
 
-    const ego_tile_info_t& tile = _tmem.get(j);
-
-	size_t vstart = tile._vrtstart;
+	const std::array<float, 4>& heights = _cmem.getHeights(j);
 	size_t vcount = std::min(static_cast<size_t>(4), _tmem.getInfo().getVertexCount());
 
-	size_t cnt;
-	size_t ivrt = vstart;
-	float zmax = _tmem._plst[ivrt][ZZ];
-	for (ivrt++, cnt = 1; cnt < vcount; ivrt++, cnt++)
+	float zmax = heights[0];
+	for (size_t cnt = 1; cnt < vcount; cnt++)
 	{
-		zmax = std::max(zmax, _tmem._plst[ivrt][ZZ]);
+		zmax = std::max(zmax, heights[cnt]);
 	}
 
 	return zmax;
@@ -1207,7 +1242,7 @@ BIT_FIELD ego_mesh_t::hit_wall(const Ego::Vector3f& pos, float radius, const BIT
 				Index1D itile = getTileIndex(Index2D(ix, iy));
 				if (grid_is_valid(itile))
 				{
-					BIT_FIELD mpdfx = data._mesh->getTileInfo(itile).getFX();
+					BIT_FIELD mpdfx = data._mesh->_cmem.getFX(itile);
 					bool is_blocked = HAS_SOME_BITS(mpdfx, bits);
 
 					if (is_blocked)
@@ -1272,7 +1307,7 @@ BIT_FIELD ego_mesh_t::hit_wall(const Ego::Vector3f& pos, const float radius, con
 }
 
 ego_mesh_t::ego_mesh_t(const Ego::MeshInfo& mesh_info)
-	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info) {
+	: _info(mesh_info), _tmem(mesh_info), _cmem(mesh_info), _fxlists(mesh_info), _chunks(mesh_info), _culling(mesh_info) {
 }
 
 ego_mesh_t::~ego_mesh_t() {
@@ -1309,7 +1344,13 @@ bool ego_mesh_t::set_texture(const Index1D& index1D, uint16_t image)
 	uint16_t tile_upper = tile_value & TILE_UPPER_MASK;
 
 	// Set the actual image.
-	_tmem.get(index1D)._img = tile_upper | tile_lower;
+	if (_tmem.get(index1D)._img != (tile_upper | tile_lower)) {
+		_tmem.get(index1D)._img = tile_upper | tile_lower;
+		// The tile moves to another batch.
+		_chunks.invalidate(index1D);
+		// The tile might be turned on or off.
+		_cmem.synch(_tmem, index1D);
+	}
 
 	// Update the pre-computed texture info.
 	return update_texture(index1D);
@@ -1351,6 +1392,8 @@ void ego_mesh_t::finalize()
 	make_normals();
 	make_bbox();
 	make_texture();
+	_chunks.invalidate();
+	_cmem.synch(_tmem);
 
 	// create some lists to make searching the mesh tiles easier
 	_fxlists.synch(_tmem, true);
@@ -24,6 +24,8 @@
 #include "egolib/game/egoboo.h"
 #include "egolib/game/lighting.h"
 #include "egolib/Mesh/Info.hpp"
+#include "egolib/game/Graphics/TerrainChunks.hpp"
+#include "egolib/game/Graphics/CullingHierarchy.hpp"
 
 //--------------------------------------------------------------------------------------------
 // external types
@@ -310,13 +312,55 @@ public:
 
 //--------------------------------------------------------------------------------------------
 
+/// A compact structure-of-arrays copy of the tile data queried by the physics, the path finding
+/// and the line of sight tests: These only touch a few bytes per tile instead of the whole
+/// ego_tile_info_t with its rendering caches. Kept in sync with tile_mem_t by ego_mesh_t.
+/// @remark The accessors do not validate the tile index.
+struct tile_collision_mem_t
+{
+private:
+	std::vector<GRID_FX_BITS> _fx;                ///< the working FX of the tiles
+	std::vector<uint8_t> _twist;                  ///< the twists of the tiles
+	std::vector<uint8_t> _fanoff;                 ///< are the tiles labelled as MAP_FANOFF?
+	std::vector<std::array<float, 4>> _heights;   ///< the heights of the four corners of the tiles
+public:
+	tile_collision_mem_t(const Ego::MeshInfo& info);
+
+	/// @brief Copy the collision data of a tile from the tile memory.
+	void synch(const tile_mem_t& tmem, const Index1D& i);
+	/// @brief Copy the collision data of all tiles from the tile memory.
+	void synch(const tile_mem_t& tmem);
+
+	GRID_FX_BITS getFX(const Index1D& i) const {
+		return _fx[i.i()];
+	}
+	uint8_t getTwist(const Index1D& i) const {
+		return _twist[i.i()];
+	}
+	bool isFanOff(const Index1D& i) const {
+		return 0 != _fanoff[i.i()];
+	}
+	/// @brief Get the heights of the corners of a tile, in the order of the first four vertices of the tile.
+	const std::array<float, 4>& getHeights(const Index1D& i) const {
+		return _heights[i.i()];
+	}
+};
+
+//--------------------------------------------------------------------------------------------
+
+/// A list of tiles, sorted by their indices.
 struct mpdfx_list_ary_t
 {
     std::vector<Index1D> elements;
 	mpdfx_list_ary_t();
 	~mpdfx_list_ary_t();
     void clear();
+    /// @brief Append a tile. Its index must be greater than the indices of the tiles in the list.
     void push_back(const Index1D& element);
+    /// @brief Insert a tile at its sorted position if it is not in the list.
+    void insert(const Index1D& element);
+    /// @brief Remove a tile if it is in the list.
+    void erase(const Index1D& element);
 };
 
 //--------------------------------------------------------------------------------------------
@@ -339,6 +383,15 @@ struct mpdfx_lists_t
     void reset();
     int push(GRID_FX_BITS fx_bits, size_t value);
     bool synch(const tile_mem_t& other, bool force);
+    /// @brief Move a tile between the lists after its FX bits changed.
+    /// @remark Only the lists whose membership condition changed are touched, hence no rescan of the mesh is required.
+    void update(const Index1D& i, GRID_FX_BITS old_bits, GRID_FX_BITS new_bits);
+
+private:
+    /// @brief Get the lists in the order of the results of getMembership.
+    std::array<mpdfx_list_ary_t *, 8> getLists();
+    /// @brief Get for each list if a tile with the FX bits belongs to it.
+    static std::array<bool, 8> getMembership(GRID_FX_BITS fx_bits);
 };
 
 //--------------------------------------------------------------------------------------------
@@ -386,7 +439,13 @@ public:
 
     Ego::MeshInfo _info;
     tile_mem_t _tmem;
+    /// @brief The collision data of the tiles, a compact copy of parts of the tile memory.
+    tile_collision_mem_t _cmem;
     mpdfx_lists_t _fxlists;
+    /// @brief The texture-batched triangle lists of the tiles, rebuilt if tile textures change.
+    Ego::Graphics::TerrainChunks _chunks;
+    /// @brief The bounding volume hierarchy of the tiles, rebuilt with the bounds of the tiles.
+    Ego::Graphics::CullingHierarchy _culling;
 
     Ego::Vector3f get_diff(const Ego::Vector3f& pos, float radius, float center_pressure, const BIT_FIELD bits);
     float get_pressure(const Ego::Vector3f& pos, float radius, const BIT_FIELD bits) const;
@@ -73,6 +73,9 @@ void LineSegmentList::draw_all(Camera& camera)
     /// @details draw some lines for debugging purposes
 
 	auto& renderer = Ego::Renderer::get();
+	if (!renderer.isDirectRenderingEnabled()) {
+		return;
+	}
 
     // disable texturing
 	renderer.getTextureUnit().setActivated(nullptr);
@@ -167,6 +170,9 @@ void PointList::draw_all(Camera& camera)
     /// @details draw some points for debugging purposes
 
 	auto& renderer = Ego::Renderer::get();
+	if (!renderer.isDirectRenderingEnabled()) {
+		return;
+	}
 
     // disable texturing
 	renderer.getTextureUnit().setActivated(nullptr);
@@ -231,6 +237,10 @@ void Renderer3D::end3D() {}
 void Renderer3D::renderAxisAlignedBox(const Ego::AxisAlignedBox3f& bv, const Ego::Colour4f& colour)
 {
     auto& renderer = Ego::Renderer::get();
+    // Debug drawing issues OpenGL commands directly.
+    if (!renderer.isDirectRenderingEnabled()) {
+        return;
+    }
 
     renderer.setViewMatrix(idlib::identity<Ego::Matrix4f4f>());
     renderer.setWorldMatrix(idlib::identity<Ego::Matrix4f4f>());
@@ -307,6 +317,10 @@ void Renderer3D::renderAxisAlignedBox(const Ego::AxisAlignedBox3f& bv, const Ego
 void Renderer3D::renderOctBB(const oct_bb_t &bb, bool drawSquare, bool drawDiamond, const Ego::Colour4f& squareColour, const Ego::Colour4f& diamondColour)
 {
     auto& renderer = Ego::Renderer::get();
+    // Debug drawing issues OpenGL commands directly.
+    if (!renderer.isDirectRenderingEnabled()) {
+        return;
+    }
 
     // disable texturing
     renderer.getTextureUnit().setActivated(nullptr);
@@ -25,11 +25,13 @@
 #include "egolib/game/game.h"
 #include "egolib/game/egoboo.h"
 #include "egolib/Script/CLogEntry.hpp"
+#include "egolib/Script/ScriptCache.hpp"
+#include "egolib/Core/CacheFile.hpp"
 
 static bool load_ai_codes_vfs();
 
 parser_state_t::parser_state_t()
-	: _loadBuffer(), _token(), _lineBuffer()
+	: _loadBuffer(), _messages(), _hasReferenceLiterals(false), _isMessage(false), _message(), _sourceLine(0), _token(), _lineBuffer()
 {
 	_line_count = 0;
 
@@ -605,6 +607,8 @@ Ego::Script::PDLToken parser_state_t::parse_token(ObjectProfile *ppro, script_in
     /// will return the next spot to read from and stick the code number in
     /// ptok->iIndex
 
+    _isMessage = false;
+
     // Check bounds
     if (state.isEndOfInput())
     {
@@ -627,6 +631,7 @@ Ego::Script::PDLToken parser_state_t::parse_token(ObjectProfile *ppro, script_in
         if (token.category() == Ego::Script::PDLTokenKind::ReferenceLiteral)
         {
             // If it is a profile reference.
+            _hasReferenceLiterals = true;
 
             // Invalid profile as default.
             token.setValue(INVALID_PRO_REF);
@@ -675,6 +680,8 @@ Ego::Script::PDLToken parser_state_t::parse_token(ObjectProfile *ppro, script_in
             // Add the string as a message message to the available messages of the object.
             token.setValue(ppro->addMessage(token.get_lexeme(), true));
             token.category(Ego::Script::PDLTokenKind::Constant);
+            _isMessage = true;
+            _message = token.get_lexeme();
             // Emit a warning that the string is empty.
             Ego::Script::CLogEntry e(Log::Level::Message, __FILE__, __LINE__, __FUNCTION__, token.get_start_location());
             e << "empty string literal\n" << Log::EndOfEntry;
@@ -735,19 +742,25 @@ void parser_state_t::emit_opcode(const Ego::Script::PDLToken& token, const BIT_F
     if (Ego::Script::PDLTokenKind::Constant == token.category())
     {
         loc_highbits |= Instruction::FUNCTIONBITS;
-        auto constantIndex = script._instructions.getConstantPool().getOrCreateConstant(token.getValue());
-        script._instructions.append(Instruction(loc_highbits | constantIndex));
+        if (_isMessage)
+        {
+            // Remember the message literal such that the message index can be relocated.
+            _messages.emplace_back(script._instructions.getNumberOfInstructions(), _message);
+            _isMessage = false;
+        }
+        auto constantIndex = script._instructions.getOrCreateConstant(token.getValue());
+        script._instructions.append(Instruction(loc_highbits | constantIndex), _sourceLine);
     }
     else if (Ego::Script::PDLTokenKind::Function == token.category())
     {
         loc_highbits |= Instruction::FUNCTIONBITS;
-        auto constantIndex = script._instructions.getConstantPool().getOrCreateConstant(token.getValue());
-        script._instructions.append(Instruction(loc_highbits | constantIndex));
+        auto constantIndex = script._instructions.getOrCreateConstant(token.getValue());
+        script._instructions.append(Instruction(loc_highbits | constantIndex), _sourceLine);
     }
     else if (Ego::Script::PDLTokenKind::Variable == token.category())
     {
-        auto constantIndex = script._instructions.getConstantPool().getOrCreateConstant(token.getValue());
-        script._instructions.append(Instruction(loc_highbits | constantIndex));
+        auto constantIndex = script._instructions.getOrCreateConstant(token.getValue());
+        script._instructions.append(Instruction(loc_highbits | constantIndex), _sourceLine);
     }
     else
     {
@@ -796,8 +809,20 @@ void parser_state_t::parse_line_by_line( ObjectProfile *ppro, script_info_t& scr
 
     size_t read = 0;
     size_t line = 1;
+    // The source line and the position up to which line breaks were counted.
+    size_t counted = 0;
+    _sourceLine = 1;
     for (_token.set_start_location({script.getName(), 1}); read < _loadBuffer.getSize(); _token.set_start_location({script.getName(), _token.get_start_location().line_number()}))
     {
+        // Count the line breaks ("\r\n" counts as one line break) up to the beginning of the line.
+        for (; counted < read; ++counted)
+        {
+            const char c = _loadBuffer.get(counted);
+            if ('\n' == c || ('\r' == c && (counted + 1 >= _loadBuffer.getSize() || '\n' != _loadBuffer.get(counted + 1))))
+            {
+                _sourceLine++;
+            }
+        }
         read = load_one_line( read, script );
         if ( 0 == _lineBuffer.getSize() ) continue;
 
@@ -916,7 +941,7 @@ void parser_state_t::parse_line_by_line( ObjectProfile *ppro, script_info_t& scr
                 
                 _token = parse_token( ppro, script, state);
             }
-            script._instructions[operand_index].setBits(operands);
+            script._instructions.set(operand_index, Instruction(operands));
         }
         else
         {
@@ -994,7 +1019,7 @@ void parser_state_t::parse_jumps( script_info_t& script )
             // Each function needs a jump
             auto iTmp = jump_goto( index, index_end, script );
             index++;
-            script._instructions[index].setBits(iTmp);
+            script._instructions.set(index, Instruction(iTmp));
             index++;
         }
         else
@@ -1054,6 +1079,25 @@ bool load_ai_codes_vfs()
 }
 
 //--------------------------------------------------------------------------------------------
+/// @brief Get the script cache key of a script source.
+/// @param source the script source
+/// @return the hash of the script source and the opcode table
+static uint64_t get_script_cache_key(const Ego::Script::Buffer& source)
+{
+    uint64_t value = Ego::CacheFile::HASH_OFFSET_BASIS;
+    for (size_t i = 0, n = source.getSize(); i < n; ++i) {
+        const char c = source.get(i);
+        value = Ego::CacheFile::hash(&c, 1, value);
+    }
+    for (const auto& opcode : Opcodes) {
+        const uint32_t kind = static_cast<uint32_t>(opcode._kind);
+        value = Ego::CacheFile::hash(opcode.cName, value);
+        value = Ego::CacheFile::hash(reinterpret_cast<const char *>(&kind), sizeof(kind), value);
+        value = Ego::CacheFile::hash(reinterpret_cast<const char *>(&opcode.iValue), sizeof(opcode.iValue), value);
+    }
+    return value;
+}
+
 egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, script_info_t& script)
 {
 	ps.clear_error();
@@ -1076,12 +1120,26 @@ egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, O
             return rv_fail;
         }
     }
-    try {
-        // save the filename for error logging
-        script._name = loadname;
+    // save the filename for error logging
+    script._name = loadname;
+    script._lowered = nullptr;
+
+    // Use a cached compilation of an identical script source if any.
+    auto& scriptCache = Ego::Script::ScriptCache::get();
+    const uint64_t key = get_script_cache_key(ps._loadBuffer);
+    const uint64_t sourceLength = ps._loadBuffer.getSize();
+    auto compiledScript = scriptCache.load(key, sourceLength);
+    if (compiledScript) {
+        // Share the instructions and relocate the message indices to the messages of this profile.
+        script._instructions = compiledScript->relocate([ppro](const std::string& message) { return ppro->addMessage(message, true); });
+        return rv_success;
+    }
 
+    try {
         // we have parsed nothing yet
         script._instructions.clear();
+        ps._messages.clear();
+        ps._hasReferenceLiterals = false;
 
         // parse/compile the scripts
         ps.parse_line_by_line(ppro, script);
@@ -1092,6 +1150,12 @@ egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, O
         return rv_fail;
     }
 
+    // Only clean compilations are cached, such that their errors are reported again on the next load.
+    // Reference literals depend on the profiles loaded at compile time, hence such scripts are not cached.
+    if (!ps.get_error() && !ps._hasReferenceLiterals) {
+        scriptCache.store(key, sourceLength, Ego::Script::CompiledScript{script._instructions, ps._messages});
+    }
+
 	return rv_success;
 }
 egolib_rv load_ai_script_vfs(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, script_info_t& script)
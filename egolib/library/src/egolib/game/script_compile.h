@@ -191,6 +191,24 @@ protected:
 public:
     Ego::Script::Buffer _loadBuffer;
 
+    /// @brief The message literals of the script being compiled in the order of their occurrence.
+    /// Each message literal is stored with the index of the instruction which loads its message index.
+    std::vector<std::pair<InstructionList::Index, std::string>> _messages;
+
+    /// @brief If the script being compiled contains reference literals.
+    /// Reference literals are resolved (and the objects they refer to are loaded) at compile time.
+    bool _hasReferenceLiterals;
+
+private:
+    /// @brief If the last token parsed is a message literal and the message.
+    bool _isMessage;
+    std::string _message;
+
+    /// @brief The source line of the line being compiled.
+    uint32_t _sourceLine;
+
+public:
+
     /// @brief Get the error variable value.
     /// @return the error variable value
     bool get_error() const;
@@ -766,6 +766,30 @@ bool vfs_isDirectory(const std::string& pathname) {
     return 0 != PHYSFS_isDirectory(temporary.c_str());
 }
 
+int64_t vfs_getLastModTime(const std::string& pathname) {
+    BAIL_IF_NOT_INIT();
+    std::string temporary;
+    if (!validate(pathname, temporary)) {
+        return -1;
+    }
+    return PHYSFS_getLastModTime(temporary.c_str());
+}
+
+int64_t vfs_getFileLength(const std::string& pathname) {
+    BAIL_IF_NOT_INIT();
+    std::string temporary;
+    if (!validate(pathname, temporary)) {
+        return -1;
+    }
+    PHYSFS_File *file = PHYSFS_openRead(temporary.c_str());
+    if (!file) {
+        return -1;
+    }
+    int64_t length = PHYSFS_fileLength(file);
+    PHYSFS_close(file);
+    return length;
+}
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 size_t vfs_read( void * buffer, size_t size, size_t count, vfs_FILE * pfile )
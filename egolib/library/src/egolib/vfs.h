@@ -302,6 +302,10 @@ bool vfs_delete_file(const std::string& pathname);
 bool vfs_exists(const std::string& pathname);
 /** @return @a true if the pathname refers to an existing directory file, @a false otherwise */
 bool vfs_isDirectory(const std::string& pathname);
+/** @return the last modification time of the file, @a -1 if it can not be determined */
+int64_t vfs_getLastModTime(const std::string& pathname);
+/** @return the length, in Bytes, of the file, @a -1 if it can not be determined */
+int64_t vfs_getFileLength(const std::string& pathname);
 
 // binary reading and writing
 size_t vfs_read(void *buffer, size_t size, size_t count, vfs_FILE *file);
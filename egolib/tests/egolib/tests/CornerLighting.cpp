@@ -0,0 +1,83 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "gtest/gtest.h"
+#include "egolib/game/Graphics/CornerLighting.hpp"
+
+namespace Ego { namespace Test { namespace CornerLighting {
+
+static lighting_cache_t makeCache(float offset) {
+    lighting_cache_t cache;
+    for (size_t i = 0; i < LIGHTING_VEC_SIZE; ++i) {
+        cache.low._lighting[i] = offset + 10.0f * i;
+        cache.hgh._lighting[i] = offset + 5.0f * i + 1.0f;
+    }
+    cache.max_light();
+    return cache;
+}
+
+TEST(corner_lighting_testing, test_evaluate_matches_lighting_evaluate_cache) {
+    const Ego::AxisAlignedBox3f bbox(Ego::Point3f(0.0f, 0.0f, -100.0f), Ego::Point3f(1000.0f, 1000.0f, 100.0f));
+    const Ego::Vector3f normals[] = {
+        Ego::Vector3f(0.0f, 0.0f, 1.0f), Ego::Vector3f(0.6f, -0.8f, 0.0f),
+        Ego::Vector3f(-0.48f, 0.6f, 0.64f), Ego::Vector3f(0.0f, -1.0f, 0.0f),
+    };
+    const float heights[] = {-150.0f, -100.0f, 0.0f, 25.0f, 100.0f, 150.0f};
+    Ego::Graphics::CornerLighting lighting;
+    std::vector<std::tuple<lighting_cache_t, Ego::Vector3f, float, bool>> corners;
+    for (size_t tile = 0; tile < 12; ++tile) {
+        lighting.addTile(Index1D(static_cast<int>(tile)));
+        for (size_t corner = 0; corner < 4; ++corner) {
+            const auto cache = makeCache(static_cast<float>(tile * 4 + corner));
+            const auto& normal = normals[(tile + corner) % 4];
+            const float z = heights[(tile * 4 + corner) % 6];
+            const bool reflective = 0 == tile % 2;
+            lighting.setCorner(tile, corner, cache, normal, z, bbox, reflective);
+            corners.emplace_back(cache, normal, z, reflective);
+        }
+    }
+    // Evaluate in two ranges as the tasks of the update do.
+    lighting.evaluate(0, 5);
+    lighting.evaluate(5, 12);
+    for (size_t i = 0; i < corners.size(); ++i) {
+        const auto& cache = std::get<0>(corners[i]);
+        float expected;
+        if (std::get<3>(corners[i])) {
+            float amb, dir;
+            lighting_cache_t::lighting_evaluate_cache(cache, std::get<1>(corners[i]), std::get<2>(corners[i]), bbox, &amb, &dir);
+            expected = amb + 0.5f * dir;
+        } else {
+            expected = lighting_cache_t::lighting_evaluate_cache(cache, std::get<1>(corners[i]), std::get<2>(corners[i]), bbox, nullptr, nullptr);
+        }
+        ASSERT_NEAR(expected, lighting.getLight(i / 4, i % 4), 1e-3f);
+    }
+}
+
+TEST(corner_lighting_testing, test_clear) {
+    Ego::Graphics::CornerLighting lighting;
+    lighting.addTile(Index1D(3));
+    lighting.addTile(Index1D(7));
+    ASSERT_EQ(2, lighting.getTileCount());
+    ASSERT_EQ(7, lighting.getTile(1).i());
+    lighting.clear();
+    ASSERT_EQ(0, lighting.getTileCount());
+}
+
+} } } // namespace Ego::Test::CornerLighting
@@ -0,0 +1,155 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/game/Graphics/CullingHierarchy.hpp"
+#include "egolib/frustum.h"
+
+namespace Ego { namespace Test { namespace CullingHierarchy {
+
+using Hierarchy = Ego::Graphics::CullingHierarchy;
+using Ego::Graphics::Frustum;
+
+/// The size of a tile in these tests.
+static const float tileSize = 4.0f;
+
+/// A frustum whose side planes enclose the rectangle (x0, y0) to (x1, y1).
+static Frustum makeFrustum(float x0, float y0, float x1, float y1) {
+    Frustum frustum;
+    frustum._planes[Frustum::LEFT] = Plane3f(+1.0f, 0.0f, 0.0f, -x0);
+    frustum._planes[Frustum::RIGHT] = Plane3f(-1.0f, 0.0f, 0.0f, +x1);
+    frustum._planes[Frustum::BOTTOM] = Plane3f(0.0f, +1.0f, 0.0f, -y0);
+    frustum._planes[Frustum::TOP] = Plane3f(0.0f, -1.0f, 0.0f, +y1);
+    return frustum;
+}
+
+/// The bounds of all tiles of a mesh. A tile (x, y) covers (x, y) to (x + 1, y + 1) times the tile size.
+static std::vector<oct_bb_t> makeTileBounds(const Ego::MeshInfo& info) {
+    std::vector<oct_bb_t> tileBounds(info.getTileCount());
+    for (size_t y = 0; y < info.getTileCountY(); ++y) {
+        for (size_t x = 0; x < info.getTileCountX(); ++x) {
+            oct_bb_t bounds(oct_vec_v2_t(Vector3f(x * tileSize, y * tileSize, 0.0f)));
+            bounds.join(oct_vec_v2_t(Vector3f((x + 1) * tileSize, (y + 1) * tileSize, 1.0f)));
+            tileBounds[info.map(Index2D(static_cast<int>(x), static_cast<int>(y))).i()] = bounds;
+        }
+    }
+    return tileBounds;
+}
+
+/// Cull the tiles and return the visible tiles as 2D indices in the order of their 1D indices.
+static std::vector<std::pair<int, int>> cull(const Ego::MeshInfo& info, const std::vector<oct_bb_t>& tileBounds,
+                                             const Frustum& frustum, oct_bb_t& bounds) {
+    auto getBounds = [&tileBounds](const Index1D& index) -> const oct_bb_t& { return tileBounds[index.i()]; };
+    Hierarchy hierarchy(info);
+    hierarchy.build(getBounds);
+    std::vector<Index1D> tiles;
+    hierarchy.cull(frustum, getBounds, tiles, bounds);
+    std::sort(tiles.begin(), tiles.end(), [](const Index1D& x, const Index1D& y) { return x.i() < y.i(); });
+    std::vector<std::pair<int, int>> result;
+    for (const auto& tile : tiles) {
+        auto index = info.map(tile);
+        result.emplace_back(index.x(), index.y());
+    }
+    return result;
+}
+
+/// The tiles (x0, y0) to (x1, y1) in the order of their 1D indices.
+static std::vector<std::pair<int, int>> makeTiles(int x0, int y0, int x1, int y1) {
+    std::vector<std::pair<int, int>> tiles;
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            tiles.emplace_back(x, y);
+        }
+    }
+    return tiles;
+}
+
+TEST(culling_hierarchy_testing, test_inside_outside_and_straddling_chunks) {
+    // 8 x 8 chunks in 2 x 2 regions.
+    Ego::MeshInfo info(64, 64);
+    auto tileBounds = makeTileBounds(info);
+    // The first region is inside of the frustum. In the second column (row) of regions, the first column (row)
+    // of chunks straddles the frustum boundary and only its first column (row) of tiles is visible.
+    const float extent = 32 * tileSize + 0.5f * tileSize;
+    oct_bb_t bounds;
+    auto tiles = cull(info, tileBounds, makeFrustum(-1.0f, -1.0f, extent, extent), bounds);
+    ASSERT_EQ(makeTiles(0, 0, 32, 32), tiles);
+    ASSERT_FALSE(bounds.isEmpty());
+    ASSERT_EQ(0.0f, bounds._mins[OCT_X]);
+    ASSERT_EQ(0.0f, bounds._mins[OCT_Y]);
+    ASSERT_EQ(33 * tileSize, bounds._maxs[OCT_X]);
+    ASSERT_EQ(33 * tileSize, bounds._maxs[OCT_Y]);
+}
+
+TEST(culling_hierarchy_testing, test_straddling_region) {
+    Ego::MeshInfo info(64, 64);
+    auto tileBounds = makeTileBounds(info);
+    // A small frustum inside of a single chunk of the last region.
+    const float x0 = 50 * tileSize + 0.5f * tileSize, y0 = 41 * tileSize + 0.5f * tileSize;
+    oct_bb_t bounds;
+    auto tiles = cull(info, tileBounds, makeFrustum(x0, y0, x0 + 2 * tileSize, y0 + tileSize), bounds);
+    ASSERT_EQ(makeTiles(50, 41, 52, 42), tiles);
+}
+
+TEST(culling_hierarchy_testing, test_outside) {
+    Ego::MeshInfo info(64, 64);
+    auto tileBounds = makeTileBounds(info);
+    const float extent = 64 * tileSize;
+    oct_bb_t bounds;
+    auto tiles = cull(info, tileBounds, makeFrustum(extent + 1.0f, 0.0f, 2 * extent, extent), bounds);
+    ASSERT_TRUE(tiles.empty());
+    ASSERT_TRUE(bounds.isEmpty());
+}
+
+TEST(culling_hierarchy_testing, test_partial_chunks_and_regions) {
+    // The last chunks and regions are not complete.
+    Ego::MeshInfo info(37, 11);
+    auto tileBounds = makeTileBounds(info);
+    oct_bb_t bounds;
+    auto tiles = cull(info, tileBounds, makeFrustum(-1.0f, -1.0f, 1000.0f, 1000.0f), bounds);
+    ASSERT_EQ(makeTiles(0, 0, 36, 10), tiles);
+    ASSERT_EQ(37 * tileSize, bounds._maxs[OCT_X]);
+    ASSERT_EQ(11 * tileSize, bounds._maxs[OCT_Y]);
+}
+
+TEST(culling_hierarchy_testing, test_empty_tile_bounds) {
+    Ego::MeshInfo info(64, 64);
+    auto tileBounds = makeTileBounds(info);
+    // The first chunk has no bounds at all, the second chunk has bounds for one tile only.
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            if (x == 9 && y == 2) continue;
+            tileBounds[info.map(Index2D(x, y)).i()] = oct_bb_t();
+        }
+    }
+    oct_bb_t bounds;
+    const float extent = 16 * tileSize - 0.5f * tileSize;
+    auto tiles = cull(info, tileBounds, makeFrustum(-1.0f, -1.0f, extent, 4 * tileSize - 0.5f * tileSize), bounds);
+    std::vector<std::pair<int, int>> expected{{9, 2}};
+    ASSERT_EQ(expected, tiles);
+    ASSERT_EQ(9 * tileSize, bounds._mins[OCT_X]);
+    ASSERT_EQ(10 * tileSize, bounds._maxs[OCT_X]);
+    // No tile has bounds.
+    std::fill(tileBounds.begin(), tileBounds.end(), oct_bb_t());
+    tiles = cull(info, tileBounds, makeFrustum(-1.0f, -1.0f, 1000.0f, 1000.0f), bounds);
+    ASSERT_TRUE(tiles.empty());
+    ASSERT_TRUE(bounds.isEmpty());
+}
+
+} } } // namespace Ego::Test::CullingHierarchy
@@ -0,0 +1,77 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/egoboo_setup.h"
+#include "egolib/game/GUI/Material.hpp"
+#include "egolib/Graphics/TextBatch.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
+
+namespace Ego { namespace Test { namespace GuiTextFlush {
+
+/// @brief Get the index of the last command with the specified name.
+static size_t lastIndexOf(const std::vector<Ego::Null::Command>& commands, const std::string& name) {
+    for (size_t i = commands.size(); i > 0; --i) {
+        if (name == commands[i - 1].name) {
+            return i - 1;
+        }
+    }
+    return commands.size();
+}
+
+TEST(gui_text_flush_testing, test_material_flushes_text_before_binding) {
+    egoboo_config_t::get().debug_nullRenderer_enable.setValue(true);
+    Ego::Renderer::initialize();
+    {
+        auto& renderer = dynamic_cast<Ego::Null::Renderer&>(Ego::Renderer::get());
+        auto atlas = renderer.createTexture();
+        Ego::TextBatch textBatch;
+        Ego::TextBatch::setActive(&textBatch);
+        const Ego::TextBatch::GlyphVertex glyph[] = {
+            {0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, {8.0f, 0.0f, 0.0f, 1.0f, 0.0f},
+            {8.0f, 8.0f, 0.0f, 1.0f, 1.0f}, {0.0f, 8.0f, 0.0f, 0.0f, 1.0f},
+        };
+        textBatch.add(atlas, glyph, 4, 16.0f, 16.0f, Colour4f::white());
+
+        renderer.getCommandStream().clear();
+        renderer.getCommandStream().setRecording(true);
+        Ego::GUI::Material(nullptr, Colour4f::red(), true).apply();
+        renderer.getCommandStream().setRecording(false);
+
+        // The text is drawn with its atlas bound, then the material unbinds the atlas and sets its colour.
+        const auto& commands = renderer.getCommandStream().getCommands();
+        ASSERT_TRUE(textBatch.isEmpty());
+        ASSERT_EQ(1, renderer.getCommandStream().getDraws());
+        const size_t draw = lastIndexOf(commands, "render");
+        const size_t bind = lastIndexOf(commands, "TextureUnit::setActivated");
+        const size_t unbind = lastIndexOf(commands, "TextureUnit::setDeactivated");
+        const size_t colour = lastIndexOf(commands, "setColour");
+        ASSERT_LT(bind, draw);
+        ASSERT_LT(draw, unbind);
+        ASSERT_LT(draw, colour);
+        ASSERT_LT(unbind, commands.size());
+        ASSERT_LT(colour, commands.size());
+
+        Ego::TextBatch::setActive(nullptr);
+    }
+    Ego::Renderer::uninitialize();
+    egoboo_config_t::get().debug_nullRenderer_enable.setValue(false);
+}
+
+} } } // namespace Ego::Test::GuiTextFlush
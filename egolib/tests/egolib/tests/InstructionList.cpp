@@ -0,0 +1,49 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/egolib.h"
+#include "egolib/Script/script.h"
+
+namespace Ego { namespace Test { namespace InstructionList {
+
+TEST(instruction_list_testing, test_copies_share_until_modified) {
+    ::InstructionList a;
+    a.append(Instruction(a.getOrCreateConstant(42)));
+    ::InstructionList b = a;
+    ASSERT_TRUE(a.isSharedWith(b));
+    // Modifying a copy detaches it.
+    b.set(0, Instruction(Instruction::FUNCTIONBITS | b.getOrCreateConstant(7)));
+    ASSERT_FALSE(a.isSharedWith(b));
+    ASSERT_EQ(42, a.getConstantPool().getConstant(a[0].getValueBits()).getAsInteger());
+    ASSERT_EQ(7, b.getConstantPool().getConstant(b[0].getValueBits()).getAsInteger());
+    ASSERT_TRUE(b[0].isInv());
+}
+
+TEST(instruction_list_testing, test_clear) {
+    ::InstructionList a;
+    a.append(Instruction(a.getOrCreateConstant(1)));
+    ::InstructionList b = a;
+    b.clear();
+    ASSERT_EQ(1, a.getNumberOfInstructions());
+    ASSERT_TRUE(b.isEmpty());
+    ASSERT_EQ(0, b.getConstantPool().getNumberOfConstants());
+}
+
+} } } // namespace Ego::Test::InstructionList
@@ -0,0 +1,75 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "gtest/gtest.h"
+#include "egolib/game/Graphics/LightClusters.hpp"
+
+namespace Ego { namespace Test { namespace LightClusters {
+
+using Clusters = Ego::Graphics::LightClusters;
+
+/// The bounds of a light covering the tiles (x0, y0) to (x1, y1).
+static ego_frect_t makeBound(int x0, int y0, int x1, int y1) {
+    const float size = Info<float>::Grid::Size();
+    return ego_frect_t{x0 * size - 0.25f * size, y0 * size - 0.25f * size,
+                       x1 * size + 0.25f * size, y1 * size + 0.25f * size};
+}
+
+static std::vector<uint32_t> getLights(const Clusters& clusters, int x, int y) {
+    auto range = clusters.get(Index2D(x, y));
+    return std::vector<uint32_t>(range.begin(), range.end());
+}
+
+TEST(light_clusters_testing, test_binning) {
+    Clusters clusters;
+    clusters.build(Ego::MeshInfo(16, 16), {makeBound(0, 0, 1, 1), makeBound(3, 3, 4, 4), makeBound(12, 0, 12, 0)});
+    ASSERT_EQ(std::vector<uint32_t>({0, 1}), getLights(clusters, 0, 0));
+    ASSERT_EQ(std::vector<uint32_t>({1}), getLights(clusters, 4, 7));
+    ASSERT_EQ(std::vector<uint32_t>({2}), getLights(clusters, 15, 3));
+    ASSERT_TRUE(clusters.get(Index2D(8, 8)).empty());
+    // Tiles outside of the mesh have no lights.
+    ASSERT_TRUE(clusters.get(Index2D(16, 0)).empty());
+}
+
+TEST(light_clusters_testing, test_lights_outside_of_mesh) {
+    Clusters clusters;
+    const float size = Info<float>::Grid::Size();
+    clusters.build(Ego::MeshInfo(8, 8), {ego_frect_t{-4 * size, -4 * size, -2 * size, -2 * size}, makeBound(-2, 6, 1, 20)});
+    ASSERT_EQ(1, clusters.getStats().references);
+    ASSERT_EQ(std::vector<uint32_t>({1}), getLights(clusters, 0, 7));
+}
+
+TEST(light_clusters_testing, test_stats) {
+    Clusters clusters;
+    clusters.build(Ego::MeshInfo(16, 16), {makeBound(0, 0, 1, 1), makeBound(3, 3, 4, 4)});
+    const auto& stats = clusters.getStats();
+    ASSERT_EQ(2, stats.lights);
+    ASSERT_EQ(16, stats.clusters);
+    ASSERT_EQ(4, stats.occupiedClusters);
+    ASSERT_EQ(5, stats.references);
+    ASSERT_EQ(2, stats.maxLightsPerCluster);
+    ASSERT_FLOAT_EQ(1.25f, stats.getAverageLightsPerCluster());
+    // Rebuilding replaces the bins.
+    clusters.build(Ego::MeshInfo(16, 16), {});
+    ASSERT_EQ(0, clusters.getStats().occupiedClusters);
+    ASSERT_TRUE(clusters.get(Index2D(0, 0)).empty());
+}
+
+} } } // namespace Ego::Test::LightClusters
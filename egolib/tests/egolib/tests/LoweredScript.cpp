@@ -0,0 +1,422 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/egolib.h"
+#include "egolib/Script/LoweredScript.hpp"
+
+namespace Ego { namespace Test { namespace LoweredScript {
+
+using Ego::Script::LoweredInstruction;
+using Ego::Script::LoweredOperand;
+
+/// @brief A line of a script.
+struct Line
+{
+    uint8_t indent;
+    bool isCall;
+    /// @brief The function or the variable.
+    uint32_t index;
+    /// @brief The operands of an assignment: A constant (operator, true, value) or a variable (operator, false, index).
+    std::vector<LoweredOperand> operands;
+};
+
+Line call(uint8_t indent, uint32_t function)
+{
+    return Line{indent, true, function, {}};
+}
+
+Line assign(uint8_t indent, uint32_t variable, std::vector<LoweredOperand> operands)
+{
+    return Line{indent, false, variable, operands};
+}
+
+LoweredOperand constant(int32_t value, uint8_t operation = Ego::Script::OPADD)
+{
+    return LoweredOperand{operation, true, value};
+}
+
+LoweredOperand variable(uint32_t index, uint8_t operation = Ego::Script::OPADD)
+{
+    return LoweredOperand{operation, false, static_cast<int32_t>(index)};
+}
+
+/// @brief Compile lines into an instruction list as the script compiler does,
+/// including the jump targets of the functions and the final "End".
+::InstructionList compile(const std::vector<Line>& lines)
+{
+    ::InstructionList list;
+    std::vector<size_t> starts;
+    uint32_t sourceLine = 1;
+    auto emitLine = [&](const Line& line)
+    {
+        starts.push_back(list.getNumberOfInstructions());
+        const uint32_t indent = (line.indent & 0x0f) << 27;
+        if (line.isCall)
+        {
+            list.append(Instruction(Instruction::FUNCTIONBITS | indent | list.getOrCreateConstant(line.index)), sourceLine);
+            list.append(Instruction(0), sourceLine);
+        }
+        else
+        {
+            list.append(Instruction(indent | list.getOrCreateConstant(line.index)), sourceLine);
+            list.append(Instruction(static_cast<uint32_t>(line.operands.size())), sourceLine);
+            for (const auto& operand : line.operands)
+            {
+                const uint32_t operation = (operand.operation & 0x0f) << 27;
+                list.append(Instruction((operand.isConstant ? Instruction::FUNCTIONBITS : 0) | operation
+                                        | list.getOrCreateConstant(operand.value)), sourceLine);
+            }
+        }
+        sourceLine++;
+    };
+    for (const auto& line : lines)
+    {
+        emitLine(line);
+    }
+    emitLine(call(0, Ego::Script::End));
+    // A function jumps to the next line with a smaller or equal indention if it fails.
+    for (size_t i = 0; i < starts.size(); ++i)
+    {
+        if (list[starts[i]].isInv())
+        {
+            size_t target = list.getNumberOfInstructions() + 1;
+            for (size_t j = i + 1; j < starts.size(); ++j)
+            {
+                if (list[starts[j]].getDataBits() <= list[starts[i]].getDataBits())
+                {
+                    target = starts[j];
+                    break;
+                }
+            }
+            list.set(starts[i] + 1, Instruction(static_cast<uint32_t>(target)));
+        }
+    }
+    return list;
+}
+
+/// @brief The state a script operates on and a trace of what the script did.
+struct State
+{
+    int32_t x = 0, y = 0, argument = 0, distance = 0;
+    uint32_t timer = 0, world = 0;
+    int32_t operationsum = 0;
+    uint32_t indent = 0, indentLast = 0;
+    bool terminated = false;
+    std::vector<std::string> trace;
+
+    int32_t load(uint32_t index) const
+    {
+        switch (index)
+        {
+            case Ego::Script::VARTMPX: return x;
+            case Ego::Script::VARTMPY: return y;
+            case Ego::Script::VARTMPARGUMENT: return argument;
+            case Ego::Script::VARTMPDISTANCE: return distance;
+            default: return 0;
+        };
+    }
+
+    void store(uint32_t index)
+    {
+        switch (index)
+        {
+            case Ego::Script::VARTMPX: x = operationsum; break;
+            case Ego::Script::VARTMPY: y = operationsum; break;
+            case Ego::Script::VARTMPARGUMENT: argument = operationsum; break;
+            case Ego::Script::VARTMPDISTANCE: distance = operationsum; break;
+            default: break;
+        };
+    }
+
+    void apply(uint8_t operation, int32_t value)
+    {
+        switch (operation)
+        {
+            case Ego::Script::OPADD: operationsum += value; break;
+            case Ego::Script::OPSUB: operationsum -= value; break;
+            case Ego::Script::OPAND: operationsum &= value; break;
+            case Ego::Script::OPSHR: operationsum >>= value; break;
+            case Ego::Script::OPSHL: operationsum <<= value; break;
+            case Ego::Script::OPMUL: operationsum *= value; break;
+            case Ego::Script::OPDIV: operationsum = value ? operationsum / value : 0; break;
+            case Ego::Script::OPMOD: operationsum = value ? operationsum % value : 0; break;
+            default: break;
+        };
+    }
+
+    /// @brief Invoke a function. The functions with side effects are traced with the indentions the Else function sees.
+    bool invoke(uint32_t function)
+    {
+        switch (function)
+        {
+            case Ego::Script::IfTimeOut: return world > timer;
+            case Ego::Script::SetTime: timer = world + argument; return true;
+            case Ego::Script::IfXIsEqualToY: return x == y;
+            case Ego::Script::IfXIsLessThanY: return x < y;
+            case Ego::Script::IfYIsLessThanX: return y < x;
+            case Ego::Script::End: terminated = true; return true;
+            default:
+                trace.push_back(std::to_string(function) + "(" + std::to_string(x) + ", " + std::to_string(y) + ", "
+                                + std::to_string(argument) + ") indent " + std::to_string(indentLast) + " -> " + std::to_string(indent));
+                return argument >= 0;
+        };
+    }
+};
+
+/// @brief Execute the compiled form as the interpreter does when debugging scripts.
+void executeCompiled(const ::InstructionList& list, State& state)
+{
+    size_t position = 0;
+    const auto& constants = list.getConstantPool();
+    while (!state.terminated && position < list.getNumberOfInstructions())
+    {
+        state.indentLast = state.indent;
+        state.indent = list[position].getDataBits();
+        const uint32_t index = constants.getConstant(list[position].getValueBits()).getAsInteger();
+        if (list[position].isInv())
+        {
+            const bool success = state.invoke(index);
+            position++;
+            position = success ? position + 1 : list[position].getBits();
+        }
+        else
+        {
+            position++;
+            const auto numberOfOperands = list[position].getBits();
+            state.operationsum = 0;
+            for (uint32_t i = 0; i < numberOfOperands; ++i)
+            {
+                position++;
+                const auto& operand = list[position];
+                const int32_t value = constants.getConstant(operand.getValueBits()).getAsInteger();
+                state.apply(operand.getDataBits(), operand.isLdc() ? value : state.load(value));
+            }
+            state.store(index);
+            position++;
+        }
+    }
+}
+
+/// @brief Executes the lowered form on a state.
+struct Machine
+{
+    State& state;
+
+    bool isTerminated() const
+    {
+        return state.terminated;
+    }
+
+    int enter(const LoweredInstruction& instruction, size_t index)
+    {
+        state.indentLast = instruction.isFused() ? instruction.previousIndent : state.indent;
+        state.indent = instruction.indent;
+        return 0;
+    }
+
+    bool call(uint32_t index, Ego::Script::NativeInterface::Function *function)
+    {
+        return state.invoke(index);
+    }
+
+    void assign(uint32_t index, const LoweredOperand *operands, size_t numberOfOperands)
+    {
+        state.operationsum = 0;
+        for (size_t i = 0; i < numberOfOperands; ++i)
+        {
+            state.apply(operands[i].operation, operands[i].isConstant ? operands[i].value : state.load(operands[i].value));
+        }
+        state.store(index);
+    }
+
+    void assignConstant(uint32_t index, int32_t constant)
+    {
+        state.operationsum = constant;
+        state.store(index);
+    }
+
+    bool compare(LoweredInstruction::Comparison comparison)
+    {
+        switch (comparison)
+        {
+            case LoweredInstruction::Comparison::Equal: return state.x == state.y;
+            case LoweredInstruction::Comparison::Less: return state.x < state.y;
+            case LoweredInstruction::Comparison::Greater: return state.x > state.y;
+            default: return false;
+        };
+    }
+
+    bool timeOutSetTime()
+    {
+        if (!(state.world > state.timer))
+        {
+            return false;
+        }
+        state.timer = state.world + state.argument;
+        return true;
+    }
+};
+
+/// @brief Lower an instruction list.
+std::shared_ptr<Ego::Script::LoweredScript> lower(const ::InstructionList& list)
+{
+    if (!Ego::Script::Runtime::is_initialized())
+    {
+        Ego::Script::Runtime::initialize();
+    }
+    return Ego::Script::LoweredScript::lower(list, Ego::Script::Runtime::get());
+}
+
+/// @brief Execute the compiled and the lowered form of a script on copies of a state and assert that they agree.
+void assertAgree(const std::vector<Line>& lines, const State& initial)
+{
+    const auto list = compile(lines);
+    const auto lowered = lower(list);
+    ASSERT_TRUE(lowered->isLowered());
+    State expected = initial, actual = initial;
+    executeCompiled(list, expected);
+    Machine machine{actual};
+    lowered->execute(machine);
+    ASSERT_EQ(expected.trace, actual.trace);
+    ASSERT_EQ(expected.x, actual.x);
+    ASSERT_EQ(expected.y, actual.y);
+    ASSERT_EQ(expected.argument, actual.argument);
+    ASSERT_EQ(expected.distance, actual.distance);
+    ASSERT_EQ(expected.timer, actual.timer);
+    ASSERT_EQ(expected.indent, actual.indent);
+    ASSERT_EQ(expected.terminated, actual.terminated);
+}
+
+/// @brief Count the instructions of a kind in a lowered script.
+size_t countKind(const Ego::Script::LoweredScript& lowered, LoweredInstruction::Kind kind)
+{
+    return std::count_if(lowered.instructions.begin(), lowered.instructions.end(),
+                         [kind](const LoweredInstruction& instruction) { return kind == instruction.kind; });
+}
+
+TEST(lowered_script_testing, test_constants_and_operators) {
+    const std::vector<Line> lines = {
+        assign(0, Ego::Script::VARTMPARGUMENT, {constant(5)}),
+        assign(0, Ego::Script::VARTMPDISTANCE, {}),
+        assign(0, Ego::Script::VARTMPX, {variable(Ego::Script::VARTMPARGUMENT), constant(3, Ego::Script::OPMUL), constant(4, Ego::Script::OPSUB)}),
+        assign(0, Ego::Script::VARTMPY, {variable(Ego::Script::VARTMPX), constant(1, Ego::Script::OPSHL), variable(Ego::Script::VARTMPARGUMENT, Ego::Script::OPMOD)}),
+        call(0, Ego::Script::SetState),
+    };
+    const auto lowered = lower(compile(lines));
+    ASSERT_EQ(2, countKind(*lowered, LoweredInstruction::Kind::AssignConstant));
+    assertAgree(lines, State());
+}
+
+TEST(lowered_script_testing, test_jumps_and_function_calls) {
+    // IfXIsLessThanY
+    //   SetState
+    //   IfXIsEqualToY
+    //     SetContent
+    //   tmpargument = 0 - 1
+    //   SetContent (fails)
+    //     SetState
+    // SetTurnModeToWatch
+    const std::vector<Line> lines = {
+        call(0, Ego::Script::IfXIsLessThanY),
+        call(1, Ego::Script::SetState),
+        call(1, Ego::Script::IfXIsEqualToY),
+        call(2, Ego::Script::SetContent),
+        assign(1, Ego::Script::VARTMPARGUMENT, {constant(0), constant(1, Ego::Script::OPSUB)}),
+        call(1, Ego::Script::SetContent),
+        call(2, Ego::Script::SetState),
+        call(0, Ego::Script::SetTurnModeToWatch),
+    };
+    const auto lowered = lower(compile(lines));
+    ASSERT_EQ(2, countKind(*lowered, LoweredInstruction::Kind::Compare));
+    for (auto xy : std::vector<std::pair<int32_t, int32_t>>{{0, 1}, {1, 1}, {2, 1}}) {
+        State state;
+        state.x = xy.first;
+        state.y = xy.second;
+        assertAgree(lines, state);
+    }
+}
+
+TEST(lowered_script_testing, test_fusions) {
+    // IfTimeOut
+    //   SetTime
+    //   tmpx = tmpdistance + 1
+    //   tmpy = 7
+    //   SpawnParticle
+    //   IfYIsLessThanX
+    //     SetState
+    const std::vector<Line> lines = {
+        assign(0, Ego::Script::VARTMPARGUMENT, {constant(20)}),
+        call(0, Ego::Script::IfTimeOut),
+        call(1, Ego::Script::SetTime),
+        assign(1, Ego::Script::VARTMPX, {variable(Ego::Script::VARTMPDISTANCE), constant(1)}),
+        assign(1, Ego::Script::VARTMPY, {constant(7)}),
+        call(1, Ego::Script::SpawnParticle),
+        call(1, Ego::Script::IfYIsLessThanX),
+        call(2, Ego::Script::SetState),
+    };
+    const auto lowered = lower(compile(lines));
+    ASSERT_EQ(1, countKind(*lowered, LoweredInstruction::Kind::TimeOutSetTime));
+    ASSERT_EQ(1, countKind(*lowered, LoweredInstruction::Kind::AssignXYCall));
+    ASSERT_EQ(1, countKind(*lowered, LoweredInstruction::Kind::Compare));
+    // The fused instructions execute 5 of the 9 lines.
+    ASSERT_EQ(9 - 3, lowered->instructions.size());
+    for (auto distance : {0, 6, 10}) {
+        for (auto world : {0, 5}) {
+            State state;
+            state.distance = distance;
+            state.world = world;
+            assertAgree(lines, state);
+        }
+    }
+}
+
+TEST(lowered_script_testing, test_no_fusion_across_jump_targets) {
+    // A SetTime nested in an IfTimeOut is fused with it.
+    const std::vector<Line> nested = {
+        call(0, Ego::Script::IfTimeOut),
+        call(1, Ego::Script::SetTime),
+        call(0, Ego::Script::SetState),
+    };
+    // A SetTime following an IfTimeOut on the same indention is the jump target of the IfTimeOut and is not fused with it.
+    const std::vector<Line> sequential = {
+        call(0, Ego::Script::IfTimeOut),
+        call(0, Ego::Script::SetTime),
+        call(0, Ego::Script::SetState),
+    };
+    ASSERT_EQ(1, countKind(*lower(compile(nested)), LoweredInstruction::Kind::TimeOutSetTime));
+    ASSERT_EQ(0, countKind(*lower(compile(sequential)), LoweredInstruction::Kind::TimeOutSetTime));
+    for (auto world : {0, 5}) {
+        State state;
+        state.world = world;
+        assertAgree(nested, state);
+        assertAgree(sequential, state);
+    }
+}
+
+TEST(lowered_script_testing, test_malformed_script_is_not_lowered) {
+    ::InstructionList list;
+    list.append(Instruction(Instruction::FUNCTIONBITS | list.getOrCreateConstant(Ego::Script::SetState)), 3);
+    const auto lowered = lower(list);
+    ASSERT_FALSE(lowered->isLowered());
+    ASSERT_TRUE(lowered->instructions.empty());
+    ASSERT_NE(std::string::npos, lowered->problem.find("truncated line"));
+}
+
+} } } // namespace Ego::Test::LoweredScript
@@ -0,0 +1,70 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/egolib.h"
+#include "egolib/Core/LruCache.hpp"
+
+namespace Ego { namespace Test { namespace LruCache {
+
+TEST(lru_cache_testing, test_find_and_insert) {
+    Ego::LruCache<std::string, int> cache(2);
+    ASSERT_EQ(nullptr, cache.find("a"));
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    ASSERT_NE(nullptr, cache.find("a"));
+    ASSERT_EQ(1, *cache.find("a"));
+    ASSERT_EQ(2, *cache.find("b"));
+    ASSERT_EQ(3, cache.getHits());
+    ASSERT_EQ(1, cache.getMisses());
+    // Replacing an entry does not grow the cache.
+    cache.insert("b", 3);
+    ASSERT_EQ(2, cache.getSize());
+    ASSERT_EQ(3, *cache.find("b"));
+}
+
+TEST(lru_cache_testing, test_eviction) {
+    Ego::LruCache<std::string, int> cache(2);
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    // "a" becomes the most recently used entry, hence "b" is evicted.
+    cache.find("a");
+    cache.insert("c", 3);
+    ASSERT_EQ(2, cache.getSize());
+    ASSERT_EQ(nullptr, cache.find("b"));
+    ASSERT_NE(nullptr, cache.find("a"));
+    ASSERT_NE(nullptr, cache.find("c"));
+}
+
+TEST(lru_cache_testing, test_capacity) {
+    Ego::LruCache<std::string, int> cache(3);
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    cache.insert("c", 3);
+    cache.setCapacity(1);
+    ASSERT_EQ(1, cache.getSize());
+    ASSERT_NE(nullptr, cache.find("c"));
+    cache.setCapacity(0);
+    ASSERT_EQ(0, cache.getSize());
+    cache.insert("d", 4);
+    ASSERT_EQ(0, cache.getSize());
+    ASSERT_EQ(nullptr, cache.find("d"));
+}
+
+} } } // namespace Ego::Test::LruCache
@@ -0,0 +1,69 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "gtest/gtest.h"
+#include "egolib/game/mesh.h"
+
+namespace Ego { namespace Test { namespace MpdfxLists {
+
+static std::vector<int> toInts(const mpdfx_list_ary_t& list) {
+    std::vector<int> ints;
+    for (const auto& element : list.elements) {
+        ints.push_back(element.i());
+    }
+    return ints;
+}
+
+TEST(mpdfx_lists_testing, test_insert_and_erase_keep_order) {
+    mpdfx_list_ary_t list;
+    list.insert(Index1D(5));
+    list.insert(Index1D(1));
+    list.insert(Index1D(3));
+    list.insert(Index1D(3));
+    ASSERT_EQ(std::vector<int>({1, 3, 5}), toInts(list));
+    list.erase(Index1D(3));
+    list.erase(Index1D(4));
+    ASSERT_EQ(std::vector<int>({1, 5}), toInts(list));
+}
+
+TEST(mpdfx_lists_testing, test_update_matches_push) {
+    mpdfx_lists_t lists(Ego::MeshInfo(4, 4));
+    lists.push(MAPFX_WALL | MAPFX_IMPASS, 2);
+    lists.push(MAPFX_WATER, 7);
+    // Open a door at the tile 2.
+    lists.update(Index1D(2), MAPFX_WALL | MAPFX_IMPASS, 0);
+    ASSERT_TRUE(lists.wal.elements.empty());
+    ASSERT_TRUE(lists.imp.elements.empty());
+    ASSERT_TRUE(lists.sha.elements.empty());
+    // Close it again and add a trap at the tile 9.
+    lists.update(Index1D(2), 0, MAPFX_WALL | MAPFX_IMPASS);
+    lists.update(Index1D(9), 0, MAPFX_DAMAGE);
+    mpdfx_lists_t expected(Ego::MeshInfo(4, 4));
+    expected.push(MAPFX_WALL | MAPFX_IMPASS, 2);
+    expected.push(MAPFX_WATER, 7);
+    expected.push(MAPFX_DAMAGE, 9);
+    ASSERT_EQ(toInts(expected.sha), toInts(lists.sha));
+    ASSERT_EQ(toInts(expected.wal), toInts(lists.wal));
+    ASSERT_EQ(toInts(expected.imp), toInts(lists.imp));
+    ASSERT_EQ(toInts(expected.wat), toInts(lists.wat));
+    ASSERT_EQ(toInts(expected.dam), toInts(lists.dam));
+}
+
+} } } // namespace Ego::Test::MpdfxLists
@@ -0,0 +1,90 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/Renderer/Null/CommandStream.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
+#include <sstream>
+
+namespace Ego { namespace Test {
+
+TEST(null_renderer_command_stream, counters_without_recording)
+{
+    Ego::Null::CommandStream stream;
+    stream.append(Ego::Null::Command::Kind::StateChange, "setBlendingEnabled");
+    stream.append(Ego::Null::Command::Kind::Draw, "render", 6);
+    stream.append(Ego::Null::Command::Kind::Draw, "render", 4);
+    stream.append(Ego::Null::Command::Kind::Upload, "Texture::load", 1024);
+    ASSERT_EQ(1, stream.getStateChanges());
+    ASSERT_EQ(2, stream.getDraws());
+    ASSERT_EQ(10, stream.getVertices());
+    ASSERT_EQ(1, stream.getUploads());
+    ASSERT_EQ(1024, stream.getBytesUploaded());
+    ASSERT_TRUE(stream.getCommands().empty());
+}
+
+TEST(null_renderer_command_stream, recording)
+{
+    Ego::Null::CommandStream stream;
+    stream.setRecording(true);
+    stream.append(Ego::Null::Command::Kind::Bind, "TextureUnit::setActivated");
+    stream.append(Ego::Null::Command::Kind::Draw, "render", 3);
+    ASSERT_EQ(2, stream.getCommands().size());
+    ASSERT_EQ(Ego::Null::Command::Kind::Bind, stream.getCommands()[0].kind);
+    ASSERT_EQ(3, stream.getCommands()[1].size);
+    std::ostringstream os;
+    stream.write(os);
+    ASSERT_NE(std::string::npos, os.str().find("draw render 3"));
+    stream.clear();
+    ASSERT_TRUE(stream.getCommands().empty());
+    ASSERT_EQ(0, stream.getDraws());
+    ASSERT_EQ(0, stream.getBinds());
+}
+
+TEST(null_renderer_command_stream, counters_per_frame)
+{
+    Ego::Null::Renderer renderer;
+    auto& stream = renderer.getCommandStream();
+    stream.append(Ego::Null::Command::Kind::Draw, "render", 6);
+    stream.append(Ego::Null::Command::Kind::Draw, "render", 4);
+    renderer.endFrame();
+    ASSERT_EQ(1, renderer.getNumberOfFrames());
+    ASSERT_EQ(2, renderer.getLastFrameCounters().draws);
+    ASSERT_EQ(10, renderer.getLastFrameCounters().vertices);
+    ASSERT_EQ(0, stream.getDraws());
+    stream.append(Ego::Null::Command::Kind::Draw, "render", 3);
+    renderer.endFrame();
+    ASSERT_EQ(2, renderer.getNumberOfFrames());
+    ASSERT_EQ(1, renderer.getLastFrameCounters().draws);
+    ASSERT_EQ(3, renderer.getTotalCounters().draws);
+    ASSERT_EQ(13, renderer.getTotalCounters().vertices);
+}
+
+TEST(null_renderer_command_stream, direct_draws)
+{
+    Ego::Null::Renderer renderer;
+    ASSERT_FALSE(renderer.isDirectRenderingEnabled());
+    renderer.countDirectDraw("TileListV2::render", 6);
+    renderer.countDirectDraw("Md2VertexBuffer::render", 3);
+    ASSERT_EQ(2, renderer.getStatistics().draws);
+    ASSERT_EQ(2, renderer.getCommandStream().getDraws());
+    ASSERT_EQ(9, renderer.getCommandStream().getVertices());
+}
+
+} } // namespace Ego::Test
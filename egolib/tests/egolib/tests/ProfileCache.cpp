@@ -0,0 +1,681 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/egolib.h"
+#include "egolib/Profiles/_Include.hpp"
+#define EGOLIB_PROFILES_PRIVATE 1
+#include "egolib/Profiles/ProfileCache.hpp"
+#undef EGOLIB_PROFILES_PRIVATE
+
+namespace Ego { namespace Test { namespace ProfileCache {
+
+using Kind = Ego::ProfileCache::Kind;
+using Validity = Ego::ProfileCache::Validity;
+
+void expectEqual(const IPair& expected, const IPair& actual) {
+    EXPECT_EQ(expected.base, actual.base);
+    EXPECT_EQ(expected.rand, actual.rand);
+}
+
+void expectEqual(const idlib::interval<float>& expected, const idlib::interval<float>& actual) {
+    EXPECT_EQ(expected.lower(), actual.lower());
+    EXPECT_EQ(expected.upper(), actual.upper());
+}
+
+void expectEqual(const SpawnDescriptor& expected, const SpawnDescriptor& actual) {
+    EXPECT_EQ(expected._amount, actual._amount);
+    EXPECT_EQ(expected._facingAdd, actual._facingAdd);
+    EXPECT_EQ(expected._lpip.get(), actual._lpip.get());
+}
+
+void expectEqual(const ContinuousSpawnDescriptor& expected, const ContinuousSpawnDescriptor& actual) {
+    expectEqual(static_cast<const SpawnDescriptor&>(expected), static_cast<const SpawnDescriptor&>(actual));
+    EXPECT_EQ(expected._delay, actual._delay);
+}
+
+void fill(SpawnDescriptor& descriptor, int seed) {
+    descriptor._amount = static_cast<uint8_t>(seed);
+    descriptor._facingAdd = static_cast<uint16_t>(seed + 1);
+    descriptor._lpip = LocalParticleProfileRef(seed + 2);
+}
+
+void fill(ContinuousSpawnDescriptor& descriptor, int seed) {
+    fill(static_cast<SpawnDescriptor&>(descriptor), seed);
+    descriptor._delay = static_cast<uint16_t>(seed + 3);
+}
+
+/// Serialize @a source into a payload, deserialize the payload into @a target,
+/// and ensure the entire payload was consumed and @a target serializes to the same payload.
+template <typename Profile>
+void roundTrip(const Profile& source, Profile& target) {
+    std::vector<char> payload;
+    source.write(payload);
+    Ego::CacheFile::Reader reader{payload.data(), payload.data() + payload.size()};
+    ASSERT_TRUE(target.read(reader));
+    ASSERT_EQ(reader.end, reader.current);
+    std::vector<char> again;
+    target.write(again);
+    ASSERT_EQ(payload, again);
+}
+
+/// An enchant profile with every cached field set to a non-default value.
+struct TestEnchantProfile : EnchantProfile {
+    void write(std::vector<char>& buffer) const { writeToCache(buffer); }
+    bool read(Ego::CacheFile::Reader& reader) { return readFromCache(reader); }
+
+    void fill() {
+        _override = true;
+        remove_overridden = true;
+        retarget = true;
+        required_damagetype = DAMAGE_FIRE;
+        require_damagetarget_damagetype = DAMAGE_ICE;
+        spawn_overlay = true;
+        lifetime = 17;
+        endIfCannotPay = true;
+        removedByIDSZ = IDSZ2('D', 'I', 'S', 'P');
+        _owner = ObjectRelation(true, 3, 4);
+        _target = ObjectRelation(true, 5, 6);
+        for (size_t i = 0; i < _set.size(); ++i) {
+            _set[i].apply = (0 == i % 2);
+            _set[i].value = i + 0.5f;
+        }
+        for (size_t i = 0; i < _add.size(); ++i) {
+            _add[i].apply = (1 == i % 2);
+            _add[i].value = i + 0.25f;
+        }
+        seeKurses = 7;
+        darkvision = 8;
+        ProfileCache::fill(contspawn, 9);
+        endsound_index = 13;
+        killtargetonend = true;
+        poofonend = true;
+        endmessage = 14;
+        _enchantName = "Haste";
+    }
+
+    void expectEqual(const TestEnchantProfile& other) const {
+        EXPECT_EQ(_override, other._override);
+        EXPECT_EQ(remove_overridden, other.remove_overridden);
+        EXPECT_EQ(retarget, other.retarget);
+        EXPECT_EQ(required_damagetype, other.required_damagetype);
+        EXPECT_EQ(require_damagetarget_damagetype, other.require_damagetarget_damagetype);
+        EXPECT_EQ(spawn_overlay, other.spawn_overlay);
+        EXPECT_EQ(lifetime, other.lifetime);
+        EXPECT_EQ(endIfCannotPay, other.endIfCannotPay);
+        EXPECT_EQ(removedByIDSZ, other.removedByIDSZ);
+        EXPECT_EQ(_owner._stay, other._owner._stay);
+        EXPECT_EQ(_owner._manaDrain, other._owner._manaDrain);
+        EXPECT_EQ(_owner._lifeDrain, other._owner._lifeDrain);
+        EXPECT_EQ(_target._stay, other._target._stay);
+        EXPECT_EQ(_target._manaDrain, other._target._manaDrain);
+        EXPECT_EQ(_target._lifeDrain, other._target._lifeDrain);
+        for (size_t i = 0; i < _set.size(); ++i) {
+            EXPECT_EQ(_set[i].apply, other._set[i].apply);
+            EXPECT_EQ(_set[i].value, other._set[i].value);
+        }
+        for (size_t i = 0; i < _add.size(); ++i) {
+            EXPECT_EQ(_add[i].apply, other._add[i].apply);
+            EXPECT_EQ(_add[i].value, other._add[i].value);
+        }
+        EXPECT_EQ(seeKurses, other.seeKurses);
+        EXPECT_EQ(darkvision, other.darkvision);
+        ProfileCache::expectEqual(contspawn, other.contspawn);
+        EXPECT_EQ(endsound_index, other.endsound_index);
+        EXPECT_EQ(killtargetonend, other.killtargetonend);
+        EXPECT_EQ(poofonend, other.poofonend);
+        EXPECT_EQ(endmessage, other.endmessage);
+        EXPECT_EQ(_enchantName, other._enchantName);
+    }
+};
+
+/// A particle profile with every cached field set to a non-default value.
+struct TestParticleProfile : ParticleProfile {
+    void write(std::vector<char>& buffer) const { writeToCache(buffer); }
+    bool read(Ego::CacheFile::Reader& reader) { return readFromCache(reader); }
+
+    void fill() {
+        soundspawn = 3;
+        force = true;
+        newtargetonspawn = true;
+        needtarget = true;
+        startontarget = true;
+        end_time = 40;
+        end_water = true;
+        end_bump = true;
+        end_ground = true;
+        end_wall = true;
+        end_lastframe = true;
+        end_sound = 4;
+        end_sound_floor = 5;
+        end_sound_wall = 6;
+        ProfileCache::fill(contspawn, 10);
+        ProfileCache::fill(endspawn, 20);
+        ProfileCache::fill(bumpspawn, 30);
+        bump_money = 11;
+        bump_size = 12;
+        bump_height = 13;
+        damage = idlib::interval<float>(1.5f, 2.5f);
+        damageType = DAMAGE_ZAP;
+        dazeTime = 14;
+        grogTime = 15;
+        _intellectDamageBonus = true;
+        spawnenchant = true;
+        onlydamagefriendly = true;
+        friendlyfire = true;
+        hateonly = true;
+        cause_roll = true;
+        cause_pancake = true;
+        lifeDrain = 16;
+        manaDrain = 17;
+        homing = true;
+        targetangle = 18;
+        homingaccel = 0.125f;
+        homingfriction = 0.25f;
+        zaimspd = 0.375f;
+        rotatetoface = true;
+        targetcaster = true;
+        spdlimit = 19.5f;
+        dampen = 0.625f;
+        allowpush = true;
+        ignore_gravity = true;
+        dynalight.mode = DYNA_MODE_LOCAL;
+        dynalight.on = 1;
+        dynalight.level = 0.75f;
+        dynalight.level_add = 0.875f;
+        dynalight.falloff = 21.0f;
+        dynalight.falloff_add = 22.0f;
+        type = SPRITE_LIGHT;
+        image_max = 23;
+        image_stt = 24;
+        image_add = IPair(25, 26);
+        rotate_pair = IPair(27, 28);
+        rotate_add = 29;
+        size_base = 30;
+        size_add = 31;
+        facingadd = 32;
+        orientation = prt_ori_t::ORIENTATION_H;
+        _comment = "fireball";
+        _particleEffectBits.set(DAMFX_ARMO);
+        _particleEffectBits.set(DAMFX_TIME);
+        _gravityPull = 0.5f;
+        _spawnFacing = IPair(33, 34);
+        _spawnPositionOffsetXY = IPair(35, 36);
+        _spawnPositionOffsetZ = IPair(37, 38);
+        _spawnVelocityOffsetXY = IPair(39, 40);
+        _spawnVelocityOffsetZ = IPair(41, 42);
+    }
+
+    void expectEqual(const TestParticleProfile& other) const {
+        EXPECT_EQ(soundspawn, other.soundspawn);
+        EXPECT_EQ(force, other.force);
+        EXPECT_EQ(newtargetonspawn, other.newtargetonspawn);
+        EXPECT_EQ(needtarget, other.needtarget);
+        EXPECT_EQ(startontarget, other.startontarget);
+        EXPECT_EQ(end_time, other.end_time);
+        EXPECT_EQ(end_water, other.end_water);
+        EXPECT_EQ(end_bump, other.end_bump);
+        EXPECT_EQ(end_ground, other.end_ground);
+        EXPECT_EQ(end_wall, other.end_wall);
+        EXPECT_EQ(end_lastframe, other.end_lastframe);
+        EXPECT_EQ(end_sound, other.end_sound);
+        EXPECT_EQ(end_sound_floor, other.end_sound_floor);
+        EXPECT_EQ(end_sound_wall, other.end_sound_wall);
+        ProfileCache::expectEqual(contspawn, other.contspawn);
+        ProfileCache::expectEqual(endspawn, other.endspawn);
+        ProfileCache::expectEqual(bumpspawn, other.bumpspawn);
+        EXPECT_EQ(bump_money, other.bump_money);
+        EXPECT_EQ(bump_size, other.bump_size);
+        EXPECT_EQ(bump_height, other.bump_height);
+        ProfileCache::expectEqual(damage, other.damage);
+        EXPECT_EQ(damageType, other.damageType);
+        EXPECT_EQ(dazeTime, other.dazeTime);
+        EXPECT_EQ(grogTime, other.grogTime);
+        EXPECT_EQ(_intellectDamageBonus, other._intellectDamageBonus);
+        EXPECT_EQ(spawnenchant, other.spawnenchant);
+        EXPECT_EQ(onlydamagefriendly, other.onlydamagefriendly);
+        EXPECT_EQ(friendlyfire, other.friendlyfire);
+        EXPECT_EQ(hateonly, other.hateonly);
+        EXPECT_EQ(cause_roll, other.cause_roll);
+        EXPECT_EQ(cause_pancake, other.cause_pancake);
+        EXPECT_EQ(lifeDrain, other.lifeDrain);
+        EXPECT_EQ(manaDrain, other.manaDrain);
+        EXPECT_EQ(homing, other.homing);
+        EXPECT_EQ(targetangle, other.targetangle);
+        EXPECT_EQ(homingaccel, other.homingaccel);
+        EXPECT_EQ(homingfriction, other.homingfriction);
+        EXPECT_EQ(zaimspd, other.zaimspd);
+        EXPECT_EQ(rotatetoface, other.rotatetoface);
+        EXPECT_EQ(targetcaster, other.targetcaster);
+        EXPECT_EQ(spdlimit, other.spdlimit);
+        EXPECT_EQ(dampen, other.dampen);
+        EXPECT_EQ(allowpush, other.allowpush);
+        EXPECT_EQ(ignore_gravity, other.ignore_gravity);
+        EXPECT_EQ(dynalight.mode, other.dynalight.mode);
+        EXPECT_EQ(dynalight.on, other.dynalight.on);
+        EXPECT_EQ(dynalight.level, other.dynalight.level);
+        EXPECT_EQ(dynalight.level_add, other.dynalight.level_add);
+        EXPECT_EQ(dynalight.falloff, other.dynalight.falloff);
+        EXPECT_EQ(dynalight.falloff_add, other.dynalight.falloff_add);
+        EXPECT_EQ(type, other.type);
+        EXPECT_EQ(image_max, other.image_max);
+        EXPECT_EQ(image_stt, other.image_stt);
+        ProfileCache::expectEqual(image_add, other.image_add);
+        ProfileCache::expectEqual(rotate_pair, other.rotate_pair);
+        EXPECT_EQ(rotate_add, other.rotate_add);
+        EXPECT_EQ(size_base, other.size_base);
+        EXPECT_EQ(size_add, other.size_add);
+        EXPECT_EQ(facingadd, other.facingadd);
+        EXPECT_EQ(orientation, other.orientation);
+        EXPECT_EQ(_comment, other._comment);
+        EXPECT_EQ(_particleEffectBits, other._particleEffectBits);
+        EXPECT_EQ(_gravityPull, other._gravityPull);
+        ProfileCache::expectEqual(_spawnFacing, other._spawnFacing);
+        ProfileCache::expectEqual(_spawnPositionOffsetXY, other._spawnPositionOffsetXY);
+        ProfileCache::expectEqual(_spawnPositionOffsetZ, other._spawnPositionOffsetZ);
+        ProfileCache::expectEqual(_spawnVelocityOffsetXY, other._spawnVelocityOffsetXY);
+        ProfileCache::expectEqual(_spawnVelocityOffsetZ, other._spawnVelocityOffsetZ);
+    }
+};
+
+/// An object profile with every cached field of its data file set to a non-default value.
+struct TestObjectProfile : ObjectProfile {
+    void write(std::vector<char>& buffer) const { writeDataToCache(buffer); }
+    bool read(Ego::CacheFile::Reader& reader) { return readDataFromCache(reader); }
+
+    void fill() {
+        _className = "Soldier";
+        for (size_t i = 0; i < 2; ++i) {
+            SkinInfo skin;
+            skin.name = "Skin " + std::to_string(i);
+            skin.cost = static_cast<uint16_t>(100 + i);
+            skin.maxAccel = 1.5f + i;
+            skin.dressy = (0 == i);
+            skin.defence = static_cast<uint8_t>(10 + i);
+            for (size_t j = 0; j < DAMAGE_COUNT; ++j) {
+                skin.damageModifier[j] = static_cast<uint8_t>(i + j);
+                skin.damageResistance[j] = i - 0.5f * j;
+            }
+            _skinInfo[2 * i + 1] = skin;
+        }
+        _skinOverride = 2;
+        _levelOverride = 3;
+        _stateOverride = 4;
+        _contentOverride = 5;
+        for (size_t i = 0; i < _idsz.size(); ++i) {
+            _idsz[i] = IDSZ2('A', 'B', 'C', static_cast<char>('D' + i));
+        }
+        _maxAmmo = 6;
+        _ammo = 7;
+        _money = 8;
+        _gender = GenderProfile::Female;
+        _spawnLife = 9;
+        _spawnMana = 10;
+        for (size_t i = 0; i < _baseAttribute.size(); ++i) {
+            _baseAttribute[i] = idlib::interval<float>(static_cast<float>(i), i + 1.5f);
+            _attributeGain[i] = idlib::interval<float>(i + 0.5f, i + 2.0f);
+        }
+        _weight = 11;
+        _bounciness = 0.125f;
+        _bumpDampen = 0.25f;
+        _size = 1.25f;
+        _sizeGainPerLevel = 0.375f;
+        _shadowSize = 12;
+        _bumpSize = 13;
+        _bumpOverrideSize = true;
+        _bumpSizeBig = 14;
+        _bumpOverrideSizeBig = true;
+        _bumpHeight = 15;
+        _bumpOverrideHeight = true;
+        _stoppedBy = 16;
+        _jumpPower = 17.5f;
+        _jumpNumber = 18;
+        _animationSpeedSneak = 1.0f;
+        _animationSpeedWalk = 2.0f;
+        _animationSpeedRun = 3.0f;
+        _flyHeight = 19;
+        _waterWalking = true;
+        _jumpSound = 20;
+        _footFallSound = 21;
+        _lifeColor = 22;
+        _manaColor = 23;
+        _drawIcon = false;
+        _flashAND = 24;
+        _alpha = 25;
+        _light = 26;
+        _transferBlending = true;
+        _sheen = 27;
+        _phongMapping = true;
+        _textureMovementRateX = 28;
+        _textureMovementRateY = -29;
+        _uniformLit = true;
+        _hasReflection = false;
+        _alwaysDraw = true;
+        _forceShadow = true;
+        _causesRipples = true;
+        _dontCullBackfaces = true;
+        iframefacing = 30;
+        iframeangle = 31;
+        nframefacing = 32;
+        nframeangle = 33;
+        _blockRating = 34;
+        _resistBumpSpawn = true;
+        for (size_t i = 0; i < _experienceForLevel.size(); ++i) {
+            _experienceForLevel[i] = static_cast<uint32_t>(100 * i);
+        }
+        _startingExperience = idlib::interval<float>(35.0f, 36.0f);
+        _experienceWorth = 37;
+        _experienceExchange = 0.5f;
+        for (size_t i = 0; i < _experienceRate.size(); ++i) {
+            _experienceRate[i] = i + 0.75f;
+        }
+        _levelUpRandomSeedOverride = 38;
+        _isEquipment = true;
+        _isItem = true;
+        _isMount = true;
+        _isStackable = true;
+        _isInvincible = true;
+        _isPlatform = true;
+        _canUsePlatforms = true;
+        _canGrabMoney = true;
+        _canOpenStuff = true;
+        _canBeDazed = true;
+        _canBeGrogged = true;
+        _isBigItem = true;
+        _isRanged = true;
+        _nameIsKnown = true;
+        _usageIsKnown = true;
+        _canCarryToNextModule = true;
+        _damageTargetDamageType = DAMAGE_EVIL;
+        for (size_t i = 0; i < _slotsValid.size(); ++i) {
+            _slotsValid[i] = (0 == i % 2);
+        }
+        _riderCanAttack = true;
+        _kurseChance = 39;
+        _hideState = 40;
+        _isValuable = 41;
+        _spellEffectType = 42;
+        _needSkillIDToUse = true;
+        _weaponAction = 43;
+        _attachAttackParticleToWeapon = true;
+        _attackParticle = LocalParticleProfileRef(44);
+        _attackFast = true;
+        _strengthBonus = 0.125f;
+        _intelligenceBonus = 0.25f;
+        _dexterityBonus = 0.375f;
+        _attachedParticleAmount = 45;
+        _attachedParticleReaffirmDamageType = DAMAGE_HOLY;
+        _attachedParticle = LocalParticleProfileRef(46);
+        _goPoofParticleAmount = 47;
+        _goPoofParticleFacingAdd = 48;
+        _goPoofParticle = LocalParticleProfileRef(49);
+        _bludValid = 50;
+        _bludParticle = LocalParticleProfileRef(51);
+        _seeInvisibleLevel = 52;
+        _stickyButt = true;
+        _useManaCost = 53.5f;
+        _startingPerks.set(1);
+        _startingPerks.set(3);
+        _perkPool.set(2);
+        _perkPool.set(5);
+    }
+
+    void expectEqual(const TestObjectProfile& other) const {
+        EXPECT_EQ(_className, other._className);
+        ASSERT_EQ(_skinInfo.size(), other._skinInfo.size());
+        for (const auto& element : _skinInfo) {
+            auto it = other._skinInfo.find(element.first);
+            ASSERT_NE(other._skinInfo.cend(), it);
+            const SkinInfo& expected = element.second, & actual = it->second;
+            EXPECT_EQ(expected.name, actual.name);
+            EXPECT_EQ(expected.cost, actual.cost);
+            EXPECT_EQ(expected.maxAccel, actual.maxAccel);
+            EXPECT_EQ(expected.dressy, actual.dressy);
+            EXPECT_EQ(expected.defence, actual.defence);
+            for (size_t j = 0; j < DAMAGE_COUNT; ++j) {
+                EXPECT_EQ(expected.damageModifier[j], actual.damageModifier[j]);
+                EXPECT_EQ(expected.damageResistance[j], actual.damageResistance[j]);
+            }
+        }
+        EXPECT_EQ(_skinOverride, other._skinOverride);
+        EXPECT_EQ(_levelOverride, other._levelOverride);
+        EXPECT_EQ(_stateOverride, other._stateOverride);
+        EXPECT_EQ(_contentOverride, other._contentOverride);
+        EXPECT_EQ(_idsz, other._idsz);
+        EXPECT_EQ(_maxAmmo, other._maxAmmo);
+        EXPECT_EQ(_ammo, other._ammo);
+        EXPECT_EQ(_money, other._money);
+        EXPECT_EQ(_gender, other._gender);
+        EXPECT_EQ(_spawnLife, other._spawnLife);
+        EXPECT_EQ(_spawnMana, other._spawnMana);
+        for (size_t i = 0; i < _baseAttribute.size(); ++i) {
+            ProfileCache::expectEqual(_baseAttribute[i], other._baseAttribute[i]);
+            ProfileCache::expectEqual(_attributeGain[i], other._attributeGain[i]);
+        }
+        EXPECT_EQ(_weight, other._weight);
+        EXPECT_EQ(_bounciness, other._bounciness);
+        EXPECT_EQ(_bumpDampen, other._bumpDampen);
+        EXPECT_EQ(_size, other._size);
+        EXPECT_EQ(_sizeGainPerLevel, other._sizeGainPerLevel);
+        EXPECT_EQ(_shadowSize, other._shadowSize);
+        EXPECT_EQ(_bumpSize, other._bumpSize);
+        EXPECT_EQ(_bumpOverrideSize, other._bumpOverrideSize);
+        EXPECT_EQ(_bumpSizeBig, other._bumpSizeBig);
+        EXPECT_EQ(_bumpOverrideSizeBig, other._bumpOverrideSizeBig);
+        EXPECT_EQ(_bumpHeight, other._bumpHeight);
+        EXPECT_EQ(_bumpOverrideHeight, other._bumpOverrideHeight);
+        EXPECT_EQ(_stoppedBy, other._stoppedBy);
+        EXPECT_EQ(_jumpPower, other._jumpPower);
+        EXPECT_EQ(_jumpNumber, other._jumpNumber);
+        EXPECT_EQ(_animationSpeedSneak, other._animationSpeedSneak);
+        EXPECT_EQ(_animationSpeedWalk, other._animationSpeedWalk);
+        EXPECT_EQ(_animationSpeedRun, other._animationSpeedRun);
+        EXPECT_EQ(_flyHeight, other._flyHeight);
+        EXPECT_EQ(_waterWalking, other._waterWalking);
+        EXPECT_EQ(_jumpSound, other._jumpSound);
+        EXPECT_EQ(_footFallSound, other._footFallSound);
+        EXPECT_EQ(_lifeColor, other._lifeColor);
+        EXPECT_EQ(_manaColor, other._manaColor);
+        EXPECT_EQ(_drawIcon, other._drawIcon);
+        EXPECT_EQ(_flashAND, other._flashAND);
+        EXPECT_EQ(_alpha, other._alpha);
+        EXPECT_EQ(_light, other._light);
+        EXPECT_EQ(_transferBlending, other._transferBlending);
+        EXPECT_EQ(_sheen, other._sheen);
+        EXPECT_EQ(_phongMapping, other._phongMapping);
+        EXPECT_EQ(_textureMovementRateX, other._textureMovementRateX);
+        EXPECT_EQ(_textureMovementRateY, other._textureMovementRateY);
+        EXPECT_EQ(_uniformLit, other._uniformLit);
+        EXPECT_EQ(_hasReflection, other._hasReflection);
+        EXPECT_EQ(_alwaysDraw, other._alwaysDraw);
+        EXPECT_EQ(_forceShadow, other._forceShadow);
+        EXPECT_EQ(_causesRipples, other._causesRipples);
+        EXPECT_EQ(_dontCullBackfaces, other._dontCullBackfaces);
+        EXPECT_EQ(iframefacing, other.iframefacing);
+        EXPECT_EQ(iframeangle, other.iframeangle);
+        EXPECT_EQ(nframefacing, other.nframefacing);
+        EXPECT_EQ(nframeangle, other.nframeangle);
+        EXPECT_EQ(_blockRating, other._blockRating);
+        EXPECT_EQ(_resistBumpSpawn, other._resistBumpSpawn);
+        EXPECT_EQ(_experienceForLevel, other._experienceForLevel);
+        ProfileCache::expectEqual(_startingExperience, other._startingExperience);
+        EXPECT_EQ(_experienceWorth, other._experienceWorth);
+        EXPECT_EQ(_experienceExchange, other._experienceExchange);
+        EXPECT_EQ(_experienceRate, other._experienceRate);
+        EXPECT_EQ(_levelUpRandomSeedOverride, other._levelUpRandomSeedOverride);
+        EXPECT_EQ(_isEquipment, other._isEquipment);
+        EXPECT_EQ(_isItem, other._isItem);
+        EXPECT_EQ(_isMount, other._isMount);
+        EXPECT_EQ(_isStackable, other._isStackable);
+        EXPECT_EQ(_isInvincible, other._isInvincible);
+        EXPECT_EQ(_isPlatform, other._isPlatform);
+        EXPECT_EQ(_canUsePlatforms, other._canUsePlatforms);
+        EXPECT_EQ(_canGrabMoney, other._canGrabMoney);
+        EXPECT_EQ(_canOpenStuff, other._canOpenStuff);
+        EXPECT_EQ(_canBeDazed, other._canBeDazed);
+        EXPECT_EQ(_canBeGrogged, other._canBeGrogged);
+        EXPECT_EQ(_isBigItem, other._isBigItem);
+        EXPECT_EQ(_isRanged, other._isRanged);
+        EXPECT_EQ(_nameIsKnown, other._nameIsKnown);
+        EXPECT_EQ(_usageIsKnown, other._usageIsKnown);
+        EXPECT_EQ(_canCarryToNextModule, other._canCarryToNextModule);
+        EXPECT_EQ(_damageTargetDamageType, other._damageTargetDamageType);
+        EXPECT_EQ(_slotsValid, other._slotsValid);
+        EXPECT_EQ(_riderCanAttack, other._riderCanAttack);
+        EXPECT_EQ(_kurseChance, other._kurseChance);
+        EXPECT_EQ(_hideState, other._hideState);
+        EXPECT_EQ(_isValuable, other._isValuable);
+        EXPECT_EQ(_spellEffectType, other._spellEffectType);
+        EXPECT_EQ(_needSkillIDToUse, other._needSkillIDToUse);
+        EXPECT_EQ(_weaponAction, other._weaponAction);
+        EXPECT_EQ(_attachAttackParticleToWeapon, other._attachAttackParticleToWeapon);
+        EXPECT_EQ(_attackParticle.get(), other._attackParticle.get());
+        EXPECT_EQ(_attackFast, other._attackFast);
+        EXPECT_EQ(_strengthBonus, other._strengthBonus);
+        EXPECT_EQ(_intelligenceBonus, other._intelligenceBonus);
+        EXPECT_EQ(_dexterityBonus, other._dexterityBonus);
+        EXPECT_EQ(_attachedParticleAmount, other._attachedParticleAmount);
+        EXPECT_EQ(_attachedParticleReaffirmDamageType, other._attachedParticleReaffirmDamageType);
+        EXPECT_EQ(_attachedParticle.get(), other._attachedParticle.get());
+        EXPECT_EQ(_goPoofParticleAmount, other._goPoofParticleAmount);
+        EXPECT_EQ(_goPoofParticleFacingAdd, other._goPoofParticleFacingAdd);
+        EXPECT_EQ(_goPoofParticle.get(), other._goPoofParticle.get());
+        EXPECT_EQ(_bludValid, other._bludValid);
+        EXPECT_EQ(_bludParticle.get(), other._bludParticle.get());
+        EXPECT_EQ(_seeInvisibleLevel, other._seeInvisibleLevel);
+        EXPECT_EQ(_stickyButt, other._stickyButt);
+        EXPECT_EQ(_useManaCost, other._useManaCost);
+        EXPECT_EQ(_startingPerks, other._startingPerks);
+        EXPECT_EQ(_perkPool, other._perkPool);
+    }
+};
+
+TEST(profile_cache_testing, enchant_profile_round_trip) {
+    TestEnchantProfile source, target;
+    source.fill();
+    roundTrip(source, target);
+    source.expectEqual(target);
+}
+
+TEST(profile_cache_testing, particle_profile_round_trip) {
+    TestParticleProfile source, target;
+    source.fill();
+    roundTrip(source, target);
+    source.expectEqual(target);
+}
+
+TEST(profile_cache_testing, object_profile_round_trip) {
+    TestObjectProfile source, target;
+    source.fill();
+    roundTrip(source, target);
+    source.expectEqual(target);
+}
+
+/// A cache entry of a particle profile and the stamp of its source file.
+struct Entry {
+    Ego::ProfileCache::Stamp stamp;
+    uint64_t sourceHash;
+    std::vector<char> data;
+
+    Entry() : stamp{"/data/objects/fireball.obj/part0.txt", 1024, 5}, sourceHash(0x1234) {
+        TestParticleProfile profile;
+        profile.fill();
+        data = Ego::ProfileCache::encode(stamp, sourceHash, Kind::Particle,
+                                         [&profile](std::vector<char>& buffer) { profile.write(buffer); });
+    }
+
+    /// Decode this entry into @a profile, given the current stamp and source hash of the source file.
+    Validity decode(TestParticleProfile& profile, const Ego::ProfileCache::Stamp& currentStamp, uint64_t currentSourceHash,
+                    Kind kind = Kind::Particle) const {
+        return Ego::ProfileCache::decode(data.data(), data.size(), currentStamp, kind,
+                                         [currentSourceHash](uint64_t& value) { value = currentSourceHash; return true; },
+                                         [&profile](Ego::CacheFile::Reader& reader) { return profile.read(reader); });
+    }
+};
+
+TEST(profile_cache_testing, valid_entry) {
+    Entry entry;
+    TestParticleProfile expected, actual;
+    expected.fill();
+    ASSERT_EQ(Validity::Valid, entry.decode(actual, entry.stamp, entry.sourceHash));
+    expected.expectEqual(actual);
+    // A touched but unchanged source file is still valid.
+    auto stamp = entry.stamp;
+    stamp.modificationTime++;
+    TestParticleProfile touched;
+    ASSERT_EQ(Validity::Valid, entry.decode(touched, stamp, entry.sourceHash));
+    expected.expectEqual(touched);
+}
+
+TEST(profile_cache_testing, stale_entry) {
+    Entry entry;
+    TestParticleProfile profile;
+    // The source file has a different length.
+    auto stamp = entry.stamp;
+    stamp.length++;
+    ASSERT_EQ(Validity::Stale, entry.decode(profile, stamp, entry.sourceHash));
+    // The source file has different contents.
+    stamp = entry.stamp;
+    stamp.modificationTime++;
+    ASSERT_EQ(Validity::Stale, entry.decode(profile, stamp, entry.sourceHash + 1));
+    // The entry belongs to another source file or another kind of profile.
+    stamp = entry.stamp;
+    stamp.resolvedPathname = "/data/objects/fireball.obj/part1.txt";
+    ASSERT_EQ(Validity::Stale, entry.decode(profile, stamp, entry.sourceHash));
+    ASSERT_EQ(Validity::Stale, entry.decode(profile, entry.stamp, entry.sourceHash, Kind::Enchant));
+    // The entry was written by another version of the cache.
+    Entry other;
+    other.data[4]++;
+    ASSERT_EQ(Validity::Stale, other.decode(profile, other.stamp, other.sourceHash));
+    // Nothing was deserialized, the parsed profile keeps its default values.
+    std::vector<char> expected, actual;
+    ParticleProfile().writeToCache(expected);
+    profile.write(actual);
+    ASSERT_EQ(expected, actual);
+}
+
+TEST(profile_cache_testing, corrupted_entry) {
+    TestParticleProfile profile;
+    // A payload Byte was changed.
+    Entry changed;
+    changed.data.back() ^= 0x5a;
+    ASSERT_EQ(Validity::Corrupted, changed.decode(profile, changed.stamp, changed.sourceHash));
+    // The payload was truncated.
+    Entry truncated;
+    truncated.data.pop_back();
+    ASSERT_EQ(Validity::Corrupted, truncated.decode(profile, truncated.stamp, truncated.sourceHash));
+    // The header was truncated.
+    Entry empty;
+    empty.data.resize(6);
+    ASSERT_EQ(Validity::Stale, empty.decode(profile, empty.stamp, empty.sourceHash));
+}
+
+TEST(profile_cache_testing, malformed_entry) {
+    Entry entry;
+    auto decode = [&entry](const Ego::ProfileCache::ReadFunction& read) {
+        return Ego::ProfileCache::decode(entry.data.data(), entry.data.size(), entry.stamp, Kind::Particle,
+                                         [](uint64_t&) { return false; }, read);
+    };
+    // The payload can not be deserialized.
+    ASSERT_EQ(Validity::Malformed, decode([](Ego::CacheFile::Reader&) { return false; }));
+    // The payload is not consumed entirely.
+    ASSERT_EQ(Validity::Malformed, decode([](Ego::CacheFile::Reader& reader) { uint8_t value; return reader.read(value); }));
+}
+
+} } } // namespace Ego::Test::ProfileCache
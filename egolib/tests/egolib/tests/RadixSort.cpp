@@ -0,0 +1,62 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "gtest/gtest.h"
+#include "egolib/Core/RadixSort.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Ego { namespace Test { namespace RadixSort {
+
+TEST(radix_sort_testing, test_float_keys_preserve_order) {
+    const std::vector<float> values = {-1000.0f, -1.5f, -0.0f, 0.0f, 1.0e-6f, 0.5f, 2.0f, 1.0e6f};
+    for (size_t i = 0; i + 1 < values.size(); ++i) {
+        ASSERT_LE(Ego::Core::toRadixKey(values[i]), Ego::Core::toRadixKey(values[i + 1]));
+    }
+    ASSERT_LT(Ego::Core::toRadixKey(-1.5f), Ego::Core::toRadixKey(0.5f));
+}
+
+TEST(radix_sort_testing, test_sort_matches_stable_sort) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-500.0f, 500.0f);
+    std::vector<std::pair<float, size_t>> elements;
+    for (size_t i = 0; i < 2000; ++i) {
+        // Quantize to get equal keys.
+        elements.emplace_back(std::floor(distribution(generator)), i);
+    }
+    auto expected = elements;
+    std::stable_sort(expected.begin(), expected.end(), [](const std::pair<float, size_t>& x, const std::pair<float, size_t>& y) {
+        return x.first < y.first;
+    });
+    std::vector<std::pair<float, size_t>> buffer;
+    Ego::Core::radixSort(elements, buffer, [](const std::pair<float, size_t>& x) { return Ego::Core::toRadixKey(x.first); });
+    ASSERT_EQ(expected, elements);
+}
+
+TEST(radix_sort_testing, test_small_keys_are_stable) {
+    std::vector<std::pair<uint32_t, int>> elements = {{2, 0}, {1, 1}, {2, 2}, {0, 3}, {1, 4}};
+    std::vector<std::pair<uint32_t, int>> buffer;
+    Ego::Core::radixSort(elements, buffer, [](const std::pair<uint32_t, int>& x) { return x.first; });
+    const std::vector<std::pair<uint32_t, int>> expected = {{0, 3}, {1, 1}, {1, 4}, {2, 0}, {2, 2}};
+    ASSERT_EQ(expected, elements);
+}
+
+} } } // namespace Ego::Test::RadixSort
@@ -0,0 +1,84 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/egolib.h"
+
+namespace Ego { namespace Test { namespace ReadContext {
+
+std::vector<char> toImage(const std::string& text)
+{
+    return std::vector<char>(text.begin(), text.end());
+}
+
+const std::string input =
+    "Integer : -42\r\n"
+    "Natural : 4294967295\n\r"
+    "Real : 0.25\n"
+    "Real : -1.5e3\n"
+    "Real : .125\n"
+    "Real : 3.\n"
+    "Real : 123456789.0\n"
+    "String : Hello~World_!\n"
+    "String : \n"
+    "Integer : +7\n";
+
+TEST(read_context, modes_agree)
+{
+    ::ReadContext tokens("test.txt", toImage(input)), direct("test.txt", toImage(input));
+    tokens.setMode(::ReadContext::Mode::Tokens);
+    ASSERT_EQ(::ReadContext::Mode::Direct, direct.getMode());
+    for (auto *ctxt : { &tokens, &direct })
+    {
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ(-42, ctxt->readIntegerLiteral());
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ(2, ctxt->get_line_number());
+        ASSERT_EQ(4294967295u, ctxt->readNaturalLiteral());
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ(3, ctxt->get_line_number());
+        ASSERT_EQ(0.25f, ctxt->readRealLiteral());
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ(-1.5e3f, ctxt->readRealLiteral());
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ(.125f, ctxt->readRealLiteral());
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ(3.f, ctxt->readRealLiteral());
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ(123456789.0f, ctxt->readRealLiteral());
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ("Hello\tWorld !", ctxt->readStringLiteral());
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ("", ctxt->readStringLiteral());
+        ASSERT_TRUE(ctxt->skipToColon(false));
+        ASSERT_EQ(7, ctxt->readIntegerLiteral());
+        ASSERT_FALSE(ctxt->skipToColon(true));
+        ASSERT_EQ(11, ctxt->get_line_number());
+    }
+}
+
+TEST(read_context, direct_mode_reports_errors)
+{
+    ::ReadContext ctxt("test.txt", toImage("Integer : -\nMissing colon"));
+    ASSERT_TRUE(ctxt.skipToColon(false));
+    ASSERT_THROW(ctxt.readIntegerLiteral(), idlib::hll::compilation_error);
+    ASSERT_THROW(ctxt.skipToColon(false), Ego::Script::MissingDelimiterError);
+}
+
+} } } // namespace Ego::Test::ReadContext
@@ -0,0 +1,121 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/egolib.h"
+#include "egolib/Script/ScriptCache.hpp"
+
+namespace Ego { namespace Test { namespace ScriptCache {
+
+using CompiledScript = Ego::Script::CompiledScript;
+using Validity = Ego::Script::ScriptCache::Validity;
+
+/// A compiled script invoking a function with two message literals of message indices 0 and 1.
+CompiledScript createCompiledScript() {
+    CompiledScript compiledScript;
+    auto& instructions = compiledScript.instructions;
+    instructions.append(Instruction(Instruction::FUNCTIONBITS | instructions.getOrCreateConstant(17)), 1);
+    instructions.append(Instruction(instructions.getOrCreateConstant(0)), 2);
+    instructions.append(Instruction(instructions.getOrCreateConstant(1)), 3);
+    instructions.append(Instruction(instructions.getOrCreateConstant(17)), 3);
+    compiledScript.messages.emplace_back(1, "Hello");
+    compiledScript.messages.emplace_back(2, "Goodbye");
+    return compiledScript;
+}
+
+/// Get the integer value loaded by an instruction.
+int getValue(const ::InstructionList& instructions, ::InstructionList::Index index) {
+    return instructions.getConstantPool().getConstant(instructions[index].getValueBits()).getAsInteger();
+}
+
+TEST(script_cache_testing, store_and_load) {
+    const auto expected = createCompiledScript();
+    std::vector<char> buffer;
+    ASSERT_TRUE(Ego::Script::ScriptCache::encode(42, 1024, expected, buffer));
+    CompiledScript actual;
+    ASSERT_EQ(Validity::Valid, Ego::Script::ScriptCache::decode(buffer.data(), buffer.size(), 42, 1024, actual));
+    const auto& expectedConstants = expected.instructions.getConstantPool();
+    const auto& actualConstants = actual.instructions.getConstantPool();
+    ASSERT_EQ(expectedConstants.getNumberOfConstants(), actualConstants.getNumberOfConstants());
+    for (uint32_t i = 0; i < expectedConstants.getNumberOfConstants(); ++i) {
+        ASSERT_EQ(expectedConstants.getConstant(i).getAsInteger(), actualConstants.getConstant(i).getAsInteger());
+    }
+    ASSERT_EQ(expected.instructions.getNumberOfInstructions(), actual.instructions.getNumberOfInstructions());
+    for (uint32_t i = 0; i < expected.instructions.getNumberOfInstructions(); ++i) {
+        ASSERT_EQ(expected.instructions[i].getBits(), actual.instructions[i].getBits());
+        ASSERT_EQ(expected.instructions.getSourceLine(i), actual.instructions.getSourceLine(i));
+    }
+    ASSERT_EQ(expected.messages, actual.messages);
+}
+
+TEST(script_cache_testing, stale_and_corrupted_entries) {
+    std::vector<char> buffer;
+    ASSERT_TRUE(Ego::Script::ScriptCache::encode(42, 1024, createCompiledScript(), buffer));
+    CompiledScript compiledScript;
+    // The entry belongs to another script source.
+    ASSERT_EQ(Validity::Stale, Ego::Script::ScriptCache::decode(buffer.data(), buffer.size(), 43, 1024, compiledScript));
+    ASSERT_EQ(Validity::Stale, Ego::Script::ScriptCache::decode(buffer.data(), buffer.size(), 42, 1025, compiledScript));
+    // The entry was written by another version of the cache.
+    auto other = buffer;
+    other[4]++;
+    ASSERT_EQ(Validity::Stale, Ego::Script::ScriptCache::decode(other.data(), other.size(), 42, 1024, compiledScript));
+    // The entry was truncated or extended.
+    ASSERT_EQ(Validity::Corrupted, Ego::Script::ScriptCache::decode(buffer.data(), buffer.size() - 1, 42, 1024, compiledScript));
+    other = buffer;
+    other.push_back(0);
+    ASSERT_EQ(Validity::Corrupted, Ego::Script::ScriptCache::decode(other.data(), other.size(), 42, 1024, compiledScript));
+}
+
+TEST(script_cache_testing, relocate_messages) {
+    const auto compiledScript = createCompiledScript();
+    // The object profile already has other messages, hence the message indices are shifted.
+    std::vector<std::string> profileMessages{"Ouch", "Hello", "Yikes"};
+    auto addMessage = [&profileMessages](const std::string& message) {
+        auto it = std::find(profileMessages.begin(), profileMessages.end(), message);
+        if (it != profileMessages.end()) return static_cast<size_t>(it - profileMessages.begin());
+        profileMessages.push_back(message);
+        return profileMessages.size() - 1;
+    };
+    const auto instructions = compiledScript.relocate(addMessage);
+    ASSERT_FALSE(instructions.isSharedWith(compiledScript.instructions));
+    ASSERT_EQ(4, profileMessages.size());
+    ASSERT_EQ(1, getValue(instructions, 1));
+    ASSERT_EQ(3, getValue(instructions, 2));
+    // Other instructions loading the same constants are not relocated.
+    ASSERT_EQ(compiledScript.instructions[0].getBits(), instructions[0].getBits());
+    ASSERT_EQ(17, getValue(instructions, 3));
+    // The compiled script is not modified.
+    ASSERT_EQ(0, getValue(compiledScript.instructions, 1));
+    ASSERT_EQ(1, getValue(compiledScript.instructions, 2));
+}
+
+TEST(script_cache_testing, relocate_unchanged_messages) {
+    const auto compiledScript = createCompiledScript();
+    std::vector<std::string> profileMessages;
+    auto addMessage = [&profileMessages](const std::string& message) {
+        profileMessages.push_back(message);
+        return profileMessages.size() - 1;
+    };
+    // The message indices are unchanged, hence the instructions are shared.
+    const auto instructions = compiledScript.relocate(addMessage);
+    ASSERT_TRUE(instructions.isSharedWith(compiledScript.instructions));
+    ASSERT_EQ((std::vector<std::string>{"Hello", "Goodbye"}), profileMessages);
+}
+
+} } } // namespace Ego::Test::ScriptCache
@@ -0,0 +1,181 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/egolib.h"
+#include "egolib/Script/IRuntimeStatistics.hpp"
+#include "egolib/Script/LoweredScript.hpp"
+#include "egolib/Script/Profiler.hpp"
+
+namespace Ego { namespace Test { namespace ScriptProfiler {
+
+using Ego::Script::Profiler;
+
+/// @brief A lowered script with one instruction per source line.
+std::shared_ptr<Ego::Script::LoweredScript> createLoweredScript(const std::vector<uint32_t>& sourceLines)
+{
+    auto lowered = std::make_shared<Ego::Script::LoweredScript>();
+    for (auto sourceLine : sourceLines)
+    {
+        Ego::Script::LoweredInstruction instruction{};
+        instruction.sourceLine = sourceLine;
+        instruction.numberOfLines = 1;
+        lowered->instructions.push_back(instruction);
+    }
+    return lowered;
+}
+
+/// @brief Runtime statistics exposing the statistics of each function.
+struct RuntimeStatistics : Ego::Script::IRuntimeStatistics<uint32_t>
+{
+    void append(const std::string&) override
+    {}
+
+    const FunctionStatistics& getFunctionStatistics(uint32_t functionName) const
+    {
+        return _functionStatistics.at(functionName);
+    }
+
+    size_t getNumberOfFunctions() const
+    {
+        return _functionStatistics.size();
+    }
+};
+
+TEST(script_profiler_testing, not_running)
+{
+    Profiler profiler;
+    auto lowered = createLoweredScript({1, 2});
+    ASSERT_FALSE(profiler.isRunning());
+    ASSERT_EQ(nullptr, profiler.beginRun("a.txt", *lowered));
+    ASSERT_THROW(profiler.start(0), idlib::argument_out_of_bounds_error);
+    ASSERT_FALSE(profiler.isRunning());
+}
+
+TEST(script_profiler_testing, sampling_interval)
+{
+    Profiler profiler;
+    auto lowered = createLoweredScript({1, 2});
+    profiler.start(3);
+    ASSERT_TRUE(profiler.isRunning());
+    ASSERT_EQ(3, profiler.getSamplingInterval());
+    // Every third run is sampled.
+    for (size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(nullptr, profiler.beginRun("a.txt", *lowered));
+        ASSERT_EQ(nullptr, profiler.beginRun("a.txt", *lowered));
+        ASSERT_NE(nullptr, profiler.beginRun("a.txt", *lowered));
+    }
+    // Stopping the profiler stops sampling, restarting it restarts counting.
+    profiler.stop();
+    ASSERT_EQ(nullptr, profiler.beginRun("a.txt", *lowered));
+    profiler.start(2);
+    ASSERT_EQ(nullptr, profiler.beginRun("a.txt", *lowered));
+    ASSERT_NE(nullptr, profiler.beginRun("a.txt", *lowered));
+}
+
+TEST(script_profiler_testing, line_statistics)
+{
+    Profiler profiler;
+    auto lowered = createLoweredScript({3, 5, 8});
+    profiler.start(1);
+    auto *statistics = profiler.beginRun("a.txt", *lowered);
+    ASSERT_NE(nullptr, statistics);
+    ASSERT_EQ("a.txt", statistics->name);
+    ASSERT_EQ(3, statistics->lines.size());
+    ASSERT_EQ(3, statistics->lines[0].sourceLine);
+    ASSERT_EQ(5, statistics->lines[1].sourceLine);
+    ASSERT_EQ(8, statistics->lines[2].sourceLine);
+    statistics->lines[1].numberOfExecutions++;
+    statistics->lines[1].totalTime += 2.0;
+    profiler.endRun(*statistics, ObjectRef(1), "Soldier", 3.0);
+    // The statistics are kept between runs of the same script.
+    auto *again = profiler.beginRun("a.txt", *lowered);
+    ASSERT_EQ(statistics, again);
+    ASSERT_EQ(1, again->lines[1].numberOfExecutions);
+    profiler.endRun(*again, ObjectRef(1), "Soldier", 1.0);
+    ASSERT_EQ(2, again->numberOfRuns);
+    ASSERT_EQ(4.0, again->totalTime);
+    // A reloaded script with a different number of instructions gets new line statistics.
+    auto reloaded = createLoweredScript({3, 4});
+    auto *other = profiler.beginRun("a.txt", *reloaded);
+    ASSERT_EQ(2, other->lines.size());
+    ASSERT_EQ(0, other->lines[1].numberOfExecutions);
+    // A reset removes all statistics.
+    profiler.reset();
+    auto *fresh = profiler.beginRun("a.txt", *lowered);
+    ASSERT_EQ(0, fresh->numberOfRuns);
+    ASSERT_EQ(0, fresh->lines[1].numberOfExecutions);
+}
+
+TEST(script_profiler_testing, summary)
+{
+    Profiler profiler;
+    auto lowered = createLoweredScript({3, 5});
+    profiler.start(1);
+    auto *a = profiler.beginRun("a.txt", *lowered);
+    a->lines[0].numberOfExecutions = 1;
+    a->lines[0].totalTime = 1.0;
+    a->lines[1].numberOfExecutions = 1;
+    a->lines[1].totalTime = 7.0;
+    profiler.endRun(*a, ObjectRef(1), "Soldier", 8.0);
+    auto *b = profiler.beginRun("b.txt", *lowered);
+    b->lines[0].numberOfExecutions = 1;
+    b->lines[0].totalTime = 4.0;
+    profiler.endRun(*b, ObjectRef(2), "Wizard", 4.0);
+    // The hot spots are ordered by descending total time and limited to the requested number.
+    const std::string summary = profiler.getSummary(2);
+    const auto first = summary.find("a.txt:5 "), second = summary.find("b.txt:3 ");
+    ASSERT_NE(std::string::npos, first);
+    ASSERT_NE(std::string::npos, second);
+    ASSERT_LT(first, second);
+    ASSERT_EQ(std::string::npos, summary.find("a.txt:3 "));
+    const auto soldier = summary.find("(Soldier)"), wizard = summary.find("(Wizard)");
+    ASSERT_NE(std::string::npos, soldier);
+    ASSERT_NE(std::string::npos, wizard);
+    ASSERT_LT(soldier, wizard);
+}
+
+TEST(script_profiler_testing, runtime_statistics)
+{
+    RuntimeStatistics statistics;
+    statistics.onFunctionInvoked(7, 2.0);
+    statistics.onFunctionInvoked(7, 5.0);
+    statistics.onFunctionInvoked(7, 1.0);
+    statistics.onFunctionInvoked(9, 3.0);
+    ASSERT_EQ(2, statistics.getNumberOfFunctions());
+    const auto& seven = statistics.getFunctionStatistics(7);
+    ASSERT_EQ(3, seven.numberOfCalls);
+    ASSERT_EQ(8.0, seven.totalTime);
+    ASSERT_EQ(5.0, seven.maxTime);
+    const auto& nine = statistics.getFunctionStatistics(9);
+    ASSERT_EQ(1, nine.numberOfCalls);
+    ASSERT_EQ(3.0, nine.totalTime);
+    ASSERT_EQ(3.0, nine.maxTime);
+    // Copies keep all values.
+    RuntimeStatistics copy = statistics;
+    const auto& copied = copy.getFunctionStatistics(7);
+    ASSERT_EQ(3, copied.numberOfCalls);
+    ASSERT_EQ(8.0, copied.totalTime);
+    ASSERT_EQ(5.0, copied.maxTime);
+    statistics.reset();
+    ASSERT_EQ(0, statistics.getNumberOfFunctions());
+}
+
+} } } // namespace Ego::Test::ScriptProfiler
@@ -0,0 +1,142 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/game/Graphics/TerrainChunks.hpp"
+#include "egolib/game/Graphics/TileList.hpp"
+
+namespace Ego { namespace Test { namespace TerrainChunks {
+
+using Chunks = Ego::Graphics::TerrainChunks;
+using Ego::Graphics::ClippingEntry;
+
+/// A quad of four vertices drawn as one fan i.e. two triangles.
+static tile_definition_t makeQuad() {
+    tile_definition_t definition = {};
+    definition.numvertices = 4;
+    definition.command_count = 1;
+    definition.command_entries[0] = 4;
+    for (uint16_t i = 0; i < 4; ++i) {
+        definition.command_verts[i] = i;
+    }
+    return definition;
+}
+
+static const tile_definition_t quad = makeQuad();
+
+/// Tiles left of x = 4 use texture 0, the other tiles use texture 1.
+static Chunks::Tile getTile(const Ego::MeshInfo& info, const Index1D& index) {
+    auto i2 = info.map(index);
+    return Chunks::Tile{i2.x() < 4 ? 0u : 1u, static_cast<uint32_t>(index.i()) * 4, &quad};
+}
+
+static std::vector<ClippingEntry> makeEntries(const Ego::MeshInfo& info, std::initializer_list<std::pair<int, int>> tiles, float distance = 0.0f) {
+    std::vector<ClippingEntry> entries;
+    for (const auto& tile : tiles) {
+        entries.emplace_back(info.map(Index2D(tile.first, tile.second)), distance);
+    }
+    return entries;
+}
+
+TEST(terrain_chunks_testing, test_chunk_count) {
+    Chunks x(Ego::MeshInfo(16, 16));
+    ASSERT_EQ(2, x.getChunkCountX());
+    ASSERT_EQ(2, x.getChunkCountY());
+    Chunks y(Ego::MeshInfo(17, 9));
+    ASSERT_EQ(3, y.getChunkCountX());
+    ASSERT_EQ(2, y.getChunkCountY());
+}
+
+TEST(terrain_chunks_testing, test_whole_chunk_is_one_draw_per_texture) {
+    Ego::MeshInfo info(16, 16);
+    Chunks chunks(info);
+    std::vector<ClippingEntry> entries;
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            entries.emplace_back(info.map(Index2D(x, y)), 0.0f);
+        }
+    }
+    const auto& draws = chunks.makeDraws(entries, [&info](const Index1D& i) { return getTile(info, i); });
+    ASSERT_EQ(2, draws.size());
+    ASSERT_EQ(0, draws[0].texture);
+    ASSERT_EQ(1, draws[1].texture);
+    // 32 tiles of two triangles each.
+    ASSERT_EQ(32 * 6, draws[0].count);
+    ASSERT_EQ(32 * 6, draws[1].count);
+    // The first triangle of the tile (0, 0).
+    ASSERT_EQ(0, draws[0].indices[0]);
+    ASSERT_EQ(1, draws[0].indices[1]);
+    ASSERT_EQ(2, draws[0].indices[2]);
+    // The first triangle of the tile (4, 0).
+    ASSERT_EQ(16, draws[1].indices[0]);
+}
+
+TEST(terrain_chunks_testing, test_invisible_tiles_split_draws) {
+    Ego::MeshInfo info(16, 16);
+    Chunks chunks(info);
+    auto entries = makeEntries(info, {{0, 0}, {1, 0}, {3, 0}});
+    const auto& draws = chunks.makeDraws(entries, [&info](const Index1D& i) { return getTile(info, i); });
+    ASSERT_EQ(2, draws.size());
+    ASSERT_EQ(12, draws[0].count);
+    ASSERT_EQ(0, draws[0].indices[0]);
+    ASSERT_EQ(6, draws[1].count);
+    ASSERT_EQ(12, draws[1].indices[0]);
+}
+
+TEST(terrain_chunks_testing, test_near_chunks_first) {
+    Ego::MeshInfo info(16, 16);
+    Chunks chunks(info);
+    auto entries = makeEntries(info, {{0, 0}}, 10.0f);
+    auto nearEntries = makeEntries(info, {{0, 8}}, 1.0f);
+    entries.insert(entries.end(), nearEntries.begin(), nearEntries.end());
+    const auto& draws = chunks.makeDraws(entries, [&info](const Index1D& i) { return getTile(info, i); });
+    ASSERT_EQ(2, draws.size());
+    ASSERT_EQ(info.map(Index2D(0, 8)).i() * 4, draws[0].indices[0]);
+    ASSERT_EQ(0, draws[1].indices[0]);
+}
+
+TEST(terrain_chunks_testing, test_rebuild_on_invalidate) {
+    Ego::MeshInfo info(16, 16);
+    Chunks chunks(info);
+    auto entries = makeEntries(info, {{0, 0}, {5, 5}});
+    uint32_t texture = 7;
+    auto function = [&](const Index1D& i) {
+        auto tile = getTile(info, i);
+        // The tile (5, 5) is not drawn.
+        auto i2 = info.map(i);
+        if (5 == i2.x() && 5 == i2.y()) {
+            tile.texture = Chunks::NoTexture;
+        } else {
+            tile.texture = texture;
+        }
+        return tile;
+    };
+    ASSERT_EQ(1, chunks.makeDraws(entries, function).size());
+    ASSERT_EQ(1, chunks.getRebuildCount());
+    // Clean chunks are not rebuilt.
+    texture = 8;
+    ASSERT_EQ(7, chunks.makeDraws(entries, function)[0].texture);
+    ASSERT_EQ(1, chunks.getRebuildCount());
+    // Dirty chunks are rebuilt when drawn.
+    chunks.invalidate(info.map(Index2D(0, 0)));
+    ASSERT_EQ(8, chunks.makeDraws(entries, function)[0].texture);
+    ASSERT_EQ(2, chunks.getRebuildCount());
+}
+
+} } } // namespace Ego::Test::TerrainChunks